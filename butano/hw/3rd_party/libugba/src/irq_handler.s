@@ -2,6 +2,12 @@
 //
 // Copyright (c) 2020-2022 Antonio Niño Díaz
 
+// The C preprocessor doesn't know C++ boolean literals:
+#define false 0
+#define true 1
+
+#include "../../../../include/bn_config_sprites.h"
+
     .section .iwram, "ax", %progbits
     .code 32
 
@@ -39,13 +45,16 @@ IRQ_GlobalInterruptHandler:
     tst     r1, r2
     bne     interrupt_found
 
-    # add     r3, r3, #4
-    # mov     r2, #(1 << 2) // VCOUNT
-    # tst     r1, r2
-    # bne     interrupt_found
+#if BN_CFG_SPRITES_MULTIPLEXING_ENABLED
+    add     r3, r3, #4
+    mov     r2, #(1 << 2) // VCOUNT
+    tst     r1, r2
+    bne     interrupt_found
 
-    # sub     r3, r3, #8
+    sub     r3, r3, #8
+#else
     sub     r3, r3, #4
+#endif
     mov     r2, #(1 << 0) // VBLANK
     tst     r1, r2
     bne     interrupt_found
@@ -7,6 +7,7 @@
 #define BN_HW_DISPLAY_H
 
 #include "bn_point.h"
+#include "bn_config_sprites.h"
 #include "bn_hw_bgs.h"
 
 #define REG_DISPCNT_U16     *(u16*)(REG_BASE+0x0000)
@@ -46,6 +47,10 @@ namespace bn::hw::display
     {
         unsigned dispcnt = unsigned(mode) | DCNT_OBJ_1D;
 
+        #if BN_CFG_SPRITES_MULTIPLEXING_ENABLED
+            dispcnt |= unsigned(DCNT_OAM_HBL);
+        #endif
+
         if(show_sprites)
         {
             dispcnt |= unsigned(DCNT_OBJ);
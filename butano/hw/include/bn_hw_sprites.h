@@ -32,6 +32,17 @@ namespace bn::hw::sprites
         to.attr2 = from.attr2;
     }
 
+    [[nodiscard]] inline bool copy_handle_if_changed(const handle_type& from, handle_type& to)
+    {
+        if(from.attr0 == to.attr0 && from.attr1 == to.attr1 && from.attr2 == to.attr2)
+        {
+            return false;
+        }
+
+        copy_handle(from, to);
+        return true;
+    }
+
     namespace
     {
         [[nodiscard]] inline handle_type* vram()
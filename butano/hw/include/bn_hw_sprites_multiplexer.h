@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2020-2025 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_HW_SPRITES_MULTIPLEXER_H
+#define BN_HW_SPRITES_MULTIPLEXER_H
+
+#include "bn_config_sprites.h"
+#include "bn_hw_irq.h"
+#include "bn_hw_tonc.h"
+#include "bn_hw_sprites_constants.h"
+#include "bn_hw_display_constants.h"
+
+namespace bn::hw::sprites_multiplexer
+{
+    class rewrite
+    {
+
+    public:
+        uint16_t attr0;
+        uint16_t attr1;
+        uint16_t attr2;
+        uint16_t handle_index;
+    };
+
+    class band
+    {
+
+    public:
+        const rewrite* rewrites;
+        int rewrites_count;
+        int vcount;
+    };
+
+    [[nodiscard]] constexpr int max_bands()
+    {
+        return BN_CFG_SPRITES_MULTIPLEXING_BANDS;
+    }
+
+    [[nodiscard]] constexpr int max_band_rewrites()
+    {
+        return BN_CFG_SPRITES_MULTIPLEXING_MAX_REWRITES_PER_BAND;
+    }
+
+    [[nodiscard]] constexpr int max_irq_rewrites()
+    {
+        // The V-Count interrupt is triggered at the beginning of a scanline, not in H-Blank,
+        // but it is kept shorter than a H-Blank interval (272 cycles) to limit how long it delays other interrupts.
+        // The interrupt dispatch takes about 80 cycles and each rewrite takes about 24 more:
+        return (272 - 80) / 24;
+    }
+
+    [[nodiscard]] constexpr int max_rewrites()
+    {
+        int max_band_rewrites_count = max_band_rewrites() * (max_bands() - 1);
+        int max_restore_rewrites_count = max_band_rewrites_count < sprites::count() ?
+                    max_band_rewrites_count : sprites::count();
+        return max_band_rewrites_count + max_restore_rewrites_count;
+    }
+
+    [[nodiscard]] constexpr int restore_vcount()
+    {
+        return display::height();
+    }
+
+    [[nodiscard]] constexpr int rewrite_scanlines()
+    {
+        // The V-Count interrupt is triggered at the beginning of a scanline
+        // and sprites are drawn one scanline before they're displayed,
+        // so handles are rewritten while the scanline before the previous one is being drawn:
+        return 3;
+    }
+
+    [[nodiscard]] constexpr int band_vcount(int first_scanline)
+    {
+        return first_scanline - rewrite_scanlines();
+    }
+
+    class table
+    {
+
+    public:
+        int bands_count = 0;
+        band bands[max_bands()];
+        rewrite rewrites[max_rewrites()];
+    };
+
+    class state
+    {
+
+    public:
+        const table* table_ptr = nullptr;
+        int band_index = 0;
+    };
+
+    extern state data;
+
+    BN_CODE_IWRAM void _intr();
+
+    inline void commit_table(const table& table_ref)
+    {
+        data.table_ptr = &table_ref;
+        data.band_index = 0;
+        REG_DISPSTAT = uint16_t((REG_DISPSTAT & ~DSTAT_VCT_MASK) | DSTAT_VCT(table_ref.bands[0].vcount));
+        irq::enable(irq::id::VCOUNT);
+    }
+
+    inline void disable()
+    {
+        irq::disable(irq::id::VCOUNT);
+    }
+}
+
+#endif
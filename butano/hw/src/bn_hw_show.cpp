@@ -152,7 +152,7 @@ namespace
         }
         else
         {
-            // Collect entries:
+            // Collect entries (total ticks are exclusive, so nested entries don't count twice):
             struct entry
             {
                 string_view id;
@@ -169,8 +169,8 @@ namespace
             for(const auto& ticks_per_entry_pair : ticks_per_entry)
             {
                 auto& ticks_entry = ticks_per_entry_pair.second;
-                entries.push_back({ ticks_per_entry_pair.first, ticks_entry.total, ticks_entry.max });
-                total_ticks += ticks_entry.total;
+                entries.push_back({ ticks_per_entry_pair.first, ticks_entry.exclusive_total, ticks_entry.max });
+                total_ticks += ticks_entry.exclusive_total;
                 max_ticks = bn::max(max_ticks, int64_t(ticks_entry.max));
             }
 
@@ -240,12 +240,12 @@ namespace
 
                 if(show_total)
                 {
-                    tte_write("PROFILER results - TOTAL ticks");
+                    tte_write("PROFILER results - EXCLUSIVE ticks");
                     global_var = total_ticks;
                 }
                 else
                 {
-                    tte_write("PROFILER results - MAX ticks");
+                    tte_write("PROFILER results - MAX inclusive ticks");
                     global_var = max_ticks;
                 }
 
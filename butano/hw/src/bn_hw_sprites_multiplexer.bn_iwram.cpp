@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2020-2025 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "../include/bn_hw_sprites_multiplexer.h"
+
+namespace bn::hw::sprites_multiplexer
+{
+
+state data;
+
+void _intr()
+{
+    const table& table_ref = *data.table_ptr;
+    int band_index = data.band_index;
+    const band& band_ref = table_ref.bands[band_index];
+    const rewrite* rewrites = band_ref.rewrites;
+    auto oam = reinterpret_cast<volatile uint16_t*>(MEM_OAM);
+
+    for(int index = 0, limit = band_ref.rewrites_count; index < limit; ++index)
+    {
+        const rewrite& rewrite_ref = rewrites[index];
+        volatile uint16_t* handle = oam + (rewrite_ref.handle_index * 4);
+        handle[0] = rewrite_ref.attr0;
+        handle[1] = rewrite_ref.attr1;
+        handle[2] = rewrite_ref.attr2;
+    }
+
+    ++band_index;
+
+    if(band_index == table_ref.bands_count)
+    {
+        band_index = 0;
+    }
+
+    data.band_index = band_index;
+    REG_DISPSTAT = uint16_t((REG_DISPSTAT & ~DSTAT_VCT_MASK) | DSTAT_VCT(table_ref.bands[band_index].vcount));
+}
+
+}
@@ -344,6 +344,9 @@ public:
      *
      * If the source and destination map cells overlap, the behavior is undefined.
      *
+     * Compressed big maps are not supported, since they are decompressed in chunks on demand
+     * (see @ref BN_CFG_BG_BLOCKS_MAX_MAP_CHUNKS).
+     *
      * @param decompressed_cells_ref Destination of the decompressed map cells.
      * @return An affine_bg_map_item pointing to the decompressed map cells.
      */
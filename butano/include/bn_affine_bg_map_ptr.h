@@ -390,6 +390,14 @@ public:
      */
     void reload_cells_ref();
 
+    /**
+     * @brief Indicates if the referenced map cells will be in VRAM after the next V-Blank.
+     *
+     * It returns `false` only if the referenced map cells are compressed and they have not been decompressed
+     * into the staging buffer yet (see @ref BN_CFG_BG_BLOCKS_STAGING_BUFFER_SIZE).
+     */
+    [[nodiscard]] bool ready() const;
+
     /**
      * @brief Returns the referenced tiles.
      */
@@ -23,6 +23,13 @@ namespace bn
 /**
  * @brief Manages a chunk of memory with a best fit allocation strategy.
  *
+ * By default, free memory blocks are stored in a single list, so allocation time grows linearly
+ * with the number of free blocks.
+ *
+ * In segregated fit mode, free memory blocks are stored in lists grouped by size (TLSF style),
+ * so a suitable free block is found in constant time at the cost of some bytes of the managed memory
+ * and of a slightly worse fit.
+ *
  * @ingroup allocator
  */
 class best_fit_allocator
@@ -46,6 +53,17 @@ public:
         reset(start, bytes);
     }
 
+    /**
+     * @brief Constructor.
+     * @param start Pointer to the first element of the memory to manage.
+     * @param bytes Size in bytes of the memory to manage.
+     * @param segregated_fit Indicates if free memory blocks must be stored in lists grouped by size or not.
+     */
+    best_fit_allocator(void* start, size_type bytes, bool segregated_fit)
+    {
+        reset(start, bytes, segregated_fit);
+    }
+
     best_fit_allocator(const best_fit_allocator&) = delete;
 
     best_fit_allocator& operator=(const best_fit_allocator&) = delete;
@@ -73,6 +91,14 @@ public:
         return _free_bytes_count;
     }
 
+    /**
+     * @brief Indicates if free memory blocks are stored in lists grouped by size or not.
+     */
+    [[nodiscard]] bool segregated_fit() const
+    {
+        return _free_lists;
+    }
+
     /**
      * @brief Indicates if it doesn't contain any item.
      */
@@ -171,6 +197,16 @@ public:
      */
     void reset(void* start, size_type bytes);
 
+    /**
+     * @brief Setups the allocator to manage a new chunk of memory.
+     * @param start Pointer to the first element of the memory to manage.
+     * @param bytes Size in bytes of the memory to manage.
+     * @param segregated_fit Indicates if free memory blocks must be stored in lists grouped by size or not.
+     *
+     * In segregated fit mode, the lists are stored at the beginning of the managed memory.
+     */
+    void reset(void* start, size_type bytes, bool segregated_fit);
+
     /**
      * @brief Logs the current status of the allocator.
      */
@@ -178,6 +214,7 @@ public:
 
 private:
     class item_type;
+    class free_lists;
 
     struct free_items_pair
     {
@@ -222,6 +259,7 @@ private:
 
     uint8_t* _start_ptr = nullptr;
     item_type* _first_free_item = nullptr;
+    free_lists* _free_lists = nullptr;
     size_type _total_bytes_count = 0;
     size_type _free_bytes_count = 0;
 
@@ -247,6 +285,14 @@ private:
 
     [[nodiscard]] item_type* _best_free_item(size_type bytes);
 
+    [[nodiscard]] void* _segregated_alloc(size_type bytes);
+
+    void _segregated_free(item_type* item);
+
+    void _insert_segregated_free_item(item_type* item);
+
+    void _erase_segregated_free_item(item_type* item);
+
     #if BN_CFG_BEST_FIT_ALLOCATOR_SANITY_CHECK_ENABLED
         void _sanity_check() const;
     #endif
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2020-2025 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_CAMERA_3D_H
+#define BN_CAMERA_3D_H
+
+/**
+ * @file
+ * bn::camera_3d implementation header file.
+ *
+ * @ingroup model_3d
+ */
+
+#include "bn_point_3d.h"
+
+namespace bn
+{
+
+/**
+ * @brief Camera which draws 3D models with imodels_3d.
+ *
+ * It looks down the y axis (from higher to lower vertical coordinates) and it can be rotated around it,
+ * so it is suited for top-down views.
+ *
+ * @ingroup model_3d
+ */
+class camera_3d
+{
+
+public:
+    /**
+     * @brief Default constructor.
+     *
+     * The camera is placed at (0, 256, 0) without rotation.
+     */
+    camera_3d() :
+        camera_3d(point_3d(0, 256, 0), 0)
+    {
+    }
+
+    /**
+     * @brief Constructor.
+     * @param position Position of the camera.
+     * @param phi Rotation angle around the y axis in degrees, in the range [0..360].
+     */
+    camera_3d(const point_3d& position, fixed phi);
+
+    /**
+     * @brief Returns the position of the camera.
+     */
+    [[nodiscard]] const point_3d& position() const
+    {
+        return _position;
+    }
+
+    /**
+     * @brief Sets the position of the camera.
+     */
+    void set_position(const point_3d& position)
+    {
+        _position = position;
+    }
+
+    /**
+     * @brief Returns the rotation angle around the y axis in degrees.
+     */
+    [[nodiscard]] fixed phi() const
+    {
+        return _phi;
+    }
+
+    /**
+     * @brief Sets the rotation angle around the y axis in degrees.
+     * @param phi Rotation angle in degrees, in the range [0..360].
+     */
+    void set_phi(fixed phi);
+
+    /**
+     * @brief Returns the screen horizontal axis in world coordinates.
+     */
+    [[nodiscard]] const point_3d& u() const
+    {
+        return _u;
+    }
+
+    /**
+     * @brief Returns the screen vertical axis in world coordinates.
+     */
+    [[nodiscard]] const point_3d& v() const
+    {
+        return _v;
+    }
+
+private:
+    point_3d _position;
+    fixed _phi;
+    point_3d _u;
+    point_3d _v;
+};
+
+}
+
+#endif
@@ -26,6 +26,73 @@
     #define BN_CFG_BG_BLOCKS_MAX_ITEMS 16
 #endif
 
+/**
+ * @def BN_CFG_BG_BLOCKS_STAGING_BUFFER_SIZE
+ *
+ * Specifies the size in bytes of the EWRAM buffer used to decompress background tiles and maps before V-Blank.
+ *
+ * If it is greater than zero, compressed background tiles and maps are decompressed outside V-Blank
+ * over one or more frames (see @ref BN_CFG_BG_BLOCKS_STAGING_MAX_CYCLES) and only copied to VRAM in V-Blank.
+ *
+ * Compressed background tiles and maps bigger than this buffer are still decompressed in V-Blank.
+ *
+ * @ingroup bg
+ */
+#ifndef BN_CFG_BG_BLOCKS_STAGING_BUFFER_SIZE
+    #define BN_CFG_BG_BLOCKS_STAGING_BUFFER_SIZE 0
+#endif
+
+/**
+ * @def BN_CFG_BG_BLOCKS_STAGING_MAX_CYCLES
+ *
+ * Specifies the maximum number of CPU cycles per frame spent decompressing background tiles and maps
+ * into the staging buffer (see @ref BN_CFG_BG_BLOCKS_STAGING_BUFFER_SIZE).
+ *
+ * Each item is decompressed in one go, so this budget can be exceeded by the last item processed in a frame.
+ *
+ * @ingroup bg
+ */
+#ifndef BN_CFG_BG_BLOCKS_STAGING_MAX_CYCLES
+    #define BN_CFG_BG_BLOCKS_STAGING_MAX_CYCLES 35112
+#endif
+
+/**
+ * @def BN_CFG_BG_BLOCKS_MAX_MAP_CHUNKS
+ *
+ * Specifies the maximum number of decompressed big map chunks kept in EWRAM.
+ *
+ * Compressed big maps are split in chunks of 32x32 cells compressed independently,
+ * so only the chunks around the visible area are decompressed (each one takes 2KB of EWRAM).
+ *
+ * Chunks required by the next frame are decompressed before V-Blank if they fit in this cache.
+ *
+ * If it is zero, compressed big maps are not supported.
+ *
+ * @ingroup bg
+ */
+#ifndef BN_CFG_BG_BLOCKS_MAX_MAP_CHUNKS
+    #define BN_CFG_BG_BLOCKS_MAX_MAP_CHUNKS 0
+#endif
+
+/**
+ * @def BN_CFG_BG_BLOCKS_MAX_STREAMED_TILES_PER_FRAME
+ *
+ * Specifies the maximum number of tiles loaded into VRAM per frame by a moved streamed big map
+ * (see bn::regular_bg_map_ptr::create_streamed).
+ *
+ * Streamed tiles are copied in V-Blank, so moving a streamed map too far in one frame asserts
+ * instead of taking more V-Blank time than this budget allows.
+ *
+ * The first commit of a streamed map is not limited.
+ *
+ * If it is zero, the number of tiles loaded per frame is not limited.
+ *
+ * @ingroup bg
+ */
+#ifndef BN_CFG_BG_BLOCKS_MAX_STREAMED_TILES_PER_FRAME
+    #define BN_CFG_BG_BLOCKS_MAX_STREAMED_TILES_PER_FRAME 256
+#endif
+
 /**
  * @def BN_CFG_BG_BLOCKS_LOG_ENABLED
  *
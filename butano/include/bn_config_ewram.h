@@ -28,4 +28,18 @@
     #define BN_CFG_EWRAM_WAIT_STATE BN_EWRAM_WAIT_STATE_2
 #endif
 
+/**
+ * @def BN_CFG_EWRAM_HEAP_SEGREGATED_FIT
+ *
+ * Indicates if the EWRAM heap allocator must store free memory blocks in lists grouped by size or not.
+ *
+ * Segregated fit mode makes EWRAM allocations faster when the heap is fragmented,
+ * at the cost of some bytes of EWRAM and of a slightly worse fit.
+ *
+ * @ingroup memory
+ */
+#ifndef BN_CFG_EWRAM_HEAP_SEGREGATED_FIT
+    #define BN_CFG_EWRAM_HEAP_SEGREGATED_FIT false
+#endif
+
 #endif
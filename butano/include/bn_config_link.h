@@ -64,4 +64,97 @@
     #define BN_CFG_LINK_MAX_MISSING_MESSAGES 4
 #endif
 
+/**
+ * @def BN_CFG_LINK_STREAM_MAX_PACKET_SIZE
+ *
+ * Specifies the maximum number of payload bytes sent in each bn::link_stream packet.
+ *
+ * Bigger packets waste less bandwidth in headers, but each lost or corrupted message
+ * makes more data to be sent again.
+ *
+ * @ingroup link
+ */
+#ifndef BN_CFG_LINK_STREAM_MAX_PACKET_SIZE
+    #define BN_CFG_LINK_STREAM_MAX_PACKET_SIZE 64
+#endif
+
+/**
+ * @def BN_CFG_LINK_STREAM_MAX_PACKETS_IN_FLIGHT
+ *
+ * Specifies the maximum number of bn::link_stream packets sent without being acknowledged by the other player.
+ *
+ * It must be a power of two.
+ *
+ * @ingroup link
+ */
+#ifndef BN_CFG_LINK_STREAM_MAX_PACKETS_IN_FLIGHT
+    #define BN_CFG_LINK_STREAM_MAX_PACKETS_IN_FLIGHT 4
+#endif
+
+/**
+ * @def BN_CFG_LINK_STREAM_RETRANSMIT_WAIT
+ *
+ * Specifies how many bn::link_stream updates have to pass without receiving acknowledgements
+ * before sending again the packets in flight.
+ *
+ * @ingroup link
+ */
+#ifndef BN_CFG_LINK_STREAM_RETRANSMIT_WAIT
+    #define BN_CFG_LINK_STREAM_RETRANSMIT_WAIT 30
+#endif
+
+/**
+ * @def BN_CFG_LINK_STREAM_WORDS_PER_UPDATE
+ *
+ * Specifies the default maximum number of messages sent by each bn::link_stream update.
+ *
+ * With the default @ref BN_CFG_LINK_SEND_WAIT value, around five messages can be sent each frame.
+ * If this parameter is too high, messages are discarded when the send queue is full
+ * (see @ref BN_CFG_LINK_MAX_MESSAGES), wasting bandwidth in retransmissions.
+ *
+ * @ingroup link
+ */
+#ifndef BN_CFG_LINK_STREAM_WORDS_PER_UPDATE
+    #define BN_CFG_LINK_STREAM_WORDS_PER_UPDATE 4
+#endif
+
+/**
+ * @def BN_CFG_LINK_ROLLBACK_INPUT_DELAY
+ *
+ * Specifies the default number of frames between the local keypad is read by a bn::link_rollback_session
+ * and the frame in which it is used.
+ *
+ * A higher delay reduces rollbacks, but it makes the game less responsive.
+ *
+ * @ingroup link
+ */
+#ifndef BN_CFG_LINK_ROLLBACK_INPUT_DELAY
+    #define BN_CFG_LINK_ROLLBACK_INPUT_DELAY 2
+#endif
+
+/**
+ * @def BN_CFG_LINK_ROLLBACK_MAX_FRAMES
+ *
+ * Specifies the default maximum number of frames that a bn::link_rollback_session can simulate
+ * predicting the keypad of the other player.
+ *
+ * If it is zero, frames are only simulated when the keypad of the other player has been received (lockstep).
+ *
+ * @ingroup link
+ */
+#ifndef BN_CFG_LINK_ROLLBACK_MAX_FRAMES
+    #define BN_CFG_LINK_ROLLBACK_MAX_FRAMES 6
+#endif
+
+/**
+ * @def BN_CFG_LINK_ROLLBACK_WORDS_PER_UPDATE
+ *
+ * Specifies the maximum number of messages sent by each bn::link_rollback_session update.
+ *
+ * @ingroup link
+ */
+#ifndef BN_CFG_LINK_ROLLBACK_WORDS_PER_UPDATE
+    #define BN_CFG_LINK_ROLLBACK_WORDS_PER_UPDATE 4
+#endif
+
 #endif
@@ -61,4 +61,28 @@
     #define BN_CFG_PROFILER_MAX_ENTRIES 64
 #endif
 
+/**
+ * @def BN_CFG_PROFILER_MAX_DEPTH
+ *
+ * Specifies the maximum number of code blocks that can be profiled at the same time (nested).
+ *
+ * @ingroup profiler
+ */
+#ifndef BN_CFG_PROFILER_MAX_DEPTH
+    #define BN_CFG_PROFILER_MAX_DEPTH 16
+#endif
+
+/**
+ * @def BN_CFG_PROFILER_TIMELINE_MAX_ENTRIES
+ *
+ * Specifies the maximum number of code block measures stored in the profiler timeline.
+ *
+ * When the timeline is full, the oldest measures are discarded.
+ *
+ * @ingroup profiler
+ */
+#ifndef BN_CFG_PROFILER_TIMELINE_MAX_ENTRIES
+    #define BN_CFG_PROFILER_TIMELINE_MAX_ENTRIES 128
+#endif
+
 #endif
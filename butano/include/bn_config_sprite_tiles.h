@@ -27,6 +27,37 @@
     #define BN_CFG_SPRITE_TILES_MAX_ITEMS 128
 #endif
 
+/**
+ * @def BN_CFG_SPRITE_TILES_STAGING_BUFFER_SIZE
+ *
+ * Specifies the size in bytes of the EWRAM buffer used to decompress sprite tiles before V-Blank.
+ *
+ * If it is greater than zero, compressed sprite tiles are decompressed outside V-Blank over one or more frames
+ * (see @ref BN_CFG_SPRITE_TILES_STAGING_MAX_CYCLES) and only copied to VRAM in V-Blank.
+ *
+ * Compressed sprite tiles bigger than this buffer are still decompressed in V-Blank.
+ *
+ * @ingroup sprite
+ */
+#ifndef BN_CFG_SPRITE_TILES_STAGING_BUFFER_SIZE
+    #define BN_CFG_SPRITE_TILES_STAGING_BUFFER_SIZE 0
+#endif
+
+/**
+ * @def BN_CFG_SPRITE_TILES_STAGING_MAX_CYCLES
+ *
+ * Specifies the maximum number of CPU cycles per frame spent decompressing sprite tiles
+ * into the staging buffer (see @ref BN_CFG_SPRITE_TILES_STAGING_BUFFER_SIZE).
+ *
+ * Each sprite tiles item is decompressed in one go, so this budget can be exceeded by the last item processed
+ * in a frame.
+ *
+ * @ingroup sprite
+ */
+#ifndef BN_CFG_SPRITE_TILES_STAGING_MAX_CYCLES
+    #define BN_CFG_SPRITE_TILES_STAGING_MAX_CYCLES 35112
+#endif
+
 /**
  * @def BN_CFG_SPRITE_TILES_LOG_ENABLED
  *
@@ -13,7 +13,10 @@
  * @ingroup sprite
  */
 
-#include "bn_common.h"
+// Assembler guard
+#ifndef __ASSEMBLER__
+    #include "bn_common.h"
+#endif
 
 /**
  * @def BN_CFG_SPRITES_MAX_ITEMS
@@ -43,4 +46,96 @@
     #define BN_CFG_SPRITES_MAX_SORT_LAYERS 16
 #endif
 
+/**
+ * @def BN_CFG_SPRITES_INCREMENTAL_SORT_ENABLED
+ *
+ * Specifies if hardware sprite handles must be updated incrementally when the order of a visible sprite
+ * is changed or when a visible sprite is hidden or destroyed.
+ *
+ * If it's disabled (or if sprites multiplexing is enabled), all hardware sprite handles are rebuilt instead.
+ *
+ * @ingroup sprite
+ */
+#ifndef BN_CFG_SPRITES_INCREMENTAL_SORT_ENABLED
+    #define BN_CFG_SPRITES_INCREMENTAL_SORT_ENABLED false
+#endif
+
+/**
+ * @def BN_CFG_SPRITES_MULTIPLEXING_ENABLED
+ *
+ * Specifies if more than 128 sprites can be displayed at the same time or not.
+ *
+ * If it's enabled, on screen sprites are split in horizontal bands depending on their vertical position.
+ * When all hardware sprite handles are used, the ones of sprites located in upper bands are reused
+ * by sprites located in lower bands by rewriting them while the screen is being drawn.
+ *
+ * Sprite handles are rewritten by a V-Count interrupt, which is triggered at the beginning of a scanline
+ * (not in H-Blank) three scanlines before the first scanline of each band which has sprite handles to rewrite.
+ * Since sprites are fetched one scanline before they're displayed, the rewrites are done before the band is drawn,
+ * but the handles of a sprite can't be reused until three scanlines after its last one.
+ *
+ * Sprites multiplexing has the following drawbacks:
+ * * Sprites rendering time per scanline is reduced (from 1210 to 954 cycles), since OAM access
+ *   in the H-Blank interval is enabled.
+ * * A V-Count interrupt is triggered before each band which has sprite handles to rewrite.
+ *   It must be short to avoid delaying other interrupts, like the H-Blank one used by H-Blank effects
+ *   (see @ref BN_CFG_SPRITES_MULTIPLEXING_MAX_REWRITES_PER_BAND).
+ * * Sprites are not always sorted as expected if they have different bands.
+ * * Sprite handles are rebuilt every time a visible sprite is created, destroyed, sorted or moved to another band.
+ *
+ * @ingroup sprite
+ */
+#ifndef BN_CFG_SPRITES_MULTIPLEXING_ENABLED
+    #define BN_CFG_SPRITES_MULTIPLEXING_ENABLED false
+#endif
+
+/**
+ * @def BN_CFG_SPRITES_MULTIPLEXING_BANDS
+ *
+ * Specifies the number of horizontal bands in which the screen is split when sprites multiplexing is enabled.
+ *
+ * More bands allow to reuse more hardware sprite handles, at the cost of more V-Count interrupts per frame.
+ *
+ * @ingroup sprite
+ */
+#ifndef BN_CFG_SPRITES_MULTIPLEXING_BANDS
+    #define BN_CFG_SPRITES_MULTIPLEXING_BANDS 8
+#endif
+
+/**
+ * @def BN_CFG_SPRITES_MULTIPLEXING_MAX_REWRITES_PER_BAND
+ *
+ * Specifies the maximum number of hardware sprite handles that can be rewritten at the beginning of each band
+ * when sprites multiplexing is enabled.
+ *
+ * Handles are only rewritten when more than 128 sprites are on screen,
+ * so this value limits how many of the extra sprites can start in each band.
+ *
+ * The V-Count interrupt which rewrites them is kept shorter than a H-Blank interval (272 cycles)
+ * to limit how long it delays other interrupts, so it can't be greater than 8.
+ *
+ * @ingroup sprite
+ */
+#ifndef BN_CFG_SPRITES_MULTIPLEXING_MAX_REWRITES_PER_BAND
+    #define BN_CFG_SPRITES_MULTIPLEXING_MAX_REWRITES_PER_BAND 8
+#endif
+
+/**
+ * @def BN_CFG_SPRITES_MAX_BATCHES
+ *
+ * Specifies the maximum number of bn::sprite_batch objects that can exist at the same time.
+ *
+ * Sprite batches are not supported when sprites multiplexing is enabled, so in that case it must be zero
+ * (its default value when sprites multiplexing is enabled).
+ *
+ * @ingroup sprite
+ */
+#ifndef BN_CFG_SPRITES_MAX_BATCHES
+    #if BN_CFG_SPRITES_MULTIPLEXING_ENABLED
+        #define BN_CFG_SPRITES_MAX_BATCHES 0
+    #else
+        #define BN_CFG_SPRITES_MAX_BATCHES 4
+    #endif
+#endif
+
 #endif
@@ -28,4 +28,15 @@
     #define BN_CFG_SRAM_WAIT_STATE BN_SRAM_WAIT_STATE_8
 #endif
 
+/**
+ * @def BN_CFG_SRAM_JOURNAL_MAX_BYTES_PER_UPDATE
+ *
+ * Specifies the default maximum number of bytes written to SRAM by bn::isram_journal::update.
+ *
+ * @ingroup sram
+ */
+#ifndef BN_CFG_SRAM_JOURNAL_MAX_BYTES_PER_UPDATE
+    #define BN_CFG_SRAM_JOURNAL_MAX_BYTES_PER_UPDATE 512
+#endif
+
 #endif
@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2020-2025 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_CONFIG_TASKS_H
+#define BN_CONFIG_TASKS_H
+
+/**
+ * @file
+ * Tasks configuration header file.
+ *
+ * @ingroup task
+ */
+
+#include "bn_common.h"
+
+/**
+ * @def BN_CFG_TASKS_MAX_ITEMS
+ *
+ * Specifies the maximum number of tasks that can be alive at the same time.
+ *
+ * If it's 0, tasks are disabled: the tasks pool is not allocated and bn::core::update doesn't check them.
+ *
+ * @ingroup task
+ */
+#ifndef BN_CFG_TASKS_MAX_ITEMS
+    #define BN_CFG_TASKS_MAX_ITEMS 0
+#endif
+
+/**
+ * @def BN_CFG_TASKS_MAX_FRAME_SIZE
+ *
+ * Specifies the maximum size in bytes of the coroutine frame of a task.
+ *
+ * The coroutine frame stores the arguments and the local variables which live across suspension points,
+ * so the memory required by all tasks is BN_CFG_TASKS_MAX_ITEMS * BN_CFG_TASKS_MAX_FRAME_SIZE bytes.
+ *
+ * @ingroup task
+ */
+#ifndef BN_CFG_TASKS_MAX_FRAME_SIZE
+    #define BN_CFG_TASKS_MAX_FRAME_SIZE 256
+#endif
+
+#endif
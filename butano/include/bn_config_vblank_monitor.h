@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2020-2025 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_CONFIG_VBLANK_MONITOR_H
+#define BN_CONFIG_VBLANK_MONITOR_H
+
+/**
+ * @file
+ * V-Blank monitor configuration header file.
+ *
+ * @ingroup core
+ */
+
+#include "bn_common.h"
+
+/**
+ * @def BN_CFG_VBLANK_MONITOR_ENABLED
+ *
+ * Specifies if the V-Blank usage of each commit stage must be recorded or not.
+ *
+ * It only reads a timer at the end of each stage, so it can be enabled in release builds.
+ *
+ * @ingroup core
+ */
+#ifndef BN_CFG_VBLANK_MONITOR_ENABLED
+    #define BN_CFG_VBLANK_MONITOR_ENABLED true
+#endif
+
+/**
+ * @def BN_CFG_VBLANK_MONITOR_MAX_FRAMES
+ *
+ * Specifies the maximum number of frames stored by the V-Blank monitor.
+ *
+ * When there's no room for a new frame, the oldest one is discarded.
+ *
+ * @ingroup core
+ */
+#ifndef BN_CFG_VBLANK_MONITOR_MAX_FRAMES
+    #define BN_CFG_VBLANK_MONITOR_MAX_FRAMES 16
+#endif
+
+/**
+ * @def BN_CFG_VBLANK_MONITOR_LOG_OVERRUNS
+ *
+ * Specifies if frames which exceeded the V-Blank period must be printed with BN_LOG when they are recorded.
+ *
+ * @ingroup core
+ */
+#ifndef BN_CFG_VBLANK_MONITOR_LOG_OVERRUNS
+    #define BN_CFG_VBLANK_MONITOR_LOG_OVERRUNS false
+#endif
+
+#endif
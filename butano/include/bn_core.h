@@ -168,12 +168,14 @@ namespace bn::core
     /**
      * @brief Returns the user function called in V-Blank.
      */
-    [[nodiscard]] vblank_callback_type vblank_callback();
+    [[nodiscard]] const vblank_callback_type& vblank_callback();
 
     /**
      * @brief Sets the user function called in V-Blank.
+     *
+     * It can be called from the V-Blank callback itself: the new callback is called from the next V-Blank.
      */
-    void set_vblank_callback(vblank_callback_type vblank_callback);
+    void set_vblank_callback(const vblank_callback_type& vblank_callback);
 
     /**
      * @brief Indicates if a slow game pak like the SuperCard SD has been detected or not.
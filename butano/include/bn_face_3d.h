@@ -0,0 +1,270 @@
+/*
+ * Copyright (c) 2020-2025 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_FACE_3D_H
+#define BN_FACE_3D_H
+
+/**
+ * @file
+ * bn::face_3d implementation header file.
+ *
+ * @ingroup model_3d
+ */
+
+#include "bn_math.h"
+#include "bn_span.h"
+#include "bn_assert.h"
+#include "bn_vertex_3d.h"
+
+namespace bn
+{
+
+/**
+ * @brief Flat shaded triangle or convex quad of a 3D model.
+ *
+ * Its vertices must be sorted counterclockwise when they are seen from the front of the face,
+ * since only front faces are drawn.
+ *
+ * @ingroup model_3d
+ */
+class face_3d
+{
+
+public:
+    /**
+     * @brief Shading value which indicates that the shading of the face
+     * must be calculated from the vertical coordinate of its normal.
+     */
+    static constexpr int directional_shading = -1;
+
+    /**
+     * @brief Number of shading levels.
+     *
+     * Each shading level is drawn with its own sprite palette.
+     */
+    static constexpr int shading_levels = 8;
+
+    /**
+     * @brief Maximum number of colors which can be referenced by faces.
+     */
+    static constexpr int max_colors = 10;
+
+    /**
+     * @brief Triangle constructor.
+     * @param vertices Vertices of the model.
+     * @param normal Normalized vector perpendicular to the face.
+     * @param first_vertex_index Index of the first vertex of the face.
+     * @param second_vertex_index Index of the second vertex of the face.
+     * @param third_vertex_index Index of the third vertex of the face.
+     * @param color_index Index of the color of the face in the range [0..max_colors).
+     * @param shading Shading level of the face in the range [0..shading_levels),
+     * or directional_shading to calculate it from the given normal.
+     */
+    constexpr face_3d(const span<const vertex_3d>& vertices, const vertex_3d& normal, int first_vertex_index,
+                      int second_vertex_index, int third_vertex_index, int color_index, int shading) :
+        _centroid(_calculate_centroid(vertices, first_vertex_index, second_vertex_index, third_vertex_index)),
+        _normal(normal),
+        _first_vertex_index(int16_t(first_vertex_index)),
+        _second_vertex_index(int16_t(second_vertex_index)),
+        _third_vertex_index(int16_t(third_vertex_index)),
+        _fourth_vertex_index(int16_t(first_vertex_index)),
+        _color_index(int8_t(color_index)),
+        _shading(int8_t(_calculate_shading(shading, normal.point().y()))),
+        _triangle(true)
+    {
+        BN_ASSERT(color_index >= 0 && color_index < max_colors, "Invalid color index: ", color_index);
+    }
+
+    /**
+     * @brief Quad constructor.
+     * @param vertices Vertices of the model.
+     * @param normal Normalized vector perpendicular to the face.
+     * @param first_vertex_index Index of the first vertex of the face.
+     * @param second_vertex_index Index of the second vertex of the face.
+     * @param third_vertex_index Index of the third vertex of the face.
+     * @param fourth_vertex_index Index of the fourth vertex of the face.
+     * @param color_index Index of the color of the face in the range [0..max_colors).
+     * @param shading Shading level of the face in the range [0..shading_levels),
+     * or directional_shading to calculate it from the given normal.
+     */
+    constexpr face_3d(const span<const vertex_3d>& vertices, const vertex_3d& normal, int first_vertex_index,
+                      int second_vertex_index, int third_vertex_index, int fourth_vertex_index, int color_index,
+                      int shading) :
+        _centroid(_calculate_centroid(vertices, first_vertex_index, second_vertex_index, third_vertex_index,
+                                      fourth_vertex_index)),
+        _normal(normal),
+        _first_vertex_index(int16_t(first_vertex_index)),
+        _second_vertex_index(int16_t(second_vertex_index)),
+        _third_vertex_index(int16_t(third_vertex_index)),
+        _fourth_vertex_index(int16_t(fourth_vertex_index)),
+        _color_index(int8_t(color_index)),
+        _shading(int8_t(_calculate_shading(shading, normal.point().y()))),
+        _triangle(false)
+    {
+        BN_ASSERT(color_index >= 0 && color_index < max_colors, "Invalid color index: ", color_index);
+    }
+
+    /**
+     * @brief Returns the center of the face, used to cull and sort it.
+     */
+    [[nodiscard]] constexpr const vertex_3d& centroid() const
+    {
+        return _centroid;
+    }
+
+    /**
+     * @brief Returns the normalized vector perpendicular to the face.
+     */
+    [[nodiscard]] constexpr const vertex_3d& normal() const
+    {
+        return _normal;
+    }
+
+    /**
+     * @brief Returns the index of the first vertex of the face.
+     */
+    [[nodiscard]] constexpr int first_vertex_index() const
+    {
+        return _first_vertex_index;
+    }
+
+    /**
+     * @brief Returns the index of the second vertex of the face.
+     */
+    [[nodiscard]] constexpr int second_vertex_index() const
+    {
+        return _second_vertex_index;
+    }
+
+    /**
+     * @brief Returns the index of the third vertex of the face.
+     */
+    [[nodiscard]] constexpr int third_vertex_index() const
+    {
+        return _third_vertex_index;
+    }
+
+    /**
+     * @brief Returns the index of the fourth vertex of the face.
+     *
+     * If the face is a triangle, it returns the index of the first vertex.
+     */
+    [[nodiscard]] constexpr int fourth_vertex_index() const
+    {
+        return _fourth_vertex_index;
+    }
+
+    /**
+     * @brief Returns the index of the color of the face.
+     */
+    [[nodiscard]] constexpr int color_index() const
+    {
+        return _color_index;
+    }
+
+    /**
+     * @brief Sets the index of the color of the face.
+     * @param color_index Index of the color of the face in the range [0..max_colors).
+     */
+    constexpr void set_color_index(int color_index)
+    {
+        BN_ASSERT(color_index >= 0 && color_index < max_colors, "Invalid color index: ", color_index);
+
+        _color_index = int8_t(color_index);
+    }
+
+    /**
+     * @brief Returns the shading level of the face.
+     */
+    [[nodiscard]] constexpr int shading() const
+    {
+        return _shading;
+    }
+
+    /**
+     * @brief Sets the shading level of the face.
+     * @param shading Shading level of the face in the range [0..shading_levels),
+     * or directional_shading to calculate it from its normal.
+     */
+    constexpr void set_shading(int shading)
+    {
+        _shading = int8_t(_calculate_shading(shading, _normal.point().y()));
+    }
+
+    /**
+     * @brief Indicates if the face is a triangle or a quad.
+     */
+    [[nodiscard]] constexpr bool triangle() const
+    {
+        return _triangle;
+    }
+
+private:
+    vertex_3d _centroid;
+    vertex_3d _normal;
+    int16_t _first_vertex_index;
+    int16_t _second_vertex_index;
+    int16_t _third_vertex_index;
+    int16_t _fourth_vertex_index;
+    int8_t _color_index;
+    int8_t _shading;
+    bool _triangle;
+
+    [[nodiscard]] static constexpr const point_3d& _point(const span<const vertex_3d>& vertices, int vertex_index)
+    {
+        BN_ASSERT(vertex_index >= 0 && vertex_index < vertices.size(),
+                  "Invalid vertex index: ", vertex_index, " - ", vertices.size());
+
+        return vertices.data()[vertex_index].point();
+    }
+
+    [[nodiscard]] static constexpr vertex_3d _calculate_centroid(
+            const span<const vertex_3d>& vertices, int first_vertex_index, int second_vertex_index,
+            int third_vertex_index)
+    {
+        const point_3d& first_point = _point(vertices, first_vertex_index);
+        const point_3d& second_point = _point(vertices, second_vertex_index);
+        const point_3d& third_point = _point(vertices, third_vertex_index);
+        BN_ASSERT(first_point != second_point && first_point != third_point && second_point != third_point,
+                  "Face vertices are the same: ", first_vertex_index, " - ", second_vertex_index, " - ",
+                  third_vertex_index);
+
+        return vertex_3d((first_point + second_point + third_point) / 3);
+    }
+
+    [[nodiscard]] static constexpr vertex_3d _calculate_centroid(
+            const span<const vertex_3d>& vertices, int first_vertex_index, int second_vertex_index,
+            int third_vertex_index, int fourth_vertex_index)
+    {
+        const point_3d& first_point = _point(vertices, first_vertex_index);
+        const point_3d& second_point = _point(vertices, second_vertex_index);
+        const point_3d& third_point = _point(vertices, third_vertex_index);
+        const point_3d& fourth_point = _point(vertices, fourth_vertex_index);
+        BN_ASSERT(first_point != second_point && first_point != third_point && second_point != third_point &&
+                  fourth_point != first_point && fourth_point != second_point && fourth_point != third_point,
+                  "Face vertices are the same: ", first_vertex_index, " - ", second_vertex_index, " - ",
+                  third_vertex_index, " - ", fourth_vertex_index);
+
+        return vertex_3d((first_point + second_point + third_point + fourth_point) / 4);
+    }
+
+    [[nodiscard]] static constexpr int _calculate_shading(int shading, fixed normal_y)
+    {
+        if(shading == directional_shading)
+        {
+            // Light comes from above, so horizontal faces are brighter than vertical ones:
+            int result = abs(normal_y).data() >> (fixed::precision() - 3);
+            return min(result, shading_levels - 1);
+        }
+
+        BN_ASSERT(shading >= 0 && shading < shading_levels, "Invalid shading: ", shading);
+
+        return shading;
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2020-2025 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_FUNCTION_REF_H
+#define BN_FUNCTION_REF_H
+
+/**
+ * @file
+ * bn::function_ref implementation header file.
+ *
+ * @ingroup functional
+ */
+
+#include "bn_assert.h"
+#include "bn_utility.h"
+#include "bn_type_traits.h"
+
+namespace bn
+{
+
+/**
+ * @brief Non-owning reference to a callable, useful as a cheap function parameter type.
+ *
+ * It doesn't allocate memory nor copy the referenced callable,
+ * so the referenced lambda or function object must outlive the function_ref.
+ *
+ * @tparam Signature Function type of the referenced callable, like `void(int)`.
+ *
+ * @ingroup functional
+ */
+template<typename Signature>
+class function_ref;
+
+
+template<typename Result, typename... Args>
+class function_ref<Result(Args...)>
+{
+
+public:
+    using result_type = Result; //!< Result type alias.
+
+    /**
+     * @brief Constructor.
+     * @param function Function pointer to reference. It must not be null.
+     */
+    template<typename Function>
+    requires(is_function_v<Function> && is_invocable_r_v<Result, Function&, Args...>)
+    function_ref(Function* function) :
+        _invoker(&_invoke_function<Function>)
+    {
+        BN_BASIC_ASSERT(function, "Function is null");
+
+        _target.function = reinterpret_cast<void(*)()>(function);
+    }
+
+    /**
+     * @brief Constructor.
+     * @param function Lambda or function object to reference.
+     */
+    template<typename Function>
+    requires(! is_same_v<remove_cvref_t<Function>, function_ref> && ! is_pointer_v<remove_cvref_t<Function>> &&
+             ! is_member_pointer_v<remove_cvref_t<Function>> &&
+             is_invocable_r_v<Result, remove_reference_t<Function>&, Args...>)
+    function_ref(Function&& function) :
+        _invoker(&_invoke_object<remove_reference_t<Function>>)
+    {
+        _target.object = &function;
+    }
+
+    /**
+     * @brief Calls the referenced callable with the given arguments.
+     * @return The value returned by the referenced callable.
+     */
+    Result operator()(Args... args) const
+    {
+        return _invoker(_target, forward<Args>(args)...);
+    }
+
+private:
+    union target_type
+    {
+        const void* object;
+        void(*function)();
+    };
+
+    using invoker_type = Result(*)(target_type target, Args&&... args);
+
+    target_type _target;
+    invoker_type _invoker;
+
+    template<typename Function>
+    static Result _invoke_object(target_type target, Args&&... args)
+    {
+        Function& function = *static_cast<Function*>(const_cast<void*>(target.object));
+
+        if constexpr(is_void_v<Result>)
+        {
+            function(forward<Args>(args)...);
+        }
+        else
+        {
+            return function(forward<Args>(args)...);
+        }
+    }
+
+    template<typename Function>
+    static Result _invoke_function(target_type target, Args&&... args)
+    {
+        Function* function = reinterpret_cast<Function*>(target.function);
+
+        if constexpr(is_void_v<Result>)
+        {
+            function(forward<Args>(args)...);
+        }
+        else
+        {
+            return function(forward<Args>(args)...);
+        }
+    }
+};
+
+}
+
+#endif
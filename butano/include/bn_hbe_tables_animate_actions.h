@@ -0,0 +1,297 @@
+/*
+ * Copyright (c) 2020-2025 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_HBE_TABLES_ANIMATE_ACTIONS_H
+#define BN_HBE_TABLES_ANIMATE_ACTIONS_H
+
+/**
+ * @file
+ * H-Blank effect tables animate actions header file.
+ *
+ * @ingroup hblank_effect
+ * @ingroup action
+ */
+
+#include "bn_fixed.h"
+#include "bn_utility.h"
+#include "bn_hbe_tables_item.h"
+
+namespace bn
+{
+
+/**
+ * @brief Sets the values reference of a H-Blank effect with its `set_values_ref` method.
+ *
+ * @tparam HbePtr H-Blank effect to modify.
+ * @tparam Type Type of the values referenced by the H-Blank effect.
+ *
+ * @ingroup hblank_effect
+ * @ingroup action
+ */
+template<class HbePtr, typename Type>
+class hbe_values_ref_manager
+{
+
+public:
+    /**
+     * @brief Sets the values reference of the given H-Blank effect.
+     */
+    static void set(const span<const Type>& values_ref, HbePtr& hbe)
+    {
+        hbe.set_values_ref(values_ref);
+    }
+};
+
+
+/**
+ * @brief Sets the deltas reference of a H-Blank effect with its `set_deltas_ref` method.
+ *
+ * @tparam HbePtr H-Blank effect to modify.
+ *
+ * @ingroup hblank_effect
+ * @ingroup action
+ */
+template<class HbePtr>
+class hbe_deltas_ref_manager
+{
+
+public:
+    /**
+     * @brief Sets the deltas reference of the given H-Blank effect.
+     */
+    static void set(const span<const fixed>& deltas_ref, HbePtr& hbe)
+    {
+        hbe.set_deltas_ref(deltas_ref);
+    }
+};
+
+
+/**
+ * @brief Changes the values referenced by a H-Blank effect with the tables of a hbe_tables_item
+ * when the given amount of update calls are done.
+ *
+ * Values are not computed at runtime: only the referenced table is changed.
+ *
+ * @tparam HbePtr H-Blank effect to modify.
+ * @tparam Type Type of the values referenced by the H-Blank effect.
+ * @tparam ValuesRefManager Sets the values reference of the H-Blank effect to modify.
+ *
+ * @ingroup hblank_effect
+ * @ingroup action
+ */
+template<class HbePtr, typename Type, class ValuesRefManager>
+class hbe_tables_animate_template_action
+{
+
+public:
+    /**
+     * @brief Generates a hbe_tables_animate_template_action which loops over the given tables only once.
+     * @param hbe H-Blank effect to copy.
+     * @param wait_updates Number of times the action must be updated before changing the referenced table.
+     * @param tables_item It contains the tables to reference.
+     * @return The requested hbe_tables_animate_template_action.
+     */
+    [[nodiscard]] static hbe_tables_animate_template_action once(
+            const HbePtr& hbe, int wait_updates, const hbe_tables_item<Type>& tables_item)
+    {
+        return hbe_tables_animate_template_action(HbePtr(hbe), wait_updates, tables_item, false);
+    }
+
+    /**
+     * @brief Generates a hbe_tables_animate_template_action which loops over the given tables only once.
+     * @param hbe H-Blank effect to move.
+     * @param wait_updates Number of times the action must be updated before changing the referenced table.
+     * @param tables_item It contains the tables to reference.
+     * @return The requested hbe_tables_animate_template_action.
+     */
+    [[nodiscard]] static hbe_tables_animate_template_action once(
+            HbePtr&& hbe, int wait_updates, const hbe_tables_item<Type>& tables_item)
+    {
+        return hbe_tables_animate_template_action(move(hbe), wait_updates, tables_item, false);
+    }
+
+    /**
+     * @brief Generates a hbe_tables_animate_template_action which loops over the given tables forever.
+     * @param hbe H-Blank effect to copy.
+     * @param wait_updates Number of times the action must be updated before changing the referenced table.
+     * @param tables_item It contains the tables to reference.
+     * @return The requested hbe_tables_animate_template_action.
+     */
+    [[nodiscard]] static hbe_tables_animate_template_action forever(
+            const HbePtr& hbe, int wait_updates, const hbe_tables_item<Type>& tables_item)
+    {
+        return hbe_tables_animate_template_action(HbePtr(hbe), wait_updates, tables_item, true);
+    }
+
+    /**
+     * @brief Generates a hbe_tables_animate_template_action which loops over the given tables forever.
+     * @param hbe H-Blank effect to move.
+     * @param wait_updates Number of times the action must be updated before changing the referenced table.
+     * @param tables_item It contains the tables to reference.
+     * @return The requested hbe_tables_animate_template_action.
+     */
+    [[nodiscard]] static hbe_tables_animate_template_action forever(
+            HbePtr&& hbe, int wait_updates, const hbe_tables_item<Type>& tables_item)
+    {
+        return hbe_tables_animate_template_action(move(hbe), wait_updates, tables_item, true);
+    }
+
+    /**
+     * @brief Changes the table referenced by the given H-Blank effect
+     * when the given amount of update calls are done.
+     */
+    void update()
+    {
+        BN_ASSERT(! done(), "Action is done");
+
+        if(_current_wait_updates)
+        {
+            --_current_wait_updates;
+        }
+        else
+        {
+            int current_table_index = _current_table_index;
+            _current_wait_updates = _wait_updates;
+            ValuesRefManager::set(_tables_item.table(current_table_index), _hbe);
+
+            if(_forever && current_table_index == _tables_item.tables_count() - 1)
+            {
+                _current_table_index = 0;
+            }
+            else
+            {
+                _current_table_index = current_table_index + 1;
+            }
+        }
+    }
+
+    /**
+     * @brief Indicates if the action must not be updated anymore.
+     */
+    [[nodiscard]] bool done() const
+    {
+        return _current_table_index == _tables_item.tables_count();
+    }
+
+    /**
+     * @brief Resets the action to its initial state.
+     */
+    void reset()
+    {
+        _current_table_index = 0;
+        _current_wait_updates = 0;
+    }
+
+    /**
+     * @brief Returns the H-Blank effect to modify.
+     */
+    [[nodiscard]] const HbePtr& hbe() const
+    {
+        return _hbe;
+    }
+
+    /**
+     * @brief Returns the number of times the action must be updated before changing the referenced table.
+     */
+    [[nodiscard]] int wait_updates() const
+    {
+        return _wait_updates;
+    }
+
+    /**
+     * @brief Sets the number of times the action must be updated before changing the referenced table.
+     */
+    void set_wait_updates(int wait_updates)
+    {
+        BN_ASSERT(wait_updates >= 0, "Invalid wait updates: ", wait_updates);
+
+        _wait_updates = uint16_t(wait_updates);
+    }
+
+    /**
+     * @brief Returns the number of times the action must be updated before the next table change.
+     */
+    [[nodiscard]] int next_change_updates() const
+    {
+        return _current_wait_updates;
+    }
+
+    /**
+     * @brief Returns the hbe_tables_item which contains the tables to reference.
+     */
+    [[nodiscard]] const hbe_tables_item<Type>& tables_item() const
+    {
+        return _tables_item;
+    }
+
+    /**
+     * @brief Indicates if the action can be updated forever or not.
+     */
+    [[nodiscard]] bool update_forever() const
+    {
+        return _forever;
+    }
+
+    /**
+     * @brief Returns the index of the next table to reference.
+     */
+    [[nodiscard]] int current_index() const
+    {
+        return _current_table_index;
+    }
+
+private:
+    HbePtr _hbe;
+    hbe_tables_item<Type> _tables_item;
+    uint16_t _wait_updates;
+    uint16_t _current_table_index = 0;
+    uint16_t _current_wait_updates = 0;
+    bool _forever;
+
+    hbe_tables_animate_template_action(HbePtr&& hbe, int wait_updates, const hbe_tables_item<Type>& tables_item,
+                                       bool forever) :
+        _hbe(move(hbe)),
+        _tables_item(tables_item),
+        _wait_updates(uint16_t(wait_updates)),
+        _forever(forever)
+    {
+        BN_ASSERT(wait_updates >= 0, "Invalid wait updates: ", wait_updates);
+    }
+};
+
+
+/**
+ * @brief Changes the values referenced by a H-Blank effect with a `set_values_ref` method
+ * (like bn::affine_bg_pa_register_hbe_ptr or bn::affine_bg_dx_register_hbe_ptr)
+ * with the tables of a hbe_tables_item when the given amount of update calls are done.
+ *
+ * @tparam HbePtr H-Blank effect to modify.
+ * @tparam Type Type of the values referenced by the H-Blank effect.
+ *
+ * @ingroup hblank_effect
+ * @ingroup action
+ */
+template<class HbePtr, typename Type>
+using hbe_values_tables_animate_action =
+        hbe_tables_animate_template_action<HbePtr, Type, hbe_values_ref_manager<HbePtr, Type>>;
+
+
+/**
+ * @brief Changes the deltas referenced by a H-Blank effect with a `set_deltas_ref` method
+ * (like bn::regular_bg_position_hbe_ptr or bn::affine_bg_pivot_position_hbe_ptr)
+ * with the tables of a hbe_tables_item when the given amount of update calls are done.
+ *
+ * @tparam HbePtr H-Blank effect to modify.
+ *
+ * @ingroup hblank_effect
+ * @ingroup action
+ */
+template<class HbePtr>
+using hbe_deltas_tables_animate_action =
+        hbe_tables_animate_template_action<HbePtr, fixed, hbe_deltas_ref_manager<HbePtr>>;
+
+}
+
+#endif
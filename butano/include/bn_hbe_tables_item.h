@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2020-2025 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_HBE_TABLES_ITEM_H
+#define BN_HBE_TABLES_ITEM_H
+
+/**
+ * @file
+ * bn::hbe_tables_item header file.
+ *
+ * @ingroup hblank_effect
+ * @ingroup tool
+ */
+
+#include "bn_span.h"
+#include "bn_display.h"
+
+namespace bn
+{
+
+/**
+ * @brief Contains one or more precomputed H-Blank effect tables of 160 values each.
+ *
+ * The assets conversion tools generate an object of this type in the build folder for each *.json file
+ * with `hbe_tables` type.
+ *
+ * The values are not copied but referenced, so they should outlive the hbe_tables_item
+ * to avoid dangling references.
+ *
+ * @tparam Type Type of the values referenced by the H-Blank effect tables.
+ *
+ * @ingroup hblank_effect
+ * @ingroup tool
+ */
+template<typename Type>
+class hbe_tables_item
+{
+
+public:
+    /**
+     * @brief Constructor.
+     * @param values_ref Reference to the values of all tables, one table after another.
+     *
+     * The values are not copied but referenced, so they should outlive the hbe_tables_item
+     * to avoid dangling references.
+     *
+     * @param tables_count Number of tables contained in values_ref.
+     */
+    constexpr hbe_tables_item(const span<const Type>& values_ref, int tables_count) :
+        _values_ref(values_ref),
+        _tables_count(tables_count)
+    {
+        BN_ASSERT(tables_count > 0, "Invalid tables count: ", tables_count);
+        BN_ASSERT(values_ref.size() == tables_count * display::height(),
+                  "Invalid values count: ", values_ref.size(), " - ", tables_count * display::height());
+    }
+
+    /**
+     * @brief Returns the referenced values of all tables.
+     */
+    [[nodiscard]] constexpr const span<const Type>& values_ref() const
+    {
+        return _values_ref;
+    }
+
+    /**
+     * @brief Returns the number of tables contained in this item.
+     */
+    [[nodiscard]] constexpr int tables_count() const
+    {
+        return _tables_count;
+    }
+
+    /**
+     * @brief Returns the 160 values of the table specified by table_index.
+     */
+    [[nodiscard]] constexpr span<const Type> table(int table_index) const
+    {
+        BN_ASSERT(table_index >= 0 && table_index < _tables_count, "Invalid table index: ", table_index);
+
+        return _values_ref.subspan(table_index * display::height(), display::height());
+    }
+
+    /**
+     * @brief Default equal operator.
+     */
+    [[nodiscard]] constexpr friend bool operator==(const hbe_tables_item& a, const hbe_tables_item& b) = default;
+
+private:
+    span<const Type> _values_ref;
+    int _tables_count;
+};
+
+}
+
+#endif
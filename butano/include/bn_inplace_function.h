@@ -0,0 +1,376 @@
+/*
+ * Copyright (c) 2020-2025 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_INPLACE_FUNCTION_H
+#define BN_INPLACE_FUNCTION_H
+
+/**
+ * @file
+ * bn::inplace_function implementation header file.
+ *
+ * @ingroup functional
+ */
+
+#include <new>
+#include "bn_utility.h"
+#include "bn_power_of_two.h"
+#include "bn_type_traits.h"
+#include "bn_config_assert.h"
+
+/// @cond DO_NOT_DOCUMENT
+
+namespace _bn
+{
+    void inplace_function_empty_error();
+}
+
+/// @endcond
+
+
+namespace bn
+{
+
+/**
+ * @brief `std::function` like callable wrapper which stores the target in a fixed size buffer,
+ * so it never allocates memory.
+ *
+ * It doesn't throw exceptions. Instead, asserts are used to ensure valid usage.
+ *
+ * The target is called through a plain function pointer instead of a virtual table,
+ * and targets which are trivially copyable and destructible (function pointers and most lambdas)
+ * are copied without calling any function.
+ *
+ * @tparam Signature Function type of the target, like `void(int)`.
+ * @tparam MaxSize Maximum size in bytes of the target. The default one allows to store a lambda with two captures.
+ * @tparam MaxAlignment Maximum alignment in bytes of the target.
+ *
+ * @ingroup functional
+ */
+template<typename Signature, int MaxSize = int(sizeof(void*) * 2), int MaxAlignment = int(alignof(void*))>
+class inplace_function;
+
+
+template<typename Result, typename... Args, int MaxSize, int MaxAlignment>
+class inplace_function<Result(Args...), MaxSize, MaxAlignment>
+{
+    static_assert(MaxSize > 0);
+    static_assert(MaxAlignment > 0 && power_of_two(MaxAlignment));
+
+public:
+    using result_type = Result; //!< Result type alias.
+
+    /**
+     * @brief Default constructor.
+     *
+     * The created inplace_function is empty.
+     */
+    inplace_function() = default;
+
+    /**
+     * @brief Null constructor.
+     *
+     * The created inplace_function is empty.
+     */
+    inplace_function(nullptr_t)
+    {
+    }
+
+    /**
+     * @brief Constructor.
+     * @param function Function pointer, lambda or function object to store.
+     *
+     * If it is a null function pointer, the created inplace_function is empty.
+     */
+    template<typename Function>
+    requires(! is_same_v<remove_cvref_t<Function>, inplace_function> && ! is_same_v<decay_t<Function>, nullptr_t> &&
+             ! is_member_pointer_v<decay_t<Function>> && is_copy_constructible_v<decay_t<Function>> &&
+             is_invocable_r_v<Result, decay_t<Function>&, Args...>)
+    inplace_function(Function&& function)
+    {
+        _create(forward<Function>(function));
+    }
+
+    /**
+     * @brief Copy constructor.
+     * @param other inplace_function to copy.
+     */
+    inplace_function(const inplace_function& other)
+    {
+        _copy(other);
+    }
+
+    /**
+     * @brief Move constructor.
+     * @param other inplace_function to move.
+     */
+    inplace_function(inplace_function&& other) noexcept
+    {
+        _move(other);
+    }
+
+    /**
+     * @brief Destructor.
+     */
+    ~inplace_function() noexcept
+    {
+        reset();
+    }
+
+    /**
+     * @brief Copy assignment operator.
+     * @param other inplace_function to copy.
+     * @return Reference to this.
+     */
+    inplace_function& operator=(const inplace_function& other)
+    {
+        if(this != &other)
+        {
+            reset();
+            _copy(other);
+        }
+
+        return *this;
+    }
+
+    /**
+     * @brief Move assignment operator.
+     * @param other inplace_function to move.
+     * @return Reference to this.
+     */
+    inplace_function& operator=(inplace_function&& other) noexcept
+    {
+        if(this != &other)
+        {
+            reset();
+            _move(other);
+        }
+
+        return *this;
+    }
+
+    /**
+     * @brief Null assignment operator.
+     *
+     * It destroys the stored target, if any.
+     *
+     * @return Reference to this.
+     */
+    inplace_function& operator=(nullptr_t)
+    {
+        reset();
+        return *this;
+    }
+
+    /**
+     * @brief Assignment operator.
+     * @param function Function pointer, lambda or function object to store.
+     *
+     * If it is a null function pointer, this inplace_function becomes empty.
+     *
+     * @return Reference to this.
+     */
+    template<typename Function>
+    requires(! is_same_v<remove_cvref_t<Function>, inplace_function> && ! is_same_v<decay_t<Function>, nullptr_t> &&
+             ! is_member_pointer_v<decay_t<Function>> && is_copy_constructible_v<decay_t<Function>> &&
+             is_invocable_r_v<Result, decay_t<Function>&, Args...>)
+    inplace_function& operator=(Function&& function)
+    {
+        reset();
+        _create(forward<Function>(function));
+        return *this;
+    }
+
+    /**
+     * @brief Indicates if this inplace_function stores a target or not.
+     */
+    [[nodiscard]] explicit operator bool() const
+    {
+        return _invoker;
+    }
+
+    /**
+     * @brief Calls the stored target with the given arguments.
+     *
+     * This inplace_function must not be empty.
+     *
+     * @return The value returned by the stored target.
+     */
+    Result operator()(Args... args) const
+    {
+        #if BN_CFG_ASSERT_ENABLED
+            if(! _invoker) [[unlikely]]
+            {
+                _bn::inplace_function_empty_error();
+            }
+        #endif
+
+        return _invoker(_storage.data, forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Destroys the stored target, if any.
+     */
+    void reset()
+    {
+        if(_manager)
+        {
+            _manager(operation_type::DESTROY, _storage.data, nullptr);
+            _manager = nullptr;
+        }
+
+        _invoker = nullptr;
+    }
+
+    /**
+     * @brief Exchanges the contents of this inplace_function with those of the other one.
+     * @param other inplace_function to exchange the contents with.
+     */
+    void swap(inplace_function& other)
+    {
+        if(this != &other)
+        {
+            inplace_function temp(move(other));
+            other = move(*this);
+            *this = move(temp);
+        }
+    }
+
+    /**
+     * @brief Exchanges the contents of an inplace_function with those of another one.
+     * @param a First inplace_function to exchange the contents with.
+     * @param b Second inplace_function to exchange the contents with.
+     */
+    friend void swap(inplace_function& a, inplace_function& b)
+    {
+        a.swap(b);
+    }
+
+    /**
+     * @brief Indicates if the given inplace_function is empty or not.
+     */
+    [[nodiscard]] friend bool operator==(const inplace_function& function, nullptr_t)
+    {
+        return ! function._invoker;
+    }
+
+private:
+    enum class operation_type
+    {
+        COPY,
+        MOVE,
+        DESTROY
+    };
+
+    class storage_type
+    {
+
+    public:
+        alignas(MaxAlignment) char data[MaxSize];
+    };
+
+    using invoker_type = Result(*)(void* storage, Args&&... args);
+    using manager_type = void(*)(operation_type operation, void* source, void* destination);
+
+    invoker_type _invoker = nullptr;
+    manager_type _manager = nullptr;
+    mutable storage_type _storage;
+
+    template<typename Function>
+    static Result _invoke(void* storage, Args&&... args)
+    {
+        Function& function = *static_cast<Function*>(storage);
+
+        if constexpr(is_void_v<Result>)
+        {
+            function(forward<Args>(args)...);
+        }
+        else
+        {
+            return function(forward<Args>(args)...);
+        }
+    }
+
+    template<typename Function>
+    static void _manage(operation_type operation, void* source, void* destination)
+    {
+        Function& source_function = *static_cast<Function*>(source);
+
+        if(operation == operation_type::COPY)
+        {
+            ::new(destination) Function(source_function);
+        }
+        else
+        {
+            if(operation == operation_type::MOVE)
+            {
+                ::new(destination) Function(move(source_function));
+            }
+
+            source_function.~Function();
+        }
+    }
+
+    template<typename Function>
+    void _create(Function&& function)
+    {
+        using function_type = decay_t<Function>;
+
+        static_assert(int(sizeof(function_type)) <= MaxSize, "Function is too big");
+        static_assert(MaxAlignment % int(alignof(function_type)) == 0, "Invalid function alignment");
+
+        // Functions passed by reference decay to pointers which can't be null:
+        if constexpr(is_pointer_v<remove_cvref_t<Function>>)
+        {
+            if(! function)
+            {
+                return;
+            }
+        }
+
+        ::new(static_cast<void*>(_storage.data)) function_type(forward<Function>(function));
+        _invoker = &_invoke<function_type>;
+
+        if constexpr(! is_trivially_copyable_v<function_type> || ! is_trivially_destructible_v<function_type>)
+        {
+            _manager = &_manage<function_type>;
+        }
+    }
+
+    void _copy(const inplace_function& other)
+    {
+        if(manager_type other_manager = other._manager)
+        {
+            other_manager(operation_type::COPY, other._storage.data, _storage.data);
+            _manager = other_manager;
+        }
+        else
+        {
+            _storage = other._storage;
+        }
+
+        _invoker = other._invoker;
+    }
+
+    void _move(inplace_function& other)
+    {
+        if(manager_type other_manager = other._manager)
+        {
+            other_manager(operation_type::MOVE, other._storage.data, _storage.data);
+            _manager = other_manager;
+            other._manager = nullptr;
+        }
+        else
+        {
+            _storage = other._storage;
+        }
+
+        _invoker = other._invoker;
+        other._invoker = nullptr;
+    }
+};
+
+}
+
+#endif
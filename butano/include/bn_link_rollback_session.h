@@ -0,0 +1,293 @@
+/*
+ * Copyright (c) 2020-2025 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_LINK_ROLLBACK_SESSION_H
+#define BN_LINK_ROLLBACK_SESSION_H
+
+/**
+ * @file
+ * bn::link_rollback_session header file.
+ *
+ * @ingroup link
+ */
+
+#include "bn_optional.h"
+#include "bn_config_link.h"
+
+namespace bn
+{
+
+/**
+ * @brief Keeps the simulation of a two players game in sync through the link cable
+ * exchanging the keypad state of each frame.
+ *
+ * When the keypad state of the other player for a frame has not been received yet,
+ * the frame is simulated predicting that it is the same as the last received one.
+ * If the prediction was wrong, the game state is restored to that frame and the following frames are simulated again
+ * (rollback).
+ *
+ * The local keypad state is read from bn::keypad, so keypad commands recorded with the keypad logger
+ * can be replayed in link sessions too.
+ *
+ * @ingroup link
+ */
+class link_rollback_session
+{
+
+public:
+    /**
+     * @brief Returns the maximum number of frames between the local keypad is read and the frame in which it is used.
+     */
+    [[nodiscard]] static constexpr int max_input_delay()
+    {
+        return 4;
+    }
+
+    /**
+     * @brief Returns the maximum number of frames that can be simulated predicting the keypad of the other player.
+     */
+    [[nodiscard]] static constexpr int max_max_rollback_frames()
+    {
+        return 8;
+    }
+
+    /**
+     * @brief Constructor.
+     * @param input_delay Number of frames between the local keypad is read and the frame in which it is used.
+     * @param max_rollback_frames Maximum number of frames that can be simulated
+     * predicting the keypad of the other player.
+     * If it is zero, frames are only simulated when the keypad of the other player has been received (lockstep).
+     */
+    explicit link_rollback_session(int input_delay = BN_CFG_LINK_ROLLBACK_INPUT_DELAY,
+                                   int max_rollback_frames = BN_CFG_LINK_ROLLBACK_MAX_FRAMES);
+
+    /**
+     * @brief Returns the number of frames between the local keypad is read and the frame in which it is used.
+     */
+    [[nodiscard]] int input_delay() const
+    {
+        return _input_delay;
+    }
+
+    /**
+     * @brief Returns the maximum number of frames that can be simulated predicting the keypad of the other player.
+     */
+    [[nodiscard]] int max_rollback_frames() const
+    {
+        return _max_rollback_frames;
+    }
+
+    /**
+     * @brief Returns the link player ID of this console, or -1 if the other player has not been found yet.
+     */
+    [[nodiscard]] int player_id() const
+    {
+        return _player_id;
+    }
+
+    /**
+     * @brief Returns the next frame to simulate.
+     */
+    [[nodiscard]] int frame() const
+    {
+        return _frame;
+    }
+
+    /**
+     * @brief Returns the last frame whose keypad state of the other player has been received.
+     */
+    [[nodiscard]] int confirmed_frame() const
+    {
+        return _confirmed_frame;
+    }
+
+    /**
+     * @brief Returns the number of frames simulated again in the last update() call.
+     */
+    [[nodiscard]] int last_rollback_frames() const
+    {
+        return _last_rollback_frames;
+    }
+
+    /**
+     * @brief Returns the CPU ticks spent simulating frames again in the last update() call.
+     */
+    [[nodiscard]] int last_resimulation_ticks() const
+    {
+        return _last_resimulation_ticks;
+    }
+
+    /**
+     * @brief Returns the maximum number of frames simulated again in an update() call
+     * since the last reset_stats() call.
+     */
+    [[nodiscard]] int peak_rollback_frames() const
+    {
+        return _peak_rollback_frames;
+    }
+
+    /**
+     * @brief Returns the maximum CPU ticks spent simulating frames again in an update() call
+     * since the last reset_stats() call.
+     */
+    [[nodiscard]] int peak_resimulation_ticks() const
+    {
+        return _peak_resimulation_ticks;
+    }
+
+    /**
+     * @brief Returns the number of rollbacks since the last reset_stats() call.
+     */
+    [[nodiscard]] int rollbacks_count() const
+    {
+        return _rollbacks_count;
+    }
+
+    /**
+     * @brief Returns the number of update() calls which didn't simulate a frame
+     * since the last reset_stats() call.
+     */
+    [[nodiscard]] int stalled_updates() const
+    {
+        return _stalled_updates;
+    }
+
+    /**
+     * @brief Sets all stats to zero.
+     */
+    void reset_stats();
+
+    /**
+     * @brief Exchanges keypad states with the other player and simulates the next frame if possible.
+     *
+     * It should be called once per frame, after bn::core::update().
+     *
+     * @param simulation Game simulation. It must provide these methods:
+     * * `void save(int slot)`: stores the game state in the given slot,
+     * in the range [0..max_rollback_frames()).
+     * * `void restore(int slot)`: restores the game state stored in the given slot.
+     * * `void simulate(unsigned first_player_keys, unsigned second_player_keys)`: simulates a frame
+     * with the given keypad states (bn::keypad::key_type bit masks) of the players with link IDs 0 and 1.
+     *
+     * @return `true` if the next frame was simulated,
+     * or `false` if it must wait for the keypad of the other player.
+     */
+    template<class Simulation>
+    bool update(Simulation& simulation)
+    {
+        return _update(&simulation, _save<Simulation>, _restore<Simulation>, _simulate<Simulation>);
+    }
+
+    /**
+     * @brief Simulates the next frame if possible without using the link cable nor reading the keypad.
+     *
+     * Messages received from the other player must be processed with push_received_word() before calling it,
+     * and messages to send to the other player must be retrieved with pop_sent_word() after calling it.
+     *
+     * update(Simulation&) already calls it.
+     *
+     * @param player_id Link player ID of this console (0 or 1).
+     * @param local_keys Keypad state (bn::keypad::key_type bit mask) of this console.
+     * @param simulation Game simulation (see update(Simulation&)).
+     * @return `true` if the next frame was simulated,
+     * or `false` if it must wait for the keypad of the other player.
+     */
+    template<class Simulation>
+    bool update(int player_id, unsigned local_keys, Simulation& simulation)
+    {
+        return _update(player_id, local_keys, &simulation, _save<Simulation>, _restore<Simulation>,
+                       _simulate<Simulation>);
+    }
+
+    /**
+     * @brief Processes a message received from the other player without using the link cable.
+     *
+     * update(Simulation&) already calls it.
+     *
+     * @param word Received message.
+     */
+    void push_received_word(int word);
+
+    /**
+     * @brief Returns the next message to send to the other player without using the link cable, if any.
+     *
+     * Messages not retrieved before the next update are discarded.
+     *
+     * update(Simulation&) already calls it.
+     */
+    [[nodiscard]] optional<int> pop_sent_word();
+
+private:
+    static constexpr int _max_frames = 32;
+    static constexpr int _max_sent_words = BN_CFG_LINK_ROLLBACK_WORDS_PER_UPDATE;
+
+    using save_type = void(*)(void*, int);
+    using restore_type = void(*)(void*, int);
+    using simulate_type = void(*)(void*, unsigned, unsigned);
+
+    int _input_delay;
+    int _max_rollback_frames;
+    int _player_id = -1;
+    int _frame = 0;
+    int _local_frame;
+    int _sent_frame;
+    int _confirmed_frame;
+    int _peer_confirmed_frame;
+    int _remote_first_frame;
+    int _rollback_frame;
+    int _last_rollback_frames = 0;
+    int _last_resimulation_ticks = 0;
+    int _peak_rollback_frames = 0;
+    int _peak_resimulation_ticks = 0;
+    int _rollbacks_count = 0;
+    int _stalled_updates = 0;
+    int _remote_frames[_max_frames];
+    uint16_t _local_keys[_max_frames] = {};
+    uint16_t _remote_keys[_max_frames] = {};
+    uint16_t _predicted_keys[_max_frames] = {};
+    uint16_t _sent_words[_max_sent_words] = {};
+    int8_t _sent_words_count = 0;
+    int8_t _sent_words_index = 0;
+
+    template<class Simulation>
+    static void _save(void* simulation, int slot)
+    {
+        static_cast<Simulation*>(simulation)->save(slot);
+    }
+
+    template<class Simulation>
+    static void _restore(void* simulation, int slot)
+    {
+        static_cast<Simulation*>(simulation)->restore(slot);
+    }
+
+    template<class Simulation>
+    static void _simulate(void* simulation, unsigned first_player_keys, unsigned second_player_keys)
+    {
+        static_cast<Simulation*>(simulation)->simulate(first_player_keys, second_player_keys);
+    }
+
+    [[nodiscard]] bool _update(void* simulation, save_type save, restore_type restore, simulate_type simulate);
+
+    [[nodiscard]] bool _update(int player_id, unsigned local_keys, void* simulation, save_type save,
+                               restore_type restore, simulate_type simulate);
+
+    [[nodiscard]] bool _update_frame(unsigned local_keys, void* simulation, save_type save, restore_type restore,
+                                     simulate_type simulate);
+
+    [[nodiscard]] unsigned _frame_remote_keys(int frame) const;
+
+    void _send_words();
+
+    void _send_word(unsigned word);
+
+    void _send_keys(int frame);
+
+    void _simulate_frame(int frame, bool save_state, void* simulation, save_type save, simulate_type simulate);
+};
+
+}
+
+#endif
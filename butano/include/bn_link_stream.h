@@ -0,0 +1,285 @@
+/*
+ * Copyright (c) 2020-2025 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_LINK_STREAM_H
+#define BN_LINK_STREAM_H
+
+/**
+ * @file
+ * bn::ilink_stream and bn::link_stream implementation header file.
+ *
+ * @ingroup link
+ */
+
+#include "bn_span.h"
+#include "bn_optional.h"
+#include "bn_config_link.h"
+#include "bn_power_of_two.h"
+
+namespace bn
+{
+
+/**
+ * @brief Base class of bn::link_stream.
+ *
+ * It sends bytes to another player through the link cable split in packets
+ * with a header, a sequence number and a checksum each.
+ *
+ * Received packets are acknowledged by the other player,
+ * and packets not acknowledged in time are sent again, so bytes are received in order without losses.
+ *
+ * Only two players are supported: messages received while more players are connected are ignored.
+ *
+ * @ingroup link
+ */
+class ilink_stream
+{
+
+public:
+    ilink_stream(const ilink_stream& other) = delete;
+
+    ilink_stream& operator=(const ilink_stream& other) = delete;
+
+    /**
+     * @brief Returns the maximum number of bytes that can be stored to be sent.
+     */
+    [[nodiscard]] int max_send_size() const
+    {
+        return _send_mask + 1;
+    }
+
+    /**
+     * @brief Returns the number of stored bytes not acknowledged yet by the other player.
+     */
+    [[nodiscard]] int send_size() const
+    {
+        return _send_size;
+    }
+
+    /**
+     * @brief Returns the number of bytes that can be written with write().
+     */
+    [[nodiscard]] int available_send_size() const
+    {
+        return max_send_size() - _send_size;
+    }
+
+    /**
+     * @brief Indicates if all written bytes have been acknowledged by the other player or not.
+     */
+    [[nodiscard]] bool flushed() const
+    {
+        return ! _send_size;
+    }
+
+    /**
+     * @brief Returns the maximum number of received bytes that can be stored.
+     */
+    [[nodiscard]] int max_received_size() const
+    {
+        return _receive_mask + 1;
+    }
+
+    /**
+     * @brief Returns the number of received bytes which can be read with read().
+     */
+    [[nodiscard]] int received_size() const
+    {
+        return _receive_size;
+    }
+
+    /**
+     * @brief Returns the maximum number of messages sent by each update() call.
+     */
+    [[nodiscard]] int words_per_update() const
+    {
+        return _words_per_update;
+    }
+
+    /**
+     * @brief Sets the maximum number of messages sent by each update() call.
+     */
+    void set_words_per_update(int words_per_update);
+
+    /**
+     * @brief Returns the number of packets sent for the first time.
+     */
+    [[nodiscard]] int sent_packets() const
+    {
+        return _sent_packets;
+    }
+
+    /**
+     * @brief Returns the number of packets sent again because they were not acknowledged in time.
+     */
+    [[nodiscard]] int retransmitted_packets() const
+    {
+        return _retransmitted_packets;
+    }
+
+    /**
+     * @brief Returns the number of valid data packets received.
+     */
+    [[nodiscard]] int received_packets() const
+    {
+        return _received_packets;
+    }
+
+    /**
+     * @brief Returns the number of received packets discarded because they were corrupted,
+     * out of order or didn't fit in the receive buffer.
+     */
+    [[nodiscard]] int discarded_packets() const
+    {
+        return _discarded_packets;
+    }
+
+    /**
+     * @brief Stores the given bytes to be sent to the other player.
+     * @param bytes Bytes to send.
+     * @return Number of stored bytes, which is less than the given ones if the send buffer is full.
+     */
+    int write(const span<const uint8_t>& bytes);
+
+    /**
+     * @brief Retrieves received bytes.
+     * @param bytes Destination of the received bytes.
+     * @return Number of retrieved bytes.
+     */
+    int read(span<uint8_t>& bytes);
+
+    /**
+     * @brief Discards all stored bytes and restarts the communication.
+     *
+     * It should be called by both players at the same time.
+     */
+    void reset();
+
+    /**
+     * @brief Receives and sends pending messages through the link cable.
+     *
+     * It should be called once per frame.
+     */
+    void update();
+
+    /**
+     * @brief Advances retransmission timers without using the link cable.
+     *
+     * update() already calls it.
+     */
+    void tick();
+
+    /**
+     * @brief Returns the next message to send to the other player without using the link cable, if any.
+     *
+     * update() already calls it.
+     */
+    [[nodiscard]] optional<int> pop_sent_word();
+
+    /**
+     * @brief Processes a message received from the other player without using the link cable.
+     *
+     * update() already calls it.
+     *
+     * @param word Received message, in the range [0..65533].
+     */
+    void push_received_word(int word);
+
+protected:
+    /// @cond DO_NOT_DOCUMENT
+
+    ilink_stream(uint8_t* send_buffer, int max_send_size, uint8_t* receive_buffer, int max_received_size);
+
+    /// @endcond
+
+private:
+    static constexpr int _max_packet_size = BN_CFG_LINK_STREAM_MAX_PACKET_SIZE;
+    static constexpr int _max_packets_in_flight = BN_CFG_LINK_STREAM_MAX_PACKETS_IN_FLIGHT;
+    static constexpr int _max_packet_words = 3 + ((_max_packet_size + 1) / 2);
+
+    static_assert(_max_packet_size > 0 && _max_packet_size <= 255);
+    static_assert(_max_packets_in_flight > 0 && _max_packets_in_flight <= 64);
+    static_assert(power_of_two(_max_packets_in_flight));
+    static_assert(BN_CFG_LINK_STREAM_RETRANSMIT_WAIT > 0);
+
+    uint8_t* _send_buffer;
+    uint8_t* _receive_buffer;
+    int _send_mask;
+    int _receive_mask;
+    int _send_begin = 0;
+    int _send_size = 0;
+    int _in_flight_size = 0;
+    int _emit_offset = 0;
+    int _receive_begin = 0;
+    int _receive_size = 0;
+    int _words_per_update = BN_CFG_LINK_STREAM_WORDS_PER_UPDATE;
+    int _retransmit_counter = 0;
+    int _sent_packets = 0;
+    int _retransmitted_packets = 0;
+    int _received_packets = 0;
+    int _discarded_packets = 0;
+    uint8_t _base_sequence = 0;
+    uint8_t _next_sequence = 0;
+    uint8_t _emit_sequence = 0;
+    uint8_t _expected_sequence = 0;
+    uint16_t _out_words_index = 0;
+    uint16_t _out_words_count = 0;
+    uint16_t _in_words_count = 0;
+    bool _in_packet = false;
+    bool _in_escape = false;
+    bool _ack_pending = false;
+    uint8_t _packet_sizes[_max_packets_in_flight] = {};
+    uint16_t _out_words[1 + (_max_packet_words * 2)];
+    uint16_t _in_words[_max_packet_words];
+
+    [[nodiscard]] int _in_flight_packets() const;
+
+    void _push_out_word(unsigned word);
+
+    void _build_packet();
+
+    void _process_ack(int ack);
+
+    void _process_packet();
+};
+
+
+/**
+ * @brief Sends bytes to another player through the link cable split in packets
+ * with a header, a sequence number and a checksum each.
+ *
+ * Received packets are acknowledged by the other player,
+ * and packets not acknowledged in time are sent again, so bytes are received in order without losses.
+ *
+ * Only two players are supported: messages received while more players are connected are ignored.
+ *
+ * @tparam MaxSendSize Maximum number of bytes that can be stored to be sent. It must be a power of two.
+ * @tparam MaxReceivedSize Maximum number of received bytes that can be stored. It must be a power of two.
+ *
+ * @ingroup link
+ */
+template<int MaxSendSize, int MaxReceivedSize = MaxSendSize>
+class link_stream : public ilink_stream
+{
+    static_assert(MaxSendSize > 0 && power_of_two(MaxSendSize));
+    static_assert(MaxReceivedSize > 0 && power_of_two(MaxReceivedSize));
+
+public:
+    /**
+     * @brief Default constructor.
+     */
+    link_stream() :
+        ilink_stream(_send_buffer_data, MaxSendSize, _receive_buffer_data, MaxReceivedSize)
+    {
+    }
+
+private:
+    uint8_t _send_buffer_data[MaxSendSize];
+    uint8_t _receive_buffer_data[MaxReceivedSize];
+};
+
+}
+
+#endif
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2020-2025 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_LINK_STREAM_LOOPBACK_H
+#define BN_LINK_STREAM_LOOPBACK_H
+
+/**
+ * @file
+ * bn::link_stream_loopback header file.
+ *
+ * @ingroup link
+ */
+
+#include "bn_deque.h"
+#include "bn_seed_random.h"
+
+namespace bn
+{
+
+class ilink_stream;
+
+/**
+ * @brief Connects two link streams without using the link cable, so they can be tested deterministically.
+ *
+ * Messages are delivered with the specified latency, and some of them can be dropped or corrupted on purpose.
+ *
+ * @ingroup link
+ */
+class link_stream_loopback
+{
+
+public:
+    /**
+     * @brief Constructor.
+     * @param first_stream First connected stream.
+     * @param second_stream Second connected stream.
+     * @param seed Seed of the random number generator used to drop and corrupt messages.
+     */
+    link_stream_loopback(ilink_stream& first_stream, ilink_stream& second_stream, unsigned seed = 0);
+
+    link_stream_loopback(const link_stream_loopback& other) = delete;
+
+    link_stream_loopback& operator=(const link_stream_loopback& other) = delete;
+
+    /**
+     * @brief Returns the maximum number of messages that can be in transit in each direction.
+     *
+     * If there's no room for more messages, the oldest one is dropped, like in the link cable send queue.
+     */
+    [[nodiscard]] static constexpr int max_words()
+    {
+        return _max_words;
+    }
+
+    /**
+     * @brief Returns the number of updates between a message is sent and it is received.
+     */
+    [[nodiscard]] int latency() const
+    {
+        return _latency;
+    }
+
+    /**
+     * @brief Sets the number of updates between a message is sent and it is received.
+     */
+    void set_latency(int latency);
+
+    /**
+     * @brief Returns the average number of sent messages per dropped message (0 means no message is dropped).
+     */
+    [[nodiscard]] int drop_one_in() const
+    {
+        return _drop_one_in;
+    }
+
+    /**
+     * @brief Sets the average number of sent messages per dropped message (0 means no message is dropped).
+     */
+    void set_drop_one_in(int drop_one_in);
+
+    /**
+     * @brief Returns the average number of sent messages per corrupted message (0 means no message is corrupted).
+     */
+    [[nodiscard]] int corrupt_one_in() const
+    {
+        return _corrupt_one_in;
+    }
+
+    /**
+     * @brief Sets the average number of sent messages per corrupted message (0 means no message is corrupted).
+     */
+    void set_corrupt_one_in(int corrupt_one_in);
+
+    /**
+     * @brief Returns the number of dropped messages.
+     */
+    [[nodiscard]] int dropped_words() const
+    {
+        return _dropped_words;
+    }
+
+    /**
+     * @brief Returns the number of corrupted messages.
+     */
+    [[nodiscard]] int corrupted_words() const
+    {
+        return _corrupted_words;
+    }
+
+    /**
+     * @brief Updates both streams, delivering messages in transit and sending new ones.
+     *
+     * It replaces ilink_stream::update() calls.
+     */
+    void update();
+
+private:
+    static constexpr int _max_words = 64;
+
+    class word_type
+    {
+
+    public:
+        int delivery_update;
+        uint16_t data;
+    };
+
+    ilink_stream& _first_stream;
+    ilink_stream& _second_stream;
+    deque<word_type, _max_words> _first_to_second_words;
+    deque<word_type, _max_words> _second_to_first_words;
+    seed_random _random;
+    int _updates = 0;
+    int _latency = 1;
+    int _drop_one_in = 0;
+    int _corrupt_one_in = 0;
+    int _dropped_words = 0;
+    int _corrupted_words = 0;
+
+    void _update(ilink_stream& stream, ideque<word_type>& received_words, ideque<word_type>& sent_words);
+};
+
+}
+
+#endif
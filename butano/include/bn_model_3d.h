@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2020-2025 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_MODEL_3D_H
+#define BN_MODEL_3D_H
+
+/**
+ * @file
+ * bn::model_3d implementation header file.
+ *
+ * @ingroup model_3d
+ */
+
+#include "bn_intrusive_list.h"
+#include "bn_model_3d_item.h"
+
+namespace bn
+{
+
+/**
+ * @brief 3D model which can be moved, rotated and scaled.
+ *
+ * Models are created and destroyed with imodels_3d::create_dynamic_model and imodels_3d::destroy_dynamic_model.
+ *
+ * Rotation angles are applied in Z-Y-X order: first psi around the x axis, then theta around the y axis
+ * and finally phi around the z axis.
+ *
+ * @ingroup model_3d
+ */
+class model_3d : public intrusive_list_node_type
+{
+
+public:
+    /**
+     * @brief Constructor.
+     * @param item Model item to draw. It is not copied but referenced, so it should outlive the model_3d.
+     */
+    explicit model_3d(const model_3d_item& item) :
+        _item(item)
+    {
+    }
+
+    /**
+     * @brief Returns the model item to draw.
+     */
+    [[nodiscard]] const model_3d_item& item() const
+    {
+        return _item;
+    }
+
+    /**
+     * @brief Returns the position of the model.
+     */
+    [[nodiscard]] const point_3d& position() const
+    {
+        return _position;
+    }
+
+    /**
+     * @brief Sets the position of the model.
+     */
+    void set_position(const point_3d& position)
+    {
+        _position = position;
+    }
+
+    /**
+     * @brief Returns the scale of the model.
+     */
+    [[nodiscard]] fixed scale() const
+    {
+        return _scale;
+    }
+
+    /**
+     * @brief Sets the scale of the model.
+     * @param scale Scale of the model (> 0).
+     */
+    void set_scale(fixed scale)
+    {
+        BN_ASSERT(scale > 0, "Invalid scale: ", scale);
+
+        _scale = scale;
+    }
+
+    /**
+     * @brief Returns the rotation angle around the z axis in degrees.
+     */
+    [[nodiscard]] fixed phi() const
+    {
+        return _phi;
+    }
+
+    /**
+     * @brief Sets the rotation angle around the z axis in degrees.
+     * @param phi Rotation angle in degrees, in the range [0..360].
+     */
+    void set_phi(fixed phi)
+    {
+        set_rotation(phi, _theta, _psi);
+    }
+
+    /**
+     * @brief Returns the rotation angle around the y axis in degrees.
+     */
+    [[nodiscard]] fixed theta() const
+    {
+        return _theta;
+    }
+
+    /**
+     * @brief Sets the rotation angle around the y axis in degrees.
+     * @param theta Rotation angle in degrees, in the range [0..360].
+     */
+    void set_theta(fixed theta)
+    {
+        set_rotation(_phi, theta, _psi);
+    }
+
+    /**
+     * @brief Returns the rotation angle around the x axis in degrees.
+     */
+    [[nodiscard]] fixed psi() const
+    {
+        return _psi;
+    }
+
+    /**
+     * @brief Sets the rotation angle around the x axis in degrees.
+     * @param psi Rotation angle in degrees, in the range [0..360].
+     */
+    void set_psi(fixed psi)
+    {
+        set_rotation(_phi, _theta, psi);
+    }
+
+    /**
+     * @brief Sets all rotation angles at once.
+     * @param phi Rotation angle around the z axis in degrees, in the range [0..360].
+     * @param theta Rotation angle around the y axis in degrees, in the range [0..360].
+     * @param psi Rotation angle around the x axis in degrees, in the range [0..360].
+     */
+    void set_rotation(fixed phi, fixed theta, fixed psi);
+
+    /**
+     * @brief Returns the given vertex rotated with the rotation angles of the model.
+     */
+    [[nodiscard]] point_3d rotate(const vertex_3d& vertex) const
+    {
+        // (a + y)(b + x) - ab - xy = ax + by, so each coordinate only needs two multiplications per vertex:
+        fixed vx = vertex.point().x();
+        fixed vy = vertex.point().y();
+        fixed vz = vertex.point().z();
+        fixed vxy = vertex.xy();
+        fixed rx = (_xx + vy).safe_multiplication(_xy + vx) + vz.unsafe_multiplication(_xz) - _xx_xy - vxy;
+        fixed ry = (_yx + vy).safe_multiplication(_yy + vx) + vz.unsafe_multiplication(_yz) - _yx_yy - vxy;
+        fixed rz = (_zx + vy).safe_multiplication(_zy + vx) + vz.unsafe_multiplication(_zz) - _zx_zy - vxy;
+        return point_3d(rx, ry, rz);
+    }
+
+    /**
+     * @brief Returns the given vertex rotated, scaled and moved with the properties of the model.
+     */
+    [[nodiscard]] point_3d transform(const vertex_3d& vertex) const
+    {
+        point_3d result = rotate(vertex);
+        fixed scale = _scale;
+
+        if(scale != 1)
+        {
+            result.set_x(result.x().unsafe_multiplication(scale));
+            result.set_y(result.y().unsafe_multiplication(scale));
+            result.set_z(result.z().unsafe_multiplication(scale));
+        }
+
+        return result + _position;
+    }
+
+private:
+    const model_3d_item& _item;
+    point_3d _position;
+    fixed _scale = 1;
+    fixed _phi;
+    fixed _theta;
+    fixed _psi;
+    fixed _xx = 1;
+    fixed _xy;
+    fixed _xz;
+    fixed _yx;
+    fixed _yy = 1;
+    fixed _yz;
+    fixed _zx;
+    fixed _zy;
+    fixed _zz = 1;
+    fixed _xx_xy;
+    fixed _yx_yy;
+    fixed _zx_zy;
+};
+
+}
+
+#endif
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2020-2025 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_MODEL_3D_ITEM_H
+#define BN_MODEL_3D_ITEM_H
+
+/**
+ * @file
+ * bn::model_3d_item implementation header file.
+ *
+ * @ingroup model_3d
+ * @ingroup tool
+ */
+
+#include "bn_face_3d.h"
+
+namespace bn
+{
+
+/**
+ * @brief Contains the required information to draw a 3D model.
+ *
+ * The assets conversion tools generate an object of this type in the build folder for each `*.obj` file
+ * processed with `butano/tools/butano_models_3d_tool.py`.
+ *
+ * @ingroup model_3d
+ * @ingroup tool
+ */
+class model_3d_item
+{
+
+public:
+    /**
+     * @brief Constructor.
+     * @param vertices Vertices of the model.
+     *
+     * The vertices are not copied but referenced, so they should outlive the model_3d_item.
+     *
+     * @param faces Faces of the model.
+     *
+     * The faces are not copied but referenced, so they should outlive the model_3d_item.
+     */
+    constexpr model_3d_item(const span<const vertex_3d>& vertices, const span<const face_3d>& faces) :
+        _vertices(vertices),
+        _faces(faces)
+    {
+        BN_ASSERT(vertices.size() > 0 && vertices.size() < 32768, "Invalid vertices count: ", vertices.size());
+        BN_ASSERT(! faces.empty(), "There's no faces");
+    }
+
+    /**
+     * @brief Returns the referenced vertices of the model.
+     */
+    [[nodiscard]] constexpr const span<const vertex_3d>& vertices() const
+    {
+        return _vertices;
+    }
+
+    /**
+     * @brief Returns the referenced faces of the model.
+     */
+    [[nodiscard]] constexpr const span<const face_3d>& faces() const
+    {
+        return _faces;
+    }
+
+private:
+    span<const vertex_3d> _vertices;
+    span<const face_3d> _faces;
+};
+
+}
+
+#endif
@@ -0,0 +1,411 @@
+/*
+ * Copyright (c) 2020-2025 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_MODELS_3D_H
+#define BN_MODELS_3D_H
+
+/**
+ * @file
+ * bn::imodels_3d and bn::models_3d implementation header file.
+ *
+ * @ingroup model_3d
+ * @ingroup hdma
+ */
+
+#include "bn_pool.h"
+#include "bn_color.h"
+#include "bn_limits.h"
+#include "bn_vector.h"
+#include "bn_display.h"
+#include "bn_model_3d.h"
+#include "bn_sprite_tiles_ptr.h"
+#include "bn_sprite_palette_ptr.h"
+
+namespace bn
+{
+
+class camera_3d;
+
+/**
+ * @brief Base class of bn::models_3d.
+ *
+ * Can be used as a reference type for all bn::models_3d objects.
+ *
+ * Each frame, vertices are projected through a reciprocal LUT, back faces are culled,
+ * remaining faces are sorted by depth and they are split in horizontal lines.
+ * Each horizontal line is drawn with a sprite, and sprites are copied to OAM in each H-Blank
+ * with the low priority HDMA channel.
+ *
+ * Since OAM is written in each H-Blank:
+ * * The last max_scanline_sprites() sprite handles are reserved,
+ *   so no more than `128 - max_scanline_sprites()` sprites should be shown at the same time.
+ * * Sprite affine matrices with an id greater or equal than `(128 - max_scanline_sprites()) / 4` are overwritten.
+ * * Low priority HDMA can't be used for other purposes.
+ *
+ * Faces are drawn with one sprite palette for each shading level
+ * and each color requires 85 sprite tiles (triangles of 8x8, 16x16, 32x32 and 64x64 pixels).
+ *
+ * @ingroup model_3d
+ * @ingroup hdma
+ */
+class imodels_3d
+{
+
+public:
+    /**
+     * @brief Returns the distance from the camera to the projection plane.
+     */
+    [[nodiscard]] static constexpr int focal_length()
+    {
+        return 256;
+    }
+
+    /**
+     * @brief Returns the minimum distance from the camera of a vertex to be drawn.
+     *
+     * If a vertex of a model is closer to the camera, the whole model is not drawn.
+     */
+    [[nodiscard]] static constexpr int near_plane()
+    {
+        return 24;
+    }
+
+    /**
+     * @brief Returns the maximum distance from the camera of a vertex to be drawn.
+     *
+     * If a vertex of a model is at this distance or further, the whole model is not drawn.
+     */
+    [[nodiscard]] static constexpr int far_plane()
+    {
+        return 1024;
+    }
+
+    imodels_3d(const imodels_3d& other) = delete;
+
+    imodels_3d& operator=(const imodels_3d& other) = delete;
+
+    /**
+     * @brief Destructor.
+     *
+     * The HDMA channel is stopped if it was started by this object.
+     */
+    ~imodels_3d();
+
+    /**
+     * @brief Returns the maximum number of models that can be created with create_dynamic_model.
+     */
+    [[nodiscard]] int max_dynamic_models() const
+    {
+        return _dynamic_models_pool.max_size();
+    }
+
+    /**
+     * @brief Returns the maximum number of vertices of all models.
+     */
+    [[nodiscard]] int max_vertices() const
+    {
+        return _max_vertices;
+    }
+
+    /**
+     * @brief Returns the maximum number of faces of all models.
+     */
+    [[nodiscard]] int max_faces() const
+    {
+        return _max_faces;
+    }
+
+    /**
+     * @brief Returns the maximum number of sprites shown in each screen horizontal line.
+     *
+     * If more horizontal lines are required, the furthest ones are discarded.
+     */
+    [[nodiscard]] int max_scanline_sprites() const
+    {
+        return _max_scanline_sprites;
+    }
+
+    /**
+     * @brief Returns the number of vertices of all models.
+     */
+    [[nodiscard]] int vertices_count() const
+    {
+        return _vertices_count;
+    }
+
+    /**
+     * @brief Returns the number of faces of all models.
+     */
+    [[nodiscard]] int faces_count() const
+    {
+        return _faces_count;
+    }
+
+    /**
+     * @brief Returns the colors referenced by the faces of the models.
+     */
+    [[nodiscard]] span<const color> colors() const
+    {
+        return span<const color>(_colors, _color_tiles.size());
+    }
+
+    /**
+     * @brief Sets the colors referenced by the faces of the models.
+     * @param colors Colors referenced by the faces of the models.
+     * Its size must be less or equal than face_3d::max_colors.
+     */
+    void set_colors(const span<const color>& colors);
+
+    /**
+     * @brief Sets the color and the intensity of the fade effect applied to the models.
+     * @param color New fade color.
+     * @param intensity New fade intensity in the range [0..1].
+     */
+    void set_fade(color color, fixed intensity);
+
+    /**
+     * @brief Returns the models which are not moved, rotated nor scaled.
+     */
+    [[nodiscard]] const span<const model_3d_item* const>& static_model_items() const
+    {
+        return _static_model_items;
+    }
+
+    /**
+     * @brief Sets the models which are not moved, rotated nor scaled.
+     *
+     * Their vertices are projected as they are, so they must be in world coordinates.
+     *
+     * @param static_model_items Model items to draw.
+     * They are not copied but referenced, so they should outlive the imodels_3d.
+     */
+    void set_static_model_items(const span<const model_3d_item* const>& static_model_items);
+
+    /**
+     * @brief Creates a model which can be moved, rotated and scaled.
+     * @param model_item Model item to draw. It is not copied but referenced, so it should outlive the model.
+     * @return Reference to the created model. It is valid until destroy_dynamic_model is called with it.
+     */
+    [[nodiscard]] model_3d& create_dynamic_model(const model_3d_item& model_item);
+
+    /**
+     * @brief Destroys a model created with create_dynamic_model.
+     */
+    void destroy_dynamic_model(model_3d& model);
+
+    /**
+     * @brief Draws all models from the given camera.
+     *
+     * It should be called once per frame, even if models have not been modified:
+     * if it is not called, HDMA is stopped in the next bn::core::update call.
+     */
+    void update(const camera_3d& camera);
+
+    /**
+     * @brief Returns the number of vertices projected in the last update call.
+     */
+    [[nodiscard]] int last_vertices_count() const
+    {
+        return _last_vertices_count;
+    }
+
+    /**
+     * @brief Returns the number of faces drawn in the last update call.
+     */
+    [[nodiscard]] int last_faces_count() const
+    {
+        return _last_faces_count;
+    }
+
+    /**
+     * @brief Returns the number of horizontal lines drawn with sprites in the last update call.
+     */
+    [[nodiscard]] int last_hlines_count() const
+    {
+        return _last_hlines_count;
+    }
+
+    /**
+     * @brief Returns the number of horizontal lines discarded in the last update call
+     * because there was no more sprites available in their screen horizontal line.
+     */
+    [[nodiscard]] int last_discarded_hlines_count() const
+    {
+        return _last_discarded_hlines_count;
+    }
+
+protected:
+    /// @cond DO_NOT_DOCUMENT
+
+    class point_2d
+    {
+
+    public:
+        int16_t x;
+        int16_t y;
+    };
+
+    class valid_face_type
+    {
+
+    public:
+        const face_3d* face;
+        const point_2d* projected_vertices;
+        int projected_z;
+    };
+
+    class visible_face_type
+    {
+
+    public:
+        const valid_face_type* valid_face;
+        int projected_z;
+        int16_t minimum_x;
+        int16_t maximum_x;
+        int16_t minimum_y;
+        int16_t maximum_y;
+        int8_t top_index;
+    };
+
+    imodels_3d(ipool<model_3d>& dynamic_models_pool, point_2d* projected_vertices_ptr,
+               valid_face_type* valid_faces_ptr, visible_face_type* visible_faces_ptr,
+               uint16_t* visible_face_indexes_ptr, uint16_t* hdma_source_a_ptr, uint16_t* hdma_source_b_ptr,
+               int max_vertices, int max_faces, int max_scanline_sprites);
+
+    void _destroy_dynamic_models();
+
+    /// @endcond
+
+private:
+    class hline_type
+    {
+
+    public:
+        int xl;
+        int xr;
+    };
+
+    class color_tiles_type
+    {
+
+    public:
+        sprite_tiles_ptr small_tiles;
+        sprite_tiles_ptr normal_tiles;
+        sprite_tiles_ptr big_tiles;
+        sprite_tiles_ptr huge_tiles;
+
+        explicit color_tiles_type(int color_index);
+    };
+
+    class color_tiles_ids_type
+    {
+
+    public:
+        uint16_t small_tiles_id;
+        uint16_t normal_tiles_id;
+        uint16_t big_tiles_id;
+        uint16_t huge_tiles_id;
+    };
+
+    ipool<model_3d>& _dynamic_models_pool;
+    intrusive_list<model_3d> _dynamic_models_list;
+    span<const model_3d_item* const> _static_model_items;
+    point_2d* _projected_vertices_ptr;
+    valid_face_type* _valid_faces_ptr;
+    visible_face_type* _visible_faces_ptr;
+    uint16_t* _visible_face_indexes_ptr;
+    uint16_t* _hdma_source_a_ptr;
+    uint16_t* _hdma_source_b_ptr;
+    uint16_t* _hdma_source_ptr;
+    vector<color_tiles_type, face_3d::max_colors> _color_tiles;
+    color_tiles_ids_type _color_tiles_ids[face_3d::max_colors];
+    color _colors[face_3d::max_colors];
+    vector<sprite_palette_ptr, face_3d::shading_levels> _palettes;
+    uint8_t _palette_ids[face_3d::shading_levels];
+    alignas(int) uint8_t _hlines_count[display::height()] = {};
+    alignas(int) uint8_t _previous_hlines_count_a[display::height()] = {};
+    alignas(int) uint8_t _previous_hlines_count_b[display::height()] = {};
+    int _max_vertices;
+    int _max_faces;
+    int _max_scanline_sprites;
+    int _vertices_count = 0;
+    int _faces_count = 0;
+    int _static_vertices_count = 0;
+    int _static_faces_count = 0;
+    int _last_vertices_count = 0;
+    int _last_faces_count = 0;
+    int _last_hlines_count = 0;
+    int _last_discarded_hlines_count = 0;
+    bool _draw_enabled = false;
+    bool _hdma_running = false;
+
+    BN_CODE_IWRAM void _process_models(const camera_3d& camera);
+
+    BN_CODE_IWRAM void _add_hlines(unsigned minimum_y, unsigned maximum_y, int width, bool x_outside,
+                                   int color_index, int shading, const hline_type* hlines);
+
+    BN_CODE_IWRAM void _hide_previous_hlines(const uint8_t* previous_hlines_count);
+
+    void _commit();
+
+    void _stop();
+};
+
+
+/**
+ * @brief Draws flat shaded 3D models with sprites.
+ *
+ * See imodels_3d for more information.
+ *
+ * The HDMA tables require `MaxScanlineSprites * 2576` bytes, so this class should be allocated in the heap.
+ *
+ * @tparam MaxDynamicModels Maximum number of models that can be created with create_dynamic_model.
+ * @tparam MaxVertices Maximum number of vertices of all models.
+ * @tparam MaxFaces Maximum number of faces of all models.
+ * @tparam MaxScanlineSprites Maximum number of sprites shown in each screen horizontal line.
+ * Copying more than 23 sprites in each H-Blank is not recommended.
+ *
+ * @ingroup model_3d
+ * @ingroup hdma
+ */
+template<int MaxDynamicModels, int MaxVertices, int MaxFaces, int MaxScanlineSprites = 23>
+class models_3d : public imodels_3d
+{
+    static_assert(MaxDynamicModels > 0);
+    static_assert(MaxVertices > 0);
+    static_assert(MaxFaces > 0 && MaxFaces <= numeric_limits<uint16_t>::max());
+    static_assert(MaxScanlineSprites > 0 && MaxScanlineSprites <= 128);
+
+public:
+    /**
+     * @brief Default constructor.
+     */
+    models_3d() :
+        imodels_3d(_dynamic_models_pool, _projected_vertices, _valid_faces, _visible_faces, _visible_face_indexes,
+                   _hdma_source_a, _hdma_source_b, MaxVertices, MaxFaces, MaxScanlineSprites)
+    {
+    }
+
+    /**
+     * @brief Destructor.
+     */
+    ~models_3d()
+    {
+        this->_destroy_dynamic_models();
+    }
+
+private:
+    pool<model_3d, MaxDynamicModels> _dynamic_models_pool;
+    point_2d _projected_vertices[MaxVertices];
+    valid_face_type _valid_faces[MaxFaces];
+    visible_face_type _visible_faces[MaxFaces];
+    uint16_t _visible_face_indexes[MaxFaces];
+    alignas(int) uint16_t _hdma_source_a[(display::height() + 1) * 4 * MaxScanlineSprites];
+    alignas(int) uint16_t _hdma_source_b[(display::height() + 1) * 4 * MaxScanlineSprites];
+};
+
+}
+
+#endif
@@ -0,0 +1,276 @@
+/*
+ * Copyright (c) 2020-2025 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_PALETTE_BANDS_H
+#define BN_PALETTE_BANDS_H
+
+/**
+ * @file
+ * bn::ipalette_bands and bn::palette_bands implementation header file.
+ *
+ * @ingroup palette
+ * @ingroup hdma
+ */
+
+#include "bn_span.h"
+#include "bn_color.h"
+#include "bn_display.h"
+#include "bn_optional.h"
+#include "bn_bg_palette_ptr.h"
+#include "bn_sprite_palette_ptr.h"
+
+namespace bn
+{
+
+/**
+ * @brief Base class of bn::palette_bands.
+ *
+ * Can be used as a reference type for all bn::palette_bands objects.
+ *
+ * @ingroup palette
+ * @ingroup hdma
+ */
+class ipalette_bands
+{
+
+public:
+    /**
+     * @brief Returns the maximum number of colors that can be copied in each H-Blank
+     * without modifying colors of the next scanline while it is being drawn.
+     *
+     * H-Blank lasts 226 CPU cycles once the H-Blank flag is set,
+     * and copying a color with DMA from EWRAM to palette RAM takes around 4 CPU cycles.
+     * The remaining cycles are left for the DMA setup and for the other HDMA channel.
+     */
+    [[nodiscard]] static constexpr int max_hblank_colors()
+    {
+        return 48;
+    }
+
+    ipalette_bands(const ipalette_bands& other) = delete;
+
+    ipalette_bands& operator=(const ipalette_bands& other) = delete;
+
+    /**
+     * @brief Destructor.
+     *
+     * The HDMA channel is stopped if it was started by this object.
+     */
+    ~ipalette_bands();
+
+    /**
+     * @brief Returns the background color palette updated by the bands, if any.
+     */
+    [[nodiscard]] const optional<bg_palette_ptr>& bg_palette() const
+    {
+        return _bg_palette;
+    }
+
+    /**
+     * @brief Returns the sprite color palette updated by the bands, if any.
+     */
+    [[nodiscard]] const optional<sprite_palette_ptr>& sprite_palette() const
+    {
+        return _sprite_palette;
+    }
+
+    /**
+     * @brief Returns the number of colors of each band.
+     */
+    [[nodiscard]] int colors_count() const
+    {
+        return _colors_count;
+    }
+
+    /**
+     * @brief Returns the number of bands.
+     */
+    [[nodiscard]] int bands_count() const
+    {
+        return _bands_count;
+    }
+
+    /**
+     * @brief Returns the maximum number of bands.
+     */
+    [[nodiscard]] int max_bands_count() const
+    {
+        return _max_bands_count;
+    }
+
+    /**
+     * @brief Indicates if there's no bands.
+     */
+    [[nodiscard]] bool empty() const
+    {
+        return _bands_count == 0;
+    }
+
+    /**
+     * @brief Indicates if no more bands can be added.
+     */
+    [[nodiscard]] bool full() const
+    {
+        return _bands_count == _max_bands_count;
+    }
+
+    /**
+     * @brief Returns the first scanline of the specified band.
+     */
+    [[nodiscard]] int band_first_scanline(int band_index) const;
+
+    /**
+     * @brief Returns the colors of the specified band.
+     */
+    [[nodiscard]] span<const color> band_colors(int band_index) const;
+
+    /**
+     * @brief Adds a band at the end of the screen.
+     * @param first_scanline First scanline of the band. The band ends when the next one starts.
+     *
+     * The first band must start at scanline 0, and the following ones after the previous band.
+     *
+     * @param colors Colors of the palette in the given band. Its size must be equal to colors_count().
+     */
+    void push_band(int first_scanline, const span<const color>& colors);
+
+    /**
+     * @brief Removes all bands.
+     *
+     * The HDMA table is not modified until start() or high_priority_start() are called again.
+     */
+    void clear()
+    {
+        _bands_count = 0;
+    }
+
+    /**
+     * @brief Returns the number of colors copied in each H-Blank.
+     *
+     * Only the range of colors which change between bands are copied.
+     */
+    [[nodiscard]] int hblank_colors() const;
+
+    /**
+     * @brief Indicates if the colors copied in each H-Blank fit in max_hblank_colors() or not.
+     */
+    [[nodiscard]] bool fits_hblank() const
+    {
+        return hblank_colors() <= max_hblank_colors();
+    }
+
+    /**
+     * @brief Indicates if the bands have been started with start() or high_priority_start() or not.
+     */
+    [[nodiscard]] bool running() const
+    {
+        return _hdma_channel != 0;
+    }
+
+    /**
+     * @brief Builds the HDMA table from the bands and starts copying it with the low priority HDMA channel
+     * in the next frame.
+     *
+     * It must be called again after modifying the bands.
+     *
+     * If the colors copied in each H-Blank don't fit in max_hblank_colors(),
+     * the band change which exceeded the limit is printed with BN_LOG.
+     */
+    void start();
+
+    /**
+     * @brief Builds the HDMA table from the bands and starts copying it with the high priority HDMA channel
+     * in the next frame.
+     *
+     * It must be called again after modifying the bands.
+     *
+     * If the colors copied in each H-Blank don't fit in max_hblank_colors(),
+     * the band change which exceeded the limit is printed with BN_LOG.
+     */
+    void high_priority_start();
+
+    /**
+     * @brief Stops the HDMA channel started by start() or high_priority_start() in the next frame.
+     */
+    void stop();
+
+protected:
+    /// @cond DO_NOT_DOCUMENT
+
+    ipalette_bands(const bg_palette_ptr& palette, int16_t* bands_scanlines, color* bands_colors,
+                   uint16_t* hdma_table, int max_bands_count, int max_colors_count);
+
+    ipalette_bands(const sprite_palette_ptr& palette, int16_t* bands_scanlines, color* bands_colors,
+                   uint16_t* hdma_table, int max_bands_count, int max_colors_count);
+
+    /// @endcond
+
+private:
+    optional<bg_palette_ptr> _bg_palette;
+    optional<sprite_palette_ptr> _sprite_palette;
+    int16_t* _bands_scanlines;
+    color* _bands_colors;
+    uint16_t* _hdma_table;
+    int _max_bands_count;
+    int _colors_count;
+    int _bands_count = 0;
+    int8_t _hdma_channel = 0;
+
+    [[nodiscard]] int _hblank_colors_range(bool log, int& first_color) const;
+
+    void _start(bool high_priority);
+};
+
+
+/**
+ * @brief Splits the screen in horizontal bands, each one with a different set of colors for the same palette.
+ *
+ * Colors are copied to palette RAM with HDMA in each H-Blank, so more than 256 colors can be shown at once.
+ *
+ * Band colors are written to palette RAM as they are, so palette and global color effects
+ * (fade, brightness, etc) are not applied to them.
+ *
+ * The HDMA table requires `MaxColors * 320` bytes, so this class should be allocated in the heap.
+ *
+ * @tparam MaxBands Maximum number of bands.
+ * @tparam MaxColors Maximum number of colors of the palette.
+ *
+ * @ingroup palette
+ * @ingroup hdma
+ */
+template<int MaxBands, int MaxColors = 16>
+class palette_bands : public ipalette_bands
+{
+    static_assert(MaxBands > 0 && MaxBands <= display::height());
+    static_assert(MaxColors > 0 && MaxColors <= 256);
+
+public:
+    /**
+     * @brief Constructor.
+     * @param palette Background color palette to update. Its colors count must be less or equal than MaxColors.
+     */
+    explicit palette_bands(const bg_palette_ptr& palette) :
+        ipalette_bands(palette, _bands_scanlines, _bands_colors, _hdma_table, MaxBands, MaxColors)
+    {
+    }
+
+    /**
+     * @brief Constructor.
+     * @param palette Sprite color palette to update. Its colors count must be less or equal than MaxColors.
+     */
+    explicit palette_bands(const sprite_palette_ptr& palette) :
+        ipalette_bands(palette, _bands_scanlines, _bands_colors, _hdma_table, MaxBands, MaxColors)
+    {
+    }
+
+private:
+    int16_t _bands_scanlines[MaxBands];
+    color _bands_colors[MaxBands * MaxColors];
+    alignas(int) uint16_t _hdma_table[display::height() * MaxColors];
+};
+
+}
+
+#endif
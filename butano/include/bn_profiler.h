@@ -34,6 +34,19 @@
  * @ingroup profiler
  */
 
+/**
+ * @def BN_PROFILER_SCOPE
+ *
+ * Measures elapsed time from its definition until the end of the enclosing scope.
+ *
+ * Code blocks can be nested: the elapsed time of the inner code blocks is subtracted from the exclusive time
+ * of the outer ones.
+ *
+ * @param id Small text string which identifies the code block.
+ *
+ * @ingroup profiler
+ */
+
 /**
  * @def BN_PROFILER_RESET
  *
@@ -56,6 +69,13 @@
          * @brief Stops the execution and shows the profiling results on the screen.
          */
         [[noreturn]] void show();
+
+        /**
+         * @brief Prints the profiling results and the timeline of the last measures with BN_LOG.
+         *
+         * Log must be enabled to print anything.
+         */
+        void log();
     }
 
     /// @cond DO_NOT_DOCUMENT
@@ -65,18 +85,54 @@
         struct ticks
         {
             int64_t total = 0;
+            int64_t exclusive_total = 0;
+            const char* parent_id = nullptr;
+            int count = 0;
+            int min = 0;
             int max = 0;
         };
 
+        struct timeline_entry
+        {
+            const char* id;
+            const char* parent_id;
+            int frame;
+            int start_ticks;
+            int inclusive_ticks;
+            int exclusive_ticks;
+            int depth;
+        };
+
         using ticks_map = bn::unordered_map<const char*, ticks, BN_CFG_PROFILER_MAX_ENTRIES * 2>;
 
         void start(const char* id, unsigned id_hash);
 
         void stop();
 
+        void new_frame();
+
         [[nodiscard]] const ticks_map& ticks_per_entry();
 
         void reset();
+
+        class scope
+        {
+
+        public:
+            scope(const char* id, unsigned id_hash)
+            {
+                start(id, id_hash);
+            }
+
+            ~scope()
+            {
+                stop();
+            }
+
+            scope(const scope&) = delete;
+
+            scope& operator=(const scope&) = delete;
+        };
     }
 
     /// @endcond
@@ -87,8 +143,21 @@
     #define BN_PROFILER_STOP() \
         _bn::profiler::stop()
 
+    #define BN_PROFILER_SCOPE(id) \
+        _bn::profiler::scope BN_PROFILER_SCOPE_NAME(__LINE__)(id, bn::hash<const char*>()(id))
+
     #define BN_PROFILER_RESET() \
         _bn::profiler::reset()
+
+    /// @cond DO_NOT_DOCUMENT
+
+    #define BN_PROFILER_SCOPE_NAME(line) \
+        BN_PROFILER_SCOPE_NAME_IMPL(line)
+
+    #define BN_PROFILER_SCOPE_NAME_IMPL(line) \
+        _bn_profiler_scope_##line
+
+    /// @endcond
 #else
     #define BN_PROFILER_START(id) \
         do \
@@ -100,6 +169,11 @@
         { \
         } while(false)
 
+    #define BN_PROFILER_SCOPE(id) \
+        do \
+        { \
+        } while(false)
+
     #define BN_PROFILER_RESET() \
         do \
         { \
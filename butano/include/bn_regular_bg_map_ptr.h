@@ -28,6 +28,8 @@ class regular_bg_item;
 class regular_bg_map_item;
 class regular_bg_tiles_ptr;
 class regular_bg_tiles_item;
+class iregular_bg_tiles_cache;
+class regular_bg_streamed_item;
 enum class bpp_mode : uint8_t;
 enum class compression_type : uint8_t;
 
@@ -172,6 +174,56 @@ public:
 
     /// @endcond
 
+    /**
+     * @brief Creates a big regular_bg_map_ptr which keeps in VRAM only the tiles referenced by its visible part.
+     *
+     * The tiles are loaded into the given cache when new rows and columns are exposed,
+     * so the referenced tiles can take more memory than the available VRAM.
+     *
+     * The map cells, the tiles and the cache are not copied but referenced,
+     * so they should outlive the regular_bg_map_ptr to avoid dangling references.
+     *
+     * @param map_item regular_bg_map_item which references the map cells to handle. It must be big and uncompressed.
+     * @param tiles_item regular_bg_tiles_item which references the uncompressed tiles to stream.
+     * @param palette Referenced color palette of the map to create.
+     * @param tiles_cache Keeps the tiles in VRAM. It can't be used by another map.
+     * @return The requested regular_bg_map_ptr.
+     */
+    [[nodiscard]] static regular_bg_map_ptr create_streamed(
+            const regular_bg_map_item& map_item, const regular_bg_tiles_item& tiles_item, bg_palette_ptr palette,
+            iregular_bg_tiles_cache& tiles_cache);
+
+    /**
+     * @brief Creates a big regular_bg_map_ptr which keeps in VRAM only the tiles referenced by its visible part.
+     *
+     * The tiles are loaded into the given cache when new rows and columns are exposed,
+     * so the referenced tiles can take more memory than the available VRAM.
+     *
+     * The map cells, the tiles and the cache are not copied but referenced,
+     * so they should outlive the regular_bg_map_ptr to avoid dangling references.
+     *
+     * @param item regular_bg_item which references the tiles, the color palette and the map cells to handle.
+     * @param tiles_cache Keeps the tiles in VRAM. It can't be used by another map.
+     * @return The requested regular_bg_map_ptr.
+     */
+    [[nodiscard]] static regular_bg_map_ptr create_streamed(
+            const regular_bg_item& item, iregular_bg_tiles_cache& tiles_cache);
+
+    /**
+     * @brief Creates a big regular_bg_map_ptr which keeps in VRAM only the tiles referenced by its visible part.
+     *
+     * Unlike the maps created from a regular_bg_item, it can reference more than 1024 tiles.
+     *
+     * The map cells, the tiles and the cache are not copied but referenced,
+     * so they should outlive the regular_bg_map_ptr to avoid dangling references.
+     *
+     * @param item regular_bg_streamed_item which references the tiles, the color palette and the map cells to handle.
+     * @param tiles_cache Keeps the tiles in VRAM. It can't be used by another map.
+     * @return The requested regular_bg_map_ptr.
+     */
+    [[nodiscard]] static regular_bg_map_ptr create_streamed(
+            const regular_bg_streamed_item& item, iregular_bg_tiles_cache& tiles_cache);
+
     /**
      * @brief Creates a regular_bg_map_ptr which references a chunk of VRAM map cells not visible on the screen.
      * @param dimensions Size in map cells of the map to allocate.
@@ -340,6 +392,12 @@ public:
      */
     [[nodiscard]] bool big() const;
 
+    /**
+     * @brief Indicates if this map keeps in VRAM only the tiles referenced by its visible part or not
+     * (see create_streamed).
+     */
+    [[nodiscard]] bool streamed() const;
+
     /**
      * @brief Returns the bits per pixel of the referenced color palette.
      */
@@ -396,6 +454,14 @@ public:
      */
     void reload_cells_ref();
 
+    /**
+     * @brief Indicates if the referenced map cells will be in VRAM after the next V-Blank.
+     *
+     * It returns `false` only if the referenced map cells are compressed and they have not been decompressed
+     * into the staging buffer yet (see @ref BN_CFG_BG_BLOCKS_STAGING_BUFFER_SIZE).
+     */
+    [[nodiscard]] bool ready() const;
+
     /**
      * @brief Returns the referenced tiles.
      */
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2020-2025 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_REGULAR_BG_STREAMED_ITEM_H
+#define BN_REGULAR_BG_STREAMED_ITEM_H
+
+/**
+ * @file
+ * bn::regular_bg_streamed_item header file.
+ *
+ * @ingroup regular_bg
+ * @ingroup tool
+ */
+
+#include "bn_tile.h"
+#include "bn_fixed_point.h"
+#include "bn_bg_palette_item.h"
+#include "bn_regular_bg_map_item.h"
+
+namespace bn
+{
+
+class regular_bg_ptr;
+class regular_bg_map_ptr;
+class iregular_bg_tiles_cache;
+
+/**
+ * @brief Contains the required information to generate big regular backgrounds which keep in VRAM
+ * only the tiles referenced by their visible part (see regular_bg_map_ptr::create_streamed).
+ *
+ * Since map cells can only reference up to 1024 tiles, the source tile of each map cell is stored in a separate
+ * array of 16-bit indexes, so it can reference up to 65534 tiles instead of 1024.
+ *
+ * The assets conversion tools generate an object of this type in the build folder for each *.bmp file
+ * with `regular_bg_streamed` type.
+ *
+ * Tiles, colors, map cells and tile indexes are not copied but referenced,
+ * so they should outlive the regular_bg_streamed_item to avoid dangling references.
+ *
+ * @ingroup regular_bg
+ * @ingroup tool
+ */
+class regular_bg_streamed_item
+{
+
+public:
+    /**
+     * @brief Constructor.
+     * @param tiles_ref Reference to the uncompressed tiles to stream.
+     * @param palette_item It creates the color palette of the output regular backgrounds.
+     * @param map_item It creates the map of the output regular backgrounds. It must be big and uncompressed.
+     * @param tile_indexes_ref Reference to the source tile index of each map cell.
+     */
+    constexpr regular_bg_streamed_item(const span<const tile>& tiles_ref, const bg_palette_item& palette_item,
+                                       const regular_bg_map_item& map_item,
+                                       const span<const uint16_t>& tile_indexes_ref) :
+        _tiles_ref(tiles_ref),
+        _tile_indexes_ref(tile_indexes_ref),
+        _palette_item(palette_item),
+        _map_item(map_item)
+    {
+        BN_ASSERT(! tiles_ref.empty() && (palette_item.bpp() == bpp_mode::BPP_4 || tiles_ref.size() % 2 == 0),
+                  "Invalid tiles count: ", tiles_ref.size(), " - ", int(palette_item.bpp()));
+        BN_BASIC_ASSERT(map_item.big(), "Map is not big");
+        BN_BASIC_ASSERT(map_item.compression() == compression_type::NONE, "Compressed maps are not supported");
+        BN_ASSERT(tile_indexes_ref.size() == map_item.dimensions().width() * map_item.dimensions().height(),
+                  "Invalid tile indexes count: ", tile_indexes_ref.size(), " - ",
+                  map_item.dimensions().width() * map_item.dimensions().height());
+    }
+
+    /**
+     * @brief Returns the reference to the tiles to stream.
+     */
+    [[nodiscard]] constexpr const span<const tile>& tiles_ref() const
+    {
+        return _tiles_ref;
+    }
+
+    /**
+     * @brief Returns the reference to the source tile index of each map cell.
+     */
+    [[nodiscard]] constexpr const span<const uint16_t>& tile_indexes_ref() const
+    {
+        return _tile_indexes_ref;
+    }
+
+    /**
+     * @brief Returns the item used to create the color palette of the output regular backgrounds.
+     */
+    [[nodiscard]] constexpr const bg_palette_item& palette_item() const
+    {
+        return _palette_item;
+    }
+
+    /**
+     * @brief Returns the item used to create the map of the output regular backgrounds.
+     */
+    [[nodiscard]] constexpr const regular_bg_map_item& map_item() const
+    {
+        return _map_item;
+    }
+
+    /**
+     * @brief Returns the bits per pixel of the tiles and the color palette.
+     */
+    [[nodiscard]] constexpr bpp_mode bpp() const
+    {
+        return _palette_item.bpp();
+    }
+
+    /**
+     * @brief Creates a regular_bg_ptr using the information contained in this item.
+     * @param x Horizontal position of the regular background.
+     * @param y Vertical position of the regular background.
+     * @param tiles_cache Keeps the tiles in VRAM. It can't be used by another map.
+     * @return The requested regular_bg_ptr.
+     */
+    [[nodiscard]] regular_bg_ptr create_bg(fixed x, fixed y, iregular_bg_tiles_cache& tiles_cache) const;
+
+    /**
+     * @brief Creates a regular_bg_map_ptr using the information contained in this item.
+     * @param tiles_cache Keeps the tiles in VRAM. It can't be used by another map.
+     * @return The requested regular_bg_map_ptr.
+     */
+    [[nodiscard]] regular_bg_map_ptr create_map(iregular_bg_tiles_cache& tiles_cache) const;
+
+private:
+    span<const tile> _tiles_ref;
+    span<const uint16_t> _tile_indexes_ref;
+    bg_palette_item _palette_item;
+    regular_bg_map_item _map_item;
+};
+
+}
+
+#endif
@@ -0,0 +1,271 @@
+/*
+ * Copyright (c) 2020-2025 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_REGULAR_BG_TEXT_GENERATOR_H
+#define BN_REGULAR_BG_TEXT_GENERATOR_H
+
+/**
+ * @file
+ * bn::iregular_bg_text_generator and bn::regular_bg_text_generator implementation header file.
+ *
+ * @ingroup regular_bg
+ * @ingroup text
+ */
+
+#include "bn_sprite_font.h"
+#include "bn_string_view.h"
+#include "bn_power_of_two.h"
+#include "bn_bg_palette_item.h"
+#include "bn_regular_bg_map_ptr.h"
+
+namespace bn
+{
+
+/**
+ * @brief Base class of regular_bg_text_generator.
+ *
+ * It draws text from a given sprite_font into the cells of a 32x32 regular background map,
+ * so no sprites are needed to show it.
+ *
+ * Glyph tiles are uploaded to VRAM through a tiles cache indexed by their content:
+ * identical tiles (repeated characters, blank tiles, etc) are uploaded only once and shared by all cells
+ * which reference them, and they are released when no cell references them anymore.
+ *
+ * Variable width characters are composited into shared tiles, so consecutive characters can share a cell.
+ *
+ * Currently, it supports 4 bits per pixel (16 colors) fixed width AND variable width characters.
+ *
+ * Also, UTF-8 characters are supported.
+ *
+ * @ingroup regular_bg
+ * @ingroup text
+ */
+class iregular_bg_text_generator
+{
+
+public:
+    /**
+     * @brief Available horizontal alignment types.
+     */
+    enum class alignment_type : uint8_t
+    {
+        LEFT, //!< Aligns with the left text edge.
+        CENTER, //!< Aligns with the middle of the text.
+        RIGHT //!< Aligns with the right text edge.
+    };
+
+    iregular_bg_text_generator(const iregular_bg_text_generator& other) = delete;
+
+    iregular_bg_text_generator& operator=(const iregular_bg_text_generator& other) = delete;
+
+    /**
+     * @brief Returns the sprite font for drawing text.
+     */
+    [[nodiscard]] const sprite_font& font() const
+    {
+        return _font;
+    }
+
+    /**
+     * @brief Returns the regular background map in which text is drawn.
+     *
+     * It can be used to create a regular_bg_ptr which shows the generated text.
+     */
+    [[nodiscard]] const regular_bg_map_ptr& map() const
+    {
+        return _map;
+    }
+
+    /**
+     * @brief Returns the horizontal alignment of the output text.
+     */
+    [[nodiscard]] alignment_type alignment() const
+    {
+        return _alignment;
+    }
+
+    /**
+     * @brief Sets the horizontal alignment of the output text.
+     */
+    void set_alignment(alignment_type alignment)
+    {
+        _alignment = alignment;
+    }
+
+    /**
+     * @brief Sets the horizontal alignment of the output text to the left.
+     */
+    void set_left_alignment()
+    {
+        _alignment = alignment_type::LEFT;
+    }
+
+    /**
+     * @brief Sets the horizontal alignment of the output text to the center.
+     */
+    void set_center_alignment()
+    {
+        _alignment = alignment_type::CENTER;
+    }
+
+    /**
+     * @brief Sets the horizontal alignment of the output text to the right.
+     */
+    void set_right_alignment()
+    {
+        _alignment = alignment_type::RIGHT;
+    }
+
+    /**
+     * @brief Returns the maximum number of unique tiles that can be kept in VRAM,
+     * including the blank tile.
+     */
+    [[nodiscard]] int max_tiles_count() const
+    {
+        return _max_tiles_count;
+    }
+
+    /**
+     * @brief Returns the number of unique tiles kept in VRAM, including the blank tile.
+     */
+    [[nodiscard]] int used_tiles_count() const
+    {
+        return _used_tiles_count;
+    }
+
+    /**
+     * @brief Returns the number of unique tiles that can still be uploaded to VRAM.
+     */
+    [[nodiscard]] int available_tiles_count() const
+    {
+        return _max_tiles_count - _used_tiles_count;
+    }
+
+    /**
+     * @brief Returns the width in pixels of the given text.
+     */
+    [[nodiscard]] int width(const string_view& text) const;
+
+    /**
+     * @brief Draws the given text in the map.
+     *
+     * The cells covered by the text are overwritten, so characters of previously drawn text
+     * which share cells with the new one are removed.
+     *
+     * @param x Horizontal position of the text in the map, in pixels (see alignment()).
+     * @param y Vertical position of the top of the text in the map, in pixels. It must be a multiple of 8.
+     * @param text Text to draw. It must fit in the map.
+     */
+    void generate(int x, int y, const string_view& text);
+
+    /**
+     * @brief Clears the given map cells, releasing their tiles.
+     * @param x Horizontal position of the first cell to clear.
+     * @param y Vertical position of the first cell to clear.
+     * @param width Number of columns to clear.
+     * @param height Number of rows to clear.
+     */
+    void clear_cells(int x, int y, int width, int height);
+
+    /**
+     * @brief Clears all cells of the map, releasing all tiles but the blank one.
+     */
+    void clear();
+
+protected:
+    /// @cond DO_NOT_DOCUMENT
+
+    class slot_type
+    {
+
+    public:
+        unsigned hash;
+        uint16_t usages;
+        uint16_t next;
+    };
+
+    iregular_bg_text_generator(const sprite_font& font, const bg_palette_item& palette_item, slot_type* slots_ptr,
+                               uint16_t* buckets_ptr, int max_tiles_count);
+
+    /// @endcond
+
+private:
+    sprite_font _font;
+    regular_bg_map_ptr _map;
+    slot_type* _slots_ptr;
+    uint16_t* _buckets_ptr;
+    tile* _tiles_vram;
+    regular_bg_map_cell* _cells_vram;
+    uint16_t _max_tiles_count;
+    uint16_t _used_tiles_count = 1;
+    uint16_t _free_slots_first;
+    uint16_t _cells_offset;
+    alignment_type _alignment = alignment_type::LEFT;
+
+    [[nodiscard]] int _acquire(const tile& source_tile);
+
+    void _release(int tile_index);
+
+    void _set_cell(int cell_index, int tile_index);
+};
+
+
+/**
+ * @brief Draws text from a given sprite_font into the cells of a 32x32 regular background map.
+ *
+ * See iregular_bg_text_generator for more information.
+ *
+ * @tparam MaxTilesCount Maximum number of unique tiles that can be kept in VRAM, including the blank tile.
+ * It must be a power of two.
+ *
+ * @ingroup regular_bg
+ * @ingroup text
+ */
+template<int MaxTilesCount>
+class regular_bg_text_generator : public iregular_bg_text_generator
+{
+    static_assert(MaxTilesCount > 1 && MaxTilesCount <= 1024);
+    static_assert(power_of_two(MaxTilesCount));
+
+public:
+    /**
+     * @brief Constructor.
+     * @param font Sprite font for drawing text.
+     */
+    explicit regular_bg_text_generator(const sprite_font& font) :
+        regular_bg_text_generator(font, font.item().palette_item())
+    {
+    }
+
+    /**
+     * @brief Constructor.
+     * @param font Sprite font for drawing text.
+     * @param palette_item Sprite palette item used to create the background palette.
+     */
+    regular_bg_text_generator(const sprite_font& font, const sprite_palette_item& palette_item) :
+        iregular_bg_text_generator(
+            font, bg_palette_item(palette_item.colors_ref(), palette_item.bpp(), palette_item.compression()),
+            _slots, _buckets, MaxTilesCount)
+    {
+    }
+
+    /**
+     * @brief Constructor.
+     * @param font Sprite font for drawing text.
+     * @param palette_item Background palette item used to draw text.
+     */
+    regular_bg_text_generator(const sprite_font& font, const bg_palette_item& palette_item) :
+        iregular_bg_text_generator(font, palette_item, _slots, _buckets, MaxTilesCount)
+    {
+    }
+
+private:
+    slot_type _slots[MaxTilesCount];
+    uint16_t _buckets[MaxTilesCount];
+};
+
+}
+
+#endif
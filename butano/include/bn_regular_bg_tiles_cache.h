@@ -0,0 +1,237 @@
+/*
+ * Copyright (c) 2020-2025 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_REGULAR_BG_TILES_CACHE_H
+#define BN_REGULAR_BG_TILES_CACHE_H
+
+/**
+ * @file
+ * bn::iregular_bg_tiles_cache and bn::regular_bg_tiles_cache implementation header file.
+ *
+ * @ingroup regular_bg
+ * @ingroup tile
+ */
+
+#include "bn_assert.h"
+
+namespace bn
+{
+
+class tile;
+enum class bpp_mode : uint8_t;
+
+/**
+ * @brief Base class of regular_bg_tiles_cache.
+ *
+ * It keeps in VRAM only the tiles referenced by the visible part of a streamed big map
+ * (see regular_bg_map_ptr::create_streamed), loading them on demand when new rows and columns are exposed.
+ *
+ * When there's no room for a new tile, the least recently used tile which is not referenced by the map
+ * is replaced.
+ *
+ * @ingroup regular_bg
+ * @ingroup tile
+ */
+class iregular_bg_tiles_cache
+{
+
+public:
+    iregular_bg_tiles_cache(const iregular_bg_tiles_cache& other) = delete;
+
+    iregular_bg_tiles_cache& operator=(const iregular_bg_tiles_cache& other) = delete;
+
+    /**
+     * @brief Returns the maximum number of tiles that can be kept in VRAM.
+     */
+    [[nodiscard]] int max_tiles_count() const
+    {
+        return _max_tiles_count;
+    }
+
+    /**
+     * @brief Returns the maximum number of tiles of the streamed map source tiles.
+     */
+    [[nodiscard]] int max_source_tiles_count() const
+    {
+        return _max_source_tiles_count;
+    }
+
+    /**
+     * @brief Returns the number of tiles kept in VRAM.
+     */
+    [[nodiscard]] int loaded_tiles_count() const
+    {
+        return _loaded_tiles_count;
+    }
+
+    /**
+     * @brief Returns the number of tiles kept in VRAM referenced by the streamed map.
+     */
+    [[nodiscard]] int referenced_tiles_count() const
+    {
+        return _referenced_tiles_count;
+    }
+
+    /**
+     * @brief Indicates if this cache is used by a streamed map or not.
+     */
+    [[nodiscard]] bool used() const
+    {
+        return _source_tiles_ptr;
+    }
+
+    /**
+     * @brief Returns the number of map cells committed in the last frame whose tile was already in VRAM.
+     */
+    [[nodiscard]] int hits() const;
+
+    /**
+     * @brief Returns the number of map cells committed in the last frame whose tile was loaded into VRAM.
+     */
+    [[nodiscard]] int misses() const;
+
+    /**
+     * @brief Returns the number of map cells committed whose tile was already in VRAM
+     * since the last reset_total_stats() call.
+     */
+    [[nodiscard]] int total_hits() const
+    {
+        return _total_hits;
+    }
+
+    /**
+     * @brief Returns the number of map cells committed whose tile was loaded into VRAM
+     * since the last reset_total_stats() call.
+     */
+    [[nodiscard]] int total_misses() const
+    {
+        return _total_misses;
+    }
+
+    /**
+     * @brief Sets total_hits() and total_misses() to zero.
+     */
+    void reset_total_stats()
+    {
+        _total_hits = 0;
+        _total_misses = 0;
+    }
+
+    /// @cond DO_NOT_DOCUMENT
+
+    void _bind(const tile* source_tiles_ptr, int source_tiles_count, bpp_mode bpp, tile* vram_tiles_ptr);
+
+    void _unbind();
+
+    void _start_commit(int commit, int max_commit_misses);
+
+    void _release_all();
+
+    [[nodiscard]] static int _cell_tile(unsigned cell)
+    {
+        return int(cell & 0x3FF);
+    }
+
+    [[nodiscard]] unsigned _stream_cell(unsigned source_cell, int source_tile);
+
+    [[nodiscard]] unsigned _replace_cell(unsigned old_cell, unsigned source_cell, int source_tile);
+
+    /// @endcond
+
+protected:
+    /// @cond DO_NOT_DOCUMENT
+
+    class slot_type
+    {
+
+    public:
+        uint16_t source_tile;
+        uint16_t usages;
+        uint16_t previous;
+        uint16_t next;
+    };
+
+    iregular_bg_tiles_cache(slot_type* slots_ptr, int max_tiles_count, uint16_t* source_tile_slots_ptr,
+                            int max_source_tiles_count) :
+        _slots_ptr(slots_ptr),
+        _source_tile_slots_ptr(source_tile_slots_ptr),
+        _max_tiles_count(uint16_t(max_tiles_count)),
+        _max_source_tiles_count(uint16_t(max_source_tiles_count))
+    {
+    }
+
+    /// @endcond
+
+private:
+    static constexpr uint16_t _invalid_index = 0xFFFF;
+
+    slot_type* _slots_ptr;
+    uint16_t* _source_tile_slots_ptr;
+    const tile* _source_tiles_ptr = nullptr;
+    tile* _vram_tiles_ptr = nullptr;
+    int _commit = -1;
+    int _commit_hits = 0;
+    int _commit_misses = 0;
+    int _max_commit_misses = 0;
+    int _total_hits = 0;
+    int _total_misses = 0;
+    uint16_t _max_tiles_count;
+    uint16_t _max_source_tiles_count;
+    uint16_t _source_tiles_count = 0;
+    uint16_t _loaded_tiles_count = 0;
+    uint16_t _referenced_tiles_count = 0;
+    uint16_t _lru_first = _invalid_index;
+    uint16_t _lru_last = _invalid_index;
+    uint8_t _tile_size = 0;
+
+    void _lru_push(int slot_index);
+
+    void _lru_remove(int slot_index);
+
+    [[nodiscard]] int _acquire(int source_tile);
+
+    void _release(int slot_index);
+};
+
+
+/**
+ * @brief Keeps in VRAM only the tiles referenced by the visible part of a streamed big map
+ * (see regular_bg_map_ptr::create_streamed), loading them on demand when new rows and columns are exposed.
+ *
+ * The cache must be big enough to hold all unique tiles referenced by any 32x32 cells area of the map.
+ *
+ * The number of tiles loaded per frame when the map is moved is limited by
+ * @ref BN_CFG_BG_BLOCKS_MAX_STREAMED_TILES_PER_FRAME.
+ *
+ * @tparam MaxTilesCount Maximum number of tiles that can be kept in VRAM.
+ * @tparam MaxSourceTilesCount Maximum number of tiles of the streamed map source tiles
+ * (the tiles count of the regular_bg_streamed_item for example).
+ *
+ * @ingroup regular_bg
+ * @ingroup tile
+ */
+template<int MaxTilesCount, int MaxSourceTilesCount = 1024>
+class regular_bg_tiles_cache : public iregular_bg_tiles_cache
+{
+    static_assert(MaxTilesCount > 0 && MaxTilesCount <= 1024);
+    static_assert(MaxSourceTilesCount > 0 && MaxSourceTilesCount < 0xFFFF);
+
+public:
+    /**
+     * @brief Default constructor.
+     */
+    regular_bg_tiles_cache() :
+        iregular_bg_tiles_cache(_slots, MaxTilesCount, _source_tile_slots, MaxSourceTilesCount)
+    {
+    }
+
+private:
+    slot_type _slots[MaxTilesCount];
+    uint16_t _source_tile_slots[MaxSourceTilesCount];
+};
+
+}
+
+#endif
@@ -197,6 +197,14 @@ public:
      */
     void reload_tiles_ref();
 
+    /**
+     * @brief Indicates if the referenced tiles will be in VRAM after the next V-Blank.
+     *
+     * It returns `false` only if the referenced tiles are compressed and they have not been decompressed
+     * into the staging buffer yet (see @ref BN_CFG_BG_BLOCKS_STAGING_BUFFER_SIZE).
+     */
+    [[nodiscard]] bool ready() const;
+
     /**
      * @brief Returns the allocated memory in VRAM
      * if this regular_bg_tiles_ptr was created with allocate or allocate_optional; bn::nullopt otherwise.
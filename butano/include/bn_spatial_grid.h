@@ -0,0 +1,338 @@
+/*
+ * Copyright (c) 2020-2025 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_SPATIAL_GRID_H
+#define BN_SPATIAL_GRID_H
+
+/**
+ * @file
+ * bn::ispatial_grid and bn::spatial_grid implementation header file.
+ *
+ * @ingroup math
+ */
+
+#include "bn_span.h"
+#include "bn_vector.h"
+#include "bn_fixed_rect.h"
+#include "bn_top_left_fixed_rect.h"
+
+/// @cond DO_NOT_DOCUMENT
+
+namespace _bn::spatial_grid
+{
+    class data_type
+    {
+
+    public:
+        int* lefts;
+        int* tops;
+        int* rights;
+        int* bottoms;
+        uint16_t* cell_starts;
+        uint16_t* entries;
+        uint16_t* stamps;
+        int origin_x;
+        int origin_y;
+        int shift;
+        int columns;
+        int rows;
+    };
+
+    [[nodiscard]] int build(const data_type& data, int size, int max_entries);
+
+    [[nodiscard]] int find(const data_type& data, int left, int top, int right, int bottom);
+
+    void find(const data_type& data, const bn::fixed_rect* rects, int rects_count, int16_t* indexes);
+
+    void find(const data_type& data, const bn::top_left_fixed_rect* rects, int rects_count, int16_t* indexes);
+
+    [[nodiscard]] int query(const data_type& data, int stamp, int left, int top, int right, int bottom,
+                            uint16_t* indexes, int max_indexes);
+}
+
+/// @endcond
+
+
+namespace bn
+{
+
+/**
+ * @brief Base class of bn::spatial_grid.
+ *
+ * Can be used as a reference type for all bn::spatial_grid objects.
+ *
+ * @ingroup math
+ */
+class ispatial_grid
+{
+
+public:
+    ispatial_grid(const ispatial_grid& other) = delete;
+
+    ispatial_grid& operator=(const ispatial_grid& other) = delete;
+
+    /**
+     * @brief Returns the position of the top-left corner of the first cell.
+     */
+    [[nodiscard]] const fixed_point& top_left() const
+    {
+        return _top_left;
+    }
+
+    /**
+     * @brief Returns the width and height of each cell in pixels.
+     */
+    [[nodiscard]] int cell_size() const
+    {
+        return 1 << _cell_shift;
+    }
+
+    /**
+     * @brief Returns the number of columns of cells.
+     */
+    [[nodiscard]] int columns() const
+    {
+        return _data.columns;
+    }
+
+    /**
+     * @brief Returns the number of rows of cells.
+     */
+    [[nodiscard]] int rows() const
+    {
+        return _data.rows;
+    }
+
+    /**
+     * @brief Returns the number of inserted rectangles.
+     */
+    [[nodiscard]] int size() const
+    {
+        return _size;
+    }
+
+    /**
+     * @brief Returns the maximum number of rectangles that can be inserted.
+     */
+    [[nodiscard]] int max_size() const
+    {
+        return _max_size;
+    }
+
+    /**
+     * @brief Indicates if there's no inserted rectangles.
+     */
+    [[nodiscard]] bool empty() const
+    {
+        return _size == 0;
+    }
+
+    /**
+     * @brief Indicates if no more rectangles can be inserted.
+     */
+    [[nodiscard]] bool full() const
+    {
+        return _size == _max_size;
+    }
+
+    /**
+     * @brief Returns the specified inserted rectangle.
+     */
+    [[nodiscard]] top_left_fixed_rect rect(int index) const;
+
+    /**
+     * @brief Inserts the given rectangle.
+     * @return Index of the inserted rectangle, valid until clear() is called.
+     */
+    int insert(const fixed_rect& rect)
+    {
+        return _insert(rect.left().data(), rect.top().data(), rect.width().data(), rect.height().data());
+    }
+
+    /**
+     * @brief Inserts the given rectangle.
+     * @return Index of the inserted rectangle, valid until clear() is called.
+     */
+    int insert(const top_left_fixed_rect& rect)
+    {
+        return _insert(rect.left().data(), rect.top().data(), rect.width().data(), rect.height().data());
+    }
+
+    /**
+     * @brief Replaces the specified inserted rectangle.
+     */
+    void set_rect(int index, const fixed_rect& rect)
+    {
+        _set_rect(index, rect.left().data(), rect.top().data(), rect.width().data(), rect.height().data());
+    }
+
+    /**
+     * @brief Replaces the specified inserted rectangle.
+     */
+    void set_rect(int index, const top_left_fixed_rect& rect)
+    {
+        _set_rect(index, rect.left().data(), rect.top().data(), rect.width().data(), rect.height().data());
+    }
+
+    /**
+     * @brief Removes all inserted rectangles.
+     */
+    void clear()
+    {
+        _size = 0;
+        _built = false;
+    }
+
+    /**
+     * @brief Searches for an inserted rectangle which intersects with the given one.
+     *
+     * Two rectangles intersect if there is at least one point that is within both rectangles,
+     * excluding their edges.
+     *
+     * @return Index of the first found rectangle, or -1 if there's no intersection.
+     */
+    [[nodiscard]] int find(const fixed_rect& rect)
+    {
+        return _find(rect.left().data(), rect.top().data(), rect.width().data(), rect.height().data());
+    }
+
+    /**
+     * @brief Searches for an inserted rectangle which intersects with the given one.
+     *
+     * Two rectangles intersect if there is at least one point that is within both rectangles,
+     * excluding their edges.
+     *
+     * @return Index of the first found rectangle, or -1 if there's no intersection.
+     */
+    [[nodiscard]] int find(const top_left_fixed_rect& rect)
+    {
+        return _find(rect.left().data(), rect.top().data(), rect.width().data(), rect.height().data());
+    }
+
+    /**
+     * @brief Searches for an inserted rectangle which intersects with each one of the given rectangles
+     * in a single call.
+     * @param rects Rectangles to test.
+     * @param indexes Index of the first found rectangle for each one of the given rectangles,
+     * or -1 if there's no intersection. Its size must be equal or greater than the size of rects.
+     */
+    void find(const span<const fixed_rect>& rects, span<int16_t> indexes);
+
+    /**
+     * @brief Searches for an inserted rectangle which intersects with each one of the given rectangles
+     * in a single call.
+     * @param rects Rectangles to test.
+     * @param indexes Index of the first found rectangle for each one of the given rectangles,
+     * or -1 if there's no intersection. Its size must be equal or greater than the size of rects.
+     */
+    void find(const span<const top_left_fixed_rect>& rects, span<int16_t> indexes);
+
+    /**
+     * @brief Searches for all inserted rectangles which intersect with the given one.
+     * @param rect Rectangle to test.
+     * @param indexes Indexes of the found rectangles are inserted at the end of this vector.
+     */
+    void query(const fixed_rect& rect, ivector<uint16_t>& indexes)
+    {
+        _query(rect.left().data(), rect.top().data(), rect.width().data(), rect.height().data(), indexes);
+    }
+
+    /**
+     * @brief Searches for all inserted rectangles which intersect with the given one.
+     * @param rect Rectangle to test.
+     * @param indexes Indexes of the found rectangles are inserted at the end of this vector.
+     */
+    void query(const top_left_fixed_rect& rect, ivector<uint16_t>& indexes)
+    {
+        _query(rect.left().data(), rect.top().data(), rect.width().data(), rect.height().data(), indexes);
+    }
+
+    /**
+     * @brief Sorts the inserted rectangles by cell.
+     *
+     * It is called by the query methods if rectangles have been inserted or modified since the last call,
+     * so it should only be called to control when this work is done.
+     */
+    void build();
+
+protected:
+    /// @cond DO_NOT_DOCUMENT
+
+    ispatial_grid(int* lefts, int* tops, int* rights, int* bottoms, uint16_t* cell_starts, uint16_t* entries,
+                  uint16_t* stamps, int max_size, int max_entries, int columns, int rows,
+                  const fixed_point& top_left, int cell_size);
+
+    /// @endcond
+
+private:
+    _bn::spatial_grid::data_type _data;
+    fixed_point _top_left;
+    int _max_size;
+    int _max_entries;
+    int _size = 0;
+    uint16_t _stamp = 0;
+    uint8_t _cell_shift;
+    bool _built = false;
+
+    int _insert(int left, int top, int width, int height);
+
+    void _set_rect(int index, int left, int top, int width, int height);
+
+    [[nodiscard]] int _find(int left, int top, int width, int height);
+
+    void _query(int left, int top, int width, int height, ivector<uint16_t>& indexes);
+
+    [[nodiscard]] int _next_stamp();
+};
+
+
+/**
+ * @brief Uniform grid which allows to find the intersections between lots of rectangles
+ * without testing all of them against each other (broadphase).
+ *
+ * Inserted rectangles are sorted by cell in a single pass before the first query,
+ * so they should be inserted (or modified) in a batch and then queried.
+ *
+ * Rectangles outside the grid are stored in its border cells.
+ *
+ * @tparam MaxSize Maximum number of rectangles that can be inserted.
+ * @tparam Columns Number of columns of cells.
+ * @tparam Rows Number of rows of cells.
+ * @tparam MaxEntries Maximum number of cells referenced by all inserted rectangles.
+ *
+ * @ingroup math
+ */
+template<int MaxSize, int Columns, int Rows, int MaxEntries = MaxSize * 4>
+class spatial_grid : public ispatial_grid
+{
+    static_assert(MaxSize > 0 && MaxSize < 65536);
+    static_assert(Columns > 0 && Rows > 0 && Columns * Rows < 65536);
+    static_assert(MaxEntries >= MaxSize && MaxEntries < 65536);
+
+public:
+    /**
+     * @brief Constructor.
+     * @param top_left Position of the top-left corner of the first cell.
+     * @param cell_size Width and height of each cell in pixels. It must be a power of two.
+     */
+    spatial_grid(const fixed_point& top_left, int cell_size) :
+        ispatial_grid(_lefts, _tops, _rights, _bottoms, _cell_starts, _entries, _stamps, MaxSize, MaxEntries,
+                      Columns, Rows, top_left, cell_size)
+    {
+    }
+
+private:
+    int _lefts[MaxSize];
+    int _tops[MaxSize];
+    int _rights[MaxSize];
+    int _bottoms[MaxSize];
+    uint16_t _cell_starts[(Columns * Rows) + 1];
+    uint16_t _entries[MaxEntries];
+    uint16_t _stamps[MaxSize];
+};
+
+}
+
+#endif
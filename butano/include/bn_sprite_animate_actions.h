@@ -943,6 +943,401 @@ template<typename ...Args>
                 array<uint16_t, sizeof...(Args)>{{ uint16_t(graphics_indexes)... }});
 }
 
+
+// streamed animation
+
+/**
+ * @brief Base class of bn::sprite_streamed_animate_action.
+ *
+ * Can be used as a reference type for all bn::sprite_streamed_animate_action objects.
+ *
+ * @ingroup sprite
+ * @ingroup tile
+ * @ingroup action
+ */
+class isprite_streamed_animate_action
+{
+
+public:
+    isprite_streamed_animate_action(const isprite_streamed_animate_action& other) = delete;
+
+    isprite_streamed_animate_action& operator=(const isprite_streamed_animate_action& other) = delete;
+
+    /**
+     * @brief Move assignment operator.
+     * @param other isprite_streamed_animate_action to move.
+     * @return Reference to this.
+     */
+    isprite_streamed_animate_action& operator=(isprite_streamed_animate_action&& other) noexcept;
+
+    /**
+     * @brief Copies the next tile set into the back VRAM slot and shows it
+     * when the given amount of update calls are done.
+     */
+    void update();
+
+    /**
+     * @brief Indicates if the action must not be updated anymore.
+     */
+    [[nodiscard]] bool done() const
+    {
+        return _current_graphics_indexes_index == _graphics_indexes_ref->size();
+    }
+
+    /**
+     * @brief Resets the action to its initial state.
+     */
+    void reset()
+    {
+        _current_graphics_indexes_index = 0;
+        _current_wait_updates = 0;
+    }
+
+    /**
+     * @brief Returns the sprite_ptr to modify.
+     */
+    [[nodiscard]] const sprite_ptr& sprite() const
+    {
+        return *_sprite_ref;
+    }
+
+    /**
+     * @brief Returns the number of times the action must be updated before changing the tiles
+     * of the given sprite_ptr.
+     */
+    [[nodiscard]] int wait_updates() const
+    {
+        return _wait_updates;
+    }
+
+    /**
+     * @brief Sets the number of times the action must be updated before changing the tiles
+     * of the given sprite_ptr.
+     */
+    void set_wait_updates(int wait_updates);
+
+    /**
+     * @brief Returns the number of times the action must be updated before the next tiles change.
+     */
+    [[nodiscard]] int next_change_updates() const
+    {
+        return _current_wait_updates;
+    }
+
+    /**
+     * @brief Returns the sprite_tiles_item which contains the tile sets to copy into VRAM.
+     */
+    [[nodiscard]] const sprite_tiles_item& tiles_item() const
+    {
+        return *_tiles_item_ref;
+    }
+
+    /**
+     * @brief Returns the indexes of the tile sets to copy in the given sprite_tiles_item.
+     */
+    [[nodiscard]] const ivector<uint16_t>& graphics_indexes() const
+    {
+        return *_graphics_indexes_ref;
+    }
+
+    /**
+     * @brief Indicates if the action can be updated forever or not.
+     */
+    [[nodiscard]] bool update_forever() const
+    {
+        return _forever;
+    }
+
+    /**
+     * @brief Returns the current index of the given graphics_indexes
+     * (not the current index of the tile set to copy from the given tiles_item).
+     */
+    [[nodiscard]] int current_index() const
+    {
+        return _current_graphics_indexes_index;
+    }
+
+    /**
+     * @brief Returns the current index of the tile set to copy from the given tiles_item.
+     */
+    [[nodiscard]] int current_graphics_index() const
+    {
+        return graphics_indexes()[_current_graphics_indexes_index];
+    }
+
+    /**
+     * @brief Returns the VRAM slot shown by the given sprite_ptr after the last tiles change.
+     */
+    [[nodiscard]] const sprite_tiles_ptr& front_tiles() const
+    {
+        return _second_tiles_back ? *_first_tiles_ref : *_second_tiles_ref;
+    }
+
+    /**
+     * @brief Returns the VRAM slot in which the next tile set is going to be copied.
+     */
+    [[nodiscard]] const sprite_tiles_ptr& back_tiles() const
+    {
+        return _second_tiles_back ? *_second_tiles_ref : *_first_tiles_ref;
+    }
+
+protected:
+    /// @cond DO_NOT_DOCUMENT
+
+    isprite_streamed_animate_action() = default;
+
+    [[nodiscard]] static sprite_tiles_ptr _allocate_tiles(const sprite_tiles_item& tiles_item);
+
+    void _set_refs(sprite_ptr& sprite, sprite_tiles_item& tiles_item, ivector<uint16_t>& graphics_indexes,
+                   sprite_tiles_ptr& first_tiles, sprite_tiles_ptr& second_tiles);
+
+    void _assign(const isprite_streamed_animate_action& other);
+
+    void _set_update_forever(bool forever)
+    {
+        _forever = forever;
+    }
+
+    void _assign_graphics_indexes(const span<const uint16_t>& graphics_indexes);
+
+    /// @endcond
+
+private:
+    sprite_ptr* _sprite_ref = nullptr;
+    sprite_tiles_item* _tiles_item_ref = nullptr;
+    ivector<uint16_t>* _graphics_indexes_ref = nullptr;
+    sprite_tiles_ptr* _first_tiles_ref = nullptr;
+    sprite_tiles_ptr* _second_tiles_ref = nullptr;
+    uint16_t _wait_updates = 0;
+    uint16_t _current_graphics_indexes_index = 0;
+    uint16_t _current_wait_updates = 0;
+    bool _forever = true;
+    bool _second_tiles_back = false;
+};
+
+template<int MaxSize>
+class sprite_streamed_animate_action : public isprite_streamed_animate_action
+{
+    static_assert(MaxSize > 1);
+
+public:
+    /**
+     * @brief Generates a sprite_streamed_animate_action which loops over the given sprite tile sets only once.
+     * @param sprite sprite_ptr to copy.
+     * @param wait_updates Number of times the action must be updated before changing the tiles of the given sprite_ptr.
+     * @param tiles_item Uncompressed sprite_tiles_item which contains the tile sets to copy into VRAM.
+     * @param graphics_indexes Indexes of the tile sets to copy from tiles_item.
+     * @return The requested sprite_streamed_animate_action.
+     */
+    [[nodiscard]] static sprite_streamed_animate_action once(
+            const sprite_ptr& sprite, int wait_updates, const sprite_tiles_item& tiles_item,
+            const span<const uint16_t>& graphics_indexes)
+    {
+        return sprite_streamed_animate_action(sprite, wait_updates, tiles_item, false, graphics_indexes);
+    }
+
+    /**
+     * @brief Generates a sprite_streamed_animate_action which loops over the given sprite tile sets only once.
+     * @param sprite sprite_ptr to move.
+     * @param wait_updates Number of times the action must be updated before changing the tiles of the given sprite_ptr.
+     * @param tiles_item Uncompressed sprite_tiles_item which contains the tile sets to copy into VRAM.
+     * @param graphics_indexes Indexes of the tile sets to copy from tiles_item.
+     * @return The requested sprite_streamed_animate_action.
+     */
+    [[nodiscard]] static sprite_streamed_animate_action once(
+            sprite_ptr&& sprite, int wait_updates, const sprite_tiles_item& tiles_item,
+            const span<const uint16_t>& graphics_indexes)
+    {
+        return sprite_streamed_animate_action(move(sprite), wait_updates, tiles_item, false, graphics_indexes);
+    }
+
+    /**
+     * @brief Generates a sprite_streamed_animate_action which loops over the given sprite tile sets forever.
+     * @param sprite sprite_ptr to copy.
+     * @param wait_updates Number of times the action must be updated before changing the tiles of the given sprite_ptr.
+     * @param tiles_item Uncompressed sprite_tiles_item which contains the tile sets to copy into VRAM.
+     * @param graphics_indexes Indexes of the tile sets to copy from tiles_item.
+     * @return The requested sprite_streamed_animate_action.
+     */
+    [[nodiscard]] static sprite_streamed_animate_action forever(
+            const sprite_ptr& sprite, int wait_updates, const sprite_tiles_item& tiles_item,
+            const span<const uint16_t>& graphics_indexes)
+    {
+        return sprite_streamed_animate_action(sprite, wait_updates, tiles_item, true, graphics_indexes);
+    }
+
+    /**
+     * @brief Generates a sprite_streamed_animate_action which loops over the given sprite tile sets forever.
+     * @param sprite sprite_ptr to move.
+     * @param wait_updates Number of times the action must be updated before changing the tiles of the given sprite_ptr.
+     * @param tiles_item Uncompressed sprite_tiles_item which contains the tile sets to copy into VRAM.
+     * @param graphics_indexes Indexes of the tile sets to copy from tiles_item.
+     * @return The requested sprite_streamed_animate_action.
+     */
+    [[nodiscard]] static sprite_streamed_animate_action forever(
+            sprite_ptr&& sprite, int wait_updates, const sprite_tiles_item& tiles_item,
+            const span<const uint16_t>& graphics_indexes)
+    {
+        return sprite_streamed_animate_action(move(sprite), wait_updates, tiles_item, true, graphics_indexes);
+    }
+
+    /**
+     * @brief Move constructor.
+     * @param other sprite_streamed_animate_action to move.
+     */
+    sprite_streamed_animate_action(sprite_streamed_animate_action&& other) noexcept :
+        _sprite(move(other._sprite)),
+        _tiles_item(other._tiles_item),
+        _graphics_indexes(other._graphics_indexes),
+        _first_tiles(move(other._first_tiles)),
+        _second_tiles(move(other._second_tiles))
+    {
+        this->_set_refs(_sprite, _tiles_item, _graphics_indexes, _first_tiles, _second_tiles);
+        this->_assign(other);
+    }
+
+    /**
+     * @brief Move assignment operator.
+     * @param other sprite_streamed_animate_action to move.
+     * @return Reference to this.
+     */
+    sprite_streamed_animate_action& operator=(sprite_streamed_animate_action&& other) noexcept
+    {
+        if(this != &other)
+        {
+            _sprite = move(other._sprite);
+            _tiles_item = other._tiles_item;
+            _graphics_indexes = other._graphics_indexes;
+            _first_tiles = move(other._first_tiles);
+            _second_tiles = move(other._second_tiles);
+            this->_assign(other);
+        }
+
+        return *this;
+    }
+
+    /**
+     * @brief Move assignment operator.
+     * @param other isprite_streamed_animate_action to move.
+     * @return Reference to this.
+     */
+    sprite_streamed_animate_action& operator=(isprite_streamed_animate_action&& other) noexcept
+    {
+        static_cast<isprite_streamed_animate_action&>(*this) = move(other);
+        return *this;
+    }
+
+private:
+    sprite_ptr _sprite;
+    sprite_tiles_item _tiles_item;
+    vector<uint16_t, MaxSize> _graphics_indexes;
+    sprite_tiles_ptr _first_tiles;
+    sprite_tiles_ptr _second_tiles;
+
+    sprite_streamed_animate_action(const sprite_ptr& sprite, int wait_updates, const sprite_tiles_item& tiles_item,
+                                   bool forever, const span<const uint16_t>& graphics_indexes) :
+        _sprite(sprite),
+        _tiles_item(tiles_item),
+        _first_tiles(this->_allocate_tiles(tiles_item)),
+        _second_tiles(this->_allocate_tiles(tiles_item))
+    {
+        this->_set_refs(_sprite, _tiles_item, _graphics_indexes, _first_tiles, _second_tiles);
+        this->_set_update_forever(forever);
+        this->set_wait_updates(wait_updates);
+        this->_assign_graphics_indexes(graphics_indexes);
+    }
+
+    sprite_streamed_animate_action(sprite_ptr&& sprite, int wait_updates, const sprite_tiles_item& tiles_item,
+                                   bool forever, const span<const uint16_t>& graphics_indexes) :
+        _sprite(move(sprite)),
+        _tiles_item(tiles_item),
+        _first_tiles(this->_allocate_tiles(tiles_item)),
+        _second_tiles(this->_allocate_tiles(tiles_item))
+    {
+        this->_set_refs(_sprite, _tiles_item, _graphics_indexes, _first_tiles, _second_tiles);
+        this->_set_update_forever(forever);
+        this->set_wait_updates(wait_updates);
+        this->_assign_graphics_indexes(graphics_indexes);
+    }
+};
+
+
+/**
+ * @brief Generates a sprite_streamed_animate_action which loops over the given sprite tile sets only once.
+ * @param sprite sprite_ptr to copy.
+ * @param wait_updates Number of times the action must be updated before changing the tiles of the given sprite_ptr.
+ * @param tiles_item Uncompressed sprite_tiles_item which contains the tile sets to copy into VRAM.
+ * @param graphics_indexes Indexes of the tile sets to copy from tiles_item.
+ * @return The requested sprite_streamed_animate_action.
+ *
+ * @ingroup sprite
+ */
+template<typename ...Args>
+[[nodiscard]] auto create_sprite_streamed_animate_action_once(
+        const sprite_ptr& sprite, int wait_updates, const sprite_tiles_item& tiles_item, Args ...graphics_indexes)
+{
+    return sprite_streamed_animate_action<sizeof...(Args)>::once(
+                sprite, wait_updates, tiles_item,
+                array<uint16_t, sizeof...(Args)>{{ uint16_t(graphics_indexes)... }});
+}
+
+/**
+ * @brief Generates a sprite_streamed_animate_action which loops over the given sprite tile sets only once.
+ * @param sprite sprite_ptr to move.
+ * @param wait_updates Number of times the action must be updated before changing the tiles of the given sprite_ptr.
+ * @param tiles_item Uncompressed sprite_tiles_item which contains the tile sets to copy into VRAM.
+ * @param graphics_indexes Indexes of the tile sets to copy from tiles_item.
+ * @return The requested sprite_streamed_animate_action.
+ *
+ * @ingroup sprite
+ */
+template<typename ...Args>
+[[nodiscard]] auto create_sprite_streamed_animate_action_once(
+        sprite_ptr&& sprite, int wait_updates, const sprite_tiles_item& tiles_item, Args ...graphics_indexes)
+{
+    return sprite_streamed_animate_action<sizeof...(Args)>::once(
+                move(sprite), wait_updates, tiles_item,
+                array<uint16_t, sizeof...(Args)>{{ uint16_t(graphics_indexes)... }});
+}
+
+/**
+ * @brief Generates a sprite_streamed_animate_action which loops over the given sprite tile sets forever.
+ * @param sprite sprite_ptr to copy.
+ * @param wait_updates Number of times the action must be updated before changing the tiles of the given sprite_ptr.
+ * @param tiles_item Uncompressed sprite_tiles_item which contains the tile sets to copy into VRAM.
+ * @param graphics_indexes Indexes of the tile sets to copy from tiles_item.
+ * @return The requested sprite_streamed_animate_action.
+ *
+ * @ingroup sprite
+ */
+template<typename ...Args>
+[[nodiscard]] auto create_sprite_streamed_animate_action_forever(
+        const sprite_ptr& sprite, int wait_updates, const sprite_tiles_item& tiles_item, Args ...graphics_indexes)
+{
+    return sprite_streamed_animate_action<sizeof...(Args)>::forever(
+                sprite, wait_updates, tiles_item,
+                array<uint16_t, sizeof...(Args)>{{ uint16_t(graphics_indexes)... }});
+}
+
+/**
+ * @brief Generates a sprite_streamed_animate_action which loops over the given sprite tile sets forever.
+ * @param sprite sprite_ptr to move.
+ * @param wait_updates Number of times the action must be updated before changing the tiles of the given sprite_ptr.
+ * @param tiles_item Uncompressed sprite_tiles_item which contains the tile sets to copy into VRAM.
+ * @param graphics_indexes Indexes of the tile sets to copy from tiles_item.
+ * @return The requested sprite_streamed_animate_action.
+ *
+ * @ingroup sprite
+ */
+template<typename ...Args>
+[[nodiscard]] auto create_sprite_streamed_animate_action_forever(
+        sprite_ptr&& sprite, int wait_updates, const sprite_tiles_item& tiles_item, Args ...graphics_indexes)
+{
+    return sprite_streamed_animate_action<sizeof...(Args)>::forever(
+                move(sprite), wait_updates, tiles_item,
+                array<uint16_t, sizeof...(Args)>{{ uint16_t(graphics_indexes)... }});
+}
+
 }
 
 #endif
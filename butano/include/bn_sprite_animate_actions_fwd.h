@@ -57,6 +57,30 @@ namespace bn
      */
     template<int MaxSize>
     class sprite_cached_animate_action;
+
+
+    // streamed animation
+
+    class isprite_streamed_animate_action;
+
+    /**
+     * @brief Changes the tile set of a sprite_ptr when the action is updated a given number of times.
+     *
+     * This action differs from sprite_animate_action in that the sprite tile sets are not searched for nor created:
+     * two VRAM slots are allocated when the action is created,
+     * and each new tile set is copied from ROM into the slot not shown by the sprite_ptr in the next V-Blank.
+     *
+     * It is useful for animations with a lot of frames, since it takes only two tile sets of VRAM.
+     * Compressed tiles are not supported.
+     *
+     * @tparam MaxSize Maximum number of indexes to sprite tile sets to store.
+     *
+     * @ingroup sprite
+     * @ingroup tile
+     * @ingroup action
+     */
+    template<int MaxSize>
+    class sprite_streamed_animate_action;
 }
 
 #endif
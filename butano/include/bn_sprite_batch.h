@@ -0,0 +1,554 @@
+/*
+ * Copyright (c) 2020-2025 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_SPRITE_BATCH_H
+#define BN_SPRITE_BATCH_H
+
+/**
+ * @file
+ * bn::isprite_batch and bn::sprite_batch implementation header file.
+ *
+ * @ingroup sprite
+ */
+
+#include "bn_point.h"
+#include "bn_vector.h"
+#include "bn_optional.h"
+#include "bn_camera_ptr.h"
+#include "bn_config_sprites.h"
+#include "bn_sprite_tiles_ptr.h"
+#include "bn_sprite_shape_size.h"
+#include "bn_sprite_palette_ptr.h"
+
+namespace bn
+{
+
+class sprite_item;
+
+/**
+ * @brief Base class of bn::sprite_batch.
+ *
+ * Can be used as a reference type for all bn::sprite_batch objects.
+ *
+ * Batches are not sorted with sprite_ptr objects: they are always committed to OAM after them,
+ * in creation order, and they don't have a z order.
+ *
+ * @ingroup sprite
+ */
+class isprite_batch
+{
+
+public:
+    isprite_batch(const isprite_batch& other) = delete;
+
+    isprite_batch& operator=(const isprite_batch& other) = delete;
+
+    /**
+     * @brief Destructor.
+     */
+    ~isprite_batch();
+
+    /**
+     * @brief Returns the number of sprites in the batch.
+     */
+    [[nodiscard]] int size() const
+    {
+        return _size;
+    }
+
+    /**
+     * @brief Returns the maximum number of sprites that can be stored in the batch.
+     */
+    [[nodiscard]] int max_size() const
+    {
+        return _max_size;
+    }
+
+    /**
+     * @brief Indicates if the batch doesn't contain any sprite.
+     */
+    [[nodiscard]] bool empty() const
+    {
+        return _size == 0;
+    }
+
+    /**
+     * @brief Indicates if the batch can't contain any more sprites.
+     */
+    [[nodiscard]] bool full() const
+    {
+        return _size == _max_size;
+    }
+
+    /**
+     * @brief Returns the shape and size of all sprites in the batch.
+     */
+    [[nodiscard]] const sprite_shape_size& shape_size() const
+    {
+        return _shape_size;
+    }
+
+    /**
+     * @brief Returns the tile sets that can be referenced by the sprites in the batch.
+     */
+    [[nodiscard]] const ivector<sprite_tiles_ptr>& tiles_list() const
+    {
+        return *_tiles_list_ref;
+    }
+
+    /**
+     * @brief Returns the color palette used by all sprites in the batch.
+     */
+    [[nodiscard]] const sprite_palette_ptr& palette() const
+    {
+        return _palette;
+    }
+
+    /**
+     * @brief Returns the priority of the sprites relative to backgrounds.
+     *
+     * Sprites with higher priorities are drawn first
+     * (and therefore can be covered by later sprites and backgrounds).
+     */
+    [[nodiscard]] int bg_priority() const
+    {
+        return _bg_priority;
+    }
+
+    /**
+     * @brief Sets the priority of the sprites relative to backgrounds.
+     *
+     * Sprites with higher priorities are drawn first
+     * (and therefore can be covered by later sprites and backgrounds).
+     *
+     * It doesn't change the order of the batch relative to sprite_ptr objects:
+     * sprites with the same priority are still drawn below all sprite_ptr objects.
+     *
+     * @param bg_priority Priority relative to backgrounds in the range [0..3].
+     */
+    void set_bg_priority(int bg_priority);
+
+    /**
+     * @brief Indicates if blending must be applied to the sprites or not.
+     */
+    [[nodiscard]] bool blending_enabled() const
+    {
+        return _blending_enabled;
+    }
+
+    /**
+     * @brief Sets if blending must be applied to the sprites or not.
+     */
+    void set_blending_enabled(bool blending_enabled)
+    {
+        _blending_enabled = blending_enabled;
+    }
+
+    /**
+     * @brief Indicates if the sprites of the batch must be committed to the GBA or not.
+     */
+    [[nodiscard]] bool visible() const
+    {
+        return _visible;
+    }
+
+    /**
+     * @brief Sets if the sprites of the batch must be committed to the GBA or not.
+     */
+    void set_visible(bool visible)
+    {
+        _visible = visible;
+    }
+
+    /**
+     * @brief Returns the camera_ptr attached to the batch (if any).
+     */
+    [[nodiscard]] const optional<camera_ptr>& camera() const
+    {
+        return _camera;
+    }
+
+    /**
+     * @brief Sets the camera_ptr attached to the batch.
+     * @param camera camera_ptr to copy.
+     */
+    void set_camera(const camera_ptr& camera)
+    {
+        _camera = camera;
+    }
+
+    /**
+     * @brief Sets the camera_ptr attached to the batch.
+     * @param camera camera_ptr to move.
+     */
+    void set_camera(camera_ptr&& camera)
+    {
+        _camera = move(camera);
+    }
+
+    /**
+     * @brief Sets or removes the camera_ptr attached to the batch.
+     * @param camera Optional camera_ptr to copy.
+     */
+    void set_camera(const optional<camera_ptr>& camera)
+    {
+        _camera = camera;
+    }
+
+    /**
+     * @brief Sets or removes the camera_ptr attached to the batch.
+     * @param camera Optional camera_ptr to move.
+     */
+    void set_camera(optional<camera_ptr>&& camera)
+    {
+        _camera = move(camera);
+    }
+
+    /**
+     * @brief Removes the camera_ptr attached to the batch (if any).
+     */
+    void remove_camera()
+    {
+        _camera.reset();
+    }
+
+    /**
+     * @brief Returns the horizontal position of the center of the specified sprite.
+     */
+    [[nodiscard]] int x(int index) const
+    {
+        BN_ASSERT(index >= 0 && index < _size, "Invalid index: ", index, " - ", _size);
+
+        return _xs[index];
+    }
+
+    /**
+     * @brief Sets the horizontal position of the center of the specified sprite.
+     */
+    void set_x(int index, int x)
+    {
+        BN_ASSERT(index >= 0 && index < _size, "Invalid index: ", index, " - ", _size);
+
+        _xs[index] = int16_t(x);
+    }
+
+    /**
+     * @brief Returns the vertical position of the center of the specified sprite.
+     */
+    [[nodiscard]] int y(int index) const
+    {
+        BN_ASSERT(index >= 0 && index < _size, "Invalid index: ", index, " - ", _size);
+
+        return _ys[index];
+    }
+
+    /**
+     * @brief Sets the vertical position of the center of the specified sprite.
+     */
+    void set_y(int index, int y)
+    {
+        BN_ASSERT(index >= 0 && index < _size, "Invalid index: ", index, " - ", _size);
+
+        _ys[index] = int16_t(y);
+    }
+
+    /**
+     * @brief Returns the position of the center of the specified sprite.
+     */
+    [[nodiscard]] point position(int index) const
+    {
+        BN_ASSERT(index >= 0 && index < _size, "Invalid index: ", index, " - ", _size);
+
+        return point(_xs[index], _ys[index]);
+    }
+
+    /**
+     * @brief Sets the position of the center of the specified sprite.
+     */
+    void set_position(int index, int x, int y)
+    {
+        BN_ASSERT(index >= 0 && index < _size, "Invalid index: ", index, " - ", _size);
+
+        _xs[index] = int16_t(x);
+        _ys[index] = int16_t(y);
+    }
+
+    /**
+     * @brief Sets the position of the center of the specified sprite.
+     */
+    void set_position(int index, const point& position)
+    {
+        set_position(index, position.x(), position.y());
+    }
+
+    /**
+     * @brief Returns the horizontal positions of all sprites, so they can be updated in a single loop.
+     */
+    [[nodiscard]] span<const int16_t> xs() const
+    {
+        return span<const int16_t>(_xs, _size);
+    }
+
+    /**
+     * @brief Returns the horizontal positions of all sprites, so they can be updated in a single loop.
+     */
+    [[nodiscard]] span<int16_t> xs()
+    {
+        return span<int16_t>(_xs, _size);
+    }
+
+    /**
+     * @brief Returns the vertical positions of all sprites, so they can be updated in a single loop.
+     */
+    [[nodiscard]] span<const int16_t> ys() const
+    {
+        return span<const int16_t>(_ys, _size);
+    }
+
+    /**
+     * @brief Returns the vertical positions of all sprites, so they can be updated in a single loop.
+     */
+    [[nodiscard]] span<int16_t> ys()
+    {
+        return span<int16_t>(_ys, _size);
+    }
+
+    /**
+     * @brief Returns the index in tiles_list() of the tile set referenced by the specified sprite.
+     */
+    [[nodiscard]] int tiles_index(int index) const
+    {
+        BN_ASSERT(index >= 0 && index < _size, "Invalid index: ", index, " - ", _size);
+
+        return _tiles_indexes[index];
+    }
+
+    /**
+     * @brief Sets the index in tiles_list() of the tile set referenced by the specified sprite.
+     */
+    void set_tiles_index(int index, int tiles_index)
+    {
+        BN_ASSERT(index >= 0 && index < _size, "Invalid index: ", index, " - ", _size);
+        BN_ASSERT(tiles_index >= 0 && tiles_index < _tiles_list_ref->size(),
+                  "Invalid tiles index: ", tiles_index, " - ", _tiles_list_ref->size());
+
+        _tiles_indexes[index] = uint8_t(tiles_index);
+    }
+
+    /**
+     * @brief Returns the indexes in tiles_list() of the tile sets referenced by all sprites.
+     */
+    [[nodiscard]] span<const uint8_t> tiles_indexes() const
+    {
+        return span<const uint8_t>(_tiles_indexes, _size);
+    }
+
+    /**
+     * @brief Indicates if the specified sprite is flipped in the horizontal axis or not.
+     */
+    [[nodiscard]] bool horizontal_flip(int index) const
+    {
+        BN_ASSERT(index >= 0 && index < _size, "Invalid index: ", index, " - ", _size);
+
+        return _flags[index] & horizontal_flip_flag;
+    }
+
+    /**
+     * @brief Sets if the specified sprite must be flipped in the horizontal axis or not.
+     */
+    void set_horizontal_flip(int index, bool horizontal_flip)
+    {
+        _set_flag(index, horizontal_flip_flag, horizontal_flip);
+    }
+
+    /**
+     * @brief Indicates if the specified sprite is flipped in the vertical axis or not.
+     */
+    [[nodiscard]] bool vertical_flip(int index) const
+    {
+        BN_ASSERT(index >= 0 && index < _size, "Invalid index: ", index, " - ", _size);
+
+        return _flags[index] & vertical_flip_flag;
+    }
+
+    /**
+     * @brief Sets if the specified sprite must be flipped in the vertical axis or not.
+     */
+    void set_vertical_flip(int index, bool vertical_flip)
+    {
+        _set_flag(index, vertical_flip_flag, vertical_flip);
+    }
+
+    /**
+     * @brief Returns the flags of all sprites (a combination of horizontal_flip_flag and vertical_flip_flag).
+     */
+    [[nodiscard]] span<const uint8_t> flags() const
+    {
+        return span<const uint8_t>(_flags, _size);
+    }
+
+    /**
+     * @brief Inserts a sprite at the end of the batch.
+     * @param x Horizontal position of the center of the new sprite.
+     * @param y Vertical position of the center of the new sprite.
+     * @param tiles_index Index in tiles_list() of the tile set referenced by the new sprite.
+     */
+    void push_back(int x, int y, int tiles_index = 0);
+
+    /**
+     * @brief Inserts a sprite at the end of the batch.
+     * @param position Position of the center of the new sprite.
+     * @param tiles_index Index in tiles_list() of the tile set referenced by the new sprite.
+     */
+    void push_back(const point& position, int tiles_index = 0)
+    {
+        push_back(position.x(), position.y(), tiles_index);
+    }
+
+    /**
+     * @brief Removes the last sprite of the batch.
+     */
+    void pop_back()
+    {
+        BN_ASSERT(_size, "Batch is empty");
+
+        --_size;
+    }
+
+    /**
+     * @brief Removes the specified sprite, replacing it with the last sprite of the batch.
+     *
+     * The order of the sprites is not preserved, but no other sprite is moved.
+     */
+    void erase(int index);
+
+    /**
+     * @brief Removes all sprites of the batch.
+     */
+    void clear()
+    {
+        _size = 0;
+    }
+
+    /**
+     * @brief Flag which indicates that a sprite is flipped in the horizontal axis.
+     */
+    static constexpr uint8_t horizontal_flip_flag = 1;
+
+    /**
+     * @brief Flag which indicates that a sprite is flipped in the vertical axis.
+     */
+    static constexpr uint8_t vertical_flip_flag = 2;
+
+protected:
+    /// @cond DO_NOT_DOCUMENT
+
+    isprite_batch(const sprite_item& item, ivector<sprite_tiles_ptr>& tiles_list, int16_t* xs, int16_t* ys,
+                  uint8_t* tiles_indexes, uint8_t* flags, int max_size);
+
+    isprite_batch(const sprite_shape_size& shape_size, const sprite_palette_ptr& palette,
+                  ivector<sprite_tiles_ptr>& tiles_list, int16_t* xs, int16_t* ys, uint8_t* tiles_indexes,
+                  uint8_t* flags, int max_size);
+
+    void _assign_tiles_list(const sprite_item& item);
+
+    void _assign_tiles_list(const span<const sprite_tiles_ptr>& tiles_list);
+
+    /// @endcond
+
+private:
+    ivector<sprite_tiles_ptr>* _tiles_list_ref;
+    int16_t* _xs;
+    int16_t* _ys;
+    uint8_t* _tiles_indexes;
+    uint8_t* _flags;
+    optional<camera_ptr> _camera;
+    sprite_palette_ptr _palette;
+    sprite_shape_size _shape_size;
+    int _size = 0;
+    int _max_size;
+    uint8_t _bg_priority = 3;
+    bool _blending_enabled = false;
+    bool _visible = true;
+
+    void _set_flag(int index, uint8_t flag, bool enabled)
+    {
+        BN_ASSERT(index >= 0 && index < _size, "Invalid index: ", index, " - ", _size);
+
+        if(enabled)
+        {
+            _flags[index] |= flag;
+        }
+        else
+        {
+            _flags[index] &= uint8_t(~flag);
+        }
+    }
+};
+
+
+/**
+ * @brief Stores lots of sprites with the same shape, size and color palette in a struct of arrays,
+ * so they can be updated and committed to the GBA much faster than sprite_ptr objects.
+ *
+ * Sprites in a batch are rebuilt in a single pass every frame, so they are useful for particles and bullets.
+ *
+ * Batches are not integrated with the sprites sorter: they are committed to OAM after all sprite_ptr objects,
+ * in creation order, ignoring z orders.
+ * Therefore, sprites in a batch are drawn below all sprite_ptr objects with the same background priority,
+ * and below the sprites of batches created before it.
+ *
+ * Sprites which don't fit in OAM are not shown.
+ *
+ * Sprite batches are not supported when sprites multiplexing is enabled.
+ *
+ * @tparam MaxSize Maximum number of sprites that can be stored in the batch.
+ * @tparam MaxTilesCount Maximum number of tile sets that can be referenced by the sprites in the batch.
+ *
+ * @ingroup sprite
+ */
+template<int MaxSize, int MaxTilesCount = 1>
+class sprite_batch : public isprite_batch
+{
+    static_assert(MaxSize > 0 && MaxSize <= 32767);
+    static_assert(MaxTilesCount > 0 && MaxTilesCount <= 256);
+    static_assert(MaxSize > 0 && BN_CFG_SPRITES_MAX_BATCHES > 0,
+                  "Sprite batches are disabled (see BN_CFG_SPRITES_MAX_BATCHES)");
+
+public:
+    /**
+     * @brief Constructor.
+     * @param item sprite_item used to create the tile sets (one per graphic) and the color palette of the batch.
+     */
+    explicit sprite_batch(const sprite_item& item) :
+        isprite_batch(item, _tiles_list, _xs, _ys, _tiles_indexes, _flags, MaxSize)
+    {
+        this->_assign_tiles_list(item);
+    }
+
+    /**
+     * @brief Constructor.
+     * @param shape_size Shape and size of all sprites in the batch.
+     * @param tiles_list Tile sets that can be referenced by the sprites in the batch.
+     * @param palette Color palette used by all sprites in the batch.
+     */
+    sprite_batch(const sprite_shape_size& shape_size, const span<const sprite_tiles_ptr>& tiles_list,
+                 const sprite_palette_ptr& palette) :
+        isprite_batch(shape_size, palette, _tiles_list, _xs, _ys, _tiles_indexes, _flags, MaxSize)
+    {
+        this->_assign_tiles_list(tiles_list);
+    }
+
+private:
+    vector<sprite_tiles_ptr, MaxTilesCount> _tiles_list;
+    int16_t _xs[MaxSize];
+    int16_t _ys[MaxSize];
+    uint8_t _tiles_indexes[MaxSize];
+    uint8_t _flags[MaxSize];
+};
+
+}
+
+#endif
@@ -0,0 +1,218 @@
+/*
+ * Copyright (c) 2020-2025 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_SPRITE_TEXT_H
+#define BN_SPRITE_TEXT_H
+
+/**
+ * @file
+ * bn::isprite_text and bn::sprite_text implementation header file.
+ *
+ * @ingroup sprite
+ * @ingroup text
+ */
+
+#include "bn_sprite_ptr.h"
+#include "bn_sprite_palette_ptr.h"
+#include "bn_sprite_text_generator.h"
+
+namespace bn
+{
+
+/**
+ * @brief Base class of sprite_text.
+ *
+ * It keeps text drawn in sprites and, when the text is replaced,
+ * only redraws in place the tiles of the characters which have changed.
+ *
+ * Sprites and tiles are kept between text replacements: they are only created or destroyed
+ * when the text needs more or less sprites than before.
+ *
+ * Fonts with characters up to 16x16 pixels are supported.
+ *
+ * @ingroup sprite
+ * @ingroup text
+ */
+class isprite_text
+{
+
+public:
+    isprite_text(const isprite_text& other) = delete;
+
+    isprite_text& operator=(const isprite_text& other) = delete;
+
+    /**
+     * @brief Returns the sprite text generator whose properties are used to create the sprites.
+     */
+    [[nodiscard]] const sprite_text_generator& generator() const
+    {
+        return _generator;
+    }
+
+    /**
+     * @brief Returns the sprites which show the text.
+     */
+    [[nodiscard]] const ivector<sprite_ptr>& sprites() const
+    {
+        return _sprites;
+    }
+
+    /**
+     * @brief Returns the maximum number of sprites that can show the text.
+     */
+    [[nodiscard]] int max_sprites() const
+    {
+        return _max_sprites;
+    }
+
+    /**
+     * @brief Returns the width in pixels of the text.
+     */
+    [[nodiscard]] int width() const
+    {
+        return _width;
+    }
+
+    /**
+     * @brief Returns the position of the text (see alignment()).
+     */
+    [[nodiscard]] const fixed_point& position() const
+    {
+        return _position;
+    }
+
+    /**
+     * @brief Sets the position of the text (see alignment()).
+     * @param x Horizontal position of the text.
+     * @param y Vertical position of the text.
+     */
+    void set_position(fixed x, fixed y)
+    {
+        set_position(fixed_point(x, y));
+    }
+
+    /**
+     * @brief Sets the position of the text (see alignment()).
+     * @param position Position of the text.
+     */
+    void set_position(const fixed_point& position);
+
+    /**
+     * @brief Returns the horizontal alignment of the text.
+     */
+    [[nodiscard]] sprite_text_generator::alignment_type alignment() const
+    {
+        return _generator.alignment();
+    }
+
+    /**
+     * @brief Sets the horizontal alignment of the text.
+     */
+    void set_alignment(sprite_text_generator::alignment_type alignment);
+
+    /**
+     * @brief Replaces the text.
+     *
+     * Only the tiles of the characters which differ from the previous text are redrawn.
+     *
+     * @param text New text to show.
+     */
+    void set_text(const string_view& text);
+
+    /**
+     * @brief Returns the number of tiles redrawn in the last set_text call.
+     */
+    [[nodiscard]] int last_redrawn_tiles_count() const
+    {
+        return _last_redrawn_tiles_count;
+    }
+
+protected:
+    /// @cond DO_NOT_DOCUMENT
+
+    class character_type
+    {
+
+    public:
+        int16_t column;
+        int16_t graphics_index;
+        int16_t width;
+    };
+
+    isprite_text(const sprite_text_generator& generator, const fixed_point& position, ivector<sprite_ptr>& sprites,
+                 tile** sprite_tiles_ptr, character_type* characters_ptr, bool* dirty_columns_ptr, int max_sprites);
+
+    /// @endcond
+
+private:
+    sprite_text_generator _generator;
+    sprite_palette_ptr _palette;
+    fixed_point _position;
+    ivector<sprite_ptr>& _sprites;
+    tile** _sprite_tiles_ptr;
+    character_type* _characters_ptr;
+    bool* _dirty_columns_ptr;
+    int _max_sprites;
+    int _characters_count = 0;
+    int _width = 0;
+    int _last_redrawn_tiles_count = 0;
+
+    void _update_positions();
+
+    void _redraw_column(int column);
+};
+
+
+/**
+ * @brief Keeps text drawn in sprites and, when the text is replaced,
+ * only redraws in place the tiles of the characters which have changed.
+ *
+ * See isprite_text for more information.
+ *
+ * @tparam MaxSprites Maximum number of sprites that can show the text.
+ *
+ * @ingroup sprite
+ * @ingroup text
+ */
+template<int MaxSprites>
+class sprite_text : public isprite_text
+{
+    static_assert(MaxSprites > 0 && MaxSprites <= 128);
+
+public:
+    /**
+     * @brief Constructor.
+     * @param generator Sprite text generator whose properties are used to create the sprites.
+     * @param position Position of the text (see alignment()).
+     * @param text Text to show.
+     */
+    sprite_text(const sprite_text_generator& generator, const fixed_point& position, const string_view& text) :
+        isprite_text(generator, position, _sprites, _sprite_tiles, _characters, _dirty_columns, MaxSprites)
+    {
+        set_text(text);
+    }
+
+    /**
+     * @brief Constructor.
+     * @param generator Sprite text generator whose properties are used to create the sprites.
+     * @param x Horizontal position of the text (see alignment()).
+     * @param y Vertical position of the text.
+     * @param text Text to show.
+     */
+    sprite_text(const sprite_text_generator& generator, fixed x, fixed y, const string_view& text) :
+        sprite_text(generator, fixed_point(x, y), text)
+    {
+    }
+
+private:
+    vector<sprite_ptr, MaxSprites> _sprites;
+    tile* _sprite_tiles[MaxSprites];
+    character_type _characters[MaxSprites * 32];
+    bool _dirty_columns[MaxSprites * 4] = {};
+};
+
+}
+
+#endif
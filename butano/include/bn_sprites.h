@@ -90,6 +90,44 @@ namespace bn::sprites
      */
     void set_blending_bottom_enabled(bool blending_bottom_enabled);
 
+    /**
+     * @brief Returns the number of on screen sprites that could not be displayed in the last frame
+     * because there were no hardware sprite handles available for them.
+     *
+     * It's always zero if sprites multiplexing is disabled (see @ref BN_CFG_SPRITES_MULTIPLEXING_ENABLED).
+     */
+    [[nodiscard]] int overflow_items_count();
+
+    /**
+     * @brief Returns the number of on screen sprites that could not be displayed in the given scanline
+     * in the last frame because there were no hardware sprite handles available for them.
+     * @param scanline Scanline index in the range [0..display::height()).
+     *
+     * It's always zero if sprites multiplexing is disabled (see @ref BN_CFG_SPRITES_MULTIPLEXING_ENABLED).
+     */
+    [[nodiscard]] int scanline_overflow_items_count(int scanline);
+
+    /**
+     * @brief Returns the number of on screen sprites displayed in the last frame
+     * by reusing the hardware sprite handles of other sprites.
+     *
+     * It's always zero if sprites multiplexing is disabled (see @ref BN_CFG_SPRITES_MULTIPLEXING_ENABLED).
+     */
+    [[nodiscard]] int multiplexed_items_count();
+
+    /**
+     * @brief Returns the number of bytes written to OAM in the last V-Blank.
+     *
+     * Only modified hardware sprite handles are written to OAM.
+     */
+    [[nodiscard]] int last_commit_bytes();
+
+    /**
+     * @brief Returns the number of copies of consecutive hardware sprite handles
+     * done to write them to OAM in the last V-Blank.
+     */
+    [[nodiscard]] int last_commit_runs();
+
     /**
      * @brief Returns the number of hardware sprite handles not used by Butano sprites manager.
      *
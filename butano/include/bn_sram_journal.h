@@ -0,0 +1,241 @@
+/*
+ * Copyright (c) 2020-2025 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_SRAM_JOURNAL_H
+#define BN_SRAM_JOURNAL_H
+
+/**
+ * @file
+ * bn::isram_journal and bn::sram_journal implementation header file.
+ *
+ * @ingroup sram
+ */
+
+#include "bn_sram.h"
+#include "bn_fixed.h"
+#include "bn_type_traits.h"
+#include "bn_config_sram.h"
+
+namespace bn
+{
+
+/**
+ * @brief Base class of bn::sram_journal.
+ *
+ * It stores data in two SRAM slots with a header and a checksum each,
+ * and writes new data in the oldest slot a few bytes per update,
+ * so an interrupted write never corrupts the last completed one.
+ *
+ * @ingroup sram
+ */
+class isram_journal
+{
+
+public:
+    isram_journal(const isram_journal& other) = delete;
+
+    isram_journal& operator=(const isram_journal& other) = delete;
+
+    /**
+     * @brief Returns the size in bytes of the header of each slot.
+     */
+    [[nodiscard]] static constexpr int header_size()
+    {
+        return 16;
+    }
+
+    /**
+     * @brief Returns the size in bytes of the stored data.
+     */
+    [[nodiscard]] int data_size() const
+    {
+        return _data_size;
+    }
+
+    /**
+     * @brief Returns the SRAM offset of the first slot.
+     */
+    [[nodiscard]] int offset() const
+    {
+        return _offset;
+    }
+
+    /**
+     * @brief Returns the size in bytes of each slot (header and data).
+     */
+    [[nodiscard]] int slot_size() const
+    {
+        return header_size() + _data_size;
+    }
+
+    /**
+     * @brief Returns the size in bytes of both slots.
+     */
+    [[nodiscard]] int size() const
+    {
+        return slot_size() * 2;
+    }
+
+    /**
+     * @brief Returns the maximum number of bytes written to SRAM by each update call.
+     */
+    [[nodiscard]] int max_bytes_per_update() const
+    {
+        return _max_bytes_per_update;
+    }
+
+    /**
+     * @brief Sets the maximum number of bytes written to SRAM by each update call.
+     */
+    void set_max_bytes_per_update(int max_bytes_per_update);
+
+    /**
+     * @brief Indicates if there's a write in progress or not.
+     */
+    [[nodiscard]] bool writing() const
+    {
+        return _target_slot >= 0;
+    }
+
+    /**
+     * @brief Returns the number of bytes of the current (or last) write already written to SRAM.
+     */
+    [[nodiscard]] int written_bytes() const
+    {
+        return _written_bytes;
+    }
+
+    /**
+     * @brief Returns the number of bytes written to SRAM by a complete write (header and data).
+     */
+    [[nodiscard]] int total_bytes() const
+    {
+        return slot_size();
+    }
+
+    /**
+     * @brief Returns the progress of the current (or last) write in the range [0..1].
+     */
+    [[nodiscard]] fixed progress() const;
+
+    /**
+     * @brief Indicates if the last write was completed or not.
+     */
+    [[nodiscard]] bool completed() const
+    {
+        return _written_bytes == slot_size();
+    }
+
+    /**
+     * @brief Writes the next bytes of the current write to SRAM, if any.
+     *
+     * It should be called once per frame.
+     */
+    void update();
+
+    /**
+     * @brief Writes all remaining bytes of the current write to SRAM, if any.
+     */
+    void flush();
+
+    /**
+     * @brief Invalidates both slots, so no data can be read until a new write is completed.
+     *
+     * The current write (if any) is canceled.
+     */
+    void clear();
+
+protected:
+    /// @cond DO_NOT_DOCUMENT
+
+    isram_journal(uint8_t* snapshot, int data_size, int offset, int max_bytes_per_update);
+
+    [[nodiscard]] bool _read(void* destination);
+
+    void _write(const void* source);
+
+    /// @endcond
+
+private:
+    uint8_t* _snapshot;
+    int _data_size;
+    int _offset;
+    int _max_bytes_per_update;
+    int _written_bytes = 0;
+    int _target_slot = -1;
+    int _last_slot = -1;
+    unsigned _last_sequence = 0;
+    unsigned _checksum = 0;
+    bool _slots_checked = false;
+
+    [[nodiscard]] int _slot_offset(int slot) const
+    {
+        return _offset + (slot * slot_size());
+    }
+
+    void _write_bytes(int max_bytes);
+
+    [[nodiscard]] bool _read_valid_header(int slot, unsigned& sequence) const;
+
+    void _check_slots();
+};
+
+
+/**
+ * @brief Stores a trivially copyable value in SRAM with two slots, writing it a few bytes per update.
+ *
+ * The value to write is copied into an internal snapshot, so it can be modified while it's being written.
+ *
+ * @tparam Type Type of the stored value. It must be trivially copyable.
+ *
+ * @ingroup sram
+ */
+template<typename Type>
+class sram_journal : public isram_journal
+{
+    static_assert(is_trivially_copyable<Type>(), "Type is not trivially copyable");
+    static_assert((header_size() + int(sizeof(Type))) * 2 <= sram::size(), "Type size is too high");
+
+public:
+    /**
+     * @brief Constructor.
+     * @param offset SRAM offset of the first slot.
+     * @param max_bytes_per_update Maximum number of bytes written to SRAM by each update call.
+     */
+    explicit sram_journal(int offset = 0,
+                          int max_bytes_per_update = BN_CFG_SRAM_JOURNAL_MAX_BYTES_PER_UPDATE) :
+        isram_journal(_snapshot_data, int(sizeof(Type)), offset, max_bytes_per_update)
+    {
+    }
+
+    /**
+     * @brief Copies the last completed write into the given value.
+     * @param destination The last completed write is copied into this value.
+     * @return `true` if there was a valid completed write, otherwise `false`.
+     */
+    [[nodiscard]] bool read(Type& destination)
+    {
+        return _read(&destination);
+    }
+
+    /**
+     * @brief Starts writing the given value into SRAM.
+     *
+     * If there's a write in progress, it is restarted with the given value.
+     *
+     * @param source Value to write.
+     */
+    void write(const Type& source)
+    {
+        _write(&source);
+    }
+
+private:
+    alignas(Type) uint8_t _snapshot_data[sizeof(Type)];
+};
+
+}
+
+#endif
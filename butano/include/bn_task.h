@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2020-2025 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_TASK_H
+#define BN_TASK_H
+
+/**
+ * @file
+ * bn::task header file.
+ *
+ * @ingroup task
+ */
+
+#include <coroutine>
+#include "bn_utility.h"
+
+/// @cond DO_NOT_DOCUMENT
+
+namespace _bn::tasks
+{
+    using ready_type = bool(*)(void* data);
+
+    [[nodiscard]] void* alloc(unsigned bytes);
+
+    void free(void* ptr);
+
+    [[nodiscard]] int create(std::coroutine_handle<> handle, const void* promise);
+
+    void wait(int id, ready_type ready, void* ready_data);
+}
+
+/// @endcond
+
+
+namespace bn
+{
+
+/**
+ * @brief Cooperative task implemented with a C++20 coroutine.
+ *
+ * A function which returns a bn::task and uses `co_await` is a task:
+ *
+ * @code{.cpp}
+ * bn::task move_sprite(bn::sprite_ptr sprite)
+ * {
+ *     bn::sprite_move_to_action action(sprite, 60, 32, 0);
+ *     co_await bn::tasks::update_until_done(action);
+ *     co_await bn::tasks::wait_frames(30);
+ *     sprite.set_visible(false);
+ * }
+ *
+ * bn::task move_task = move_sprite(sprite);
+ * @endcode
+ *
+ * The task runs until its first suspension point when it is created,
+ * and then it is resumed by bn::core::update once its awaited condition is met
+ * (see bn::tasks::next_frame, bn::tasks::wait_frames, bn::tasks::wait_until, bn::tasks::wait_done
+ * and bn::tasks::update_until_done).
+ *
+ * Tasks are resumed at the end of bn::core::update, after the keypad has been updated,
+ * so they run just like code placed after the bn::core::update call of the main loop.
+ *
+ * Coroutine frames are allocated in a fixed pool
+ * (see @ref BN_CFG_TASKS_MAX_ITEMS and @ref BN_CFG_TASKS_MAX_FRAME_SIZE), not in the heap.
+ * The pool is empty by default, so @ref BN_CFG_TASKS_MAX_ITEMS must be greater than 0 to create tasks.
+ *
+ * Destroying a bn::task object destroys its coroutine, even if it has not finished,
+ * so a task must not destroy its own bn::task object.
+ *
+ * @ingroup task
+ */
+class task
+{
+
+public:
+    /**
+     * @brief Coroutine promise type.
+     */
+    class promise_type
+    {
+
+    public:
+        /**
+         * @brief Allocates a coroutine frame in the tasks pool.
+         */
+        [[nodiscard]] static void* operator new(unsigned bytes)
+        {
+            return _bn::tasks::alloc(bytes);
+        }
+
+        /**
+         * @brief Releases a coroutine frame allocated in the tasks pool.
+         */
+        static void operator delete(void* ptr)
+        {
+            _bn::tasks::free(ptr);
+        }
+
+        /**
+         * @brief Returns the task which owns the coroutine.
+         */
+        [[nodiscard]] task get_return_object()
+        {
+            auto handle = std::coroutine_handle<promise_type>::from_promise(*this);
+            _id = _bn::tasks::create(handle, this);
+            return task(handle);
+        }
+
+        /**
+         * @brief Tasks run until their first suspension point when they are created.
+         */
+        [[nodiscard]] std::suspend_never initial_suspend()
+        {
+            return std::suspend_never();
+        }
+
+        /**
+         * @brief Finished tasks are not destroyed until their bn::task object is destroyed.
+         */
+        [[nodiscard]] std::suspend_always final_suspend() noexcept
+        {
+            return std::suspend_always();
+        }
+
+        /**
+         * @brief Called when the task finishes.
+         */
+        void return_void()
+        {
+        }
+
+        /**
+         * @brief Exceptions are not supported.
+         */
+        void unhandled_exception()
+        {
+        }
+
+        /// @cond DO_NOT_DOCUMENT
+
+        void _wait(_bn::tasks::ready_type ready, void* ready_data)
+        {
+            _bn::tasks::wait(_id, ready, ready_data);
+        }
+
+        /// @endcond
+
+    private:
+        int _id = 0;
+    };
+
+    task(const task& other) = delete;
+
+    task& operator=(const task& other) = delete;
+
+    /**
+     * @brief Move constructor.
+     * @param other task to move.
+     */
+    task(task&& other) noexcept :
+        _handle(other._handle)
+    {
+        other._handle = nullptr;
+    }
+
+    /**
+     * @brief Move assignment operator.
+     * @param other task to move.
+     * @return Reference to this.
+     */
+    task& operator=(task&& other) noexcept
+    {
+        bn::swap(_handle, other._handle);
+        return *this;
+    }
+
+    /**
+     * @brief Destroys the coroutine, even if it has not finished.
+     */
+    ~task()
+    {
+        if(_handle)
+        {
+            _handle.destroy();
+        }
+    }
+
+    /**
+     * @brief Indicates if the task has finished or not.
+     */
+    [[nodiscard]] bool done() const
+    {
+        return ! _handle || _handle.done();
+    }
+
+private:
+    std::coroutine_handle<promise_type> _handle;
+
+    explicit task(std::coroutine_handle<promise_type> handle) :
+        _handle(handle)
+    {
+    }
+};
+
+}
+
+#endif
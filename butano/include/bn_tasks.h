@@ -0,0 +1,270 @@
+/*
+ * Copyright (c) 2020-2025 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_TASKS_H
+#define BN_TASKS_H
+
+/**
+ * @file
+ * bn::tasks header file.
+ *
+ * @ingroup task
+ */
+
+#include "bn_task.h"
+
+/**
+ * @brief Tasks related functions and awaitable conditions.
+ *
+ * @ingroup task
+ */
+namespace bn::tasks
+{
+    /**
+     * @brief Returns the number of alive tasks.
+     */
+    [[nodiscard]] int used_items_count();
+
+    /**
+     * @brief Returns the number of tasks that can be created.
+     */
+    [[nodiscard]] int available_items_count();
+
+
+    /**
+     * @brief Suspends the awaiting task until the next bn::core::update call.
+     *
+     * @ingroup task
+     */
+    class next_frame
+    {
+
+    public:
+        /// @cond DO_NOT_DOCUMENT
+
+        [[nodiscard]] bool await_ready() const
+        {
+            return false;
+        }
+
+        void await_suspend(std::coroutine_handle<task::promise_type> handle)
+        {
+            handle.promise()._wait(nullptr, nullptr);
+        }
+
+        void await_resume() const
+        {
+        }
+
+        /// @endcond
+    };
+
+
+    /**
+     * @brief Suspends the awaiting task for the given number of bn::core::update calls.
+     *
+     * @ingroup task
+     */
+    class wait_frames
+    {
+
+    public:
+        /**
+         * @brief Constructor.
+         * @param frames Number of bn::core::update calls to wait.
+         * If it is less than 1, the awaiting task is not suspended.
+         */
+        constexpr explicit wait_frames(int frames) :
+            _frames(frames)
+        {
+        }
+
+        /// @cond DO_NOT_DOCUMENT
+
+        [[nodiscard]] bool await_ready() const
+        {
+            return _frames <= 0;
+        }
+
+        void await_suspend(std::coroutine_handle<task::promise_type> handle)
+        {
+            handle.promise()._wait(&_ready, this);
+        }
+
+        void await_resume() const
+        {
+        }
+
+        /// @endcond
+
+    private:
+        int _frames;
+
+        [[nodiscard]] static bool _ready(void* data)
+        {
+            auto awaiter = static_cast<wait_frames*>(data);
+            --awaiter->_frames;
+            return awaiter->_frames <= 0;
+        }
+    };
+
+
+    /**
+     * @brief Suspends the awaiting task until the given predicate returns `true`.
+     *
+     * The predicate is evaluated once per bn::core::update call.
+     *
+     * @tparam Predicate Callable object type which returns a `bool`.
+     *
+     * @ingroup task
+     */
+    template<typename Predicate>
+    class wait_until
+    {
+
+    public:
+        /**
+         * @brief Constructor.
+         * @param predicate Callable object which returns `true` when the awaiting task must be resumed.
+         * If it returns `true` when the task starts to wait, the awaiting task is not suspended.
+         */
+        constexpr explicit wait_until(const Predicate& predicate) :
+            _predicate(predicate)
+        {
+        }
+
+        /// @cond DO_NOT_DOCUMENT
+
+        [[nodiscard]] bool await_ready()
+        {
+            return _predicate();
+        }
+
+        void await_suspend(std::coroutine_handle<task::promise_type> handle)
+        {
+            handle.promise()._wait(&_ready, this);
+        }
+
+        void await_resume() const
+        {
+        }
+
+        /// @endcond
+
+    private:
+        Predicate _predicate;
+
+        [[nodiscard]] static bool _ready(void* data)
+        {
+            return static_cast<wait_until*>(data)->_predicate();
+        }
+    };
+
+
+    /**
+     * @brief Suspends the awaiting task until the given object is done (another task, an action, etc).
+     *
+     * The object is not updated by the awaiting task, only its `done()` method is called
+     * once per bn::core::update call.
+     *
+     * @tparam Type Type of the object to wait for.
+     *
+     * @ingroup task
+     */
+    template<typename Type>
+    class wait_done
+    {
+
+    public:
+        /**
+         * @brief Constructor.
+         * @param object Object to wait for. It must outlive the wait.
+         */
+        constexpr explicit wait_done(const Type& object) :
+            _object(&object)
+        {
+        }
+
+        /// @cond DO_NOT_DOCUMENT
+
+        [[nodiscard]] bool await_ready() const
+        {
+            return _object->done();
+        }
+
+        void await_suspend(std::coroutine_handle<task::promise_type> handle)
+        {
+            handle.promise()._wait(&_ready, this);
+        }
+
+        void await_resume() const
+        {
+        }
+
+        /// @endcond
+
+    private:
+        const Type* _object;
+
+        [[nodiscard]] static bool _ready(void* data)
+        {
+            return static_cast<wait_done*>(data)->_object->done();
+        }
+    };
+
+
+    /**
+     * @brief Updates the given action once per bn::core::update call
+     * and suspends the awaiting task until it is done.
+     *
+     * @tparam Action Type of the action to update.
+     *
+     * @ingroup task
+     */
+    template<typename Action>
+    class update_until_done
+    {
+
+    public:
+        /**
+         * @brief Constructor.
+         * @param action Action to update. It must outlive the wait.
+         */
+        constexpr explicit update_until_done(Action& action) :
+            _action(&action)
+        {
+        }
+
+        /// @cond DO_NOT_DOCUMENT
+
+        [[nodiscard]] bool await_ready() const
+        {
+            return _action->done();
+        }
+
+        void await_suspend(std::coroutine_handle<task::promise_type> handle)
+        {
+            handle.promise()._wait(&_ready, this);
+        }
+
+        void await_resume() const
+        {
+        }
+
+        /// @endcond
+
+    private:
+        Action* _action;
+
+        [[nodiscard]] static bool _ready(void* data)
+        {
+            Action* action = static_cast<update_until_done*>(data)->_action;
+            action->update();
+            return action->done();
+        }
+    };
+}
+
+#endif
@@ -78,6 +78,24 @@ namespace bn
     using std::remove_cv;
     using std::remove_cv_t;
 
+    using std::remove_cvref;
+    using std::remove_cvref_t;
+
+    using std::is_void;
+    using std::is_void_v;
+
+    using std::is_function;
+    using std::is_function_v;
+
+    using std::is_pointer;
+    using std::is_pointer_v;
+
+    using std::is_member_pointer;
+    using std::is_member_pointer_v;
+
+    using std::is_invocable_r;
+    using std::is_invocable_r_v;
+
     using std::is_constant_evaluated;
 }
 
@@ -13,11 +13,11 @@
  * @ingroup core
  */
 
-#include "bn_common.h"
+#include "bn_inplace_function.h"
 
 namespace bn
 {
-    using vblank_callback_type = void(*)(); //!< V-Blank callback type alias.
+    using vblank_callback_type = inplace_function<void()>; //!< V-Blank callback type alias.
 }
 
 #endif
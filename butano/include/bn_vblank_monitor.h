@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2020-2025 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_VBLANK_MONITOR_H
+#define BN_VBLANK_MONITOR_H
+
+/**
+ * @file
+ * bn::vblank_monitor header file.
+ *
+ * @ingroup core
+ */
+
+#include "bn_timers.h"
+#include "bn_optional.h"
+#include "bn_deque_fwd.h"
+#include "bn_string_view.h"
+#include "bn_config_vblank_monitor.h"
+
+#if BN_CFG_VBLANK_MONITOR_ENABLED || BN_DOXYGEN
+
+/**
+ * @brief Records how much V-Blank time is spent by each commit stage of core::update.
+ *
+ * @ingroup core
+ */
+namespace bn::vblank_monitor
+{
+    /**
+     * @brief Commit stages of core::update, in execution order.
+     */
+    enum class stage : uint8_t
+    {
+        AUDIO_COMMANDS, //!< Audio commands execution (and H-Blank effects disabling).
+        DISPLAY, //!< Display registers commit.
+        SPRITES, //!< Sprites OAM commit.
+        BGS, //!< Backgrounds registers commit.
+        PALETTES, //!< Color palettes commit.
+        SPRITE_TILES_UNCOMPRESSED, //!< Uncompressed sprite tiles commit.
+        HDMA, //!< HDMA update and commit.
+        HBLANK_EFFECTS, //!< H-Blank effects commit.
+        BIG_MAPS, //!< Big background maps commit.
+        BG_BLOCKS_UNCOMPRESSED, //!< Uncompressed background tiles and maps commit.
+        SPRITE_TILES_COMPRESSED, //!< Compressed sprite tiles commit.
+        BG_BLOCKS_COMPRESSED, //!< Compressed background tiles and maps commit.
+        VBLANK_CALLBACK, //!< User V-Blank callback.
+    };
+
+    /**
+     * @brief Returns the number of commit stages.
+     */
+    [[nodiscard]] constexpr int stages_count()
+    {
+        return int(stage::VBLANK_CALLBACK) + 1;
+    }
+
+    /**
+     * @brief Returns the name of the given commit stage.
+     */
+    [[nodiscard]] string_view stage_name(stage commit_stage);
+
+
+    /**
+     * @brief Contains the V-Blank timer ticks spent by each commit stage in a frame.
+     *
+     * @ingroup core
+     */
+    class frame_record
+    {
+
+    public:
+        /**
+         * @brief Default constructor.
+         */
+        frame_record() = default;
+
+        /**
+         * @brief Constructor.
+         * @param frame_index Index of the recorded frame (number of core::update calls before it).
+         * @param stage_end_ticks V-Blank timer ticks elapsed at the end of each commit stage.
+         */
+        frame_record(int frame_index, const int (&stage_end_ticks)[stages_count()]);
+
+        /**
+         * @brief Returns the index of the recorded frame (number of core::update calls before it).
+         */
+        [[nodiscard]] int frame_index() const
+        {
+            return _frame_index;
+        }
+
+        /**
+         * @brief Returns the V-Blank timer ticks spent by the given commit stage.
+         */
+        [[nodiscard]] int stage_ticks(stage commit_stage) const
+        {
+            return _stage_ticks[int(commit_stage)];
+        }
+
+        /**
+         * @brief Returns the V-Blank timer ticks spent by all commit stages.
+         */
+        [[nodiscard]] int ticks() const
+        {
+            return _ticks;
+        }
+
+        /**
+         * @brief Indicates if the commit stages exceeded the V-Blank period (timers::ticks_per_vblank()) or not.
+         */
+        [[nodiscard]] bool overrun() const
+        {
+            return _ticks > timers::ticks_per_vblank();
+        }
+
+        /**
+         * @brief Returns the commit stage which was running when the V-Blank period was exceeded.
+         */
+        [[nodiscard]] stage overrun_stage() const;
+
+        /**
+         * @brief Returns the commit stage which spent the most V-Blank timer ticks.
+         */
+        [[nodiscard]] stage max_stage() const;
+
+    private:
+        int _frame_index = 0;
+        int _ticks = 0;
+        int _stage_ticks[stages_count()] = {};
+    };
+
+
+    /**
+     * @brief Returns the last recorded frames, from the oldest to the newest one.
+     */
+    [[nodiscard]] const ideque<frame_record>& frames();
+
+    /**
+     * @brief Returns the number of recorded frames which exceeded the V-Blank period.
+     */
+    [[nodiscard]] int overruns_count();
+
+    /**
+     * @brief Returns the last recorded frame which exceeded the V-Blank period, if any.
+     *
+     * It is not discarded when newer frames are recorded.
+     */
+    [[nodiscard]] const optional<frame_record>& last_overrun();
+
+    /**
+     * @brief Forgets all recorded frames.
+     */
+    void reset();
+
+    /**
+     * @brief Prints the last recorded frame which exceeded the V-Blank period and the last recorded frames
+     * with BN_LOG.
+     *
+     * Log must be enabled to print anything.
+     */
+    void log();
+}
+
+/// @cond DO_NOT_DOCUMENT
+
+namespace _bn::vblank_monitor
+{
+    void add_frame(const int (&stage_end_ticks)[bn::vblank_monitor::stages_count()]);
+}
+
+/// @endcond
+
+#endif
+
+#endif
@@ -266,6 +266,8 @@
  * (`true` by default).
  * * `"big"`: optional boolean field which specifies if maps generated with this item are big or not.
  *    If this field is omitted, big maps are generated only if needed.
+ * * `"tiles_bank"`: optional field which specifies the name of the tiles bank shared with other regular backgrounds
+ *   (see @ref import_regular_bg_tiles_bank "below").
  * * `"tiles_compression"`: optional field which specifies the compression of the tiles data:
  *   * `"none"`: uncompressed data (this is the default option).
  *   * `"lz77"`: LZ77 compressed data.
@@ -280,7 +282,9 @@
  *   * `"huffman"`: Huffman compressed data.
  *   * `"auto"`: uses the option which gives the smallest data size.
  *   * `"auto_no_huffman"`: uses the option which gives the smallest data size, excluding "huffman".
- * * `"map_compression"`: optional field which specifies the compression of the map data:
+ * * `"map_compression"`: optional field which specifies the compression of the map data
+ *   (compressed big maps are split in chunks of 32x32 cells compressed independently, so "huffman" is not supported
+ *   and @ref BN_CFG_BG_BLOCKS_MAX_MAP_CHUNKS must be greater than zero):
  *   * `"none"`: uncompressed data (this is the default option).
  *   * `"lz77"`: LZ77 compressed data.
  *   * `"run_length"`: run-length compressed data.
@@ -309,6 +313,23 @@
  * bn::regular_bg_ptr regular_bg = bn::regular_bg_items::image.create_bg(0, 0);
  * @endcode
  *
+ * @anchor import_regular_bg_tiles_bank
+ * Regular backgrounds with the same `"tiles_bank"` name are converted together,
+ * so tiles and colors shared by them are stored only once in ROM and in VRAM:
+ * * Repeated tiles are removed across all of them, including horizontally and vertically flipped ones.
+ * * The colors of all tiles are packed in the smallest number of 16 color palettes,
+ *   merging the palettes of different backgrounds when they fit together.
+ *
+ * For example, from two files named `forest_day.bmp` and `forest_night.bmp`
+ * with `"tiles_bank": "forest"` in their `*.json` files,
+ * a header file named `bn_regular_bg_tiles_items_forest.h` is generated in the `build` folder
+ * with the shared bn::regular_bg_tiles_item and bn::bg_palette_item (`forest` and `forest_palette`),
+ * and `bn_regular_bg_items_forest_day.h` and `bn_regular_bg_items_forest_night.h` contain only their maps.
+ *
+ * Backgrounds of a tiles bank must be 16 color images with up to 15 opaque colors per tile
+ * (the first color of the image palette is the transparent one) and the same `"tiles_compression"`.
+ * `"palette_item"`, `"huffman"` compression and compressed big maps are not supported by tiles banks.
+ *
  *
  * @subsection import_regular_bg_tiles Regular background tiles
  *
@@ -361,6 +382,51 @@
  * @endcode
  *
  *
+ * @subsection import_regular_bg_streamed Streamed regular backgrounds
+ *
+ * Big regular backgrounds which keep in VRAM only the tiles referenced by their visible part
+ * can have up to 65534 tiles.
+ *
+ * An example of the `*.json` files required for streamed regular backgrounds is the following:
+ *
+ * @code{.json}
+ * {
+ *     "type": "regular_bg_streamed"
+ * }
+ * @endcode
+ *
+ * The fields for streamed regular backgrounds are the following:
+ * * `"type"`: must be `"regular_bg_streamed"` for streamed regular backgrounds.
+ * * `"colors_count"`: optional field which specifies the background palette size [1..256].
+ * * `"bpp_mode"`: optional field which specifies the bits per pixel of the streamed regular background:
+ *   * `"bpp_8"`: up to 256 colors.
+ *   * `"bpp_4"`: up to 16 colors per @ref tile "tile".
+ * Butano expects that the image color palette is already valid for this mode.
+ * * `"repeated_tiles_reduction"`: optional field which specifies if repeated tiles must be reduced or not
+ *   (`true` by default).
+ * * `"flipped_tiles_reduction"`: optional field which specifies if flipped tiles must be reduced or not
+ *   (`true` by default).
+ *
+ * Streamed regular backgrounds must be big, and their data can't be compressed.
+ *
+ * If the conversion process has finished successfully,
+ * a bn::regular_bg_streamed_item should have been generated in the `build` folder.
+ *
+ * For example, from two files named `image.bmp` and `image.json`,
+ * a header file named `bn_regular_bg_streamed_items_image.h` is generated in the `build` folder.
+ *
+ * The tiles cache must be big enough to hold all unique tiles referenced by any 32x32 cells area of the map,
+ * and it must be able to index all the tiles of the streamed regular background:
+ *
+ * @code{.cpp}
+ * #include "bn_regular_bg_tiles_cache.h"
+ * #include "bn_regular_bg_streamed_items_image.h"
+ *
+ * bn::regular_bg_tiles_cache<512, 4096> tiles_cache;
+ * bn::regular_bg_ptr regular_bg = bn::regular_bg_streamed_items::image.create_bg(0, 0, tiles_cache);
+ * @endcode
+ *
+ *
  * @subsection import_affine_bg Affine backgrounds
  *
  * An image file can contain multiple affine backgrounds.
@@ -403,7 +469,9 @@
  *   * `"huffman"`: Huffman compressed data.
  *   * `"auto"`: uses the option which gives the smallest data size.
  *   * `"auto_no_huffman"`: uses the option which gives the smallest data size, excluding "huffman".
- * * `"map_compression"`: optional field which specifies the compression of the map data:
+ * * `"map_compression"`: optional field which specifies the compression of the map data
+ *   (compressed big maps are split in chunks of 32x32 cells compressed independently, so "huffman" is not supported
+ *   and @ref BN_CFG_BG_BLOCKS_MAX_MAP_CHUNKS must be greater than zero):
  *   * `"none"`: uncompressed data (this is the default option).
  *   * `"lz77"`: LZ77 compressed data.
  *   * `"run_length"`: run-length compressed data.
@@ -519,6 +587,71 @@
  * @endcode
  *
  *
+ * @subsection import_hbe_tables H-Blank effect tables
+ *
+ * Static or looping @ref hblank_effect "H-Blank effects" (like waves, perspective or parallax effects)
+ * don't need to compute their values at runtime: they can be generated by the assets conversion tools instead.
+ *
+ * H-Blank effect tables don't need an image file: a `*.json` file without a `*.bmp` file
+ * with the same name is enough. An example of the `*.json` files required for them is the following:
+ *
+ * @code{.json}
+ * {
+ *     "type": "hbe_tables",
+ *     "effect": "wave",
+ *     "amplitude": 4,
+ *     "period": 32,
+ *     "frames": 16
+ * }
+ * @endcode
+ *
+ * The fields for H-Blank effect tables are the following:
+ * * `"type"`: must be `"hbe_tables"` for H-Blank effect tables.
+ * * `"effect"`: specifies how the values of each table are generated:
+ *   * `"wave"`: sine wave. `"amplitude"` specifies the maximum value,
+ *     `"period"` the number of screen lines of each cycle (160 by default)
+ *     and each table is the previous one shifted by 1 / `"frames"` cycles.
+ *   * `"parallax"`: `"bands"` specifies an array of bands with the number of screen `"lines"` of each one
+ *     (160 lines in total), their initial `"value"` and how much it is incremented in each table (`"speed"`).
+ *   * `"perspective"`: one table with `"scale"` / (line - `"horizon"`) values below the `"horizon"` line
+ *     and `"sky_value"` (0 by default) above it.
+ *   * `"values"`: `"values"` specifies an array of tables with 160 values each.
+ * * `"frames"`: optional field which specifies the number of generated tables (1 by default).
+ * * `"value_type"`: optional field which specifies the type of the generated values:
+ *   * `"fixed"`: bn::fixed values, like the deltas of bn::regular_bg_position_hbe_ptr (this is the default option).
+ *   * `"int"`: `int` values, like the ones of bn::affine_bg_dx_register_hbe_ptr.
+ *   * `"int16"`: `int16_t` values, like the ones of bn::affine_bg_pa_register_hbe_ptr.
+ * * `"fractional_bits"`: optional field which specifies the number of fractional bits
+ *   of `"int"` and `"int16"` values (0 by default, 8 for affine registers).
+ *
+ * If the conversion process has finished successfully,
+ * a bn::hbe_tables_item should have been generated in the `build` folder.
+ *
+ * For example, from a file named `wave.json`,
+ * a header file named `bn_hbe_tables_items_wave.h` is generated in the `build` folder.
+ *
+ * The generated tables are stored in ROM, so they can be referenced directly by a H-Blank effect.
+ * Animating them only requires swapping the referenced table with an action like
+ * bn::hbe_deltas_tables_animate_action or bn::hbe_values_tables_animate_action:
+ *
+ * @code{.cpp}
+ * #include "bn_hbe_tables_animate_actions.h"
+ * #include "bn_hbe_tables_items_wave.h"
+ *
+ * bn::regular_bg_position_hbe_ptr wave_hbe = bn::regular_bg_position_hbe_ptr::create_horizontal(
+ *         bg, bn::hbe_tables_items::wave.table(0));
+ * bn::hbe_deltas_tables_animate_action<bn::regular_bg_position_hbe_ptr> wave_action =
+ *         bn::hbe_deltas_tables_animate_action<bn::regular_bg_position_hbe_ptr>::forever(
+ *             wave_hbe, 1, bn::hbe_tables_items::wave);
+ *
+ * while(true)
+ * {
+ *     wave_action.update();
+ *     bn::core::update();
+ * }
+ * @endcode
+ *
+ *
  * @section import_audio Audio
  *
  * By default audio files played with Direct Sound channels go into the `audio` folder of your project,
@@ -12,6 +12,76 @@
  * @tableofcontents
  *
  *
+ * @section changelog_18_8_0 18.8.0 (next release)
+ *
+ * * Profiler code blocks can be nested and measured with @ref BN_PROFILER_SCOPE.
+ * * bn::profiler::log added.
+ * * Profiler results screen shows exclusive ticks, so nested entries don't add up to more than 100%.
+ * * Compressed sprite tiles and background tiles and maps can be decompressed outside V-Blank
+ *   (see @ref BN_CFG_SPRITE_TILES_STAGING_BUFFER_SIZE and @ref BN_CFG_BG_BLOCKS_STAGING_BUFFER_SIZE).
+ * * `ready` method added to sprite tiles and background tiles and maps pointers.
+ * * bn::best_fit_allocator segregated fit mode added.
+ * * EWRAM heap allocator can work in segregated fit mode (see @ref BN_CFG_EWRAM_HEAP_SEGREGATED_FIT).
+ * * More than 128 sprites can be displayed at the same time with sprites multiplexing
+ *   (see @ref BN_CFG_SPRITES_MULTIPLEXING_ENABLED).
+ * * bn::sprites::overflow_items_count, bn::sprites::scanline_overflow_items_count
+ *   and bn::sprites::multiplexed_items_count added.
+ * * Only modified hardware sprite handles are written to OAM, coalesced in as few copies as possible.
+ * * bn::sprites::last_commit_bytes and bn::sprites::last_commit_runs added.
+ * * Hardware sprite handles can be updated incrementally when the order of a visible sprite is changed
+ *   or when a visible sprite is hidden or destroyed (see @ref BN_CFG_SPRITES_INCREMENTAL_SORT_ENABLED).
+ * * bn::sram_journal added: it writes data into SRAM a few bytes per frame without corrupting the last save
+ *   if the write is interrupted.
+ * * H-Blank effect tables can be generated by the assets conversion tools (see @ref import_hbe_tables).
+ * * bn::hbe_tables_item, bn::hbe_deltas_tables_animate_action and bn::hbe_values_tables_animate_action added.
+ * * Converted assets are cached by content, so touched or restored files are not converted again.
+ *   By default the cache is shared by all projects and it is stored in the folder specified by the
+ *   `BN_ASSETS_CACHE` environment variable or in `~/.butano_assets_cache`.
+ *   The `ASSETSCACHE` makefile variable specifies another folder, `build` for a cache per build folder
+ *   or `none` to disable it. Remove the cache folder to clear it.
+ * * bn::vblank_monitor added: it records the V-Blank usage of each commit stage and reports the frames
+ *   which exceeded the V-Blank period (see @ref BN_CFG_VBLANK_MONITOR_ENABLED).
+ * * Big regular BG maps can keep in VRAM only the tiles referenced by their visible part
+ *   with bn::regular_bg_map_ptr::create_streamed and bn::regular_bg_tiles_cache.
+ *   The new `regular_bg_streamed` graphics type generates a bn::regular_bg_streamed_item,
+ *   which stores the source tile of each map cell in a separate 16-bit index table,
+ *   so a streamed map can reference up to 65534 tiles instead of 1024.
+ *   The number of tiles loaded per frame is limited by @ref BN_CFG_BG_BLOCKS_MAX_STREAMED_TILES_PER_FRAME.
+ * * Compressed big maps supported: they are split in chunks of 32x32 cells compressed independently
+ *   and decompressed on demand before V-Blank (see @ref BN_CFG_BG_BLOCKS_MAX_MAP_CHUNKS).
+ * * bn::link_stream added: it sends bytes through the link cable split in packets with checksums,
+ *   sending again the ones lost or corrupted.
+ * * bn::link_stream_loopback added: it connects two link streams without the link cable to test them.
+ * * bn::link_rollback_session added: it keeps two players games in sync through the link cable,
+ *   predicting the keypad of the other player and simulating frames again when the prediction was wrong.
+ *   It can also be updated without using the link cable, so it can be tested deterministically.
+ * * bn::sprite_streamed_animate_action added: it copies each animation frame from ROM into one of two VRAM slots
+ *   in V-Blank, without searching for nor creating sprite tile sets.
+ * * bn::sprite_batch added: it stores lots of sprites with the same shape, size and color palette
+ *   in a struct of arrays, and commits them to OAM in a single IWRAM pass.
+ * * bn::spatial_grid added: uniform grid which allows to find the intersections between lots of rectangles
+ *   without testing all of them against each other.
+ * * bn::palette_bands added: it splits the screen in horizontal bands with different colors for the same palette
+ *   using HDMA, and warns when a band change doesn't fit in the H-Blank budget.
+ * * Regular BGs can share a tiles bank with the `"tiles_bank"` import field: repeated and flipped tiles are reduced
+ *   across all of them and their 16 color palettes are merged.
+ * * bn::task added: cooperative tasks implemented with C++20 coroutines which can `co_await` the next frame,
+ *   a number of frames or the completion of an action, and are resumed at the end of bn::core::update.
+ *   They are disabled by default (see @ref BN_CFG_TASKS_MAX_ITEMS).
+ * * Moving a camera only updates the sprites, backgrounds and rectangle windows attached to it.
+ * * bn::regular_bg_text_generator added: it draws text from a bn::sprite_font into a regular BG map
+ *   through a tiles cache which uploads each unique tile only once, so text doesn't need sprites.
+ * * bn::sprite_text added: it keeps text drawn in sprites and, when the text is replaced,
+ *   only redraws in place the tiles of the characters which have changed.
+ * * bn::models_3d added: it draws flat shaded 3D models with HDMA sprites. Models are imported from `*.obj` files
+ *   with `butano/tools/butano_models_3d_tool.py`, and `models_3d` example shows its stats per frame.
+ * * bn::inplace_function and bn::function_ref added. They allow to store and reference lambdas with captures
+ *   without allocating memory nor using virtual tables.
+ * * bn::core::set_vblank_callback accepts lambdas with captures.
+ * * <b>(Breaking change)</b> bn::core::vblank_callback returns a const reference to a bn::vblank_callback_type
+ *   instead of a function pointer.
+ *
+ *
  * @section changelog_18_7_1 18.7.1
  *
  * * Placement `new` calls with user-provided `operator new` overloads fixed.
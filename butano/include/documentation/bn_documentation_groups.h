@@ -315,6 +315,17 @@
  * @ingroup display
  */
 
+/**
+ * @defgroup model_3d 3D models
+ *
+ * Flat shaded 3D models drawn with sprites, one sprite per polygon horizontal line.
+ *
+ * Sprites are copied to OAM each screen horizontal line with HDMA,
+ * so there's no need of a bitmap display mode to draw them.
+ *
+ * @ingroup display
+ */
+
 /**
  * @defgroup memory Memory
  *
@@ -564,7 +575,8 @@
  *
  * Part of the standard function objects library.
  *
- * It provides the standard hash function.
+ * It provides the standard hash function, and allocation-free type-erased callables
+ * like bn::inplace_function and bn::function_ref.
  *
  * @ingroup std
  */
@@ -589,6 +601,15 @@
  * @ingroup action
  */
 
+/**
+ * @defgroup task Tasks
+ *
+ * Tasks allow to write behaviors which span multiple frames as C++20 coroutines,
+ * without hand-written state machines.
+ *
+ * They are resumed by bn::core::update once the condition they are waiting for is met.
+ */
+
 /**
  * @defgroup tool Tools
  *
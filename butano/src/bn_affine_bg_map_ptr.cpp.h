@@ -317,6 +317,11 @@ void affine_bg_map_ptr::reload_cells_ref()
     bg_blocks_manager::reload(_handle);
 }
 
+bool affine_bg_map_ptr::ready() const
+{
+    return bg_blocks_manager::ready(_handle);
+}
+
 const affine_bg_tiles_ptr& affine_bg_map_ptr::tiles() const
 {
     return bg_blocks_manager::affine_map_tiles(_handle);
@@ -24,6 +24,41 @@ namespace bn
 namespace
 {
     constexpr best_fit_allocator::size_type alignment_bytes = sizeof(int);
+    constexpr int alignment_bytes_log2 = 2;
+    constexpr int second_level_count_log2 = 3;
+    constexpr int second_level_count = 1 << second_level_count_log2;
+    constexpr int first_level_shift = second_level_count_log2 + alignment_bytes_log2;
+    constexpr int first_level_max_log2 = 24;
+    constexpr int first_level_count = first_level_max_log2 - first_level_shift + 1;
+    constexpr best_fit_allocator::size_type small_item_bytes = 1 << first_level_shift;
+    constexpr best_fit_allocator::size_type max_segregated_bytes = 1 << first_level_max_log2;
+
+    static_assert(alignment_bytes == 1 << alignment_bytes_log2);
+
+    [[nodiscard]] int _most_significant_bit(unsigned value)
+    {
+        return 31 - __builtin_clz(value);
+    }
+
+    [[nodiscard]] int _least_significant_bit(unsigned value)
+    {
+        return __builtin_ctz(value);
+    }
+
+    void _segregated_indexes(best_fit_allocator::size_type bytes, int& first_level, int& second_level)
+    {
+        if(bytes < small_item_bytes)
+        {
+            first_level = 0;
+            second_level = bytes / (small_item_bytes / second_level_count);
+        }
+        else
+        {
+            int msb = _most_significant_bit(unsigned(bytes));
+            first_level = msb - (first_level_shift - 1);
+            second_level = (bytes >> (msb - second_level_count_log2)) ^ second_level_count;
+        }
+    }
 
     [[nodiscard]] best_fit_allocator::size_type _aligned_bytes(best_fit_allocator::size_type bytes)
     {
@@ -36,6 +71,15 @@ namespace
     }
 }
 
+class best_fit_allocator::free_lists
+{
+
+public:
+    item_type* items[first_level_count][second_level_count] = {};
+    uint8_t second_level_bitmaps[first_level_count] = {};
+    unsigned first_level_bitmap = 0;
+};
+
 best_fit_allocator::~best_fit_allocator() noexcept
 {
     BN_BASIC_ASSERT(empty(), "Allocator is not empty");
@@ -57,6 +101,11 @@ void* best_fit_allocator::alloc(size_type bytes)
         return nullptr;
     }
 
+    if(_free_lists)
+    {
+        return _segregated_alloc(bytes);
+    }
+
     item_type* item = _best_free_item(bytes);
 
     if(! item)
@@ -191,6 +240,12 @@ void best_fit_allocator::free(void* ptr)
         _free_check(item);
     #endif
 
+    if(_free_lists)
+    {
+        _segregated_free(item);
+        return;
+    }
+
     bool item_linked = false;
     item->used = false;
     item->free_items.previous = nullptr;
@@ -296,10 +351,32 @@ void best_fit_allocator::free(void* ptr)
 }
 
 void best_fit_allocator::reset(void* start, size_type bytes)
+{
+    reset(start, bytes, false);
+}
+
+void best_fit_allocator::reset(void* start, size_type bytes, bool segregated_fit)
 {
     BN_ASSERT(bytes >= 0 && bytes % size_type(sizeof(int)) == 0, "Invalid bytes: ", bytes);
     BN_BASIC_ASSERT(empty(), "Allocator is not empty");
 
+    _free_lists = nullptr;
+
+    if(segregated_fit)
+    {
+        constexpr size_type free_lists_bytes = sizeof(free_lists);
+        static_assert(free_lists_bytes % alignment_bytes == 0);
+
+        BN_ASSERT(bytes >= free_lists_bytes + _sizeof_free_item, "Not enough bytes for segregated fit: ", bytes);
+        BN_ASSERT(bytes - free_lists_bytes < max_segregated_bytes, "Too many bytes for segregated fit: ", bytes);
+        BN_BASIC_ASSERT(start, "Start is null");
+        BN_ASSERT(aligned<alignment_bytes>(start), "Start is not aligned");
+
+        _free_lists = ::new(start) free_lists();
+        start = static_cast<uint8_t*>(start) + free_lists_bytes;
+        bytes -= free_lists_bytes;
+    }
+
     if(bytes >= _sizeof_free_item)
     {
         BN_BASIC_ASSERT(start, "Start is null");
@@ -313,9 +390,18 @@ void best_fit_allocator::reset(void* start, size_type bytes)
         first_item->free_items.next = nullptr;
 
         _start_ptr = static_cast<uint8_t*>(start);
-        _first_free_item = first_item;
         _total_bytes_count = bytes;
         _free_bytes_count = bytes;
+
+        if(_free_lists)
+        {
+            _first_free_item = nullptr;
+            _insert_segregated_free_item(first_item);
+        }
+        else
+        {
+            _first_free_item = first_item;
+        }
     }
     else
     {
@@ -351,6 +437,7 @@ void best_fit_allocator::log_status() const
         BN_LOG(']');
         BN_LOG("free_bytes_count: ", _free_bytes_count);
         BN_LOG("total_bytes_count: ", _total_bytes_count);
+        BN_LOG("segregated_fit: ", _free_lists ? "true" : "false");
     #endif
 }
 
@@ -381,6 +468,177 @@ best_fit_allocator::item_type* best_fit_allocator::_best_free_item(size_type byt
     return best_free_item;
 }
 
+void* best_fit_allocator::_segregated_alloc(size_type bytes)
+{
+    // Round up the requested size to the next list, so any free item of the found list is big enough:
+    size_type search_bytes = bytes;
+
+    if(search_bytes >= small_item_bytes)
+    {
+        search_bytes += (1 << (_most_significant_bit(unsigned(search_bytes)) - second_level_count_log2)) - 1;
+    }
+
+    int first_level;
+    int second_level;
+    _segregated_indexes(search_bytes, first_level, second_level);
+
+    if(first_level >= first_level_count)
+    {
+        return nullptr;
+    }
+
+    free_lists& lists = *_free_lists;
+    unsigned second_level_bitmap = lists.second_level_bitmaps[first_level] & (~0U << second_level);
+
+    if(! second_level_bitmap)
+    {
+        unsigned first_level_bitmap = lists.first_level_bitmap & (~0U << (first_level + 1));
+
+        if(! first_level_bitmap)
+        {
+            return nullptr;
+        }
+
+        first_level = _least_significant_bit(first_level_bitmap);
+        second_level_bitmap = lists.second_level_bitmaps[first_level];
+    }
+
+    second_level = _least_significant_bit(second_level_bitmap);
+
+    item_type* item = lists.items[first_level][second_level];
+    _erase_segregated_free_item(item);
+
+    size_type new_item_size = item->size - bytes;
+
+    if(new_item_size > _sizeof_free_item)
+    {
+        item->size = bytes;
+
+        item_type* new_item = item->next();
+        new_item->previous = item;
+        new_item->size = new_item_size;
+        new_item->used = false;
+
+        item_type* new_next_item = new_item->next();
+
+        if(new_next_item != _end_item())
+        {
+            new_next_item->previous = new_item;
+        }
+
+        _insert_segregated_free_item(new_item);
+    }
+
+    item->used = true;
+    _free_bytes_count -= item->size;
+
+    #if BN_CFG_BEST_FIT_ALLOCATOR_SANITY_CHECK_ENABLED
+        _sanity_check();
+    #endif
+
+    return item->data();
+}
+
+void best_fit_allocator::_segregated_free(item_type* item)
+{
+    item->used = false;
+    _free_bytes_count += item->size;
+
+    if(item_type* previous_item = item->previous)
+    {
+        if(! previous_item->used)
+        {
+            _erase_segregated_free_item(previous_item);
+            previous_item->size += item->size;
+            item = previous_item;
+        }
+    }
+
+    item_type* next_item = item->next();
+    item_type* end_item = _end_item();
+
+    if(next_item != end_item)
+    {
+        if(! next_item->used)
+        {
+            _erase_segregated_free_item(next_item);
+            item->size += next_item->size;
+            next_item = item->next();
+        }
+
+        if(next_item != end_item)
+        {
+            next_item->previous = item;
+        }
+    }
+
+    _insert_segregated_free_item(item);
+
+    #if BN_CFG_BEST_FIT_ALLOCATOR_SANITY_CHECK_ENABLED
+        _sanity_check();
+    #endif
+}
+
+void best_fit_allocator::_insert_segregated_free_item(item_type* item)
+{
+    int first_level;
+    int second_level;
+    _segregated_indexes(item->size, first_level, second_level);
+
+    free_lists& lists = *_free_lists;
+    item_type*& first_item = lists.items[first_level][second_level];
+    item->free_items.previous = nullptr;
+    item->free_items.next = first_item;
+
+    if(first_item)
+    {
+        first_item->free_items.previous = item;
+    }
+
+    first_item = item;
+    lists.second_level_bitmaps[first_level] |= uint8_t(1 << second_level);
+    lists.first_level_bitmap |= 1U << first_level;
+}
+
+void best_fit_allocator::_erase_segregated_free_item(item_type* item)
+{
+    item_type* previous_free_item = item->free_items.previous;
+    item_type* next_free_item = item->free_items.next;
+
+    if(next_free_item)
+    {
+        next_free_item->free_items.previous = previous_free_item;
+    }
+
+    if(previous_free_item)
+    {
+        previous_free_item->free_items.next = next_free_item;
+    }
+    else
+    {
+        int first_level;
+        int second_level;
+        _segregated_indexes(item->size, first_level, second_level);
+
+        free_lists& lists = *_free_lists;
+        lists.items[first_level][second_level] = next_free_item;
+
+        if(! next_free_item)
+        {
+            uint8_t& second_level_bitmap = lists.second_level_bitmaps[first_level];
+            second_level_bitmap &= uint8_t(~(1 << second_level));
+
+            if(! second_level_bitmap)
+            {
+                lists.first_level_bitmap &= ~(1U << first_level);
+            }
+        }
+    }
+
+    item->free_items.previous = nullptr;
+    item->free_items.next = nullptr;
+}
+
 #if BN_CFG_BEST_FIT_ALLOCATOR_SANITY_CHECK_ENABLED
     void best_fit_allocator::_sanity_check() const
     {
@@ -426,22 +684,62 @@ best_fit_allocator::item_type* best_fit_allocator::_best_free_item(size_type byt
             item = next_item;
         }
 
-        BN_ASSERT(first_free_item == _first_free_item);
         BN_ASSERT(real_used_bytes == used_bytes(), real_used_bytes, " - ", used_bytes());
 
-        item_type* free_item = _first_free_item;
         size_type num_list_free_items = 0;
 
-        while(free_item)
+        if(const free_lists* lists = _free_lists)
+        {
+            BN_ASSERT(! _first_free_item);
+
+            for(int first_level = 0; first_level < first_level_count; ++first_level)
+            {
+                for(int second_level = 0; second_level < second_level_count; ++second_level)
+                {
+                    const item_type* free_item = lists->items[first_level][second_level];
+                    bool second_level_bit = lists->second_level_bitmaps[first_level] & (1 << second_level);
+                    BN_ASSERT(second_level_bit == bool(free_item), first_level, " - ", second_level);
+
+                    while(free_item)
+                    {
+                        ++num_list_free_items;
+
+                        BN_ASSERT(! free_item->used);
+
+                        int item_first_level;
+                        int item_second_level;
+                        _segregated_indexes(free_item->size, item_first_level, item_second_level);
+                        BN_ASSERT(item_first_level == first_level && item_second_level == second_level,
+                                  first_level, " - ", second_level);
+
+                        const item_type* next_free_item = free_item->free_items.next;
+                        BN_ASSERT(! next_free_item || next_free_item->free_items.previous == free_item);
+
+                        free_item = next_free_item;
+                    }
+                }
+
+                bool first_level_bit = lists->first_level_bitmap & (1U << first_level);
+                BN_ASSERT(first_level_bit == bool(lists->second_level_bitmaps[first_level]), first_level);
+            }
+        }
+        else
         {
-            ++num_list_free_items;
+            BN_ASSERT(first_free_item == _first_free_item);
 
-            BN_ASSERT(! free_item->used);
+            const item_type* free_item = _first_free_item;
 
-            item_type* next_free_item = free_item->free_items.next;
-            BN_ASSERT(! next_free_item || next_free_item->free_items.previous == free_item);
+            while(free_item)
+            {
+                ++num_list_free_items;
+
+                BN_ASSERT(! free_item->used);
 
-            free_item = next_free_item;
+                const item_type* next_free_item = free_item->free_items.next;
+                BN_ASSERT(! next_free_item || next_free_item->free_items.previous == free_item);
+
+                free_item = next_free_item;
+            }
         }
 
         BN_ASSERT(num_free_items == num_list_free_items);
@@ -6,6 +6,7 @@
 #include "bn_bg_blocks_manager.h"
 
 #include "bn_limits.h"
+#include "bn_algorithm.h"
 #include "bn_string_view.h"
 #include "bn_bgs_manager.h"
 #include "bn_config_bg_blocks.h"
@@ -20,11 +21,17 @@
 #include "bn_regular_bg_map_item.cpp.h"
 #include "bn_regular_bg_tiles_ptr.cpp.h"
 #include "bn_regular_bg_tiles_item.cpp.h"
+#include "bn_regular_bg_tiles_cache.cpp.h"
 #include "bn_affine_bg_map_ptr.cpp.h"
 #include "bn_affine_bg_map_item.cpp.h"
 #include "bn_affine_bg_tiles_ptr.cpp.h"
 #include "bn_affine_bg_tiles_item.cpp.h"
 
+#if BN_CFG_BG_BLOCKS_STAGING_BUFFER_SIZE
+    #include "bn_timer.h"
+    #include "../hw/include/bn_hw_timer_constants.h"
+#endif
+
 #if BN_CFG_BG_BLOCKS_LOG_ENABLED
     #include "bn_log.h"
 
@@ -39,6 +46,18 @@ namespace bn::bg_blocks_manager
 namespace
 {
     static_assert(BN_CFG_BG_BLOCKS_MAX_ITEMS > 0 && BN_CFG_BG_BLOCKS_MAX_ITEMS <= hw::bg_tiles::blocks_count());
+    static_assert(BN_CFG_BG_BLOCKS_STAGING_BUFFER_SIZE >= 0 &&
+                  BN_CFG_BG_BLOCKS_STAGING_BUFFER_SIZE <= hw::bg_maps::cells_count() * 2);
+    static_assert(BN_CFG_BG_BLOCKS_STAGING_BUFFER_SIZE % 4 == 0);
+    static_assert(BN_CFG_BG_BLOCKS_STAGING_MAX_CYCLES > 0);
+
+    // Two map chunks are referenced at the same time when a map row or column crosses a chunk boundary:
+    static_assert(BN_CFG_BG_BLOCKS_MAX_MAP_CHUNKS == 0 || BN_CFG_BG_BLOCKS_MAX_MAP_CHUNKS > 1);
+
+    constexpr int staging_half_words_count = BN_CFG_BG_BLOCKS_STAGING_BUFFER_SIZE / 2;
+    constexpr int max_map_chunks = BN_CFG_BG_BLOCKS_MAX_MAP_CHUNKS;
+    constexpr int map_chunk_size = 32;
+    constexpr int map_chunk_cells_count = map_chunk_size * map_chunk_size;
 
 
     #if BN_CFG_LOG_ENABLED
@@ -159,9 +178,52 @@ namespace
     }
 
 
+    void _stream_regular_map_cells(const uint16_t* source_data_ptr, const uint16_t* source_tile_indexes_ptr,
+                                   int source_step, int count, uint16_t offset, bool replace,
+                                   iregular_bg_tiles_cache& tiles_cache, uint16_t* destination_vram_ptr,
+                                   int destination_step)
+    {
+        for(int index = 0; index < count; ++index)
+        {
+            unsigned source_cell = *source_data_ptr;
+            int source_tile;
+
+            // Tile indexes are stored apart when map cells can't reference all tiles:
+            if(source_tile_indexes_ptr)
+            {
+                source_tile = *source_tile_indexes_ptr;
+                source_tile_indexes_ptr += source_step;
+            }
+            else
+            {
+                source_tile = iregular_bg_tiles_cache::_cell_tile(source_cell);
+            }
+
+            unsigned new_cell;
+
+            if(replace)
+            {
+                auto old_cell = uint16_t(*destination_vram_ptr - offset);
+                new_cell = tiles_cache._replace_cell(old_cell, source_cell, source_tile);
+            }
+            else
+            {
+                new_cell = tiles_cache._stream_cell(source_cell, source_tile);
+            }
+
+            *destination_vram_ptr = uint16_t(new_cell + offset);
+            source_data_ptr += source_step;
+            destination_vram_ptr += destination_step;
+        }
+    }
+
+
     constexpr int max_items = BN_CFG_BG_BLOCKS_MAX_ITEMS;
     constexpr int max_list_items = max_items + 1;
 
+    constexpr int max_streamed_tiles_per_frame = BN_CFG_BG_BLOCKS_MAX_STREAMED_TILES_PER_FRAME;
+    static_assert(max_streamed_tiles_per_frame >= 0);
+
 
     enum class status_type
     {
@@ -189,8 +251,16 @@ namespace
         optional<regular_bg_tiles_ptr> regular_tiles;
         optional<affine_bg_tiles_ptr> affine_tiles;
         optional<bg_palette_ptr> palette;
+        iregular_bg_tiles_cache* tiles_cache = nullptr;
+        const uint16_t* tile_indexes = nullptr;
         uint16_t width = 0; // If is_tiles == true, it stores half_words.
         uint16_t height = 0;
+
+        #if BN_CFG_BG_BLOCKS_STAGING_BUFFER_SIZE
+            const uint16_t* staged_data = nullptr;
+            uint16_t staging_half_word = 0;
+        #endif
+
         uint8_t start_block = 0;
         uint8_t blocks_count = 0;
         uint8_t next_index = max_list_items;
@@ -461,6 +531,16 @@ namespace
     };
 
 
+    class map_chunk_type
+    {
+
+    public:
+        const uint16_t* data = nullptr;
+        unsigned usage = 0;
+        int index = 0;
+    };
+
+
     class static_data
     {
 
@@ -473,6 +553,21 @@ namespace
         int to_remove_blocks_count = 0;
         int to_commit_uncompressed_items_count = 0;
         int to_commit_compressed_items_count = 0;
+        int commits_count = 0;
+
+        #if BN_CFG_BG_BLOCKS_STAGING_BUFFER_SIZE
+            alignas(int) uint16_t staging_half_words[staging_half_words_count];
+            alignas(int) uint8_t staged_items_array[max_items];
+            int staged_items_count = 0;
+            int staging_used_half_words_count = 0;
+        #endif
+
+        #if BN_CFG_BG_BLOCKS_MAX_MAP_CHUNKS
+            alignas(int) uint16_t map_chunks_cells[max_map_chunks][map_chunk_cells_count];
+            map_chunk_type map_chunks[max_map_chunks];
+            unsigned map_chunks_usage = 0;
+        #endif
+
         bool allow_tiles_offset = true;
         bool check_commit = false;
         bool delay_commit = false;
@@ -792,7 +887,7 @@ namespace
 
             if(item.data == data_ptr && ! item.is_tiles && map_item.dimensions().width() == item.width &&
                     map_item.dimensions().height() == item.height && map_item.compression() == item.compression() &&
-                    map_item.big() == item.is_big && ! item.is_affine)
+                    map_item.big() == item.is_big && ! item.is_affine && ! item.tiles_cache)
             {
                 const regular_bg_tiles_ptr* item_tiles = item.regular_tiles.get();
                 const bg_palette_ptr* item_palette = item.palette.get();
@@ -915,10 +1010,9 @@ namespace
         return -1;
     }
 
-    void _commit_item(const item_type& item, bool use_dma)
+    void _commit_item(const item_type& item, const uint16_t* source_data_ptr, compression_type compression,
+                      bool use_dma)
     {
-        const uint16_t* source_data_ptr = item.data;
-
         if(! source_data_ptr)
         {
             return;
@@ -927,7 +1021,7 @@ namespace
         if(item.is_tiles)
         {
             uint16_t* destination_vram_ptr = hw::bg_blocks::vram(item.start_block);
-            _hw_commit(source_data_ptr, item.compression(), item.width, use_dma, destination_vram_ptr);
+            _hw_commit(source_data_ptr, compression, item.width, use_dma, destination_vram_ptr);
             return;
         }
 
@@ -939,7 +1033,6 @@ namespace
                 return;
             }
 
-            compression_type compression = item.compression();
             uint16_t* destination_vram_ptr = hw::bg_blocks::vram(item.start_block);
             auto tiles_offset = unsigned(item.affine_tiles_offset());
             int half_words = (item.width * item.height) / 2;
@@ -968,7 +1061,6 @@ namespace
                 return;
             }
 
-            compression_type compression = item.compression();
             uint16_t* destination_vram_ptr = hw::bg_blocks::vram(item.start_block);
             auto tiles_offset = unsigned(item.regular_tiles_offset());
             auto palette_offset = unsigned(item.palette_offset());
@@ -992,6 +1084,100 @@ namespace
         }
     }
 
+    #if BN_CFG_BG_BLOCKS_STAGING_BUFFER_SIZE
+        [[nodiscard]] bool _staged(const item_type& item)
+        {
+            return item.staged_data == item.data;
+        }
+
+        [[nodiscard]] int _staging_half_words(const item_type& item)
+        {
+            int result;
+
+            if(item.is_tiles)
+            {
+                result = item.width;
+            }
+            else if(item.is_affine)
+            {
+                result = (item.width * item.height) / 2;
+            }
+            else
+            {
+                result = item.width * item.height;
+            }
+
+            // Keep staged items word aligned:
+            return result + (result % 2);
+        }
+
+        [[nodiscard]] bool _stageable(const item_type& item)
+        {
+            // Big maps are committed from bgs_manager, so they are never staged:
+            return ! item.is_big && _staging_half_words(item) <= staging_half_words_count;
+        }
+
+        void _stage_compressed_items()
+        {
+            constexpr int max_ticks = BN_CFG_BG_BLOCKS_STAGING_MAX_CYCLES / hw::timers::divisor();
+
+            timer staging_timer;
+            bool staged_items = false;
+
+            for(int index = 0, limit = data.to_commit_compressed_items_count; index < limit; ++index)
+            {
+                int item_index = data.to_commit_compressed_items_array[index];
+                item_type& item = data.items.item(item_index);
+
+                if(! item.data || _staged(item) || ! _stageable(item))
+                {
+                    continue;
+                }
+
+                int half_words = _staging_half_words(item);
+
+                if(data.staging_used_half_words_count + half_words > staging_half_words_count)
+                {
+                    break;
+                }
+
+                if(staged_items && staging_timer.elapsed_ticks() >= max_ticks)
+                {
+                    break;
+                }
+
+                uint16_t* staging_ptr = data.staging_half_words + data.staging_used_half_words_count;
+
+                switch(item.compression())
+                {
+
+                case compression_type::LZ77:
+                    hw::decompress::lz77(item.data, staging_ptr);
+                    break;
+
+                case compression_type::RUN_LENGTH:
+                    hw::decompress::rl_wram(item.data, staging_ptr);
+                    break;
+
+                case compression_type::HUFFMAN:
+                    hw::decompress::huff(item.data, staging_ptr);
+                    break;
+
+                default:
+                    BN_ERROR("Invalid compression type: ", int(item.compression()));
+                    break;
+                }
+
+                item.staged_data = item.data;
+                item.staging_half_word = uint16_t(data.staging_used_half_words_count);
+                data.staging_used_half_words_count += half_words;
+                data.staged_items_array[data.staged_items_count] = uint8_t(item_index);
+                ++data.staged_items_count;
+                staged_items = true;
+            }
+        }
+    #endif
+
     void _fix_blocks_count(const item_type& item, int new_item_blocks_count)
     {
         switch(item.status())
@@ -1117,7 +1303,7 @@ namespace
             }
             else
             {
-                _commit_item(*item, false);
+                _commit_item(*item, item->data, item->compression(), false);
             }
         }
 
@@ -1285,6 +1471,157 @@ namespace
     {
         return _fix_map_x(map_y, map_height);
     }
+
+    #if BN_CFG_BG_BLOCKS_MAX_MAP_CHUNKS
+        [[nodiscard]] const uint16_t* _map_chunk(const item_type& item, int x, int y)
+        {
+            // Compressed big maps data starts with the byte offset of each chunk,
+            // followed by the chunks compressed independently:
+            const uint16_t* item_data = item.data;
+            int chunk_index = ((y / map_chunk_size) * (item.width / map_chunk_size)) + (x / map_chunk_size);
+            unsigned usage = ++data.map_chunks_usage;
+            int replaced_index = 0;
+
+            for(int index = 0; index < max_map_chunks; ++index)
+            {
+                map_chunk_type& map_chunk = data.map_chunks[index];
+
+                if(map_chunk.data == item_data && map_chunk.index == chunk_index)
+                {
+                    map_chunk.usage = usage;
+                    return data.map_chunks_cells[index];
+                }
+
+                if(map_chunk.usage < data.map_chunks[replaced_index].usage)
+                {
+                    replaced_index = index;
+                }
+            }
+
+            // The least recently used chunk is replaced:
+            map_chunk_type& map_chunk = data.map_chunks[replaced_index];
+            map_chunk.data = item_data;
+            map_chunk.usage = usage;
+            map_chunk.index = chunk_index;
+
+            auto chunk_offsets = reinterpret_cast<const unsigned*>(item_data);
+            const uint8_t* chunk_data = reinterpret_cast<const uint8_t*>(item_data) + chunk_offsets[chunk_index];
+            uint16_t* chunk_cells = data.map_chunks_cells[replaced_index];
+
+            switch(item.compression())
+            {
+
+            case compression_type::LZ77:
+                hw::decompress::lz77(chunk_data, chunk_cells);
+                break;
+
+            case compression_type::RUN_LENGTH:
+                hw::decompress::rl_wram(chunk_data, chunk_cells);
+                break;
+
+            case compression_type::HUFFMAN:
+                hw::decompress::huff(chunk_data, chunk_cells);
+                break;
+
+            default:
+                BN_ERROR("Invalid compression type: ", int(item.compression()));
+                break;
+            }
+
+            return chunk_cells;
+        }
+
+        void _invalidate_map_chunks(const uint16_t* item_data)
+        {
+            for(map_chunk_type& map_chunk : data.map_chunks)
+            {
+                if(map_chunk.data == item_data)
+                {
+                    map_chunk.data = nullptr;
+                    map_chunk.usage = 0;
+                }
+            }
+        }
+
+        void _set_affine_map_vram_cell(unsigned cell, uint8_t* dest_data)
+        {
+            auto dest_address = reinterpret_cast<uintptr_t>(dest_data);
+            auto u16_dest_data = reinterpret_cast<uint16_t*>(dest_address & ~uintptr_t(1));
+
+            if(dest_address % 2)
+            {
+                *u16_dest_data = uint16_t((cell << 8) | (*u16_dest_data & 0xFF));
+            }
+            else
+            {
+                *u16_dest_data = uint16_t((*u16_dest_data & 0xFF00) | cell);
+            }
+        }
+
+        void _commit_chunked_affine_map_cells(const item_type& item, int x, int y, int count, bool col,
+                                              unsigned tiles_offset, uint8_t* dest_data, int dest_step)
+        {
+            int source_step = col ? map_chunk_size : 1;
+
+            while(count)
+            {
+                int chunk_x = x % map_chunk_size;
+                int chunk_y = y % map_chunk_size;
+                int chunk_count = min(map_chunk_size - (col ? chunk_y : chunk_x), count);
+                auto source_data = reinterpret_cast<const uint8_t*>(_map_chunk(item, x, y));
+                source_data += (chunk_y * map_chunk_size) + chunk_x;
+
+                for(int index = 0; index < chunk_count; ++index)
+                {
+                    _set_affine_map_vram_cell(*source_data + tiles_offset, dest_data);
+                    source_data += source_step;
+                    dest_data += dest_step;
+                }
+
+                if(col)
+                {
+                    y += chunk_count;
+                }
+                else
+                {
+                    x += chunk_count;
+                }
+
+                count -= chunk_count;
+            }
+        }
+    #endif
+
+    [[nodiscard]] const uint16_t* _regular_map_cells(const item_type& item, int x, int y)
+    {
+        #if BN_CFG_BG_BLOCKS_MAX_MAP_CHUNKS
+            if(item.compression() != compression_type::NONE)
+            {
+                const uint16_t* chunk_cells = _map_chunk(item, x, y);
+                return chunk_cells + (((y % map_chunk_size) * map_chunk_size) + (x % map_chunk_size));
+            }
+        #endif
+
+        return item.data + ((y * item.width) + x);
+    }
+
+    [[nodiscard]] int _regular_map_cells_row_step(const item_type& item)
+    {
+        #if BN_CFG_BG_BLOCKS_MAX_MAP_CHUNKS
+            if(item.compression() != compression_type::NONE)
+            {
+                return map_chunk_size;
+            }
+        #endif
+
+        return item.width;
+    }
+
+    [[nodiscard]] const uint16_t* _regular_map_tile_indexes(const item_type& item, const uint16_t* cells)
+    {
+        const uint16_t* tile_indexes = item.tile_indexes;
+        return tile_indexes ? tile_indexes + (cells - item.data) : nullptr;
+    }
 }
 
 void init()
@@ -1600,7 +1937,8 @@ int create_regular_map(const regular_bg_map_item& map_item, const regular_bg_map
     BN_ASSERT(aligned<4>(data_ptr), "Map cells are not aligned");
     BN_ASSERT(regular_bg_tiles_item::valid_tiles_count(tiles.tiles_count(), palette.bpp()),
               "Invalid tiles count: ", tiles.tiles_count(), " - ", int(palette.bpp()));
-    BN_BASIC_ASSERT(compression == compression_type::NONE || ! big, "Compressed big maps are not supported");
+    BN_BASIC_ASSERT(compression == compression_type::NONE || ! big || max_map_chunks,
+                    "Compressed big maps are not supported (BN_CFG_BG_BLOCKS_MAX_MAP_CHUNKS is zero)");
 
     result = _create_impl(
                 create_data::from_regular_map(data_ptr, dimensions, compression, big, move(tiles), move(palette)));
@@ -1633,6 +1971,64 @@ int create_regular_map(const regular_bg_map_item& map_item, const regular_bg_map
     return result;
 }
 
+int create_regular_streamed_map(
+        const regular_bg_map_item& map_item, const regular_bg_map_cell* data_ptr,
+        const span<const tile>& source_tiles_ref, const uint16_t* source_tile_indexes_ptr,
+        regular_bg_tiles_ptr&& tiles, bg_palette_ptr&& palette, iregular_bg_tiles_cache& tiles_cache, bool optional)
+{
+    const size& dimensions = map_item.dimensions();
+    compression_type compression = map_item.compression();
+    bool big = map_item.big();
+
+    BN_BG_BLOCKS_LOG("bg_blocks_manager - CREATE REGULAR STREAMED MAP", (optional ? " OPTIONAL: " : ": "), data_ptr,
+                     " - ", dimensions.width(), " - ", dimensions.height(), " - ", tiles.id(), " - ", palette.id(),
+                     " - ", tiles_cache.max_tiles_count());
+
+    BN_ASSERT(aligned<4>(data_ptr), "Map cells are not aligned");
+    BN_BASIC_ASSERT(big, "Streamed maps must be big");
+    BN_BASIC_ASSERT(compression == compression_type::NONE, "Compressed streamed maps are not supported");
+    BN_BASIC_ASSERT(! tiles_cache.used(), "Tiles cache is already used by another map");
+
+    // Streamed maps are never shared, since their VRAM tiles depend on their position:
+    int tiles_id = tiles.id();
+    bpp_mode bpp = palette.bpp();
+    int result = _create_impl(
+                create_data::from_regular_map(data_ptr, dimensions, compression, big, move(tiles), move(palette)));
+
+    if(result >= 0)
+    {
+        item_type& item = data.items.item(result);
+        auto vram_tiles_ptr = reinterpret_cast<tile*>(hw::bg_blocks::vram(tiles_id));
+        tiles_cache._bind(source_tiles_ref.data(), source_tiles_ref.size(), bpp, vram_tiles_ptr);
+        item.tiles_cache = &tiles_cache;
+        item.tile_indexes = source_tile_indexes_ptr;
+
+        BN_BG_BLOCKS_LOG("CREATED. start_block: ", item.start_block);
+        BN_BG_BLOCKS_LOG_STATUS();
+    }
+    else
+    {
+        BN_BG_BLOCKS_LOG("NOT CREATED");
+
+        if(! optional)
+        {
+            #if BN_CFG_LOG_ENABLED
+                log_status();
+            #endif
+
+            BN_ERROR("Regular BG streamed map create failed:",
+                     "\n\tMap data: ", data_ptr,
+                     "\n\tMap width: ", dimensions.width(),
+                     "\n\tMap height: ", dimensions.height(),
+                     "\n\tBlocks count: ", _new_regular_map_blocks_count(dimensions.width(), dimensions.height(), big),
+                     "\n\nThere's no more available VRAM.",
+                     _status_log_message);
+        }
+    }
+
+    return result;
+}
+
 int create_affine_map(const affine_bg_map_item& map_item, const affine_bg_map_cell* data_ptr,
                       affine_bg_tiles_ptr&& tiles, bg_palette_ptr&& palette, bool optional)
 {
@@ -1653,7 +2049,8 @@ int create_affine_map(const affine_bg_map_item& map_item, const affine_bg_map_ce
 
     BN_ASSERT(aligned<4>(data_ptr), "Map cells are not aligned");
     BN_ASSERT(palette.bpp() == bpp_mode::BPP_8, "4BPP affine maps not supported");
-    BN_BASIC_ASSERT(compression == compression_type::NONE || ! big, "Compressed big maps are not supported");
+    BN_BASIC_ASSERT(compression == compression_type::NONE || ! big || max_map_chunks,
+                    "Compressed big maps are not supported (BN_CFG_BG_BLOCKS_MAX_MAP_CHUNKS is zero)");
     BN_BASIC_ASSERT(! big || dimensions.width() % data.new_affine_big_map_canvas_info.size() == 0,
                     "Big maps width must be divisible by canvas width: ",
                     dimensions.width(), " - ", data.new_affine_big_map_canvas_info.size());
@@ -1882,6 +2279,13 @@ void decrease_usages(int id)
         item.set_status(status_type::TO_REMOVE);
         data.to_remove_blocks_count += item.blocks_count;
 
+        if(iregular_bg_tiles_cache* tiles_cache = item.tiles_cache)
+        {
+            tiles_cache->_unbind();
+            item.tiles_cache = nullptr;
+            item.tile_indexes = nullptr;
+        }
+
         item.regular_tiles.reset();
         item.affine_tiles.reset();
         item.palette.reset();
@@ -2070,8 +2474,8 @@ void set_regular_map_cells_ref(int id, const regular_bg_map_item& map_item, cons
                     "Map height does not match item map height: ", map_item.dimensions().height(), " - ", item.height);
     BN_BASIC_ASSERT(map_item.big() == item.is_big, "Map big does not match item map big: ",
                     map_item.big(), " - ", item.is_big);
-    BN_BASIC_ASSERT(compression == compression_type::NONE || ! map_item.big(),
-                    "Compressed big maps are not supported");
+    BN_BASIC_ASSERT(compression == compression_type::NONE || ! map_item.big() || max_map_chunks,
+                    "Compressed big maps are not supported (BN_CFG_BG_BLOCKS_MAX_MAP_CHUNKS is zero)");
 
     if(item_data != data_ptr)
     {
@@ -2111,8 +2515,8 @@ void set_affine_map_cells_ref(int id, const affine_bg_map_item& map_item, const
                     "Map height does not match item map height: ", map_item.dimensions().height(), " - ", item.height);
     BN_BASIC_ASSERT(map_item.big() == item.is_big, "Map big does not match item map big: ",
                     map_item.big(), " - ", item.is_big);
-    BN_BASIC_ASSERT(compression == compression_type::NONE || ! map_item.big(),
-                    "Compressed big maps are not supported");
+    BN_BASIC_ASSERT(compression == compression_type::NONE || ! map_item.big() || max_map_chunks,
+                    "Compressed big maps are not supported (BN_CFG_BG_BLOCKS_MAX_MAP_CHUNKS is zero)");
 
     auto u16_data_ptr = reinterpret_cast<const uint16_t*>(data_ptr);
 
@@ -2146,6 +2550,10 @@ void reload(int id)
 
     BN_BASIC_ASSERT(item.data, "Item has no data");
 
+    #if BN_CFG_BG_BLOCKS_MAX_MAP_CHUNKS
+        _invalidate_map_chunks(item.data);
+    #endif
+
     item.commit = true;
     data.check_commit = true;
 
@@ -2170,6 +2578,7 @@ void set_regular_map_tiles(int id, regular_bg_tiles_ptr&& tiles)
 
     if(tiles != item.regular_tiles)
     {
+        BN_BASIC_ASSERT(! item.tiles_cache, "Streamed map tiles can't be replaced");
         BN_ASSERT(regular_bg_tiles_item::valid_tiles_count(tiles.tiles_count(), item.palette->bpp()),
                   "Invalid tiles count: ", tiles.tiles_count(), " - ", int(item.palette->bpp()));
 
@@ -2244,6 +2653,8 @@ void set_affine_map_tiles(int id, affine_bg_tiles_ptr&& tiles)
 void remove_regular_map_tiles(int id)
 {
     item_type& item = data.items.item(id);
+    BN_BASIC_ASSERT(! item.tiles_cache, "Streamed map tiles can't be removed");
+
     item.regular_tiles.reset();
 }
 
@@ -2322,6 +2733,8 @@ void remove_map_palette(int id)
 void set_regular_map_tiles_and_palette(int id, regular_bg_tiles_ptr&& tiles, bg_palette_ptr&& palette)
 {
     item_type& item = data.items.item(id);
+    BN_BASIC_ASSERT(! item.tiles_cache || tiles == item.regular_tiles, "Streamed map tiles can't be replaced");
+
     bpp_mode new_palette_bpp = palette.bpp();
     BN_ASSERT(regular_bg_tiles_item::valid_tiles_count(tiles.tiles_count(), new_palette_bpp),
               "Invalid tiles count or palette BPP: ", tiles.tiles_count(), " - ", int(new_palette_bpp));
@@ -2416,11 +2829,88 @@ optional<span<affine_bg_map_cell>> affine_map_vram(int id)
     return result;
 }
 
+bool streamed_map(int id)
+{
+    const item_type& item = data.items.item(id);
+    return item.tiles_cache;
+}
+
+int commits_count()
+{
+    return data.commits_count;
+}
+
 bool must_commit(int id)
 {
     return data.items.item(id).commit;
 }
 
+bool ready([[maybe_unused]] int id)
+{
+    #if BN_CFG_BG_BLOCKS_STAGING_BUFFER_SIZE
+        const item_type& item = data.items.item(id);
+
+        if(item.commit && item.compression() != compression_type::NONE)
+        {
+            return _staged(item) || ! _stageable(item);
+        }
+    #endif
+
+    return true;
+}
+
+void load_big_map_chunks([[maybe_unused]] int id, [[maybe_unused]] int x, [[maybe_unused]] int y)
+{
+    #if BN_CFG_BG_BLOCKS_MAX_MAP_CHUNKS
+        const item_type& item = data.items.item(id);
+
+        if(! item.data || item.compression() == compression_type::NONE)
+        {
+            return;
+        }
+
+        int size = map_chunk_size;
+
+        if(item.is_affine)
+        {
+            affine_bg_big_map_canvas_info canvas_info(item.big_map_canvas_size());
+            size = canvas_info.size();
+            x -= canvas_info.viewport_dec();
+            y -= canvas_info.viewport_dec();
+        }
+
+        int map_width = item.width;
+        int map_height = item.height;
+        x = _fix_map_x(x, map_width);
+        y = _fix_map_y(y, map_height);
+
+        int first_chunk_x = x / map_chunk_size;
+        int first_chunk_y = y / map_chunk_size;
+        int chunks_x = ((x + size - 1) / map_chunk_size) - first_chunk_x + 1;
+        int chunks_y = ((y + size - 1) / map_chunk_size) - first_chunk_y + 1;
+
+        // If the visible chunks don't fit in the cache, they are decompressed in V-Blank on demand:
+        if(chunks_x * chunks_y <= max_map_chunks)
+        {
+            int map_chunks_x = map_width / map_chunk_size;
+            int map_chunks_y = map_height / map_chunk_size;
+
+            for(int chunk_y = first_chunk_y, chunk_y_limit = first_chunk_y + chunks_y; chunk_y < chunk_y_limit;
+                ++chunk_y)
+            {
+                int chunk_map_y = (chunk_y % map_chunks_y) * map_chunk_size;
+
+                for(int chunk_x = first_chunk_x, chunk_x_limit = first_chunk_x + chunks_x; chunk_x < chunk_x_limit;
+                    ++chunk_x)
+                {
+                    int chunk_map_x = (chunk_x % map_chunks_x) * map_chunk_size;
+                    [[maybe_unused]] const uint16_t* chunk_cells = _map_chunk(item, chunk_map_x, chunk_map_y);
+                }
+            }
+        }
+    #endif
+}
+
 void update_regular_map_col(int id, int x, int y)
 {
     const item_type& item = data.items.item(id);
@@ -2436,16 +2926,28 @@ void update_regular_map_col(int id, int x, int y)
     x = _fix_map_x(x, map_width);
     y = _fix_map_y(y, map_height);
 
-    const uint16_t* first_source_data = item_data + ((y * map_width) + x);
+    const uint16_t* first_source_data = _regular_map_cells(item, x, y);
+    int source_step = _regular_map_cells_row_step(item);
     int y_separator = y & 31;
     int second_y = _fix_map_y(y + 32 - y_separator, map_height);
 
-    const uint16_t* second_source_data = item_data + ((second_y * map_width) + x);
+    const uint16_t* second_source_data =
+            y_separator ? _regular_map_cells(item, x, second_y) : first_source_data;
     uint16_t* dest_data = hw::bg_blocks::vram(item.start_block) + (y_separator * 32) + (x & 31);
     auto tiles_offset = unsigned(item.regular_tiles_offset());
     auto palette_offset = unsigned(item.palette_offset());
 
-    if(tiles_offset || palette_offset)
+    if(iregular_bg_tiles_cache* tiles_cache = item.tiles_cache)
+    {
+        uint16_t offset = hw::bg_blocks::regular_map_cells_offset(tiles_offset, palette_offset);
+        tiles_cache->_start_commit(data.commits_count, max_streamed_tiles_per_frame);
+        _stream_regular_map_cells(first_source_data, _regular_map_tile_indexes(item, first_source_data), source_step,
+                                  32 - y_separator, offset, true, *tiles_cache, dest_data, 32);
+        _stream_regular_map_cells(second_source_data, _regular_map_tile_indexes(item, second_source_data),
+                                  source_step, y_separator, offset, true, *tiles_cache,
+                                  dest_data - (y_separator * 32), 32);
+    }
+    else if(tiles_offset || palette_offset)
     {
         uint16_t offset = hw::bg_blocks::regular_map_cells_offset(tiles_offset, palette_offset);
 
@@ -2453,7 +2955,7 @@ void update_regular_map_col(int id, int x, int y)
         {
             *dest_data = *first_source_data + offset;
             dest_data += 32;
-            first_source_data += map_width;
+            first_source_data += source_step;
         }
 
         dest_data -= 1024;
@@ -2462,7 +2964,7 @@ void update_regular_map_col(int id, int x, int y)
         {
             *dest_data = *second_source_data + offset;
             dest_data += 32;
-            second_source_data += map_width;
+            second_source_data += source_step;
         }
     }
     else
@@ -2471,7 +2973,7 @@ void update_regular_map_col(int id, int x, int y)
         {
             *dest_data = *first_source_data;
             dest_data += 32;
-            first_source_data += map_width;
+            first_source_data += source_step;
         }
 
         dest_data -= 1024;
@@ -2480,7 +2982,7 @@ void update_regular_map_col(int id, int x, int y)
         {
             *dest_data = *second_source_data;
             dest_data += 32;
-            second_source_data += map_width;
+            second_source_data += source_step;
         }
     }
 }
@@ -2517,6 +3019,18 @@ void update_affine_map_col(int id, int x, int y)
     auto dest_data = reinterpret_cast<uint8_t*>(hw::bg_blocks::vram(item.start_block));
     dest_data += ((y_separator << canvas_size_bits) + (x & canvas_viewport_size));
 
+    #if BN_CFG_BG_BLOCKS_MAX_MAP_CHUNKS
+        if(item.compression() != compression_type::NONE)
+        {
+            auto tiles_offset = unsigned(item.affine_tiles_offset());
+            _commit_chunked_affine_map_cells(item, x, y, canvas_size - y_separator, true, tiles_offset, dest_data,
+                                             canvas_size);
+            _commit_chunked_affine_map_cells(item, x, second_y, y_separator, true, tiles_offset,
+                                             dest_data - (y_separator << canvas_size_bits), canvas_size);
+            return;
+        }
+    #endif
+
     if(auto tiles_offset = unsigned(item.affine_tiles_offset()))
     {
         if(x % 2)
@@ -2635,17 +3149,26 @@ void update_regular_map_row(int id, int x, int y)
     x = _fix_map_x(x, map_width);
     y = _fix_map_y(y, map_height);
 
-    const uint16_t* first_source_data = item_data + ((y * map_width) + x);
+    const uint16_t* first_source_data = _regular_map_cells(item, x, y);
     int x_separator = x & 31;
     int elements = 32 - x_separator;
     int second_x = _fix_map_x(x + elements, map_width);
 
-    const uint16_t* second_source_data = item_data + ((y * map_width) + second_x);
+    const uint16_t* second_source_data = x_separator ? _regular_map_cells(item, second_x, y) : first_source_data;
     uint16_t* dest_data = hw::bg_blocks::vram(item.start_block) + (((y & 31) * 32) + x_separator);
     auto tiles_offset = unsigned(item.regular_tiles_offset());
     auto palette_offset = unsigned(item.palette_offset());
 
-    if(tiles_offset || palette_offset)
+    if(iregular_bg_tiles_cache* tiles_cache = item.tiles_cache)
+    {
+        uint16_t offset = hw::bg_blocks::regular_map_cells_offset(tiles_offset, palette_offset);
+        tiles_cache->_start_commit(data.commits_count, max_streamed_tiles_per_frame);
+        _stream_regular_map_cells(first_source_data, _regular_map_tile_indexes(item, first_source_data), 1,
+                                  elements, offset, true, *tiles_cache, dest_data, 1);
+        _stream_regular_map_cells(second_source_data, _regular_map_tile_indexes(item, second_source_data), 1,
+                                  x_separator, offset, true, *tiles_cache, dest_data - x_separator, 1);
+    }
+    else if(tiles_offset || palette_offset)
     {
         uint16_t offset = hw::bg_blocks::regular_map_cells_offset(tiles_offset, palette_offset);
         _hw_commit_offset(first_source_data, unsigned(elements), offset, dest_data);
@@ -2693,6 +3216,17 @@ void update_affine_map_row(int id, int x, int y)
     auto dest_data = reinterpret_cast<uint8_t*>(hw::bg_blocks::vram(item.start_block));
     dest_data += ((y & canvas_viewport_size) << canvas_size_bits) + x_separator;
 
+    #if BN_CFG_BG_BLOCKS_MAX_MAP_CHUNKS
+        if(item.compression() != compression_type::NONE)
+        {
+            auto tiles_offset = unsigned(item.affine_tiles_offset());
+            _commit_chunked_affine_map_cells(item, x, y, elements, false, tiles_offset, dest_data, 1);
+            _commit_chunked_affine_map_cells(item, second_x, y, x_separator, false, tiles_offset,
+                                             dest_data - x_separator, 1);
+            return;
+        }
+    #endif
+
     if(auto tiles_offset = unsigned(item.affine_tiles_offset()))
     {
         uint16_t offset = hw::bg_blocks::affine_map_cells_offset(tiles_offset);
@@ -2739,9 +3273,13 @@ void set_regular_map_position(int id, int x, int y)
     auto tiles_offset = unsigned(item.regular_tiles_offset());
     auto palette_offset = unsigned(item.palette_offset());
 
-    if(tiles_offset || palette_offset)
+    if(iregular_bg_tiles_cache* tiles_cache = item.tiles_cache)
     {
         uint16_t offset = hw::bg_blocks::regular_map_cells_offset(tiles_offset, palette_offset);
+        // The first commit loads all referenced tiles, so it is not limited:
+        int max_loaded_tiles = tiles_cache->loaded_tiles_count() ? max_streamed_tiles_per_frame : 0;
+        tiles_cache->_start_commit(data.commits_count, max_loaded_tiles);
+        tiles_cache->_release_all();
 
         for(int row = y, row_limit = y + 31; row <= row_limit; ++row)
         {
@@ -2752,11 +3290,36 @@ void set_regular_map_position(int id, int x, int y)
                 fixed_row -= map_height;
             }
 
-            const uint16_t* first_source_data = item_data + ((fixed_row * map_width) + x);
+            const uint16_t* first_source_data = _regular_map_cells(item, x, fixed_row);
+            uint16_t* dest_data = vram_data + (((fixed_row & 31) * 32) + x_separator);
+            _stream_regular_map_cells(first_source_data, _regular_map_tile_indexes(item, first_source_data), 1,
+                                      elements, offset, false, *tiles_cache, dest_data, 1);
+
+            const uint16_t* second_source_data =
+                    x_separator ? _regular_map_cells(item, second_x, fixed_row) : first_source_data;
+            _stream_regular_map_cells(second_source_data, _regular_map_tile_indexes(item, second_source_data), 1,
+                                      x_separator, offset, false, *tiles_cache, dest_data - x_separator, 1);
+        }
+    }
+    else if(tiles_offset || palette_offset)
+    {
+        uint16_t offset = hw::bg_blocks::regular_map_cells_offset(tiles_offset, palette_offset);
+
+        for(int row = y, row_limit = y + 31; row <= row_limit; ++row)
+        {
+            int fixed_row = row;
+
+            if(fixed_row >= map_height)
+            {
+                fixed_row -= map_height;
+            }
+
+            const uint16_t* first_source_data = _regular_map_cells(item, x, fixed_row);
             uint16_t* dest_data = vram_data + (((fixed_row & 31) * 32) + x_separator);
             _hw_commit_offset(first_source_data, unsigned(elements), offset, dest_data);
 
-            const uint16_t* second_source_data = item_data + ((fixed_row * map_width) + second_x);
+            const uint16_t* second_source_data =
+                    x_separator ? _regular_map_cells(item, second_x, fixed_row) : first_source_data;
             dest_data -= x_separator;
             _hw_commit_offset(second_source_data, unsigned(x_separator), offset, dest_data);
         }
@@ -2772,11 +3335,12 @@ void set_regular_map_position(int id, int x, int y)
                 fixed_row -= map_height;
             }
 
-            const uint16_t* first_source_data = item_data + ((fixed_row * map_width) + x);
+            const uint16_t* first_source_data = _regular_map_cells(item, x, fixed_row);
             uint16_t* dest_data = vram_data + (((fixed_row & 31) * 32) + x_separator);
             hw::memory::copy_half_words(first_source_data, elements, dest_data);
 
-            const uint16_t* second_source_data = item_data + ((fixed_row * map_width) + second_x);
+            const uint16_t* second_source_data =
+                    x_separator ? _regular_map_cells(item, second_x, fixed_row) : first_source_data;
             dest_data -= x_separator;
             hw::memory::copy_half_words(second_source_data, x_separator, dest_data);
         }
@@ -2812,6 +3376,30 @@ void set_affine_map_position(int id, int x, int y)
     int elements = canvas_info.size() - x_separator;
     int second_x = _fix_map_x(x + elements, map_width);
 
+    #if BN_CFG_BG_BLOCKS_MAX_MAP_CHUNKS
+        if(item.compression() != compression_type::NONE)
+        {
+            auto tiles_offset = unsigned(item.affine_tiles_offset());
+
+            for(int row = y, row_limit = y + canvas_viewport_size; row <= row_limit; ++row)
+            {
+                int fixed_row = row;
+
+                if(fixed_row >= map_height)
+                {
+                    fixed_row -= map_height;
+                }
+
+                uint8_t* dest_data = vram_data + (((row & canvas_viewport_size) << canvas_size_bits) + x_separator);
+                _commit_chunked_affine_map_cells(item, x, fixed_row, elements, false, tiles_offset, dest_data, 1);
+                _commit_chunked_affine_map_cells(item, second_x, fixed_row, x_separator, false, tiles_offset,
+                                                 dest_data - x_separator, 1);
+            }
+
+            return;
+        }
+    #endif
+
     if(auto tiles_offset = unsigned(item.affine_tiles_offset()))
     {
         uint16_t offset = hw::bg_blocks::affine_map_cells_offset(tiles_offset);
@@ -2940,6 +3528,13 @@ void update()
     }
 
     data.delay_commit = false;
+
+    #if BN_CFG_BG_BLOCKS_STAGING_BUFFER_SIZE
+        if(data.to_commit_compressed_items_count)
+        {
+            _stage_compressed_items();
+        }
+    #endif
 }
 
 void commit_uncompressed(bool use_dma)
@@ -2953,7 +3548,7 @@ void commit_uncompressed(bool use_dma)
             int item_index = data.to_commit_uncompressed_items_array[index];
             item_type& item = data.items.item(item_index);
             item.commit = false;
-            _commit_item(item, use_dma);
+            _commit_item(item, item.data, item.compression(), use_dma);
         }
 
         data.to_commit_uncompressed_items_count = 0;
@@ -2962,24 +3557,68 @@ void commit_uncompressed(bool use_dma)
     }
 }
 
-void commit_compressed()
+void commit_compressed([[maybe_unused]] bool use_dma)
 {
     if(int commit_items_count = data.to_commit_compressed_items_count)
     {
         BN_BG_BLOCKS_LOG("bg_blocks_manager - COMMIT COMPRESSED");
 
-        for(int index = 0; index < commit_items_count; ++index)
-        {
-            int item_index = data.to_commit_compressed_items_array[index];
-            item_type& item = data.items.item(item_index);
-            item.commit = false;
-            _commit_item(item, false);
-        }
+        #if BN_CFG_BG_BLOCKS_STAGING_BUFFER_SIZE
+            int pending_items_count = 0;
 
-        data.to_commit_compressed_items_count = 0;
+            for(int index = 0; index < commit_items_count; ++index)
+            {
+                int item_index = data.to_commit_compressed_items_array[index];
+                item_type& item = data.items.item(item_index);
+
+                if(_staged(item))
+                {
+                    item.commit = false;
+                    _commit_item(item, data.staging_half_words + item.staging_half_word, compression_type::NONE,
+                                 use_dma);
+                }
+                else if(! _stageable(item))
+                {
+                    item.commit = false;
+                    _commit_item(item, item.data, item.compression(), false);
+                }
+                else
+                {
+                    data.to_commit_compressed_items_array[pending_items_count] = uint8_t(item_index);
+                    ++pending_items_count;
+                }
+            }
+
+            data.to_commit_compressed_items_count = pending_items_count;
+        #else
+            for(int index = 0; index < commit_items_count; ++index)
+            {
+                int item_index = data.to_commit_compressed_items_array[index];
+                item_type& item = data.items.item(item_index);
+                item.commit = false;
+                _commit_item(item, item.data, item.compression(), false);
+            }
+
+            data.to_commit_compressed_items_count = 0;
+        #endif
 
         BN_BG_BLOCKS_LOG_STATUS();
     }
+
+    #if BN_CFG_BG_BLOCKS_STAGING_BUFFER_SIZE
+        if(int staged_items_count = data.staged_items_count)
+        {
+            for(int index = 0; index < staged_items_count; ++index)
+            {
+                data.items.item(data.staged_items_array[index]).staged_data = nullptr;
+            }
+
+            data.staged_items_count = 0;
+            data.staging_used_half_words_count = 0;
+        }
+    #endif
+
+    ++data.commits_count;
 }
 
 }
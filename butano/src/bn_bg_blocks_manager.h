@@ -23,6 +23,7 @@ namespace bn
     class regular_bg_map_item;
     class regular_bg_tiles_ptr;
     class regular_bg_tiles_item;
+    class iregular_bg_tiles_cache;
     enum class bpp_mode : uint8_t;
     enum class compression_type : uint8_t;
     enum class affine_bg_big_map_canvas_size : uint8_t;
@@ -80,6 +81,12 @@ namespace bn::bg_blocks_manager
                 const regular_bg_map_item& map_item, const regular_bg_map_cell* data_ptr,
                 regular_bg_tiles_ptr&& tiles, bg_palette_ptr&& palette, bool optional);
 
+    [[nodiscard]] int create_regular_streamed_map(
+                const regular_bg_map_item& map_item, const regular_bg_map_cell* data_ptr,
+                const span<const tile>& source_tiles_ref, const uint16_t* source_tile_indexes_ptr,
+                regular_bg_tiles_ptr&& tiles, bg_palette_ptr&& palette, iregular_bg_tiles_cache& tiles_cache,
+                bool optional);
+
     [[nodiscard]] int create_affine_map(
                 const affine_bg_map_item& map_item, const affine_bg_map_cell* data_ptr,
                 affine_bg_tiles_ptr&& tiles, bg_palette_ptr&& palette, bool optional);
@@ -162,8 +169,16 @@ namespace bn::bg_blocks_manager
 
     [[nodiscard]] optional<span<affine_bg_map_cell>> affine_map_vram(int id);
 
+    [[nodiscard]] bool streamed_map(int id);
+
+    [[nodiscard]] int commits_count();
+
     [[nodiscard]] bool must_commit(int id);
 
+    [[nodiscard]] bool ready(int id);
+
+    void load_big_map_chunks(int id, int x, int y);
+
     void update_regular_map_col(int id, int x, int y);
 
     inline void update_regular_map_left_col(int id, int x, int y)
@@ -214,7 +229,7 @@ namespace bn::bg_blocks_manager
 
     void commit_uncompressed(bool use_dma);
 
-    void commit_compressed();
+    void commit_compressed(bool use_dma);
 }
 
 #endif
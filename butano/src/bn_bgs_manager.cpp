@@ -26,6 +26,7 @@
 #include "bn_regular_bg_ptr.cpp.h"
 #include "bn_regular_bg_item.cpp.h"
 #include "bn_regular_bg_builder.cpp.h"
+#include "bn_regular_bg_streamed_item.cpp.h"
 #include "bn_regular_bg_attributes.cpp.h"
 
 namespace bn::bgs_manager
@@ -442,6 +443,7 @@ namespace
                     item->commit_big_map = true;
                     item->full_commit_big_map = full_commit_big_map || bn::abs(new_map_x - old_map_x) > 8 ||
                             bn::abs(new_map_y - old_map_y) > 8;
+                    bg_blocks_manager::load_big_map_chunks(map_handle, new_map_x, new_map_y);
                 }
             }
         }
@@ -1439,11 +1441,13 @@ void remove_camera(id_type id)
     }
 }
 
-void update_cameras()
+void update_camera(int camera_id)
 {
     for(item_type* item : data.items_vector)
     {
-        if(item->camera)
+        const camera_ptr* camera = item->camera.get();
+
+        if(camera && camera->id() == camera_id)
         {
             if(item->regular_map)
             {
@@ -193,7 +193,7 @@ namespace bgs_manager
 
     void remove_camera(id_type id);
 
-    void update_cameras();
+    void update_camera(int camera_id);
 
     void update_regular_map_tiles_cbb(int map_id, int tiles_cbb);
 
@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) 2020-2025 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_camera_3d.h"
+
+#include "bn_math.h"
+
+namespace bn
+{
+
+camera_3d::camera_3d(const point_3d& position, fixed phi) :
+    _position(position)
+{
+    set_phi(phi);
+}
+
+void camera_3d::set_phi(fixed phi)
+{
+    pair<fixed, fixed> sin_and_cos = degrees_lut_sin_and_cos(phi);
+    fixed phi_sin = sin_and_cos.first;
+    fixed phi_cos = sin_and_cos.second;
+    _phi = phi;
+
+    _u.set_x(phi_cos);
+    _u.set_z(phi_sin);
+
+    _v.set_x(phi_sin);
+    _v.set_z(-phi_cos);
+}
+
+}
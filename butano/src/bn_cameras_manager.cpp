@@ -30,6 +30,7 @@ namespace
     public:
         fixed_point position;
         unsigned usages = 0;
+        bool update = false;
     };
 
 
@@ -108,6 +109,7 @@ void decrease_usages(int id)
 
     if(! item.usages) [[unlikely]]
     {
+        item.update = false;
         data.free_item_indexes_array[data.free_item_indexes_size] = uint8_t(id);
         ++data.free_item_indexes_size;
     }
@@ -126,6 +128,7 @@ void set_x(int id, fixed x)
     if(item.position.x() != x)
     {
         item.position.set_x(x);
+        item.update = true;
         data.update = true;
     }
 }
@@ -137,6 +140,7 @@ void set_y(int id, fixed y)
     if(item.position.y() != y)
     {
         item.position.set_y(y);
+        item.update = true;
         data.update = true;
     }
 }
@@ -148,6 +152,7 @@ void set_position(int id, const fixed_point& position)
     if(item.position != position)
     {
         item.position = position;
+        item.update = true;
         data.update = true;
     }
 }
@@ -158,9 +163,20 @@ void update()
     {
         data.update = false;
 
-        display_manager::update_cameras();
-        sprites_manager::update_cameras();
-        bgs_manager::update_cameras();
+        // Only the sprites, backgrounds and windows attached to the moved cameras are updated:
+        for(int index = 0; index < max_items; ++index)
+        {
+            item_type& item = data.items[index];
+
+            if(item.update)
+            {
+                item.update = false;
+
+                display_manager::update_camera(index);
+                sprites_manager::update_camera(index);
+                bgs_manager::update_camera(index);
+            }
+        }
     }
 }
 
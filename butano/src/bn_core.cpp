@@ -13,8 +13,10 @@
 #include "bn_timers.h"
 #include "bn_version.h"
 #include "bn_profiler.h"
+#include "bn_config_tasks.h"
 #include "bn_system_font.h"
 #include "bn_bgs_manager.h"
+#include "bn_tasks_manager.h"
 #include "bn_hdma_manager.h"
 #include "bn_link_manager.h"
 #include "bn_gpio_manager.h"
@@ -28,6 +30,7 @@
 #include "bn_bg_blocks_manager.h"
 #include "bn_sprite_tiles_manager.h"
 #include "bn_hblank_effects_manager.h"
+#include "bn_vblank_monitor.h"
 #include "../hw/include/bn_hw_irq.h"
 #include "../hw/include/bn_hw_core.h"
 #include "../hw/include/bn_hw_gpio.h"
@@ -36,6 +39,7 @@
 #include "../hw/include/bn_hw_memory.h"
 #include "../hw/include/bn_hw_game_pak.h"
 #include "../hw/include/bn_hw_hblank_effects.h"
+#include "../hw/include/bn_hw_sprites_multiplexer.h"
 
 #if BN_CFG_ASSERT_ENABLED
     #include "bn_assert_callback_type.h"
@@ -107,6 +111,16 @@
         } while(false)
 #endif
 
+#if BN_CFG_VBLANK_MONITOR_ENABLED
+    #define BN_VBLANK_MONITOR_STAGE_END(commit_stage) \
+        stage_end_ticks[int(vblank_monitor::stage::commit_stage)] = data.cpu_usage_timer.elapsed_ticks()
+#else
+    #define BN_VBLANK_MONITOR_STAGE_END(commit_stage) \
+        do \
+        { \
+        } while(false)
+#endif
+
 namespace bn::core
 {
 
@@ -125,7 +139,7 @@ namespace
     {
 
     public:
-        vblank_callback_type vblank_callback = nullptr;
+        vblank_callback_type vblank_callback;
         #if BN_CFG_ASSERT_ENABLED
             assert::callback_type assert_callback = nullptr;
         #endif
@@ -239,6 +253,10 @@ namespace
         result.missed_frames = data.missed_frames;
         data.missed_frames = 0;
 
+        #if BN_CFG_VBLANK_MONITOR_ENABLED
+            int stage_end_ticks[vblank_monitor::stages_count()];
+        #endif
+
         BN_PROFILER_ENGINE_DETAILED_START("eng_hblank_fx_commit");
         hblank_effects_manager::disable();
         BN_PROFILER_ENGINE_DETAILED_STOP();
@@ -246,68 +264,90 @@ namespace
         BN_PROFILER_ENGINE_DETAILED_START("eng_audio_commands");
         audio_manager::execute_commands();
         BN_PROFILER_ENGINE_DETAILED_STOP();
+        BN_VBLANK_MONITOR_STAGE_END(AUDIO_COMMANDS);
 
         BN_PROFILER_ENGINE_DETAILED_START("eng_display_commit");
         display_manager::commit();
         BN_PROFILER_ENGINE_DETAILED_STOP();
+        BN_VBLANK_MONITOR_STAGE_END(DISPLAY);
 
         BN_PROFILER_ENGINE_DETAILED_START("eng_sprites_commit");
         sprites_manager::commit(use_dma);
         BN_PROFILER_ENGINE_DETAILED_STOP();
+        BN_VBLANK_MONITOR_STAGE_END(SPRITES);
 
         BN_PROFILER_ENGINE_DETAILED_START("eng_bgs_commit");
         bgs_manager::commit(use_dma);
         BN_PROFILER_ENGINE_DETAILED_STOP();
+        BN_VBLANK_MONITOR_STAGE_END(BGS);
 
         BN_PROFILER_ENGINE_DETAILED_START("eng_palettes_commit");
         palettes_manager::commit(use_dma);
         BN_PROFILER_ENGINE_DETAILED_STOP();
+        BN_VBLANK_MONITOR_STAGE_END(PALETTES);
 
         BN_PROFILER_ENGINE_DETAILED_START("eng_spr_tiles_unc_commit");
         sprite_tiles_manager::commit_uncompressed(use_dma);
         BN_PROFILER_ENGINE_DETAILED_STOP();
+        BN_VBLANK_MONITOR_STAGE_END(SPRITE_TILES_UNCOMPRESSED);
 
         BN_PROFILER_ENGINE_DETAILED_START("eng_hdma_update");
         hdma_manager::update();
         BN_PROFILER_ENGINE_DETAILED_STOP();
 
         bool hdma_running = hdma_manager::commit(use_dma);
+        BN_VBLANK_MONITOR_STAGE_END(HDMA);
 
         BN_PROFILER_ENGINE_DETAILED_START("eng_hblank_fx_commit");
         bool hblank_effects_running = hblank_effects_manager::commit();
         BN_PROFILER_ENGINE_DETAILED_STOP();
+        BN_VBLANK_MONITOR_STAGE_END(HBLANK_EFFECTS);
 
         BN_PROFILER_ENGINE_DETAILED_START("eng_big_maps_commit");
         bgs_manager::commit_big_maps();
         BN_PROFILER_ENGINE_DETAILED_STOP();
+        BN_VBLANK_MONITOR_STAGE_END(BIG_MAPS);
 
         use_dma = use_dma && ! hdma_running && ! hblank_effects_running;
 
         BN_PROFILER_ENGINE_DETAILED_START("eng_bg_blocks_unc_commit");
         bg_blocks_manager::commit_uncompressed(use_dma);
         BN_PROFILER_ENGINE_DETAILED_STOP();
+        BN_VBLANK_MONITOR_STAGE_END(BG_BLOCKS_UNCOMPRESSED);
 
         BN_PROFILER_ENGINE_DETAILED_START("eng_spr_tiles_cmp_commit");
-        sprite_tiles_manager::commit_compressed();
+        sprite_tiles_manager::commit_compressed(use_dma);
         BN_PROFILER_ENGINE_DETAILED_STOP();
+        BN_VBLANK_MONITOR_STAGE_END(SPRITE_TILES_COMPRESSED);
 
         BN_PROFILER_ENGINE_DETAILED_START("eng_bg_blocks_cmp_commit");
-        bg_blocks_manager::commit_compressed();
+        bg_blocks_manager::commit_compressed(use_dma);
         BN_PROFILER_ENGINE_DETAILED_STOP();
+        BN_VBLANK_MONITOR_STAGE_END(BG_BLOCKS_COMPRESSED);
 
         BN_PROFILER_ENGINE_DETAILED_START("eng_vblank_callback");
-        if(vblank_callback_type vblank_callback = data.vblank_callback)
+        if(data.vblank_callback)
         {
+            // The callback can replace itself, so a copy is called:
+            vblank_callback_type vblank_callback = data.vblank_callback;
             vblank_callback();
         }
         BN_PROFILER_ENGINE_DETAILED_STOP();
 
         result.vblank_usage_ticks = data.cpu_usage_timer.elapsed_ticks();
 
+        #if BN_CFG_VBLANK_MONITOR_ENABLED
+            stage_end_ticks[int(vblank_monitor::stage::VBLANK_CALLBACK)] = result.vblank_usage_ticks;
+        #endif
+
         BN_PROFILER_ENGINE_DETAILED_START("eng_audio_commit");
         audio_manager::commit();
         BN_PROFILER_ENGINE_DETAILED_STOP();
 
+        #if BN_CFG_VBLANK_MONITOR_ENABLED
+            _bn::vblank_monitor::add_frame(stage_end_ticks);
+        #endif
+
         BN_PROFILER_ENGINE_GENERAL_STOP();
 
         return result;
@@ -343,6 +383,10 @@ void init(const optional<color>& transparent_color, const string_view& keypad_co
     hw::irq::init();
     hw::irq::set_isr(hw::irq::id::HBLANK, hw::hblank_effects::_intr);
 
+    #if BN_CFG_SPRITES_MULTIPLEXING_ENABLED
+        hw::irq::set_isr(hw::irq::id::VCOUNT, hw::sprites_multiplexer::_intr);
+    #endif
+
     // Init hdma system:
     hdma_manager::init();
 
@@ -373,6 +417,7 @@ void init(const optional<color>& transparent_color, const string_view& keypad_co
     bg_blocks_manager::init();
     bgs_manager::init();
     keypad_manager::init(keypad_commands);
+    tasks_manager::init();
 
     // First update:
     update();
@@ -430,6 +475,16 @@ void update()
     BN_PROFILER_ENGINE_DETAILED_START("eng_keypad");
     keypad_manager::update();
     BN_PROFILER_ENGINE_DETAILED_STOP();
+
+    #if BN_CFG_TASKS_MAX_ITEMS
+        BN_PROFILER_ENGINE_DETAILED_START("eng_tasks_update");
+        tasks_manager::update();
+        BN_PROFILER_ENGINE_DETAILED_STOP();
+    #endif
+
+    #if BN_CFG_PROFILER_ENABLED
+        _bn::profiler::new_frame();
+    #endif
 }
 
 void on_vblank()
@@ -549,12 +604,12 @@ int last_missed_frames()
     return data.last_ticks.missed_frames;
 }
 
-vblank_callback_type vblank_callback()
+const vblank_callback_type& vblank_callback()
 {
     return data.vblank_callback;
 }
 
-void set_vblank_callback(vblank_callback_type vblank_callback)
+void set_vblank_callback(const vblank_callback_type& vblank_callback)
 {
     data.vblank_callback = vblank_callback;
 }
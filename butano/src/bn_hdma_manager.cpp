@@ -11,6 +11,7 @@
 #include "../hw/include/bn_hw_memory.h"
 
 #include "bn_hdma.cpp.h"
+#include "bn_palette_bands.cpp.h"
 
 namespace bn::hdma_manager
 {
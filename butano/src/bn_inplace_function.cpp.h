@@ -0,0 +1,18 @@
+/*
+ * Copyright (c) 2020-2025 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_inplace_function.h"
+
+#include "bn_assert.h"
+
+namespace _bn
+{
+
+void inplace_function_empty_error()
+{
+    BN_ERROR("Function is empty");
+}
+
+}
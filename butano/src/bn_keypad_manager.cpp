@@ -106,6 +106,11 @@ bool any_held()
     return data.held_keys;
 }
 
+unsigned held_keys()
+{
+    return data.held_keys;
+}
+
 bool any_pressed()
 {
     return data.pressed_keys;
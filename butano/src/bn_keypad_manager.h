@@ -24,6 +24,8 @@ namespace bn::keypad_manager
 
     [[nodiscard]] bool any_held();
 
+    [[nodiscard]] unsigned held_keys();
+
     [[nodiscard]] bool any_pressed();
 
     [[nodiscard]] bool any_released();
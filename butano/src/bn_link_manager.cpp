@@ -8,6 +8,9 @@
 #include "../hw/include/bn_hw_link.h"
 
 #include "bn_link.cpp.h"
+#include "bn_link_stream.cpp.h"
+#include "bn_link_stream_loopback.cpp.h"
+#include "bn_link_rollback_session.cpp.h"
 
 namespace bn::link_manager
 {
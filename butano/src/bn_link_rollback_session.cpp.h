@@ -0,0 +1,301 @@
+/*
+ * Copyright (c) 2020-2025 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_link_rollback_session.h"
+
+#include "bn_link.h"
+#include "bn_timer.h"
+#include "bn_algorithm.h"
+#include "bn_link_state.h"
+#include "bn_keypad_manager.h"
+
+namespace bn
+{
+
+namespace
+{
+    static_assert(BN_CFG_LINK_ROLLBACK_WORDS_PER_UPDATE > 1 && BN_CFG_LINK_ROLLBACK_WORDS_PER_UPDATE <= 127);
+
+    // Keypad words: frame (5 bits) and keys (10 bits).
+    // Ack words: flag, first frame of the following keypad words (5 bits) and last received frame (5 bits):
+    constexpr unsigned link_rollback_ack_flag = 0x8000;
+    constexpr unsigned link_rollback_keys_mask = 0x3FF;
+    constexpr int link_rollback_keys_bits = 10;
+    constexpr int link_rollback_frame_bits = 5;
+    constexpr int link_rollback_frame_mask = 31;
+}
+
+link_rollback_session::link_rollback_session(int input_delay, int max_rollback_frames) :
+    _input_delay(input_delay),
+    _max_rollback_frames(max_rollback_frames),
+    _local_frame(input_delay - 1),
+    _sent_frame(input_delay - 1),
+    _confirmed_frame(input_delay - 1),
+    _peer_confirmed_frame(input_delay - 1),
+    _remote_first_frame(input_delay),
+    _rollback_frame(-1)
+{
+    BN_ASSERT(input_delay >= 0 && input_delay <= max_input_delay(), "Invalid input delay: ", input_delay);
+    BN_ASSERT(max_rollback_frames >= 0 && max_rollback_frames <= max_max_rollback_frames(),
+              "Invalid max rollback frames: ", max_rollback_frames);
+
+    for(int& remote_frame : _remote_frames)
+    {
+        remote_frame = -1;
+    }
+}
+
+void link_rollback_session::reset_stats()
+{
+    _last_rollback_frames = 0;
+    _last_resimulation_ticks = 0;
+    _peak_rollback_frames = 0;
+    _peak_resimulation_ticks = 0;
+    _rollbacks_count = 0;
+    _stalled_updates = 0;
+}
+
+void link_rollback_session::push_received_word(int word)
+{
+    auto unsigned_word = unsigned(word);
+
+    if(unsigned_word & link_rollback_ack_flag)
+    {
+        int confirmed_frame_bits = int(unsigned_word & link_rollback_frame_mask);
+        int confirmed_frame = _local_frame - ((_local_frame - confirmed_frame_bits) & link_rollback_frame_mask);
+        _peer_confirmed_frame = max(_peer_confirmed_frame, confirmed_frame);
+
+        // The other player only sends keys of frames not confirmed by this player, so its first frame
+        // can't be greater than confirmed_frame() + 1:
+        int next_frame = _confirmed_frame + 1;
+        int first_frame_bits = int(unsigned_word >> link_rollback_frame_bits) & link_rollback_frame_mask;
+        _remote_first_frame = next_frame - ((next_frame - first_frame_bits) & link_rollback_frame_mask);
+        return;
+    }
+
+    int first_frame = _remote_first_frame;
+    int frame_bits = int(unsigned_word >> link_rollback_keys_bits) & link_rollback_frame_mask;
+    int frame = first_frame + ((frame_bits - first_frame) & link_rollback_frame_mask);
+
+    if(frame <= _confirmed_frame)
+    {
+        return;
+    }
+
+    int slot = frame & link_rollback_frame_mask;
+    _remote_frames[slot] = frame;
+    _remote_keys[slot] = uint16_t(unsigned_word & link_rollback_keys_mask);
+
+    while(_remote_frames[(_confirmed_frame + 1) & link_rollback_frame_mask] == _confirmed_frame + 1)
+    {
+        int confirmed_frame = _confirmed_frame + 1;
+        int confirmed_slot = confirmed_frame & link_rollback_frame_mask;
+        _confirmed_frame = confirmed_frame;
+
+        if(confirmed_frame < _frame && _rollback_frame < 0 &&
+                _remote_keys[confirmed_slot] != _predicted_keys[confirmed_slot])
+        {
+            _rollback_frame = confirmed_frame;
+        }
+    }
+}
+
+optional<int> link_rollback_session::pop_sent_word()
+{
+    optional<int> result;
+    int sent_words_index = _sent_words_index;
+
+    if(sent_words_index < _sent_words_count)
+    {
+        result = int(_sent_words[sent_words_index]);
+        _sent_words_index = int8_t(sent_words_index + 1);
+    }
+
+    return result;
+}
+
+bool link_rollback_session::_update(void* simulation, save_type save, restore_type restore,
+                                    simulate_type simulate)
+{
+    unsigned local_keys = keypad_manager::held_keys();
+
+    while(optional<link_state> state = link::receive())
+    {
+        if(state->player_count() == 2)
+        {
+            _player_id = state->current_player_id();
+
+            for(const link_player& other_player : state->other_players())
+            {
+                push_received_word(other_player.data());
+            }
+        }
+    }
+
+    bool result = _update_frame(local_keys, simulation, save, restore, simulate);
+
+    while(optional<int> word = pop_sent_word())
+    {
+        link::send(*word);
+    }
+
+    return result;
+}
+
+bool link_rollback_session::_update(int player_id, unsigned local_keys, void* simulation, save_type save,
+                                    restore_type restore, simulate_type simulate)
+{
+    BN_ASSERT(player_id == 0 || player_id == 1, "Invalid player ID: ", player_id);
+    BN_ASSERT(_player_id < 0 || _player_id == player_id, "Player ID can't change: ", _player_id, " - ", player_id);
+
+    _player_id = player_id;
+    return _update_frame(local_keys, simulation, save, restore, simulate);
+}
+
+bool link_rollback_session::_update_frame(unsigned local_keys, void* simulation, save_type save,
+                                          restore_type restore, simulate_type simulate)
+{
+    _last_rollback_frames = 0;
+    _last_resimulation_ticks = 0;
+
+    // Keys read in stalled updates are discarded:
+    int local_frame = _frame + _input_delay;
+
+    if(local_frame > _local_frame)
+    {
+        _local_keys[local_frame & link_rollback_frame_mask] = uint16_t(local_keys & link_rollback_keys_mask);
+        _local_frame = local_frame;
+    }
+
+    bool result = false;
+
+    if(_player_id >= 0)
+    {
+        if(int rollback_frame = _rollback_frame; rollback_frame >= 0)
+        {
+            timer resimulation_timer;
+            restore(simulation, rollback_frame % _max_rollback_frames);
+
+            for(int frame = rollback_frame; frame < _frame; ++frame)
+            {
+                _simulate_frame(frame, frame != rollback_frame, simulation, save, simulate);
+            }
+
+            int rollback_frames = _frame - rollback_frame;
+            int resimulation_ticks = resimulation_timer.elapsed_ticks();
+            _last_rollback_frames = rollback_frames;
+            _last_resimulation_ticks = resimulation_ticks;
+            _peak_rollback_frames = max(_peak_rollback_frames, rollback_frames);
+            _peak_resimulation_ticks = max(_peak_resimulation_ticks, resimulation_ticks);
+            _rollback_frame = -1;
+            ++_rollbacks_count;
+        }
+
+        if(_frame - _confirmed_frame <= _max_rollback_frames)
+        {
+            _simulate_frame(_frame, true, simulation, save, simulate);
+            ++_frame;
+            result = true;
+        }
+    }
+
+    if(! result)
+    {
+        ++_stalled_updates;
+    }
+
+    _send_words();
+    return result;
+}
+
+unsigned link_rollback_session::_frame_remote_keys(int frame) const
+{
+    // Unconfirmed keys are predicted repeating the last confirmed ones:
+    int confirmed_frame = _confirmed_frame;
+
+    if(frame > confirmed_frame)
+    {
+        if(confirmed_frame < 0)
+        {
+            return 0;
+        }
+
+        frame = confirmed_frame;
+    }
+
+    return _remote_keys[frame & link_rollback_frame_mask];
+}
+
+void link_rollback_session::_send_words()
+{
+    // Sent keys must be in the range [first_frame..first_frame + 31], so the other player can decode their frame:
+    int local_frame = _local_frame;
+    int min_frame = local_frame - link_rollback_frame_mask + 1;
+    int first_frame = max(_peer_confirmed_frame + 1, min_frame);
+    unsigned first_frame_bits = unsigned(first_frame & link_rollback_frame_mask) << link_rollback_frame_bits;
+    unsigned confirmed_frame_bits = unsigned(_confirmed_frame & link_rollback_frame_mask);
+    _sent_words_count = 0;
+    _sent_words_index = 0;
+    _send_word(link_rollback_ack_flag | first_frame_bits | confirmed_frame_bits);
+
+    int pending_words = BN_CFG_LINK_ROLLBACK_WORDS_PER_UPDATE - 1;
+
+    // New keys are sent first:
+    int first_new_frame = max(_sent_frame + 1, min_frame);
+
+    for(int frame = first_new_frame; frame <= local_frame && pending_words; ++frame, --pending_words)
+    {
+        _send_keys(frame);
+        _sent_frame = frame;
+    }
+
+    // Keys not acknowledged by the other player are sent again with the remaining words:
+    for(int frame = first_frame; frame < first_new_frame && pending_words; ++frame, --pending_words)
+    {
+        _send_keys(frame);
+    }
+}
+
+void link_rollback_session::_send_word(unsigned word)
+{
+    int sent_words_count = _sent_words_count;
+    _sent_words[sent_words_count] = uint16_t(word);
+    _sent_words_count = int8_t(sent_words_count + 1);
+}
+
+void link_rollback_session::_send_keys(int frame)
+{
+    int slot = frame & link_rollback_frame_mask;
+    _send_word((unsigned(slot) << link_rollback_keys_bits) | _local_keys[slot]);
+}
+
+void link_rollback_session::_simulate_frame(int frame, bool save_state, void* simulation, save_type save,
+                                            simulate_type simulate)
+{
+    unsigned remote_keys = _frame_remote_keys(frame);
+    unsigned local_keys = _local_keys[frame & link_rollback_frame_mask];
+
+    // Predicted frames can be rolled back:
+    if(frame > _confirmed_frame)
+    {
+        if(save_state)
+        {
+            save(simulation, frame % _max_rollback_frames);
+        }
+
+        _predicted_keys[frame & link_rollback_frame_mask] = uint16_t(remote_keys);
+    }
+
+    if(_player_id == 0)
+    {
+        simulate(simulation, local_keys, remote_keys);
+    }
+    else
+    {
+        simulate(simulation, remote_keys, local_keys);
+    }
+}
+
+}
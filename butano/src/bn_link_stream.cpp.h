@@ -0,0 +1,426 @@
+/*
+ * Copyright (c) 2020-2025 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_link_stream.h"
+
+#include "bn_link.h"
+#include "bn_algorithm.h"
+#include "bn_link_state.h"
+
+namespace bn
+{
+
+namespace
+{
+    // Words greater or equal than the escape word are sent as the escape word followed by the difference:
+    constexpr unsigned link_stream_sync_word = 65533;
+    constexpr unsigned link_stream_escape_word = 65532;
+
+    // Packet header: type (2 bits), sequence number (7 bits) and acknowledged sequence number (7 bits):
+    constexpr unsigned link_stream_data_type = 0;
+    constexpr unsigned link_stream_ack_type = 1;
+    constexpr int link_stream_sequence_mask = 127;
+
+    [[nodiscard]] unsigned _link_stream_checksum(const uint16_t* words, int words_count)
+    {
+        // Fletcher-16 of the bytes of the given words, with the modulo operations deferred to the end:
+        unsigned sum1 = 0;
+        unsigned sum2 = 0;
+
+        for(int index = 0; index < words_count; ++index)
+        {
+            unsigned word = words[index];
+            sum1 += word & 0xFF;
+            sum2 += sum1;
+            sum1 += word >> 8;
+            sum2 += sum1;
+        }
+
+        return ((sum2 % 255) << 8) | (sum1 % 255);
+    }
+}
+
+ilink_stream::ilink_stream(uint8_t* send_buffer, int max_send_size, uint8_t* receive_buffer,
+                           int max_received_size) :
+    _send_buffer(send_buffer),
+    _receive_buffer(receive_buffer),
+    _send_mask(max_send_size - 1),
+    _receive_mask(max_received_size - 1)
+{
+}
+
+void ilink_stream::set_words_per_update(int words_per_update)
+{
+    BN_ASSERT(words_per_update > 0, "Invalid words per update: ", words_per_update);
+
+    _words_per_update = words_per_update;
+}
+
+int ilink_stream::write(const span<const uint8_t>& bytes)
+{
+    int result = min(int(bytes.size()), available_send_size());
+    const uint8_t* bytes_data = bytes.data();
+    int send_end = _send_begin + _send_size;
+
+    for(int index = 0; index < result; ++index)
+    {
+        _send_buffer[(send_end + index) & _send_mask] = bytes_data[index];
+    }
+
+    _send_size += result;
+    return result;
+}
+
+int ilink_stream::read(span<uint8_t>& bytes)
+{
+    int result = min(int(bytes.size()), _receive_size);
+    uint8_t* bytes_data = bytes.data();
+    int receive_begin = _receive_begin;
+
+    for(int index = 0; index < result; ++index)
+    {
+        bytes_data[index] = _receive_buffer[(receive_begin + index) & _receive_mask];
+    }
+
+    _receive_begin = (receive_begin + result) & _receive_mask;
+    _receive_size -= result;
+    return result;
+}
+
+void ilink_stream::reset()
+{
+    _send_begin = 0;
+    _send_size = 0;
+    _in_flight_size = 0;
+    _emit_offset = 0;
+    _receive_begin = 0;
+    _receive_size = 0;
+    _retransmit_counter = 0;
+    _sent_packets = 0;
+    _retransmitted_packets = 0;
+    _received_packets = 0;
+    _discarded_packets = 0;
+    _base_sequence = 0;
+    _next_sequence = 0;
+    _emit_sequence = 0;
+    _expected_sequence = 0;
+    _out_words_index = 0;
+    _out_words_count = 0;
+    _in_words_count = 0;
+    _in_packet = false;
+    _in_escape = false;
+    _ack_pending = false;
+}
+
+void ilink_stream::update()
+{
+    tick();
+
+    while(optional<link_state> state = link::receive())
+    {
+        if(state->player_count() == 2)
+        {
+            for(const link_player& other_player : state->other_players())
+            {
+                push_received_word(other_player.data());
+            }
+        }
+    }
+
+    for(int index = 0; index < _words_per_update; ++index)
+    {
+        optional<int> word = pop_sent_word();
+
+        if(! word)
+        {
+            break;
+        }
+
+        link::send(*word);
+    }
+}
+
+void ilink_stream::tick()
+{
+    // If all packets in flight have been sent and they are not acknowledged in time, they are sent again:
+    if(_in_flight_size && _emit_sequence == _next_sequence)
+    {
+        ++_retransmit_counter;
+
+        if(_retransmit_counter >= BN_CFG_LINK_STREAM_RETRANSMIT_WAIT)
+        {
+            _retransmit_counter = 0;
+            _emit_sequence = _base_sequence;
+            _emit_offset = 0;
+        }
+    }
+}
+
+optional<int> ilink_stream::pop_sent_word()
+{
+    optional<int> result;
+
+    if(_out_words_index == _out_words_count)
+    {
+        _build_packet();
+    }
+
+    if(_out_words_index < _out_words_count)
+    {
+        result = _out_words[_out_words_index];
+        ++_out_words_index;
+    }
+
+    return result;
+}
+
+void ilink_stream::push_received_word(int word)
+{
+    BN_ASSERT(word >= 0 && word <= 65533, "Invalid word: ", word);
+
+    auto unsigned_word = unsigned(word);
+
+    if(unsigned_word == link_stream_sync_word)
+    {
+        _in_words_count = 0;
+        _in_packet = true;
+        _in_escape = false;
+        return;
+    }
+
+    if(! _in_packet)
+    {
+        return;
+    }
+
+    if(_in_escape)
+    {
+        _in_escape = false;
+        unsigned_word += link_stream_escape_word;
+
+        if(unsigned_word > 0xFFFF)
+        {
+            _in_packet = false;
+            ++_discarded_packets;
+            return;
+        }
+    }
+    else if(unsigned_word == link_stream_escape_word)
+    {
+        _in_escape = true;
+        return;
+    }
+
+    _in_words[_in_words_count] = uint16_t(unsigned_word);
+    ++_in_words_count;
+
+    int in_words_count = _in_words_count;
+    unsigned type = _in_words[0] >> 14;
+    int packet_words_count;
+
+    if(type == link_stream_ack_type)
+    {
+        packet_words_count = 2;
+    }
+    else if(type == link_stream_data_type)
+    {
+        if(in_words_count < 2)
+        {
+            return;
+        }
+
+        int size = _in_words[1];
+
+        if(size <= 0 || size > _max_packet_size)
+        {
+            _in_packet = false;
+            ++_discarded_packets;
+            return;
+        }
+
+        packet_words_count = 3 + ((size + 1) / 2);
+    }
+    else
+    {
+        _in_packet = false;
+        ++_discarded_packets;
+        return;
+    }
+
+    if(in_words_count == packet_words_count)
+    {
+        _in_packet = false;
+
+        if(_link_stream_checksum(_in_words, in_words_count - 1) == _in_words[in_words_count - 1])
+        {
+            _process_packet();
+        }
+        else
+        {
+            ++_discarded_packets;
+        }
+    }
+}
+
+int ilink_stream::_in_flight_packets() const
+{
+    return (_next_sequence - _base_sequence) & link_stream_sequence_mask;
+}
+
+void ilink_stream::_push_out_word(unsigned word)
+{
+    if(word >= link_stream_escape_word)
+    {
+        _out_words[_out_words_count] = uint16_t(link_stream_escape_word);
+        ++_out_words_count;
+        word -= link_stream_escape_word;
+    }
+
+    _out_words[_out_words_count] = uint16_t(word);
+    ++_out_words_count;
+}
+
+void ilink_stream::_build_packet()
+{
+    int sequence = _emit_sequence;
+    int size = 0;
+    int offset = 0;
+    unsigned type = link_stream_data_type;
+    _out_words_index = 0;
+    _out_words_count = 0;
+
+    if(_emit_sequence != _next_sequence)
+    {
+        size = _packet_sizes[sequence & (_max_packets_in_flight - 1)];
+        offset = _emit_offset;
+        ++_retransmitted_packets;
+    }
+    else if(_in_flight_size < _send_size && _in_flight_packets() < _max_packets_in_flight)
+    {
+        size = min(_send_size - _in_flight_size, _max_packet_size);
+        offset = _in_flight_size;
+        _packet_sizes[sequence & (_max_packets_in_flight - 1)] = uint8_t(size);
+        _in_flight_size += size;
+        _next_sequence = uint8_t((sequence + 1) & link_stream_sequence_mask);
+        ++_sent_packets;
+    }
+    else if(_ack_pending)
+    {
+        type = link_stream_ack_type;
+    }
+    else
+    {
+        return;
+    }
+
+    uint16_t words[_max_packet_words];
+    int words_count = 0;
+    words[words_count] = uint16_t((type << 14) | unsigned(sequence << 7) | _expected_sequence);
+    ++words_count;
+
+    if(size)
+    {
+        words[words_count] = uint16_t(size);
+        ++words_count;
+
+        int send_begin = _send_begin + offset;
+
+        for(int index = 0; index < size; index += 2)
+        {
+            unsigned low = _send_buffer[(send_begin + index) & _send_mask];
+            unsigned high = index + 1 < size ? _send_buffer[(send_begin + index + 1) & _send_mask] : 0;
+            words[words_count] = uint16_t(low | (high << 8));
+            ++words_count;
+        }
+
+        _emit_sequence = uint8_t((sequence + 1) & link_stream_sequence_mask);
+        _emit_offset = offset + size;
+    }
+
+    words[words_count] = uint16_t(_link_stream_checksum(words, words_count));
+    ++words_count;
+
+    // Acknowledgements are sent in every packet:
+    _ack_pending = false;
+
+    _out_words[_out_words_count] = uint16_t(link_stream_sync_word);
+    ++_out_words_count;
+
+    for(int index = 0; index < words_count; ++index)
+    {
+        _push_out_word(words[index]);
+    }
+}
+
+void ilink_stream::_process_ack(int ack)
+{
+    int base_sequence = _base_sequence;
+    int acked_packets = (ack - base_sequence) & link_stream_sequence_mask;
+
+    if(! acked_packets || acked_packets > _in_flight_packets())
+    {
+        return;
+    }
+
+    int emitted_packets = (_emit_sequence - base_sequence) & link_stream_sequence_mask;
+    int acked_size = 0;
+
+    for(int index = 0; index < acked_packets; ++index)
+    {
+        acked_size += _packet_sizes[(base_sequence + index) & (_max_packets_in_flight - 1)];
+    }
+
+    _send_begin = (_send_begin + acked_size) & _send_mask;
+    _send_size -= acked_size;
+    _in_flight_size -= acked_size;
+    _base_sequence = uint8_t(ack);
+    _retransmit_counter = 0;
+
+    if(acked_packets >= emitted_packets)
+    {
+        _emit_sequence = uint8_t(ack);
+        _emit_offset = 0;
+    }
+    else
+    {
+        _emit_offset -= acked_size;
+    }
+}
+
+void ilink_stream::_process_packet()
+{
+    unsigned header = _in_words[0];
+    _process_ack(int(header & link_stream_sequence_mask));
+
+    if(header >> 14 == link_stream_data_type)
+    {
+        int sequence = int((header >> 7) & link_stream_sequence_mask);
+        int size = _in_words[1];
+
+        // Out of order packets are discarded (they are sent again after the missing ones):
+        if(sequence == _expected_sequence && size <= max_received_size() - _receive_size)
+        {
+            int receive_end = _receive_begin + _receive_size;
+
+            for(int index = 0; index < size; ++index)
+            {
+                unsigned word = _in_words[2 + (index / 2)];
+                _receive_buffer[(receive_end + index) & _receive_mask] = uint8_t(index % 2 ? word >> 8 : word);
+            }
+
+            _receive_size += size;
+            _expected_sequence = uint8_t((sequence + 1) & link_stream_sequence_mask);
+            ++_received_packets;
+        }
+        else
+        {
+            ++_discarded_packets;
+        }
+
+        _ack_pending = true;
+    }
+}
+
+}
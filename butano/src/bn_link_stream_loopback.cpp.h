@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2020-2025 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_link_stream_loopback.h"
+
+#include "bn_link_stream.h"
+
+namespace bn
+{
+
+link_stream_loopback::link_stream_loopback(ilink_stream& first_stream, ilink_stream& second_stream,
+                                           unsigned seed) :
+    _first_stream(first_stream),
+    _second_stream(second_stream),
+    _random(seed)
+{
+    BN_ASSERT(&first_stream != &second_stream, "Both streams are the same");
+}
+
+void link_stream_loopback::set_latency(int latency)
+{
+    BN_ASSERT(latency >= 0, "Invalid latency: ", latency);
+
+    _latency = latency;
+}
+
+void link_stream_loopback::set_drop_one_in(int drop_one_in)
+{
+    BN_ASSERT(drop_one_in >= 0, "Invalid drop one in: ", drop_one_in);
+
+    _drop_one_in = drop_one_in;
+}
+
+void link_stream_loopback::set_corrupt_one_in(int corrupt_one_in)
+{
+    BN_ASSERT(corrupt_one_in >= 0, "Invalid corrupt one in: ", corrupt_one_in);
+
+    _corrupt_one_in = corrupt_one_in;
+}
+
+void link_stream_loopback::update()
+{
+    _update(_first_stream, _second_to_first_words, _first_to_second_words);
+    _update(_second_stream, _first_to_second_words, _second_to_first_words);
+    ++_updates;
+}
+
+void link_stream_loopback::_update(ilink_stream& stream, ideque<word_type>& received_words,
+                                   ideque<word_type>& sent_words)
+{
+    stream.tick();
+
+    while(! received_words.empty() && received_words.front().delivery_update <= _updates)
+    {
+        stream.push_received_word(received_words.front().data);
+        received_words.pop_front();
+    }
+
+    for(int index = 0, limit = stream.words_per_update(); index < limit; ++index)
+    {
+        optional<int> word = stream.pop_sent_word();
+
+        if(! word)
+        {
+            break;
+        }
+
+        if(_drop_one_in && ! _random.get_int(_drop_one_in))
+        {
+            ++_dropped_words;
+            continue;
+        }
+
+        int data = *word;
+
+        if(_corrupt_one_in && ! _random.get_int(_corrupt_one_in))
+        {
+            data = _random.get_int(65534);
+            ++_corrupted_words;
+        }
+
+        if(sent_words.full())
+        {
+            sent_words.pop_front();
+            ++_dropped_words;
+        }
+
+        sent_words.push_back(word_type{ _updates + _latency, uint16_t(data) });
+    }
+}
+
+}
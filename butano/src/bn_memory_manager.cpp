@@ -5,6 +5,7 @@
 
 #include "bn_memory_manager.h"
 
+#include "bn_config_ewram.h"
 #include "bn_best_fit_allocator.h"
 #include "../hw/include/bn_hw_memory.h"
 
@@ -33,7 +34,7 @@ void init()
 
     char* start = hw::memory::ewram_heap_start();
     char* end = hw::memory::ewram_heap_end();
-    data.allocator.reset(static_cast<void*>(start), end - start);
+    data.allocator.reset(static_cast<void*>(start), end - start, BN_CFG_EWRAM_HEAP_SEGREGATED_FIT);
 }
 
 void* ewram_alloc(int bytes)
@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2020-2025 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_model_3d.h"
+
+#include "bn_math.h"
+
+namespace bn
+{
+
+void model_3d::set_rotation(fixed phi, fixed theta, fixed psi)
+{
+    pair<fixed, fixed> phi_sin_and_cos = degrees_lut_sin_and_cos(phi);
+    pair<fixed, fixed> theta_sin_and_cos = degrees_lut_sin_and_cos(theta);
+    pair<fixed, fixed> psi_sin_and_cos = degrees_lut_sin_and_cos(psi);
+    fixed phi_sin = phi_sin_and_cos.first;
+    fixed phi_cos = phi_sin_and_cos.second;
+    fixed theta_sin = theta_sin_and_cos.first;
+    fixed theta_cos = theta_sin_and_cos.second;
+    fixed psi_sin = psi_sin_and_cos.first;
+    fixed psi_cos = psi_sin_and_cos.second;
+    _phi = phi;
+    _theta = theta;
+    _psi = psi;
+
+    fixed phi_cos_theta_sin = phi_cos.unsafe_multiplication(theta_sin);
+    _xx = phi_cos.unsafe_multiplication(theta_cos);
+    _xy = phi_cos_theta_sin.unsafe_multiplication(psi_sin) - phi_sin.unsafe_multiplication(psi_cos);
+    _xz = phi_cos_theta_sin.unsafe_multiplication(psi_cos) + phi_sin.unsafe_multiplication(psi_sin);
+
+    fixed phi_sin_theta_sin = phi_sin.unsafe_multiplication(theta_sin);
+    _yx = phi_sin.unsafe_multiplication(theta_cos);
+    _yy = phi_sin_theta_sin.unsafe_multiplication(psi_sin) + phi_cos.unsafe_multiplication(psi_cos);
+    _yz = phi_sin_theta_sin.unsafe_multiplication(psi_cos) - phi_cos.unsafe_multiplication(psi_sin);
+
+    _zx = -theta_sin;
+    _zy = theta_cos.unsafe_multiplication(psi_sin);
+    _zz = theta_cos.unsafe_multiplication(psi_cos);
+
+    _xx_xy = _xx.unsafe_multiplication(_xy);
+    _yx_yy = _yx.unsafe_multiplication(_yy);
+    _zx_zy = _zx.unsafe_multiplication(_zy);
+}
+
+}
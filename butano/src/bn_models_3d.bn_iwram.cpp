@@ -0,0 +1,538 @@
+/*
+ * Copyright (c) 2020-2025 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_models_3d.h"
+
+#include "bn_array.h"
+#include "bn_algorithm.h"
+#include "bn_camera_3d.h"
+#include "../hw/include/bn_hw_sprites.h"
+
+namespace bn
+{
+
+namespace
+{
+    constexpr int division_lut_precision = 24;
+    constexpr int division_lut_size = 1024 * 4;
+    constexpr int hlines_precision = 18;
+    constexpr int split_length = 64 - 2;
+
+    using hlines_fixed = fixed_t<hlines_precision>;
+
+    constexpr array<uint32_t, division_lut_size> division_lut = []{
+        array<uint32_t, division_lut_size> result;
+        result[0] = 1 << division_lut_precision;
+
+        for(int index = 1; index < division_lut_size; ++index)
+        {
+            result[index] = uint32_t(calculate_reciprocal_lut_value<division_lut_precision>(index).data());
+        }
+
+        return result;
+    }();
+
+
+    class vertex_2d
+    {
+
+    public:
+        int x;
+        int y;
+        vertex_2d* prev;
+        vertex_2d* next;
+    };
+
+
+    [[nodiscard]] hlines_fixed _hlines_delta(int delta_x, int delta_y)
+    {
+        if(delta_y < division_lut_size) [[likely]]
+        {
+            int division_lut_value = int(division_lut[delta_y] >> (division_lut_precision - hlines_precision));
+            return hlines_fixed::from_data(delta_x * division_lut_value);
+        }
+
+        return hlines_fixed::from_data(int((int64_t(delta_x) << hlines_precision) / delta_y));
+    }
+}
+
+void imodels_3d::_process_models(const camera_3d& camera)
+{
+    constexpr int display_width = display::width();
+    constexpr int display_height = display::height();
+    constexpr int near_plane_data = near_plane() << fixed::precision();
+    constexpr int far_plane_data = far_plane() << fixed::precision();
+
+    point_3d camera_position = camera.position();
+    fixed camera_u_x = camera.u().x();
+    fixed camera_u_z = camera.u().z();
+    fixed camera_v_x = camera.v().x();
+    fixed camera_v_z = camera.v().z();
+    point_2d* projected_vertices_ptr = _projected_vertices_ptr;
+    valid_face_type* valid_faces_ptr = _valid_faces_ptr;
+    int vertices_count = 0;
+    int valid_faces_count = 0;
+
+    auto project_vertex = [&](const point_3d& point, point_2d& projected_vertex)
+    {
+        int vcz = -(point.y() - camera_position.y()).data();
+
+        if(vcz < near_plane_data || vcz >= far_plane_data) [[unlikely]]
+        {
+            return false;
+        }
+
+        // Horizontal coordinates are reduced to avoid overflows:
+        fixed vrx = (point.x() - camera_position.x()) / 16;
+        fixed vrz = (point.z() - camera_position.z()) / 16;
+        int vcx = (vrx.unsafe_multiplication(camera_u_x) + vrz.unsafe_multiplication(camera_u_z)).data();
+        int vcy = -(vrx.unsafe_multiplication(camera_v_x) + vrz.unsafe_multiplication(camera_v_z)).data();
+
+        // scale = (focal_length << 20) / vcz:
+        auto scale = int(division_lut[vcz >> 10] >> 6);
+        projected_vertex.x = int16_t(((vcx * scale) >> 16) + (display_width / 2));
+        projected_vertex.y = int16_t(((vcy * scale) >> 16) + (display_height / 2));
+        return true;
+    };
+
+    // Project static models:
+
+    for(const model_3d_item* model_item : _static_model_items)
+    {
+        const vertex_3d* model_vertices = model_item->vertices().data();
+        point_2d* projected_vertices = projected_vertices_ptr + vertices_count;
+        int model_vertices_count = model_item->vertices().size();
+        bool valid_model = true;
+
+        for(int index = 0; index < model_vertices_count; ++index)
+        {
+            if(! project_vertex(model_vertices[index].point(), projected_vertices[index])) [[unlikely]]
+            {
+                valid_model = false;
+                break;
+            }
+        }
+
+        if(valid_model) [[likely]]
+        {
+            const face_3d* model_faces = model_item->faces().data();
+            int model_faces_count = model_item->faces().size();
+
+            for(int index = 0; index < model_faces_count; ++index)
+            {
+                const face_3d& face = model_faces[index];
+                point_3d vr = face.centroid().point() - camera_position;
+
+                if(vr.safe_dot_product(face.normal().point()) < 0)
+                {
+                    valid_faces_ptr[valid_faces_count] = { &face, projected_vertices, -vr.y().data() };
+                    ++valid_faces_count;
+                }
+            }
+
+            vertices_count += model_vertices_count;
+        }
+    }
+
+    // Project dynamic models:
+
+    for(const model_3d& model : _dynamic_models_list)
+    {
+        const model_3d_item& model_item = model.item();
+        const vertex_3d* model_vertices = model_item.vertices().data();
+        point_2d* projected_vertices = projected_vertices_ptr + vertices_count;
+        int model_vertices_count = model_item.vertices().size();
+        bool valid_model = true;
+
+        for(int index = 0; index < model_vertices_count; ++index)
+        {
+            if(! project_vertex(model.transform(model_vertices[index]), projected_vertices[index])) [[unlikely]]
+            {
+                valid_model = false;
+                break;
+            }
+        }
+
+        if(valid_model) [[likely]]
+        {
+            const face_3d* model_faces = model_item.faces().data();
+            int model_faces_count = model_item.faces().size();
+
+            for(int index = 0; index < model_faces_count; ++index)
+            {
+                const face_3d& face = model_faces[index];
+                point_3d vr = model.transform(face.centroid()) - camera_position;
+
+                if(vr.safe_dot_product(model.rotate(face.normal())) < 0)
+                {
+                    valid_faces_ptr[valid_faces_count] = { &face, projected_vertices, -vr.y().data() };
+                    ++valid_faces_count;
+                }
+            }
+
+            vertices_count += model_vertices_count;
+        }
+    }
+
+    _last_vertices_count = vertices_count;
+
+    // Cull valid faces outside of the screen:
+
+    visible_face_type* visible_faces_ptr = _visible_faces_ptr;
+    uint16_t* visible_face_indexes_ptr = _visible_face_indexes_ptr;
+    int visible_faces_count = 0;
+
+    for(int index = 0; index < valid_faces_count; ++index)
+    {
+        const valid_face_type& valid_face = valid_faces_ptr[index];
+        const face_3d* face = valid_face.face;
+        const point_2d* projected_vertices = valid_face.projected_vertices;
+        const point_2d& pv0 = projected_vertices[face->first_vertex_index()];
+        const point_2d& pv1 = projected_vertices[face->second_vertex_index()];
+        const point_2d& pv2 = projected_vertices[face->third_vertex_index()];
+        const point_2d& pv3 = projected_vertices[face->fourth_vertex_index()];
+        int16_t minimum_x = min(min(pv0.x, pv1.x), min(pv2.x, pv3.x));
+        int16_t maximum_x = max(max(pv0.x, pv1.x), max(pv2.x, pv3.x));
+
+        if(minimum_x < display_width && maximum_x >= 0) [[likely]]
+        {
+            int16_t minimum_y = pv0.y;
+            int16_t maximum_y = minimum_y;
+            int top_index = 0;
+
+            auto min_max_y = [&minimum_y, &maximum_y, &top_index](int vertex_index, int16_t value)
+            {
+                if(value < minimum_y)
+                {
+                    top_index = vertex_index;
+                    minimum_y = value;
+                }
+                else if(value > maximum_y)
+                {
+                    maximum_y = value;
+                }
+            };
+
+            min_max_y(1, pv1.y);
+            min_max_y(2, pv2.y);
+            min_max_y(3, pv3.y);
+
+            if(minimum_y < display_height && maximum_y >= 0)
+            {
+                visible_faces_ptr[visible_faces_count] = {
+                    &valid_face, valid_face.projected_z, minimum_x, maximum_x, minimum_y, maximum_y,
+                    int8_t(top_index)
+                };
+
+                visible_face_indexes_ptr[visible_faces_count] = uint16_t(visible_faces_count);
+                ++visible_faces_count;
+            }
+        }
+    }
+
+    _last_faces_count = visible_faces_count;
+
+    if(! visible_faces_count) [[unlikely]]
+    {
+        return;
+    }
+
+    // Sort visible faces from the furthest to the nearest:
+
+    sort(visible_face_indexes_ptr, visible_face_indexes_ptr + visible_faces_count,
+         [visible_faces_ptr](uint16_t a, uint16_t b)
+    {
+        return visible_faces_ptr[a].projected_z > visible_faces_ptr[b].projected_z;
+    });
+
+    // Split visible faces in horizontal lines, starting with the nearest one
+    // so it takes the sprites with the highest priority:
+
+    hline_type hlines[display_height];
+    _draw_enabled = true;
+
+    for(int index = visible_faces_count - 1; index >= 0; --index)
+    {
+        const visible_face_type& visible_face = visible_faces_ptr[visible_face_indexes_ptr[index]];
+        const valid_face_type* valid_face = visible_face.valid_face;
+        const face_3d* face = valid_face->face;
+        int minimum_x = visible_face.minimum_x;
+        int maximum_x = visible_face.maximum_x;
+        int minimum_y = visible_face.minimum_y;
+        int maximum_y = visible_face.maximum_y;
+        bool x_outside = false;
+
+        if(minimum_x < 0)
+        {
+            minimum_x = 0;
+            x_outside = true;
+        }
+
+        if(maximum_x > display_width - 1)
+        {
+            maximum_x = display_width - 1;
+            x_outside = true;
+        }
+
+        if(minimum_y != maximum_y) [[likely]]
+        {
+            int y = minimum_y;
+
+            if(minimum_y < 0)
+            {
+                minimum_y = 0;
+            }
+
+            if(maximum_y > display_height - 1)
+            {
+                maximum_y = display_height - 1;
+            }
+
+            vertex_2d vertices[4];
+            const point_2d* projected_vertices = valid_face->projected_vertices;
+            const point_2d& pv0 = projected_vertices[face->first_vertex_index()];
+            vertices[0].x = pv0.x;
+            vertices[0].y = pv0.y;
+            vertices[0].next = &vertices[1];
+
+            const point_2d& pv1 = projected_vertices[face->second_vertex_index()];
+            vertices[1].x = pv1.x;
+            vertices[1].y = pv1.y;
+            vertices[1].prev = &vertices[0];
+            vertices[1].next = &vertices[2];
+
+            const point_2d& pv2 = projected_vertices[face->third_vertex_index()];
+            vertices[2].x = pv2.x;
+            vertices[2].y = pv2.y;
+            vertices[2].prev = &vertices[1];
+
+            if(face->triangle())
+            {
+                vertices[0].prev = &vertices[2];
+                vertices[2].next = &vertices[0];
+            }
+            else
+            {
+                vertices[0].prev = &vertices[3];
+                vertices[2].next = &vertices[3];
+
+                const point_2d& pv3 = projected_vertices[face->fourth_vertex_index()];
+                vertices[3].x = pv3.x;
+                vertices[3].y = pv3.y;
+                vertices[3].prev = &vertices[2];
+                vertices[3].next = &vertices[0];
+            }
+
+            vertex_2d& top_vertex = vertices[visible_face.top_index];
+            vertex_2d* left_top = &top_vertex;
+            vertex_2d* right_top = &top_vertex;
+            vertex_2d* left_bottom = top_vertex.next;
+            vertex_2d* right_bottom = top_vertex.prev;
+
+            while(left_top->y == left_bottom->y) [[unlikely]]
+            {
+                left_top = left_bottom;
+                left_bottom = left_bottom->next;
+            }
+
+            while(right_top->y == right_bottom->y) [[unlikely]]
+            {
+                right_top = right_bottom;
+                right_bottom = right_bottom->prev;
+            }
+
+            hlines_fixed xl = left_top->x;
+            hlines_fixed xr = right_top->x;
+            hlines_fixed left_delta = _hlines_delta(left_bottom->x - left_top->x, left_bottom->y - left_top->y);
+            hlines_fixed right_delta = _hlines_delta(right_bottom->x - right_top->x, right_bottom->y - right_top->y);
+
+            while(true)
+            {
+                int left_bottom_y = left_bottom->y;
+                int right_bottom_y = right_bottom->y;
+                int bottom_y = min(min(left_bottom_y, right_bottom_y), maximum_y);
+
+                if(y < 0)
+                {
+                    int invalid_bottom_y = min(bottom_y, -1);
+
+                    while(y <= invalid_bottom_y)
+                    {
+                        xl += left_delta;
+                        xr += right_delta;
+                        ++y;
+                    }
+                }
+
+                while(y <= bottom_y)
+                {
+                    hlines[y] = { xl.right_shift_integer(), xr.right_shift_integer() };
+                    xl += left_delta;
+                    xr += right_delta;
+                    ++y;
+                }
+
+                if(y > maximum_y)
+                {
+                    break;
+                }
+
+                if(bottom_y == left_bottom_y)
+                {
+                    left_top = left_bottom;
+                    left_bottom = left_bottom->next;
+
+                    int delta_y = left_bottom->y - left_top->y;
+
+                    if(delta_y <= 0) [[unlikely]]
+                    {
+                        left_top = left_bottom;
+                        left_bottom = left_bottom->next;
+                        delta_y = left_bottom->y - left_top->y;
+                    }
+
+                    left_delta = _hlines_delta(left_bottom->x - left_top->x, delta_y);
+                    xl = left_top->x + left_delta;
+                }
+
+                if(bottom_y == right_bottom_y)
+                {
+                    right_top = right_bottom;
+                    right_bottom = right_bottom->prev;
+
+                    int delta_y = right_bottom->y - right_top->y;
+
+                    if(delta_y <= 0) [[unlikely]]
+                    {
+                        right_top = right_bottom;
+                        right_bottom = right_bottom->prev;
+                        delta_y = right_bottom->y - right_top->y;
+                    }
+
+                    right_delta = _hlines_delta(right_bottom->x - right_top->x, delta_y);
+                    xr = right_top->x + right_delta;
+                }
+            }
+        }
+        else
+        {
+            hlines[minimum_y] = { minimum_x, maximum_x };
+        }
+
+        int width = maximum_x - minimum_x + 1;
+        _add_hlines(unsigned(minimum_y), unsigned(maximum_y), width, x_outside, face->color_index(),
+                    face->shading(), hlines);
+    }
+}
+
+void imodels_3d::_add_hlines(unsigned minimum_y, unsigned maximum_y, int width, bool x_outside, int color_index,
+                             int shading, const hline_type* hlines)
+{
+    BN_ASSERT(color_index < _color_tiles.size(), "Color not set: ", color_index, " - ", _color_tiles.size());
+
+    const color_tiles_ids_type& tiles_ids = _color_tiles_ids[color_index];
+    int palette_id = _palette_ids[shading];
+    int attr1;
+    int attr2;
+    bool split;
+
+    if(width < 8)
+    {
+        attr1 = hw::sprites::second_attributes(0, sprite_size::SMALL, false, false);
+        attr2 = hw::sprites::third_attributes(tiles_ids.small_tiles_id, palette_id, 3);
+        split = false;
+    }
+    else if(width < 16)
+    {
+        attr1 = hw::sprites::second_attributes(0, sprite_size::NORMAL, false, false);
+        attr2 = hw::sprites::third_attributes(tiles_ids.normal_tiles_id, palette_id, 3);
+        split = false;
+    }
+    else if(width < 32)
+    {
+        attr1 = hw::sprites::second_attributes(0, sprite_size::BIG, false, false);
+        attr2 = hw::sprites::third_attributes(tiles_ids.big_tiles_id, palette_id, 3);
+        split = false;
+    }
+    else
+    {
+        attr1 = hw::sprites::second_attributes(0, sprite_size::HUGE, false, false);
+        attr2 = hw::sprites::third_attributes(tiles_ids.huge_tiles_id, palette_id, 3);
+        split = width > split_length;
+    }
+
+    uint16_t* hdma_source = _hdma_source_ptr;
+    int max_scanline_sprites = _max_scanline_sprites;
+    int scanline_elements = max_scanline_sprites * 4;
+    int discarded_hlines_count = 0;
+
+    for(unsigned y = minimum_y; y <= maximum_y; ++y)
+    {
+        int xl = hlines[y].xl;
+        int xr = hlines[y].xr;
+
+        if(x_outside) [[unlikely]]
+        {
+            if(xl >= display::width() || xr < 0) [[unlikely]]
+            {
+                continue;
+            }
+
+            xl = max(xl, 0);
+            xr = min(xr, display::width() - 1);
+        }
+
+        int hlines_count = _hlines_count[y];
+        uint16_t* sprite_hdma_source = hdma_source + (y * scanline_elements) + (hlines_count * 4);
+        bool keep_adding;
+
+        do
+        {
+            if(hlines_count < max_scanline_sprites) [[likely]]
+            {
+                int length = xr - xl;
+                keep_adding = split && length > split_length;
+
+                int sprite_y = int(y) - (keep_adding ? split_length : length);
+                sprite_hdma_source[0] = uint16_t(hw::sprites::first_attributes(
+                            sprite_y, sprite_shape::SQUARE, bpp_mode::BPP_4, 0, true, false, false, false));
+                sprite_hdma_source[1] = uint16_t(attr1 + xl);
+                sprite_hdma_source[2] = uint16_t(attr2);
+
+                xl += split_length;
+                sprite_hdma_source += 4;
+                ++hlines_count;
+            }
+            else
+            {
+                ++discarded_hlines_count;
+                keep_adding = false;
+            }
+        }
+        while(keep_adding);
+
+        _hlines_count[y] = uint8_t(hlines_count);
+    }
+
+    _last_discarded_hlines_count += discarded_hlines_count;
+}
+
+void imodels_3d::_hide_previous_hlines(const uint8_t* previous_hlines_count)
+{
+    uint16_t* hdma_source = _hdma_source_ptr;
+    int scanline_elements = _max_scanline_sprites * 4;
+
+    for(int y = 0; y < display::height(); ++y)
+    {
+        uint16_t* sprite_hdma_source = hdma_source + (y * scanline_elements);
+
+        for(int index = _hlines_count[y], limit = previous_hlines_count[y]; index < limit; ++index)
+        {
+            hw::sprites::hide_and_destroy(sprite_hdma_source[index * 4]);
+        }
+    }
+}
+
+}
@@ -0,0 +1,315 @@
+/*
+ * Copyright (c) 2020-2025 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_models_3d.h"
+
+#include "bn_hdma.h"
+#include "bn_memory.h"
+#include "bn_algorithm.h"
+#include "bn_sprites.h"
+#include "bn_sprite_palette_item.h"
+#include "../hw/include/bn_hw_sprites.h"
+
+namespace bn
+{
+
+namespace
+{
+    [[nodiscard]] color _brightness_color(color color, int brightness)
+    {
+        int red = (color.red() * brightness) / 32;
+        int green = (color.green() * brightness) / 32;
+        int blue = (color.blue() * brightness) / 32;
+        return bn::color(red, green, blue);
+    }
+
+    [[nodiscard]] sprite_tiles_ptr _create_triangle_tiles(int size, int color_index)
+    {
+        // Row n of the triangle has n + 1 pixels, so an horizontal line of length n is drawn
+        // by placing the row n of the sprite on the target screen line:
+        int columns = size / 8;
+        sprite_tiles_ptr result = sprite_tiles_ptr::allocate(columns * columns, bpp_mode::BPP_4);
+        tile* tiles_data = result.vram()->data();
+        unsigned pixels = unsigned(color_index + 1) * 0x11111111;
+
+        for(int row = 0; row < size; ++row)
+        {
+            tile* row_tiles_data = tiles_data + ((row / 8) * columns);
+            int tile_row = row % 8;
+
+            for(int column = 0; column < columns; ++column)
+            {
+                int row_pixels = clamp(row + 1 - (column * 8), 0, 8);
+                unsigned row_data = row_pixels == 8 ? pixels : pixels & ((1u << (row_pixels * 4)) - 1);
+                row_tiles_data[column].data[tile_row] = row_data;
+            }
+        }
+
+        return result;
+    }
+}
+
+imodels_3d::~imodels_3d()
+{
+    _stop();
+}
+
+void imodels_3d::set_colors(const span<const color>& colors)
+{
+    int colors_count = colors.size();
+    BN_ASSERT(colors_count <= face_3d::max_colors, "Invalid colors count: ", colors_count);
+
+    if(! colors_count)
+    {
+        _color_tiles.clear();
+        _palettes.clear();
+        return;
+    }
+
+    int current_colors_count = _color_tiles.size();
+    bool reload_palettes;
+
+    if(current_colors_count < colors_count)
+    {
+        reload_palettes = true;
+
+        for(int index = current_colors_count; index < colors_count; ++index)
+        {
+            const color_tiles_type& color_tiles = _color_tiles.emplace_back(index);
+            color_tiles_ids_type& color_tiles_ids = _color_tiles_ids[index];
+            color_tiles_ids.small_tiles_id = uint16_t(color_tiles.small_tiles.id());
+            color_tiles_ids.normal_tiles_id = uint16_t(color_tiles.normal_tiles.id());
+            color_tiles_ids.big_tiles_id = uint16_t(color_tiles.big_tiles.id());
+            color_tiles_ids.huge_tiles_id = uint16_t(color_tiles.huge_tiles.id());
+        }
+    }
+    else
+    {
+        if(current_colors_count > colors_count)
+        {
+            _color_tiles.shrink(colors_count);
+        }
+
+        reload_palettes = colors != span<const color>(_colors, colors_count);
+    }
+
+    if(reload_palettes)
+    {
+        color palettes_colors[face_3d::shading_levels][16] = {};
+
+        for(int color_index = 0; color_index < colors_count; ++color_index)
+        {
+            color color = colors[color_index];
+            _colors[color_index] = color;
+
+            int palette_color_index = color_index + 1;
+            int brightness = 32 - face_3d::shading_levels + 1;
+
+            for(bn::color* palette_colors : palettes_colors)
+            {
+                palette_colors[palette_color_index] = _brightness_color(color, brightness);
+                ++brightness;
+            }
+        }
+
+        if(_palettes.empty())
+        {
+            for(int palette_index = 0; palette_index < face_3d::shading_levels; ++palette_index)
+            {
+                sprite_palette_item palette_item(palettes_colors[palette_index], bpp_mode::BPP_4);
+                sprite_palette_ptr palette = palette_item.create_new_palette();
+                _palette_ids[palette_index] = uint8_t(palette.id());
+                _palettes.push_back(move(palette));
+            }
+        }
+        else
+        {
+            for(int palette_index = 0; palette_index < face_3d::shading_levels; ++palette_index)
+            {
+                sprite_palette_item palette_item(palettes_colors[palette_index], bpp_mode::BPP_4);
+                _palettes[palette_index].set_colors(palette_item);
+            }
+        }
+    }
+}
+
+void imodels_3d::set_fade(color color, fixed intensity)
+{
+    for(sprite_palette_ptr& palette : _palettes)
+    {
+        palette.set_fade(color, intensity);
+    }
+}
+
+void imodels_3d::set_static_model_items(const span<const model_3d_item* const>& static_model_items)
+{
+    int static_vertices_count = 0;
+    int static_faces_count = 0;
+
+    for(const model_3d_item* model_item : static_model_items)
+    {
+        static_vertices_count += model_item->vertices().size();
+        static_faces_count += model_item->faces().size();
+    }
+
+    int vertices_count = _vertices_count - _static_vertices_count + static_vertices_count;
+    BN_ASSERT(vertices_count <= _max_vertices, "Too many vertices: ", vertices_count, " - ", _max_vertices);
+
+    int faces_count = _faces_count - _static_faces_count + static_faces_count;
+    BN_ASSERT(faces_count <= _max_faces, "Too many faces: ", faces_count, " - ", _max_faces);
+
+    _static_model_items = static_model_items;
+    _vertices_count = vertices_count;
+    _faces_count = faces_count;
+    _static_vertices_count = static_vertices_count;
+    _static_faces_count = static_faces_count;
+}
+
+model_3d& imodels_3d::create_dynamic_model(const model_3d_item& model_item)
+{
+    BN_ASSERT(! _dynamic_models_pool.full(), "No more dynamic models available");
+
+    int vertices_count = _vertices_count + model_item.vertices().size();
+    BN_ASSERT(vertices_count <= _max_vertices, "Too many vertices: ", vertices_count, " - ", _max_vertices);
+
+    int faces_count = _faces_count + model_item.faces().size();
+    BN_ASSERT(faces_count <= _max_faces, "Too many faces: ", faces_count, " - ", _max_faces);
+
+    model_3d& result = _dynamic_models_pool.create(model_item);
+    _dynamic_models_list.push_back(result);
+    _vertices_count = vertices_count;
+    _faces_count = faces_count;
+    return result;
+}
+
+void imodels_3d::destroy_dynamic_model(model_3d& model)
+{
+    BN_ASSERT(_dynamic_models_pool.contains(model), "Model not found");
+
+    const model_3d_item& model_item = model.item();
+    _vertices_count -= model_item.vertices().size();
+    _faces_count -= model_item.faces().size();
+    _dynamic_models_list.erase(model);
+    _dynamic_models_pool.destroy(model);
+}
+
+void imodels_3d::update(const camera_3d& camera)
+{
+    _last_vertices_count = 0;
+    _last_faces_count = 0;
+    _last_hlines_count = 0;
+    _last_discarded_hlines_count = 0;
+    _process_models(camera);
+    _commit();
+}
+
+imodels_3d::imodels_3d(ipool<model_3d>& dynamic_models_pool, point_2d* projected_vertices_ptr,
+                       valid_face_type* valid_faces_ptr, visible_face_type* visible_faces_ptr,
+                       uint16_t* visible_face_indexes_ptr, uint16_t* hdma_source_a_ptr, uint16_t* hdma_source_b_ptr,
+                       int max_vertices, int max_faces, int max_scanline_sprites) :
+    _dynamic_models_pool(dynamic_models_pool),
+    _projected_vertices_ptr(projected_vertices_ptr),
+    _valid_faces_ptr(valid_faces_ptr),
+    _visible_faces_ptr(visible_faces_ptr),
+    _visible_face_indexes_ptr(visible_face_indexes_ptr),
+    _hdma_source_a_ptr(hdma_source_a_ptr),
+    _hdma_source_b_ptr(hdma_source_b_ptr),
+    _hdma_source_ptr(hdma_source_a_ptr),
+    _max_vertices(max_vertices),
+    _max_faces(max_faces),
+    _max_scanline_sprites(max_scanline_sprites)
+{
+    int hdma_source_size = (display::height() + 1) * max_scanline_sprites * 4;
+
+    for(int index = 0; index < hdma_source_size; index += 4)
+    {
+        hw::sprites::hide_and_destroy(hdma_source_a_ptr[index]);
+        hw::sprites::hide_and_destroy(hdma_source_b_ptr[index]);
+    }
+}
+
+void imodels_3d::_destroy_dynamic_models()
+{
+    while(! _dynamic_models_list.empty())
+    {
+        model_3d& model = _dynamic_models_list.front();
+        _dynamic_models_list.pop_front();
+        _dynamic_models_pool.destroy(model);
+    }
+}
+
+void imodels_3d::_commit()
+{
+    if(_draw_enabled)
+    {
+        uint16_t* hdma_source = _hdma_source_ptr;
+        _draw_enabled = false;
+
+        if(hdma_source == _hdma_source_a_ptr)
+        {
+            _hide_previous_hlines(_previous_hlines_count_a);
+        }
+        else
+        {
+            _hide_previous_hlines(_previous_hlines_count_b);
+        }
+
+        // HDMA copies the attributes of the next screen line in each H-Blank,
+        // so the first line is copied again at the end to be ready for the next frame:
+        int max_scanline_sprites = _max_scanline_sprites;
+        int scanline_elements = max_scanline_sprites * 4;
+        int hdma_source_size = display::height() * scanline_elements;
+        memory::copy(hdma_source[0], scanline_elements, hdma_source[hdma_source_size]);
+
+        span<const uint16_t> hdma_source_ref(hdma_source + scanline_elements, hdma_source_size);
+        hdma::start(hdma_source_ref, hw::sprites::vram()[hw::sprites::count() - max_scanline_sprites].attr0);
+        _hdma_running = true;
+
+        if(hdma_source == _hdma_source_a_ptr)
+        {
+            memory::copy(_hlines_count[0], display::height(), _previous_hlines_count_a[0]);
+            _hdma_source_ptr = _hdma_source_b_ptr;
+        }
+        else
+        {
+            memory::copy(_hlines_count[0], display::height(), _previous_hlines_count_b[0]);
+            _hdma_source_ptr = _hdma_source_a_ptr;
+        }
+
+        int hlines_count = 0;
+
+        for(int scanline_hlines_count : _hlines_count)
+        {
+            hlines_count += scanline_hlines_count;
+        }
+
+        _last_hlines_count = hlines_count;
+        memory::clear(display::height(), _hlines_count[0]);
+    }
+    else
+    {
+        _stop();
+    }
+}
+
+void imodels_3d::_stop()
+{
+    if(_hdma_running)
+    {
+        _hdma_running = false;
+        hdma::stop();
+        sprites::reload();
+    }
+}
+
+imodels_3d::color_tiles_type::color_tiles_type(int color_index) :
+    small_tiles(_create_triangle_tiles(8, color_index)),
+    normal_tiles(_create_triangle_tiles(16, color_index)),
+    big_tiles(_create_triangle_tiles(32, color_index)),
+    huge_tiles(_create_triangle_tiles(64, color_index))
+{
+}
+
+}
@@ -0,0 +1,242 @@
+/*
+ * Copyright (c) 2020-2025 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_palette_bands.h"
+
+#include "bn_log.h"
+#include "bn_hdma.h"
+#include "../hw/include/bn_hw_palettes.h"
+
+namespace bn
+{
+
+ipalette_bands::~ipalette_bands()
+{
+    stop();
+}
+
+int ipalette_bands::band_first_scanline(int band_index) const
+{
+    BN_ASSERT(band_index >= 0 && band_index < _bands_count, "Invalid band index: ", band_index, " - ", _bands_count);
+
+    return _bands_scanlines[band_index];
+}
+
+span<const color> ipalette_bands::band_colors(int band_index) const
+{
+    BN_ASSERT(band_index >= 0 && band_index < _bands_count, "Invalid band index: ", band_index, " - ", _bands_count);
+
+    int colors_count = _colors_count;
+    return span<const color>(_bands_colors + (band_index * colors_count), colors_count);
+}
+
+void ipalette_bands::push_band(int first_scanline, const span<const color>& colors)
+{
+    int bands_count = _bands_count;
+    BN_ASSERT(bands_count < _max_bands_count, "No more bands available");
+    BN_ASSERT(colors.size() == _colors_count, "Invalid colors count: ", colors.size(), " - ", _colors_count);
+
+    if(bands_count)
+    {
+        BN_ASSERT(first_scanline > _bands_scanlines[bands_count - 1] && first_scanline < display::height(),
+                  "Invalid first scanline: ", first_scanline, " - ", _bands_scanlines[bands_count - 1]);
+    }
+    else
+    {
+        BN_ASSERT(first_scanline == 0, "First band must start at scanline 0: ", first_scanline);
+    }
+
+    int colors_count = _colors_count;
+    color* band_colors = _bands_colors + (bands_count * colors_count);
+
+    for(int index = 0; index < colors_count; ++index)
+    {
+        band_colors[index] = colors[index];
+    }
+
+    _bands_scanlines[bands_count] = int16_t(first_scanline);
+    _bands_count = bands_count + 1;
+}
+
+int ipalette_bands::hblank_colors() const
+{
+    int first_color;
+    return _hblank_colors_range(false, first_color);
+}
+
+void ipalette_bands::start()
+{
+    _start(false);
+}
+
+void ipalette_bands::high_priority_start()
+{
+    _start(true);
+}
+
+void ipalette_bands::stop()
+{
+    switch(_hdma_channel)
+    {
+
+    case 1:
+        hdma::stop();
+        break;
+
+    case 2:
+        hdma::high_priority_stop();
+        break;
+
+    default:
+        break;
+    }
+
+    _hdma_channel = 0;
+}
+
+ipalette_bands::ipalette_bands(const bg_palette_ptr& palette, int16_t* bands_scanlines, color* bands_colors,
+                               uint16_t* hdma_table, int max_bands_count, int max_colors_count) :
+    _bg_palette(palette),
+    _bands_scanlines(bands_scanlines),
+    _bands_colors(bands_colors),
+    _hdma_table(hdma_table),
+    _max_bands_count(max_bands_count),
+    _colors_count(palette.colors_count())
+{
+    BN_ASSERT(_colors_count <= max_colors_count, "Too many palette colors: ", _colors_count, " - ", max_colors_count);
+}
+
+ipalette_bands::ipalette_bands(const sprite_palette_ptr& palette, int16_t* bands_scanlines, color* bands_colors,
+                               uint16_t* hdma_table, int max_bands_count, int max_colors_count) :
+    _sprite_palette(palette),
+    _bands_scanlines(bands_scanlines),
+    _bands_colors(bands_colors),
+    _hdma_table(hdma_table),
+    _max_bands_count(max_bands_count),
+    _colors_count(palette.colors_count())
+{
+    BN_ASSERT(_colors_count <= max_colors_count, "Too many palette colors: ", _colors_count, " - ", max_colors_count);
+}
+
+int ipalette_bands::_hblank_colors_range(bool log, int& first_color) const
+{
+    int bands_count = _bands_count;
+    int colors_count = _colors_count;
+    int range_first_color = colors_count;
+    int range_last_color = -1;
+    [[maybe_unused]] bool logged = false;
+
+    // Colors which don't change between consecutive bands are not copied.
+    // The last band is compared with the first one too, since both are shown consecutively:
+    for(int band_index = 0; band_index < bands_count && bands_count > 1; ++band_index)
+    {
+        int next_band_index = band_index + 1 == bands_count ? 0 : band_index + 1;
+        const color* band_colors = _bands_colors + (band_index * colors_count);
+        const color* next_band_colors = _bands_colors + (next_band_index * colors_count);
+
+        for(int color_index = 0; color_index < colors_count; ++color_index)
+        {
+            if(band_colors[color_index] != next_band_colors[color_index])
+            {
+                range_first_color = min(range_first_color, color_index);
+                range_last_color = max(range_last_color, color_index);
+            }
+        }
+
+        #if BN_CFG_LOG_ENABLED
+            int range_colors = range_last_color - range_first_color + 1;
+
+            if(log && ! logged && range_colors > max_hblank_colors())
+            {
+                BN_LOG("Palette band change exceeds the H-Blank budget at scanline ",
+                       _bands_scanlines[next_band_index], ": ", range_colors, " colors - ", max_hblank_colors());
+                logged = true;
+            }
+        #else
+            (void) log;
+        #endif
+    }
+
+    if(range_last_color < 0)
+    {
+        first_color = 0;
+        return 0;
+    }
+
+    first_color = range_first_color;
+    return range_last_color - range_first_color + 1;
+}
+
+void ipalette_bands::_start(bool high_priority)
+{
+    BN_ASSERT(_bands_count, "There's no bands");
+
+    stop();
+
+    int first_color;
+    int hblank_colors = _hblank_colors_range(true, first_color);
+
+    if(! hblank_colors)
+    {
+        return;
+    }
+
+    // Colors copied in the H-Blank of a scanline are shown in the next one,
+    // and the last row is copied before the first scanline:
+    int bands_count = _bands_count;
+    int colors_count = _colors_count;
+    int height = display::height();
+    int band_index = 0;
+    uint16_t* hdma_table = _hdma_table;
+
+    for(int scanline = 1; scanline <= height; ++scanline)
+    {
+        int band_scanline = scanline == height ? 0 : scanline;
+
+        if(band_scanline == 0)
+        {
+            band_index = 0;
+        }
+        else if(band_index + 1 < bands_count && band_scanline >= _bands_scanlines[band_index + 1])
+        {
+            ++band_index;
+        }
+
+        const color* band_colors = _bands_colors + (band_index * colors_count) + first_color;
+        uint16_t* row = hdma_table + ((scanline - 1) * hblank_colors);
+
+        for(int index = 0; index < hblank_colors; ++index)
+        {
+            row[index] = uint16_t(band_colors[index].data());
+        }
+    }
+
+    span<const uint16_t> hdma_source(hdma_table, height * hblank_colors);
+    uint16_t* color_register;
+
+    if(const bg_palette_ptr* bg_palette = _bg_palette.get())
+    {
+        int final_color = (bg_palette->id() * hw::palettes::colors_per_palette()) + first_color;
+        color_register = hw::palettes::bg_color_register(final_color);
+    }
+    else
+    {
+        int final_color = (_sprite_palette->id() * hw::palettes::colors_per_palette()) + first_color;
+        color_register = hw::palettes::sprite_color_register(final_color);
+    }
+
+    if(high_priority)
+    {
+        hdma::high_priority_start(hdma_source, *color_register);
+    }
+    else
+    {
+        hdma::start(hdma_source, *color_register);
+    }
+
+    _hdma_channel = high_priority ? 2 : 1;
+}
+
+}
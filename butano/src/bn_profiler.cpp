@@ -6,25 +6,46 @@
 #include "bn_profiler.h"
 
 #if BN_CFG_PROFILER_ENABLED
+    #include "bn_deque.h"
     #include "bn_timer.h"
-    #include "bn_optional.h"
+    #include "bn_vector.h"
+    #include "bn_timers.h"
     #include "bn_unordered_map.h"
 
+    #if BN_CFG_LOG_ENABLED
+        #include "bn_log.h"
+    #endif
+
     namespace _bn::profiler
     {
         namespace
         {
             static_assert(BN_CFG_PROFILER_MAX_ENTRIES > 0);
             static_assert(bn::power_of_two(BN_CFG_PROFILER_MAX_ENTRIES));
+            static_assert(BN_CFG_PROFILER_MAX_DEPTH > 0);
+            static_assert(BN_CFG_PROFILER_TIMELINE_MAX_ENTRIES > 0);
+            static_assert(bn::power_of_two(BN_CFG_PROFILER_TIMELINE_MAX_ENTRIES));
+
+            class active_entry
+            {
+
+            public:
+                const char* id;
+                unsigned id_hash;
+                int start_ticks;
+                int children_ticks;
+                bn::timer timer;
+            };
 
             class static_data
             {
 
             public:
                 ticks_map ticks_per_entry;
-                bn::optional<bn::timer> current_timer;
-                const char* current_id = nullptr;
-                unsigned current_id_hash;
+                bn::vector<active_entry, BN_CFG_PROFILER_MAX_DEPTH> active_entries;
+                bn::deque<timeline_entry, BN_CFG_PROFILER_TIMELINE_MAX_ENTRIES> timeline;
+                bn::timer frame_timer;
+                int frame = 0;
             };
 
             BN_DATA_EWRAM static_data data;
@@ -33,37 +54,117 @@
         void start(const char* id, unsigned id_hash)
         {
             BN_BASIC_ASSERT(id, "Id is null");
-            BN_BASIC_ASSERT(! data.current_id, "There's already an active id: ", data.current_id);
+            BN_BASIC_ASSERT(! data.active_entries.full(), "Too many active ids: ", data.active_entries.size());
 
-            data.current_id = id;
-            data.current_id_hash = id_hash;
-            data.current_timer = bn::timer();
+            data.active_entries.push_back({ id, id_hash, data.frame_timer.elapsed_ticks(), 0, bn::timer() });
         }
 
         void stop()
         {
-            BN_BASIC_ASSERT(data.current_id, "There's no active id");
-
-            int timer_ticks = data.current_timer->elapsed_ticks();
-            auto timer_ticks_64 = int64_t(timer_ticks);
-            ticks& ticks = data.ticks_per_entry(data.current_id_hash, data.current_id);
-            ticks.total += timer_ticks_64;
-            ticks.max = bn::max(ticks.max, timer_ticks);
-            data.current_id = nullptr;
+            BN_BASIC_ASSERT(! data.active_entries.empty(), "There's no active id");
+
+            active_entry& entry = data.active_entries.back();
+            int inclusive_ticks = entry.timer.elapsed_ticks();
+            int exclusive_ticks = bn::max(inclusive_ticks - entry.children_ticks, 0);
+            const char* id = entry.id;
+            int depth = data.active_entries.size() - 1;
+            const char* parent_id = nullptr;
+
+            if(depth)
+            {
+                active_entry& parent_entry = data.active_entries[depth - 1];
+                parent_entry.children_ticks += inclusive_ticks;
+                parent_id = parent_entry.id;
+            }
+
+            ticks& ticks = data.ticks_per_entry(entry.id_hash, id);
+
+            if(ticks.count)
+            {
+                ticks.min = bn::min(ticks.min, inclusive_ticks);
+                ticks.max = bn::max(ticks.max, inclusive_ticks);
+            }
+            else
+            {
+                ticks.parent_id = parent_id;
+                ticks.min = inclusive_ticks;
+                ticks.max = inclusive_ticks;
+            }
+
+            ticks.total += int64_t(inclusive_ticks);
+            ticks.exclusive_total += int64_t(exclusive_ticks);
+            ++ticks.count;
+
+            if(data.timeline.full())
+            {
+                data.timeline.pop_front();
+            }
+
+            data.timeline.push_back({ id, parent_id, data.frame, entry.start_ticks, inclusive_ticks, exclusive_ticks,
+                                      depth });
+            data.active_entries.pop_back();
+        }
+
+        void new_frame()
+        {
+            ++data.frame;
+            data.frame_timer.restart();
         }
 
         const ticks_map& ticks_per_entry()
         {
-            BN_BASIC_ASSERT(! data.current_id, "There's an active id: ", data.current_id);
+            BN_BASIC_ASSERT(data.active_entries.empty(), "There's an active id: ", data.active_entries.back().id);
 
             return data.ticks_per_entry;
         }
 
         void reset()
         {
-            BN_BASIC_ASSERT(! data.current_id, "There's an active id: ", data.current_id);
+            BN_BASIC_ASSERT(data.active_entries.empty(), "There's an active id: ", data.active_entries.back().id);
 
             data.ticks_per_entry.clear();
+            data.timeline.clear();
+            data.frame_timer.restart();
+            data.frame = 0;
+        }
+    }
+
+    namespace bn::profiler
+    {
+        void log()
+        {
+            #if BN_CFG_LOG_ENABLED
+                using namespace _bn::profiler;
+
+                const ticks_map& ticks_per_entry = _bn::profiler::ticks_per_entry();
+                BN_LOG("PROFILER results:");
+
+                for(const auto& ticks_per_entry_pair : ticks_per_entry)
+                {
+                    const ticks& entry_ticks = ticks_per_entry_pair.second;
+                    const char* parent_id = entry_ticks.parent_id;
+
+                    BN_LOG("    ", ticks_per_entry_pair.first, " (parent: ", parent_id ? parent_id : "-",
+                           ") - count: ", entry_ticks.count,
+                           " - total: ", entry_ticks.total,
+                           " - exclusive: ", entry_ticks.exclusive_total,
+                           " - min: ", entry_ticks.min,
+                           " - avg: ", entry_ticks.total / entry_ticks.count,
+                           " - max: ", entry_ticks.max);
+                }
+
+                BN_LOG("PROFILER timeline (frame budget: ", timers::ticks_per_frame(), " ticks):");
+
+                for(const timeline_entry& entry : _bn::profiler::data.timeline)
+                {
+                    BN_LOG("    frame ", entry.frame,
+                           " - depth ", entry.depth,
+                           " - ", entry.id,
+                           " - start: ", entry.start_ticks,
+                           " - inclusive: ", entry.inclusive_ticks,
+                           " - exclusive: ", entry.exclusive_ticks);
+                }
+            #endif
         }
     }
 #endif
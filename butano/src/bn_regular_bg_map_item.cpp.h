@@ -21,6 +21,8 @@ regular_bg_map_item regular_bg_map_item::decompress(span<regular_bg_map_cell> de
 
     regular_bg_map_cell* decompressed_cells_ptr = decompressed_cells_ref.data();
     BN_ASSERT(aligned<4>(decompressed_cells_ptr), "Destination map cells are not aligned");
+    BN_BASIC_ASSERT(_compression == compression_type::NONE || ! _big,
+                    "Compressed big maps are split in chunks and can't be decompressed at once");
 
     regular_bg_map_item result = *this;
 
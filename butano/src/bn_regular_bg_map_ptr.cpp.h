@@ -9,6 +9,8 @@
 #include "bn_regular_bg_item.h"
 #include "bn_bg_blocks_manager.h"
 #include "bn_regular_bg_tiles_ptr.h"
+#include "bn_regular_bg_tiles_cache.h"
+#include "bn_regular_bg_streamed_item.h"
 
 namespace bn
 {
@@ -124,6 +126,54 @@ regular_bg_map_ptr regular_bg_map_ptr::create_new(
     return create(map_item, move(tiles), move(palette), map_index);
 }
 
+regular_bg_map_ptr regular_bg_map_ptr::create_streamed(
+        const regular_bg_map_item& map_item, const regular_bg_tiles_item& tiles_item, bg_palette_ptr palette,
+        iregular_bg_tiles_cache& tiles_cache)
+{
+    bpp_mode bpp = tiles_item.bpp();
+    int tiles_count = tiles_cache.max_tiles_count();
+
+    if(bpp == bpp_mode::BPP_8)
+    {
+        tiles_count *= 2;
+    }
+
+    BN_BASIC_ASSERT(tiles_item.compression() == compression_type::NONE,
+                    "Compressed streamed map tiles are not supported");
+    BN_ASSERT(bpp == palette.bpp(), "Tiles and palette BPP are different: ", int(bpp), " - ", int(palette.bpp()));
+
+    int handle = bg_blocks_manager::create_regular_streamed_map(
+                map_item, map_item.cells_ptr(), tiles_item.tiles_ref(), nullptr,
+                regular_bg_tiles_ptr::allocate(tiles_count, bpp), move(palette), tiles_cache, false);
+    return regular_bg_map_ptr(handle);
+}
+
+regular_bg_map_ptr regular_bg_map_ptr::create_streamed(
+        const regular_bg_item& item, iregular_bg_tiles_cache& tiles_cache)
+{
+    return create_streamed(item.map_item(), item.tiles_item(), bg_palette_ptr::create(item.palette_item()),
+                           tiles_cache);
+}
+
+regular_bg_map_ptr regular_bg_map_ptr::create_streamed(
+        const regular_bg_streamed_item& item, iregular_bg_tiles_cache& tiles_cache)
+{
+    const regular_bg_map_item& map_item = item.map_item();
+    bpp_mode bpp = item.bpp();
+    int tiles_count = tiles_cache.max_tiles_count();
+
+    if(bpp == bpp_mode::BPP_8)
+    {
+        tiles_count *= 2;
+    }
+
+    int handle = bg_blocks_manager::create_regular_streamed_map(
+                map_item, map_item.cells_ptr(), item.tiles_ref(), item.tile_indexes_ref().data(),
+                regular_bg_tiles_ptr::allocate(tiles_count, bpp), bg_palette_ptr::create(item.palette_item()),
+                tiles_cache, false);
+    return regular_bg_map_ptr(handle);
+}
+
 regular_bg_map_ptr regular_bg_map_ptr::allocate(
         const size& dimensions, regular_bg_tiles_ptr tiles, bg_palette_ptr palette)
 {
@@ -282,6 +332,11 @@ bool regular_bg_map_ptr::big() const
     return bg_blocks_manager::big_map(_handle);
 }
 
+bool regular_bg_map_ptr::streamed() const
+{
+    return bg_blocks_manager::streamed_map(_handle);
+}
+
 bpp_mode regular_bg_map_ptr::bpp() const
 {
     return palette().bpp();
@@ -322,6 +377,11 @@ void regular_bg_map_ptr::reload_cells_ref()
     bg_blocks_manager::reload(_handle);
 }
 
+bool regular_bg_map_ptr::ready() const
+{
+    return bg_blocks_manager::ready(_handle);
+}
+
 const regular_bg_tiles_ptr& regular_bg_map_ptr::tiles() const
 {
     return bg_blocks_manager::regular_map_tiles(_handle);
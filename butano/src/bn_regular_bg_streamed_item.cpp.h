@@ -0,0 +1,24 @@
+/*
+ * Copyright (c) 2020-2025 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_regular_bg_streamed_item.h"
+
+#include "bn_regular_bg_ptr.h"
+#include "bn_regular_bg_map_ptr.h"
+
+namespace bn
+{
+
+regular_bg_ptr regular_bg_streamed_item::create_bg(fixed x, fixed y, iregular_bg_tiles_cache& tiles_cache) const
+{
+    return regular_bg_ptr::create(x, y, regular_bg_map_ptr::create_streamed(*this, tiles_cache));
+}
+
+regular_bg_map_ptr regular_bg_streamed_item::create_map(iregular_bg_tiles_cache& tiles_cache) const
+{
+    return regular_bg_map_ptr::create_streamed(*this, tiles_cache);
+}
+
+}
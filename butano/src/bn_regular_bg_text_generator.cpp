@@ -0,0 +1,416 @@
+/*
+ * Copyright (c) 2020-2025 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_regular_bg_text_generator.h"
+
+#include "bn_size.h"
+#include "bn_memory.h"
+#include "bn_bg_palette_ptr.h"
+#include "bn_regular_bg_tiles_ptr.h"
+#include "../hw/include/bn_hw_bg_blocks.h"
+#include "../hw/include/bn_hw_sprite_tiles.h"
+
+namespace bn
+{
+
+namespace
+{
+    constexpr int map_columns = 32;
+    constexpr int map_rows = 32;
+    constexpr int map_pixels = map_columns * 8;
+
+    // The last tile receives the pixels plotted past the right edge of the text:
+    BN_DATA_EWRAM_BSS tile row_tiles[map_columns + 2];
+
+
+    class width_painter
+    {
+
+    public:
+        explicit width_painter(const sprite_font& font) :
+            _character_widths(font.character_widths_ref().data()),
+            _max_character_width(font.item().shape_size().width()),
+            _space_between_characters(font.space_between_characters())
+        {
+        }
+
+        [[nodiscard]] int width() const
+        {
+            return _width;
+        }
+
+        void paint_space()
+        {
+            _width += _space_width() + _space_between_characters;
+        }
+
+        void paint_tab()
+        {
+            _width += (_space_width() * 4) + _space_between_characters;
+        }
+
+        void paint_character(int graphics_index)
+        {
+            int width = _character_widths ? _character_widths[graphics_index + 1] : _max_character_width;
+            _width += width + _space_between_characters;
+        }
+
+    private:
+        const int8_t* _character_widths;
+        int _max_character_width;
+        int _space_between_characters;
+        int _width = 0;
+
+        [[nodiscard]] int _space_width() const
+        {
+            return _character_widths ? _character_widths[0] : _max_character_width;
+        }
+    };
+
+
+    class tiles_row_painter
+    {
+
+    public:
+        tiles_row_painter(const sprite_font& font, int tiles_row, int first_column) :
+            _character_widths(font.character_widths_ref().data()),
+            _max_character_width(font.item().shape_size().width()),
+            _space_between_characters(font.space_between_characters()),
+            _column(first_column)
+        {
+            const sprite_shape_size& shape_size = font.item().shape_size();
+            int character_columns = shape_size.width() / 8;
+            _character_tiles = character_columns * (shape_size.height() / 8);
+            _source_tiles_ptr = font.item().tiles_item().tiles_ref().data() + (tiles_row * character_columns);
+        }
+
+        void paint_space()
+        {
+            _column += _space_width() + _space_between_characters;
+        }
+
+        void paint_tab()
+        {
+            _column += (_space_width() * 4) + _space_between_characters;
+        }
+
+        void paint_character(int graphics_index)
+        {
+            int width = _character_widths ? _character_widths[graphics_index + 1] : _max_character_width;
+            const tile* source_tiles_ptr = _source_tiles_ptr + (graphics_index * _character_tiles);
+            int column = _column;
+
+            // Characters are plotted with masks, so consecutive variable width characters share tiles:
+            for(int remaining_width = width; remaining_width > 0; remaining_width -= 8)
+            {
+                hw::sprite_tiles::plot_tiles(min(remaining_width, 8), source_tiles_ptr, 0, column, row_tiles);
+                ++source_tiles_ptr;
+                column += 8;
+            }
+
+            _column += width + _space_between_characters;
+        }
+
+    private:
+        const tile* _source_tiles_ptr;
+        const int8_t* _character_widths;
+        int _max_character_width;
+        int _space_between_characters;
+        int _character_tiles;
+        int _column;
+
+        [[nodiscard]] int _space_width() const
+        {
+            return _character_widths ? _character_widths[0] : _max_character_width;
+        }
+    };
+
+
+    [[nodiscard]] int _graphics_index(char character, const utf8_characters_map_ref& utf8_characters_map,
+                                      const char* text_data, int& text_index)
+    {
+        int result;
+
+        if(character <= '~')
+        {
+            result = character - '!';
+            ++text_index;
+        }
+        else
+        {
+            utf8_character utf8_char(text_data[text_index]);
+            result = utf8_characters_map.index(utf8_char) + sprite_font::minimum_graphics;
+            text_index += utf8_char.size();
+        }
+
+        return result;
+    }
+
+    template<class Painter>
+    void _paint(const string_view& text, const utf8_characters_map_ref& utf8_characters_map, Painter& painter)
+    {
+        const char* text_data = text.data();
+        int text_index = 0;
+        int text_size = text.size();
+
+        while(text_index < text_size)
+        {
+            char character = text_data[text_index];
+
+            if(character == ' ')
+            {
+                painter.paint_space();
+                ++text_index;
+            }
+            else if(character == '\t')
+            {
+                painter.paint_tab();
+                ++text_index;
+            }
+            else if(character >= '!')
+            {
+                int graphics_index = _graphics_index(character, utf8_characters_map, text_data, text_index);
+                painter.paint_character(graphics_index);
+            }
+            else
+            {
+                BN_ERROR("Invalid character: ", character, " (text: ", text, ")");
+            }
+        }
+    }
+
+    [[nodiscard]] unsigned _tile_hash(const tile& source_tile)
+    {
+        unsigned result = 2166136261;
+
+        for(unsigned word : source_tile.data)
+        {
+            result = (result ^ word) * 16777619;
+        }
+
+        return result ^ (result >> 16);
+    }
+
+    [[nodiscard]] bool _blank_tile(const tile& source_tile)
+    {
+        unsigned bits = 0;
+
+        for(unsigned word : source_tile.data)
+        {
+            bits |= word;
+        }
+
+        return ! bits;
+    }
+
+    [[nodiscard]] bool _equal_tiles(const tile& a, const tile& b)
+    {
+        for(int index = 0; index < 8; ++index)
+        {
+            if(a.data[index] != b.data[index])
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    [[nodiscard]] regular_bg_map_ptr _create_map(const bg_palette_item& palette_item, int max_tiles_count)
+    {
+        BN_ASSERT(palette_item.bpp() == bpp_mode::BPP_4, "8BPP fonts not supported");
+
+        return regular_bg_map_ptr::allocate(
+                    size(map_columns, map_rows), regular_bg_tiles_ptr::allocate(max_tiles_count, bpp_mode::BPP_4),
+                    palette_item.create_palette());
+    }
+}
+
+int iregular_bg_text_generator::width(const string_view& text) const
+{
+    width_painter painter(_font);
+    _paint(text, _font.utf8_characters_ref(), painter);
+    return painter.width();
+}
+
+void iregular_bg_text_generator::generate(int x, int y, const string_view& text)
+{
+    int text_width = width(text);
+
+    switch(_alignment)
+    {
+
+    case alignment_type::LEFT:
+        break;
+
+    case alignment_type::CENTER:
+        x -= text_width / 2;
+        break;
+
+    case alignment_type::RIGHT:
+        x -= text_width;
+        break;
+
+    default:
+        BN_ERROR("Invalid alignment: ", int(_alignment));
+        break;
+    }
+
+    int character_height = _font.item().shape_size().height();
+    BN_ASSERT(y >= 0 && y % 8 == 0 && y + character_height <= map_pixels, "Invalid y: ", y);
+    BN_ASSERT(x >= 0 && x + text_width <= map_pixels, "Text doesn't fit in the map: ", x, " - ", text_width);
+
+    if(text_width <= 0)
+    {
+        return;
+    }
+
+    const utf8_characters_map_ref& utf8_characters_map = _font.utf8_characters_ref();
+    int first_column = x / 8;
+    int columns = ((x + text_width - 1) / 8) - first_column + 1;
+    int first_cell_index = ((y / 8) * map_columns) + first_column;
+
+    for(int tiles_row = 0, tiles_rows = character_height / 8; tiles_row < tiles_rows; ++tiles_row)
+    {
+        memory::clear(columns + 1, row_tiles[0]);
+
+        tiles_row_painter painter(_font, tiles_row, x & 7);
+        _paint(text, utf8_characters_map, painter);
+
+        int cell_index = first_cell_index + (tiles_row * map_columns);
+
+        for(int column = 0; column < columns; ++column)
+        {
+            _set_cell(cell_index + column, _acquire(row_tiles[column]));
+        }
+    }
+}
+
+void iregular_bg_text_generator::clear_cells(int x, int y, int width, int height)
+{
+    BN_ASSERT(x >= 0 && width >= 0 && x + width <= map_columns, "Invalid x or width: ", x, " - ", width);
+    BN_ASSERT(y >= 0 && height >= 0 && y + height <= map_rows, "Invalid y or height: ", y, " - ", height);
+
+    for(int row = y, last_row = y + height; row < last_row; ++row)
+    {
+        int cell_index = row * map_columns;
+
+        for(int column = x, last_column = x + width; column < last_column; ++column)
+        {
+            _set_cell(cell_index + column, 0);
+        }
+    }
+}
+
+void iregular_bg_text_generator::clear()
+{
+    clear_cells(0, 0, map_columns, map_rows);
+}
+
+iregular_bg_text_generator::iregular_bg_text_generator(
+        const sprite_font& font, const bg_palette_item& palette_item, slot_type* slots_ptr, uint16_t* buckets_ptr,
+        int max_tiles_count) :
+    _font(font),
+    _map(_create_map(palette_item, max_tiles_count)),
+    _slots_ptr(slots_ptr),
+    _buckets_ptr(buckets_ptr),
+    _max_tiles_count(uint16_t(max_tiles_count)),
+    _free_slots_first(1)
+{
+    regular_bg_tiles_ptr tiles = _map.tiles();
+    _tiles_vram = tiles.vram()->data();
+    _cells_vram = _map.vram()->data();
+    _cells_offset = hw::bg_blocks::regular_map_cells_offset(
+                unsigned(_map.tiles_offset()), unsigned(_map.palette_banks_offset()));
+
+    // Tile 0 is the blank tile, so it is never added to the free slots list:
+    for(int index = 0; index < max_tiles_count; ++index)
+    {
+        slot_type& slot = slots_ptr[index];
+        slot.hash = 0;
+        slot.usages = 0;
+        slot.next = uint16_t(index + 1 < max_tiles_count ? index + 1 : 0);
+        buckets_ptr[index] = 0;
+    }
+
+    memory::clear(1, _tiles_vram[0]);
+    memory::set_half_words(_cells_offset, map_columns * map_rows, _cells_vram);
+}
+
+int iregular_bg_text_generator::_acquire(const tile& source_tile)
+{
+    if(_blank_tile(source_tile))
+    {
+        return 0;
+    }
+
+    slot_type* slots_ptr = _slots_ptr;
+    unsigned hash = _tile_hash(source_tile);
+    uint16_t& bucket = _buckets_ptr[hash & unsigned(_max_tiles_count - 1)];
+
+    for(int tile_index = bucket; tile_index; tile_index = slots_ptr[tile_index].next)
+    {
+        slot_type& slot = slots_ptr[tile_index];
+
+        if(slot.hash == hash && _equal_tiles(_tiles_vram[tile_index], source_tile))
+        {
+            ++slot.usages;
+            return tile_index;
+        }
+    }
+
+    int tile_index = _free_slots_first;
+    BN_BASIC_ASSERT(tile_index, "No more tiles available: ", _max_tiles_count);
+
+    slot_type& slot = slots_ptr[tile_index];
+    _free_slots_first = slot.next;
+    slot.hash = hash;
+    slot.usages = 1;
+    slot.next = bucket;
+    bucket = uint16_t(tile_index);
+    ++_used_tiles_count;
+    hw::sprite_tiles::copy_tiles(&source_tile, 1, _tiles_vram + tile_index);
+    return tile_index;
+}
+
+void iregular_bg_text_generator::_release(int tile_index)
+{
+    if(! tile_index)
+    {
+        return;
+    }
+
+    slot_type* slots_ptr = _slots_ptr;
+    slot_type& slot = slots_ptr[tile_index];
+    --slot.usages;
+
+    if(slot.usages)
+    {
+        return;
+    }
+
+    uint16_t* next_ptr = _buckets_ptr + (slot.hash & unsigned(_max_tiles_count - 1));
+
+    while(*next_ptr != tile_index)
+    {
+        next_ptr = &slots_ptr[*next_ptr].next;
+    }
+
+    *next_ptr = slot.next;
+    slot.next = _free_slots_first;
+    _free_slots_first = uint16_t(tile_index);
+    --_used_tiles_count;
+}
+
+void iregular_bg_text_generator::_set_cell(int cell_index, int tile_index)
+{
+    // New tiles are acquired before releasing the old ones, so unchanged cells keep their tiles:
+    regular_bg_map_cell& cell = _cells_vram[cell_index];
+    int old_tile_index = cell - _cells_offset;
+    cell = regular_bg_map_cell(_cells_offset + tile_index);
+    _release(old_tile_index);
+}
+
+}
@@ -0,0 +1,227 @@
+/*
+ * Copyright (c) 2020-2025 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_regular_bg_tiles_cache.h"
+
+#include "bn_tile.h"
+#include "bn_bpp_mode.h"
+#include "bn_bg_blocks_manager.h"
+#include "../hw/include/bn_hw_memory.h"
+
+namespace bn
+{
+
+int iregular_bg_tiles_cache::hits() const
+{
+    // Cells are committed before the commits count is increased:
+    return _commit == bg_blocks_manager::commits_count() - 1 ? _commit_hits : 0;
+}
+
+int iregular_bg_tiles_cache::misses() const
+{
+    return _commit == bg_blocks_manager::commits_count() - 1 ? _commit_misses : 0;
+}
+
+void iregular_bg_tiles_cache::_bind(const tile* source_tiles_ptr, int source_tiles_count, bpp_mode bpp,
+                                    tile* vram_tiles_ptr)
+{
+    BN_BASIC_ASSERT(! used(), "Tiles cache is already used by another map");
+
+    int tile_size = bpp == bpp_mode::BPP_8 ? 2 : 1;
+    int source_bpp_tiles_count = source_tiles_count / tile_size;
+    BN_ASSERT(source_bpp_tiles_count <= _max_source_tiles_count,
+              "Too many source tiles: ", source_bpp_tiles_count, " - ", _max_source_tiles_count);
+
+    _source_tiles_ptr = source_tiles_ptr;
+    _vram_tiles_ptr = vram_tiles_ptr;
+    _commit = -1;
+    _commit_hits = 0;
+    _commit_misses = 0;
+    _source_tiles_count = uint16_t(source_bpp_tiles_count);
+    _loaded_tiles_count = 0;
+    _referenced_tiles_count = 0;
+    _lru_first = _invalid_index;
+    _lru_last = _invalid_index;
+    _tile_size = uint8_t(tile_size);
+
+    for(int source_tile = 0; source_tile < source_bpp_tiles_count; ++source_tile)
+    {
+        _source_tile_slots_ptr[source_tile] = _invalid_index;
+    }
+
+    for(int slot_index = 0, limit = _max_tiles_count; slot_index < limit; ++slot_index)
+    {
+        slot_type& slot = _slots_ptr[slot_index];
+        slot.source_tile = _invalid_index;
+        slot.usages = 0;
+        _lru_push(slot_index);
+    }
+}
+
+void iregular_bg_tiles_cache::_unbind()
+{
+    _source_tiles_ptr = nullptr;
+    _vram_tiles_ptr = nullptr;
+}
+
+void iregular_bg_tiles_cache::_start_commit(int commit, int max_commit_misses)
+{
+    if(_commit != commit)
+    {
+        _commit = commit;
+        _commit_hits = 0;
+        _commit_misses = 0;
+    }
+
+    _max_commit_misses = max_commit_misses;
+}
+
+void iregular_bg_tiles_cache::_release_all()
+{
+    // Loaded tiles are kept, so they can be reused without reloading them:
+    for(int slot_index = 0, limit = _max_tiles_count; slot_index < limit; ++slot_index)
+    {
+        slot_type& slot = _slots_ptr[slot_index];
+
+        if(slot.usages)
+        {
+            slot.usages = 0;
+            _lru_push(slot_index);
+        }
+    }
+
+    _referenced_tiles_count = 0;
+}
+
+unsigned iregular_bg_tiles_cache::_stream_cell(unsigned source_cell, int source_tile)
+{
+    // Flip and palette bits are kept, tile bits are replaced with the VRAM tile index:
+    int slot_index = _acquire(source_tile);
+    return (source_cell - unsigned(_cell_tile(source_cell))) | unsigned(slot_index);
+}
+
+unsigned iregular_bg_tiles_cache::_replace_cell(unsigned old_cell, unsigned source_cell, int source_tile)
+{
+    _release(_cell_tile(old_cell));
+    return _stream_cell(source_cell, source_tile);
+}
+
+void iregular_bg_tiles_cache::_lru_push(int slot_index)
+{
+    slot_type& slot = _slots_ptr[slot_index];
+    slot.previous = _lru_last;
+    slot.next = _invalid_index;
+
+    if(_lru_last == _invalid_index)
+    {
+        _lru_first = uint16_t(slot_index);
+    }
+    else
+    {
+        _slots_ptr[_lru_last].next = uint16_t(slot_index);
+    }
+
+    _lru_last = uint16_t(slot_index);
+}
+
+void iregular_bg_tiles_cache::_lru_remove(int slot_index)
+{
+    slot_type& slot = _slots_ptr[slot_index];
+
+    if(slot.previous == _invalid_index)
+    {
+        _lru_first = slot.next;
+    }
+    else
+    {
+        _slots_ptr[slot.previous].next = slot.next;
+    }
+
+    if(slot.next == _invalid_index)
+    {
+        _lru_last = slot.previous;
+    }
+    else
+    {
+        _slots_ptr[slot.next].previous = slot.previous;
+    }
+}
+
+int iregular_bg_tiles_cache::_acquire(int source_tile)
+{
+    BN_BASIC_ASSERT(source_tile < _source_tiles_count,
+                    "Invalid source tile: ", source_tile, " - ", _source_tiles_count);
+
+    int slot_index = _source_tile_slots_ptr[source_tile];
+
+    if(slot_index != _invalid_index)
+    {
+        slot_type& slot = _slots_ptr[slot_index];
+
+        if(! slot.usages)
+        {
+            _lru_remove(slot_index);
+            ++_referenced_tiles_count;
+        }
+
+        ++slot.usages;
+        ++_commit_hits;
+        ++_total_hits;
+        return slot_index;
+    }
+
+    // The least recently used tile not referenced by the map is replaced:
+    slot_index = _lru_first;
+    BN_BASIC_ASSERT(slot_index != _invalid_index, "Tiles cache is full: ", _max_tiles_count);
+
+    slot_type& slot = _slots_ptr[slot_index];
+    _lru_remove(slot_index);
+
+    if(slot.source_tile == _invalid_index)
+    {
+        ++_loaded_tiles_count;
+    }
+    else
+    {
+        _source_tile_slots_ptr[slot.source_tile] = _invalid_index;
+    }
+
+    slot.source_tile = uint16_t(source_tile);
+    slot.usages = 1;
+    _source_tile_slots_ptr[source_tile] = uint16_t(slot_index);
+    ++_referenced_tiles_count;
+    ++_commit_misses;
+    ++_total_misses;
+
+    // Tiles are copied in V-Blank, so they can't be loaded without limit:
+    BN_ASSERT(! _max_commit_misses || _commit_misses <= _max_commit_misses,
+              "Too many streamed tiles loaded in one frame: ", _commit_misses, " - ", _max_commit_misses);
+
+    int tile_size = _tile_size;
+    hw::memory::copy_words(_source_tiles_ptr + (source_tile * tile_size), tile_size * int(sizeof(tile) / 4),
+                           _vram_tiles_ptr + (slot_index * tile_size));
+    return slot_index;
+}
+
+void iregular_bg_tiles_cache::_release(int slot_index)
+{
+    if(slot_index < _max_tiles_count)
+    {
+        slot_type& slot = _slots_ptr[slot_index];
+
+        if(slot.usages)
+        {
+            --slot.usages;
+
+            if(! slot.usages)
+            {
+                _lru_push(slot_index);
+                --_referenced_tiles_count;
+            }
+        }
+    }
+}
+
+}
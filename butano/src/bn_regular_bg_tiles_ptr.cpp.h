@@ -125,6 +125,11 @@ void regular_bg_tiles_ptr::reload_tiles_ref()
     bg_blocks_manager::reload(_handle);
 }
 
+bool regular_bg_tiles_ptr::ready() const
+{
+    return bg_blocks_manager::ready(_handle);
+}
+
 optional<span<tile>> regular_bg_tiles_ptr::vram()
 {
     return bg_blocks_manager::tiles_vram(_handle);
@@ -129,6 +129,38 @@ namespace bn::sorted_sprites
             return sort;
         }
 
+        [[nodiscard]] sprites_manager_item* next_item_with_handle(sprites_manager_item& item)
+        {
+            using items_type = intrusive_list<sprites_manager_item>;
+
+            layers_type::iterator layers_it(_layer_ptr(item.sort_layer_ptr_diff));
+            layers_type::iterator layers_end = _layer_ptrs.end();
+            items_type::iterator items_it(&item);
+            ++items_it;
+
+            while(true)
+            {
+                items_type::iterator items_end = layers_it->items().end();
+
+                for(; items_it != items_end; ++items_it)
+                {
+                    if(items_it->handles_index >= 0)
+                    {
+                        return &*items_it;
+                    }
+                }
+
+                ++layers_it;
+
+                if(layers_it == layers_end)
+                {
+                    return nullptr;
+                }
+
+                items_it = layers_it->items().begin();
+            }
+        }
+
     private:
         pool<layer, BN_CFG_SPRITES_MAX_SORT_LAYERS> _layer_pool;
         layers_type _layer_ptrs;
@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2020-2025 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_spatial_grid.h"
+
+#include "bn_algorithm.h"
+#include "../hw/include/bn_hw_common.h"
+
+namespace _bn::spatial_grid
+{
+
+namespace
+{
+    class cells_range
+    {
+
+    public:
+        int first_column;
+        int last_column;
+        int first_row;
+        int last_row;
+
+        cells_range(const data_type& data, int left, int top, int right, int bottom)
+        {
+            // Edges are excluded, so the last cell is the one which contains the last point inside the rectangle:
+            int shift = data.shift;
+            int columns = data.columns;
+            int rows = data.rows;
+            first_column = bn::clamp((left - data.origin_x) >> shift, 0, columns - 1);
+            last_column = bn::clamp((bn::max(right - 1, left) - data.origin_x) >> shift, 0, columns - 1);
+            first_row = bn::clamp((top - data.origin_y) >> shift, 0, rows - 1);
+            last_row = bn::clamp((bn::max(bottom - 1, top) - data.origin_y) >> shift, 0, rows - 1);
+        }
+    };
+
+    [[nodiscard]] BN_CODE_IWRAM int _find_impl(const data_type& data, int left, int top, int right, int bottom)
+    {
+        const int* lefts = data.lefts;
+        const int* tops = data.tops;
+        const int* rights = data.rights;
+        const int* bottoms = data.bottoms;
+        const uint16_t* cell_starts = data.cell_starts;
+        const uint16_t* entries = data.entries;
+        cells_range range(data, left, top, right, bottom);
+
+        for(int row = range.first_row; row <= range.last_row; ++row)
+        {
+            int row_cell = row * data.columns;
+
+            for(int column = range.first_column; column <= range.last_column; ++column)
+            {
+                int cell = row_cell + column;
+
+                for(int entry = cell_starts[cell], last_entry = cell_starts[cell + 1]; entry < last_entry; ++entry)
+                {
+                    int index = entries[entry];
+
+                    if(lefts[index] < right && rights[index] > left && tops[index] < bottom && bottoms[index] > top)
+                    {
+                        return index;
+                    }
+                }
+            }
+        }
+
+        return -1;
+    }
+}
+
+BN_CODE_IWRAM int build(const data_type& data, int size, int max_entries)
+{
+    const int* lefts = data.lefts;
+    const int* tops = data.tops;
+    const int* rights = data.rights;
+    const int* bottoms = data.bottoms;
+    uint16_t* cell_starts = data.cell_starts;
+    uint16_t* entries = data.entries;
+    int columns = data.columns;
+    int cells_count = columns * data.rows;
+
+    // Count the entries of each cell:
+    for(int cell = 0; cell < cells_count; ++cell)
+    {
+        cell_starts[cell] = 0;
+    }
+
+    int entries_count = 0;
+
+    for(int index = 0; index < size; ++index)
+    {
+        cells_range range(data, lefts[index], tops[index], rights[index], bottoms[index]);
+
+        for(int row = range.first_row; row <= range.last_row; ++row)
+        {
+            int row_cell = row * columns;
+
+            for(int column = range.first_column; column <= range.last_column; ++column)
+            {
+                ++cell_starts[row_cell + column];
+            }
+        }
+
+        entries_count += (range.last_column - range.first_column + 1) * (range.last_row - range.first_row + 1);
+    }
+
+    if(entries_count > max_entries)
+    {
+        return -1;
+    }
+
+    // Store the end of each cell:
+    int cell_end = 0;
+
+    for(int cell = 0; cell < cells_count; ++cell)
+    {
+        cell_end += cell_starts[cell];
+        cell_starts[cell] = uint16_t(cell_end);
+    }
+
+    cell_starts[cells_count] = uint16_t(cell_end);
+
+    // Fill cells backwards, so each cell end becomes its start and rectangles are sorted by index:
+    for(int index = size - 1; index >= 0; --index)
+    {
+        cells_range range(data, lefts[index], tops[index], rights[index], bottoms[index]);
+
+        for(int row = range.first_row; row <= range.last_row; ++row)
+        {
+            int row_cell = row * columns;
+
+            for(int column = range.first_column; column <= range.last_column; ++column)
+            {
+                entries[--cell_starts[row_cell + column]] = uint16_t(index);
+            }
+        }
+    }
+
+    return entries_count;
+}
+
+BN_CODE_IWRAM int find(const data_type& data, int left, int top, int right, int bottom)
+{
+    return _find_impl(data, left, top, right, bottom);
+}
+
+BN_CODE_IWRAM void find(const data_type& data, const bn::fixed_rect* rects, int rects_count, int16_t* indexes)
+{
+    for(int index = 0; index < rects_count; ++index)
+    {
+        const bn::fixed_rect& rect = rects[index];
+        int left = rect.left().data();
+        int top = rect.top().data();
+        indexes[index] = int16_t(_find_impl(data, left, top, left + rect.width().data(),
+                                            top + rect.height().data()));
+    }
+}
+
+BN_CODE_IWRAM void find(const data_type& data, const bn::top_left_fixed_rect* rects, int rects_count,
+                        int16_t* indexes)
+{
+    for(int index = 0; index < rects_count; ++index)
+    {
+        const bn::top_left_fixed_rect& rect = rects[index];
+        int left = rect.left().data();
+        int top = rect.top().data();
+        indexes[index] = int16_t(_find_impl(data, left, top, left + rect.width().data(),
+                                            top + rect.height().data()));
+    }
+}
+
+BN_CODE_IWRAM int query(const data_type& data, int stamp, int left, int top, int right, int bottom,
+                        uint16_t* indexes, int max_indexes)
+{
+    const int* lefts = data.lefts;
+    const int* tops = data.tops;
+    const int* rights = data.rights;
+    const int* bottoms = data.bottoms;
+    const uint16_t* cell_starts = data.cell_starts;
+    const uint16_t* entries = data.entries;
+    uint16_t* stamps = data.stamps;
+    cells_range range(data, left, top, right, bottom);
+    int indexes_count = 0;
+
+    for(int row = range.first_row; row <= range.last_row; ++row)
+    {
+        int row_cell = row * data.columns;
+
+        for(int column = range.first_column; column <= range.last_column; ++column)
+        {
+            int cell = row_cell + column;
+
+            for(int entry = cell_starts[cell], last_entry = cell_starts[cell + 1]; entry < last_entry; ++entry)
+            {
+                int index = entries[entry];
+
+                // Rectangles stored in more than one cell are tested only once:
+                if(stamps[index] != stamp)
+                {
+                    stamps[index] = uint16_t(stamp);
+
+                    if(lefts[index] < right && rights[index] > left && tops[index] < bottom && bottoms[index] > top)
+                    {
+                        if(indexes_count == max_indexes)
+                        {
+                            return -1;
+                        }
+
+                        indexes[indexes_count] = uint16_t(index);
+                        ++indexes_count;
+                    }
+                }
+            }
+        }
+    }
+
+    return indexes_count;
+}
+
+}
@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2020-2025 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_spatial_grid.h"
+
+#include "bn_memory.h"
+
+namespace bn
+{
+
+ispatial_grid::ispatial_grid(int* lefts, int* tops, int* rights, int* bottoms, uint16_t* cell_starts,
+                             uint16_t* entries, uint16_t* stamps, int max_size, int max_entries, int columns,
+                             int rows, const fixed_point& top_left, int cell_size) :
+    _top_left(top_left),
+    _max_size(max_size),
+    _max_entries(max_entries)
+{
+    BN_ASSERT(cell_size > 0 && (cell_size & (cell_size - 1)) == 0, "Invalid cell size: ", cell_size);
+
+    _cell_shift = uint8_t(__builtin_ctz(unsigned(cell_size)));
+    _data.lefts = lefts;
+    _data.tops = tops;
+    _data.rights = rights;
+    _data.bottoms = bottoms;
+    _data.cell_starts = cell_starts;
+    _data.entries = entries;
+    _data.stamps = stamps;
+    _data.origin_x = top_left.x().data();
+    _data.origin_y = top_left.y().data();
+    _data.shift = _cell_shift + fixed::precision();
+    _data.columns = columns;
+    _data.rows = rows;
+    memory::clear(max_size, *stamps);
+}
+
+top_left_fixed_rect ispatial_grid::rect(int index) const
+{
+    BN_ASSERT(index >= 0 && index < _size, "Invalid index: ", index, " - ", _size);
+
+    int left = _data.lefts[index];
+    int top = _data.tops[index];
+    return top_left_fixed_rect(fixed::from_data(left), fixed::from_data(top),
+                               fixed::from_data(_data.rights[index] - left),
+                               fixed::from_data(_data.bottoms[index] - top));
+}
+
+void ispatial_grid::find(const span<const fixed_rect>& rects, span<int16_t> indexes)
+{
+    int rects_count = rects.size();
+    BN_ASSERT(indexes.size() >= rects_count, "Invalid indexes size: ", indexes.size(), " - ", rects_count);
+
+    build();
+    _bn::spatial_grid::find(_data, rects.data(), rects_count, indexes.data());
+}
+
+void ispatial_grid::find(const span<const top_left_fixed_rect>& rects, span<int16_t> indexes)
+{
+    int rects_count = rects.size();
+    BN_ASSERT(indexes.size() >= rects_count, "Invalid indexes size: ", indexes.size(), " - ", rects_count);
+
+    build();
+    _bn::spatial_grid::find(_data, rects.data(), rects_count, indexes.data());
+}
+
+void ispatial_grid::build()
+{
+    if(! _built)
+    {
+        [[maybe_unused]] int entries_count = _bn::spatial_grid::build(_data, _size, _max_entries);
+        BN_ASSERT(entries_count >= 0, "Too many cell entries. Max entries: ", _max_entries);
+
+        _built = true;
+    }
+}
+
+int ispatial_grid::_insert(int left, int top, int width, int height)
+{
+    BN_ASSERT(! full(), "Spatial grid is full");
+    BN_ASSERT(width >= 0 && height >= 0, "Invalid size: ", width, " - ", height);
+
+    int index = _size;
+    _data.lefts[index] = left;
+    _data.tops[index] = top;
+    _data.rights[index] = left + width;
+    _data.bottoms[index] = top + height;
+    _size = index + 1;
+    _built = false;
+    return index;
+}
+
+void ispatial_grid::_set_rect(int index, int left, int top, int width, int height)
+{
+    BN_ASSERT(index >= 0 && index < _size, "Invalid index: ", index, " - ", _size);
+    BN_ASSERT(width >= 0 && height >= 0, "Invalid size: ", width, " - ", height);
+
+    _data.lefts[index] = left;
+    _data.tops[index] = top;
+    _data.rights[index] = left + width;
+    _data.bottoms[index] = top + height;
+    _built = false;
+}
+
+int ispatial_grid::_find(int left, int top, int width, int height)
+{
+    build();
+    return _bn::spatial_grid::find(_data, left, top, left + width, top + height);
+}
+
+void ispatial_grid::_query(int left, int top, int width, int height, ivector<uint16_t>& indexes)
+{
+    build();
+
+    int old_size = indexes.size();
+    int available_size = indexes.available();
+    indexes.resize(old_size + available_size);
+
+    int indexes_count = _bn::spatial_grid::query(_data, _next_stamp(), left, top, left + width, top + height,
+                                                 indexes.data() + old_size, available_size);
+    BN_ASSERT(indexes_count >= 0, "Indexes vector is full");
+
+    indexes.shrink(old_size + (indexes_count >= 0 ? indexes_count : available_size));
+}
+
+int ispatial_grid::_next_stamp()
+{
+    int stamp = _stamp + 1;
+
+    // Stamps must be reset when the counter overflows, since old stamps would be mistaken for new ones:
+    if(stamp > 65535)
+    {
+        memory::clear(_max_size, *_data.stamps);
+        stamp = 1;
+    }
+
+    _stamp = uint16_t(stamp);
+    return stamp;
+}
+
+}
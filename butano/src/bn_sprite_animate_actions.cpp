@@ -1,6 +1,7 @@
 #include "bn_sprite_animate_actions.h"
 
 #include "bn_limits.h"
+#include "bn_sprite_tiles_manager.h"
 
 namespace bn
 {
@@ -240,4 +241,120 @@ void isprite_cached_animate_action::_assign_tiles_list(ivector<sprite_tiles_ptr>
     *_tiles_list_ref = move(tiles_list);
 }
 
+
+isprite_streamed_animate_action& isprite_streamed_animate_action::operator=(
+        isprite_streamed_animate_action&& other) noexcept
+{
+    if(this != &other)
+    {
+        BN_ASSERT(other.graphics_indexes().size() <= graphics_indexes().max_size(),
+                  "Too many graphics indexes: ", other.graphics_indexes().size(), " - ",
+                  graphics_indexes().max_size());
+
+        *_sprite_ref = move(*other._sprite_ref);
+        *_tiles_item_ref = *other._tiles_item_ref;
+        *_graphics_indexes_ref = *other._graphics_indexes_ref;
+        *_first_tiles_ref = move(*other._first_tiles_ref);
+        *_second_tiles_ref = move(*other._second_tiles_ref);
+        _assign(other);
+    }
+
+    return *this;
+}
+
+void isprite_streamed_animate_action::update()
+{
+    BN_ASSERT(! done(), "Action is done");
+
+    if(_current_wait_updates)
+    {
+        --_current_wait_updates;
+    }
+    else
+    {
+        const ivector<uint16_t>& graphics_indexes = this->graphics_indexes();
+        int current_graphics_indexes_index = _current_graphics_indexes_index;
+        int current_graphics_index = graphics_indexes[current_graphics_indexes_index];
+        _current_wait_updates = _wait_updates;
+
+        if(current_graphics_indexes_index == 0 ||
+                graphics_indexes[current_graphics_indexes_index - 1] != current_graphics_index)
+        {
+            // The front slot is still shown until the next V-Blank,
+            // when the tiles are copied into the back slot and the sprite is updated to show it:
+            bool second_tiles_back = _second_tiles_back;
+            sprite_tiles_ptr& back_tiles = second_tiles_back ? *_second_tiles_ref : *_first_tiles_ref;
+            span<const tile> tiles_ref = _tiles_item_ref->graphics_tiles_ref(current_graphics_index);
+            sprite_tiles_manager::stream_tiles(back_tiles.handle(), tiles_ref.data());
+            _sprite_ref->set_tiles(back_tiles);
+            _second_tiles_back = ! second_tiles_back;
+        }
+
+        if(_forever && current_graphics_indexes_index == graphics_indexes.size() - 1)
+        {
+            _current_graphics_indexes_index = 0;
+        }
+        else
+        {
+            ++_current_graphics_indexes_index;
+        }
+    }
+}
+
+void isprite_streamed_animate_action::set_wait_updates(int wait_updates)
+{
+    BN_ASSERT(wait_updates >= 0, "Invalid wait updates: ", wait_updates);
+    BN_ASSERT(wait_updates <= numeric_limits<decltype(_wait_updates)>::max(),
+              "Too many wait updates: ", wait_updates);
+
+    _wait_updates = uint16_t(wait_updates);
+
+    if(wait_updates < _current_wait_updates)
+    {
+        _current_wait_updates = uint16_t(wait_updates);
+    }
+}
+
+sprite_tiles_ptr isprite_streamed_animate_action::_allocate_tiles(const sprite_tiles_item& tiles_item)
+{
+    BN_ASSERT(tiles_item.compression() == compression_type::NONE, "Compressed tiles are not supported");
+
+    return sprite_tiles_ptr::allocate(tiles_item.tiles_count_per_graphic(), tiles_item.bpp());
+}
+
+void isprite_streamed_animate_action::_set_refs(
+        sprite_ptr& sprite, sprite_tiles_item& tiles_item, ivector<uint16_t>& graphics_indexes,
+        sprite_tiles_ptr& first_tiles, sprite_tiles_ptr& second_tiles)
+{
+    _sprite_ref = &sprite;
+    _tiles_item_ref = &tiles_item;
+    _graphics_indexes_ref = &graphics_indexes;
+    _first_tiles_ref = &first_tiles;
+    _second_tiles_ref = &second_tiles;
+}
+
+void isprite_streamed_animate_action::_assign(const isprite_streamed_animate_action& other)
+{
+    _wait_updates = other._wait_updates;
+    _current_graphics_indexes_index = other._current_graphics_indexes_index;
+    _current_wait_updates = other._current_wait_updates;
+    _forever = other._forever;
+    _second_tiles_back = other._second_tiles_back;
+}
+
+void isprite_streamed_animate_action::_assign_graphics_indexes(const span<const uint16_t>& graphics_indexes)
+{
+    BN_ASSERT(graphics_indexes.size() > 1 && graphics_indexes.size() <= _graphics_indexes_ref->max_size(),
+              "Invalid graphics indexes count: ", graphics_indexes.size());
+
+    int graphics_count = _tiles_item_ref->graphics_count();
+
+    for(uint16_t graphics_index : graphics_indexes)
+    {
+        BN_ASSERT(graphics_index < graphics_count, "Invalid graphics index: ", graphics_index, " - ", graphics_count);
+
+        _graphics_indexes_ref->push_back(graphics_index);
+    }
+}
+
 }
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2020-2025 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_sprite_batch.h"
+
+#include "bn_sprites.h"
+#include "bn_sprite_item.h"
+#include "bn_sprites_manager.h"
+
+namespace bn
+{
+
+isprite_batch::isprite_batch(const sprite_item& item, ivector<sprite_tiles_ptr>& tiles_list, int16_t* xs,
+                             int16_t* ys, uint8_t* tiles_indexes, uint8_t* flags, int max_size) :
+    isprite_batch(item.shape_size(), item.palette_item().create_palette(), tiles_list, xs, ys, tiles_indexes,
+                  flags, max_size)
+{
+}
+
+isprite_batch::isprite_batch(const sprite_shape_size& shape_size, const sprite_palette_ptr& palette,
+                             ivector<sprite_tiles_ptr>& tiles_list, int16_t* xs, int16_t* ys,
+                             uint8_t* tiles_indexes, uint8_t* flags, int max_size) :
+    _tiles_list_ref(&tiles_list),
+    _xs(xs),
+    _ys(ys),
+    _tiles_indexes(tiles_indexes),
+    _flags(flags),
+    _palette(palette),
+    _shape_size(shape_size),
+    _max_size(max_size)
+{
+    sprites_manager::attach_batch(*this);
+}
+
+isprite_batch::~isprite_batch()
+{
+    sprites_manager::detach_batch(*this);
+}
+
+void isprite_batch::set_bg_priority(int bg_priority)
+{
+    BN_ASSERT(bg_priority >= 0 && bg_priority <= sprites::max_bg_priority(),
+              "Invalid BG priority: ", bg_priority);
+
+    _bg_priority = uint8_t(bg_priority);
+}
+
+void isprite_batch::push_back(int x, int y, int tiles_index)
+{
+    BN_ASSERT(! full(), "Batch is full");
+    BN_ASSERT(tiles_index >= 0 && tiles_index < _tiles_list_ref->size(),
+              "Invalid tiles index: ", tiles_index, " - ", _tiles_list_ref->size());
+
+    int size = _size;
+    _xs[size] = int16_t(x);
+    _ys[size] = int16_t(y);
+    _tiles_indexes[size] = uint8_t(tiles_index);
+    _flags[size] = 0;
+    _size = size + 1;
+}
+
+void isprite_batch::erase(int index)
+{
+    BN_ASSERT(index >= 0 && index < _size, "Invalid index: ", index, " - ", _size);
+
+    int last_index = _size - 1;
+    _xs[index] = _xs[last_index];
+    _ys[index] = _ys[last_index];
+    _tiles_indexes[index] = _tiles_indexes[last_index];
+    _flags[index] = _flags[last_index];
+    _size = last_index;
+}
+
+void isprite_batch::_assign_tiles_list(const sprite_item& item)
+{
+    const sprite_tiles_item& tiles_item = item.tiles_item();
+    int graphics_count = tiles_item.graphics_count();
+    ivector<sprite_tiles_ptr>& tiles_list = *_tiles_list_ref;
+
+    BN_ASSERT(graphics_count <= tiles_list.max_size(),
+              "Too many graphics: ", graphics_count, " - ", tiles_list.max_size());
+
+    for(int graphics_index = 0; graphics_index < graphics_count; ++graphics_index)
+    {
+        tiles_list.push_back(tiles_item.create_tiles(graphics_index));
+    }
+}
+
+void isprite_batch::_assign_tiles_list(const span<const sprite_tiles_ptr>& tiles_list)
+{
+    ivector<sprite_tiles_ptr>& tiles_list_ref = *_tiles_list_ref;
+    int tiles_count = _shape_size.tiles_count(_palette.bpp());
+
+    BN_ASSERT(! tiles_list.empty() && tiles_list.size() <= tiles_list_ref.max_size(),
+              "Invalid tiles count: ", tiles_list.size(), " - ", tiles_list_ref.max_size());
+
+    for(const sprite_tiles_ptr& tiles : tiles_list)
+    {
+        BN_ASSERT(tiles.tiles_count() == tiles_count,
+                  "Invalid tiles, palette or shape size: ", tiles.tiles_count(), " - ", tiles_count);
+
+        tiles_list_ref.push_back(tiles);
+    }
+}
+
+}
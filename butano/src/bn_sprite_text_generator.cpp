@@ -7,6 +7,7 @@
 
 #include "bn_sprites.h"
 #include "bn_sprite_ptr.h"
+#include "bn_sprite_text.h"
 #include "bn_sprite_builder.h"
 #include "bn_top_left_utils.h"
 #include "../hw/include/bn_hw_sprite_tiles.h"
@@ -967,6 +968,115 @@ namespace
     };
 
 
+    template<class Character>
+    class sprite_text_layout_painter
+    {
+
+    public:
+        static constexpr bool can_fail = false;
+
+        sprite_text_layout_painter(const sprite_font& font, Character* characters_ptr, int old_characters_count,
+                                   int max_width, bool* dirty_columns_ptr) :
+            _characters_ptr(characters_ptr),
+            _dirty_columns_ptr(dirty_columns_ptr),
+            _character_widths(font.character_widths_ref().data()),
+            _max_character_width(font.item().shape_size().width()),
+            _space_between_characters(font.space_between_characters()),
+            _old_characters_count(old_characters_count),
+            _max_width(max_width)
+        {
+        }
+
+        [[nodiscard]] int characters_count() const
+        {
+            return _characters_count;
+        }
+
+        [[nodiscard]] int width() const
+        {
+            return _column;
+        }
+
+        [[nodiscard]] int right_column() const
+        {
+            return _right_column;
+        }
+
+        void paint_space()
+        {
+            _column += _space_width() + _space_between_characters;
+        }
+
+        void paint_tab()
+        {
+            _column += (_space_width() * 4) + _space_between_characters;
+        }
+
+        [[nodiscard]] bool paint_character(int graphics_index)
+        {
+            int column = _column;
+            int width = _character_widths ? _character_widths[graphics_index + 1] : _max_character_width;
+
+            if(width)
+            {
+                int characters_count = _characters_count;
+                BN_BASIC_ASSERT(column + width <= _max_width, "Text is too wide for the available sprites");
+
+                // Characters laid out as in the previous text don't need to be redrawn:
+                Character& character = _characters_ptr[characters_count];
+
+                if(characters_count >= _old_characters_count || character.column != column ||
+                        character.graphics_index != graphics_index)
+                {
+                    if(characters_count < _old_characters_count)
+                    {
+                        set_dirty_columns(character, _dirty_columns_ptr);
+                    }
+
+                    character.column = int16_t(column);
+                    character.graphics_index = int16_t(graphics_index);
+                    character.width = int16_t(width);
+                    set_dirty_columns(character, _dirty_columns_ptr);
+                }
+
+                _characters_count = characters_count + 1;
+                _right_column = max(_right_column, column + width);
+            }
+
+            _column = column + width + _space_between_characters;
+            return true;
+        }
+
+        static void set_dirty_columns(const Character& character, bool* dirty_columns_ptr)
+        {
+            int first_column = character.column;
+
+            for(int column = first_column / 8, last_column = (first_column + character.width - 1) / 8;
+                column <= last_column; ++column)
+            {
+                dirty_columns_ptr[column] = true;
+            }
+        }
+
+    private:
+        Character* _characters_ptr;
+        bool* _dirty_columns_ptr;
+        const int8_t* _character_widths;
+        int _max_character_width;
+        int _space_between_characters;
+        int _old_characters_count;
+        int _max_width;
+        int _characters_count = 0;
+        int _column = 0;
+        int _right_column = 0;
+
+        [[nodiscard]] int _space_width() const
+        {
+            return _character_widths ? _character_widths[0] : _max_character_width;
+        }
+    };
+
+
     [[nodiscard]] int _graphics_index(char character, const utf8_characters_map_ref& utf8_characters_map,
                                       const char* text_data, int& text_index)
     {
@@ -1353,4 +1463,196 @@ void sprite_text_generator::_init()
     }
 }
 
+void isprite_text::set_position(const fixed_point& position)
+{
+    _position = position;
+    _update_positions();
+}
+
+void isprite_text::set_alignment(sprite_text_generator::alignment_type alignment)
+{
+    _generator.set_alignment(alignment);
+    _update_positions();
+}
+
+void isprite_text::set_text(const string_view& text)
+{
+    const sprite_font& font = _generator.font();
+    int max_columns = _max_sprites * 4;
+    int old_characters_count = _characters_count;
+    bool* dirty_columns_ptr = _dirty_columns_ptr;
+    sprite_text_layout_painter<character_type> painter(font, _characters_ptr, old_characters_count, max_columns * 8,
+                                                       dirty_columns_ptr);
+    [[maybe_unused]] bool success = _paint(text, font.utf8_characters_ref(), painter);
+
+    int characters_count = painter.characters_count();
+
+    for(int index = characters_count; index < old_characters_count; ++index)
+    {
+        painter.set_dirty_columns(_characters_ptr[index], dirty_columns_ptr);
+    }
+
+    _characters_count = characters_count;
+    _width = painter.width();
+
+    ivector<sprite_ptr>& sprites = _sprites;
+    int sprites_count = (painter.right_column() + 31) / 32;
+    int character_height = font.item().shape_size().height();
+    int character_rows = character_height / 8;
+
+    while(sprites.size() > sprites_count)
+    {
+        sprites.pop_back();
+    }
+
+    if(sprites.size() < sprites_count)
+    {
+        sprite_shape_size shape_size(sprite_shape::WIDE,
+                                     character_height == 8 ? sprite_size::NORMAL : sprite_size::BIG);
+
+        for(int index = sprites.size(); index < sprites_count; ++index)
+        {
+            sprite_tiles_ptr tiles = sprite_tiles_ptr::allocate(4 * character_rows, bpp_mode::BPP_4);
+            _sprite_tiles_ptr[index] = tiles.vram()->data();
+
+            sprite_builder builder(shape_size, move(tiles), _palette);
+            _setup_builder(_generator, builder);
+            sprites.push_back(sprite_ptr::create(move(builder)));
+
+            for(int column = index * 4, last_column = column + 4; column < last_column; ++column)
+            {
+                dirty_columns_ptr[column] = true;
+            }
+        }
+    }
+
+    _update_positions();
+
+    int columns = sprites_count * 4;
+    int redrawn_tiles_count = 0;
+
+    for(int column = 0; column < max_columns; ++column)
+    {
+        if(dirty_columns_ptr[column])
+        {
+            dirty_columns_ptr[column] = false;
+
+            if(column < columns)
+            {
+                _redraw_column(column);
+                redrawn_tiles_count += character_rows;
+            }
+        }
+    }
+
+    _last_redrawn_tiles_count = redrawn_tiles_count;
+}
+
+isprite_text::isprite_text(const sprite_text_generator& generator, const fixed_point& position,
+                           ivector<sprite_ptr>& sprites, tile** sprite_tiles_ptr, character_type* characters_ptr,
+                           bool* dirty_columns_ptr, int max_sprites) :
+    _generator(generator),
+    _palette(sprite_palette_ptr::create(generator.palette_item())),
+    _position(position),
+    _sprites(sprites),
+    _sprite_tiles_ptr(sprite_tiles_ptr),
+    _characters_ptr(characters_ptr),
+    _dirty_columns_ptr(dirty_columns_ptr),
+    _max_sprites(max_sprites)
+{
+    [[maybe_unused]] const sprite_shape_size& shape_size = generator.font().item().shape_size();
+    BN_ASSERT(shape_size.width() <= 16 && shape_size.height() <= 16,
+              "Font not supported: ", shape_size.width(), " - ", shape_size.height());
+}
+
+void isprite_text::_update_positions()
+{
+    fixed x = _position.x();
+    fixed y = _position.y();
+
+    switch(_generator.alignment())
+    {
+
+    case sprite_text_generator::alignment_type::LEFT:
+        break;
+
+    case sprite_text_generator::alignment_type::CENTER:
+        x -= _width / 2;
+        break;
+
+    case sprite_text_generator::alignment_type::RIGHT:
+        x -= _width;
+        break;
+
+    default:
+        BN_ERROR("Invalid alignment: ", int(_generator.alignment()));
+        break;
+    }
+
+    x += 16;
+
+    for(sprite_ptr& sprite : _sprites)
+    {
+        sprite.set_position(x, y);
+        x += 32;
+    }
+}
+
+void isprite_text::_redraw_column(int column)
+{
+    const sprite_item& item = _generator.font().item();
+    const sprite_shape_size& shape_size = item.shape_size();
+    int character_columns = shape_size.width() / 8;
+    int character_rows = shape_size.height() / 8;
+    int character_tiles = character_columns * character_rows;
+    const tile* source_tiles_ptr = item.tiles_item().tiles_ref().data();
+    const character_type* characters_ptr = _characters_ptr;
+    int characters_count = _characters_count;
+    int first_x = column * 8;
+    int last_x = first_x + 8;
+    tile* destination_tiles_ptr = _sprite_tiles_ptr[column / 4] + (column % 4);
+
+    // The column is drawn in the middle tile, so characters which start in the previous column can be plotted:
+    tile column_tiles[3];
+
+    for(int character_row = 0; character_row < character_rows; ++character_row)
+    {
+        hw::sprite_tiles::clear_tiles(3, column_tiles);
+
+        for(int index = 0; index < characters_count; ++index)
+        {
+            const character_type& character = characters_ptr[index];
+            int character_x = character.column;
+
+            if(character_x >= last_x)
+            {
+                break;
+            }
+
+            int character_width = character.width;
+
+            if(character_x + character_width > first_x)
+            {
+                const tile* character_tiles_ptr = source_tiles_ptr + (character.graphics_index * character_tiles) +
+                        (character_row * character_columns);
+
+                // Characters are plotted in the same order as in a full redraw, so the result is the same:
+                for(int character_column = 0; character_column < character_columns; ++character_column)
+                {
+                    int x = character_x + (character_column * 8);
+                    int width = min(character_width - (character_column * 8), 8);
+
+                    if(width > 0 && x < last_x && x + width > first_x)
+                    {
+                        hw::sprite_tiles::plot_tiles(width, character_tiles_ptr + character_column, 0,
+                                                     x - first_x + 8, column_tiles);
+                    }
+                }
+            }
+        }
+
+        hw::sprite_tiles::copy_tiles(column_tiles + 1, 1, destination_tiles_ptr + (character_row * 4));
+    }
+}
+
 }
@@ -16,6 +16,11 @@
 #include "bn_sprite_tiles_ptr.cpp.h"
 #include "bn_sprite_tiles_item.cpp.h"
 
+#if BN_CFG_SPRITE_TILES_STAGING_BUFFER_SIZE
+    #include "bn_timer.h"
+    #include "../hw/include/bn_hw_timer_constants.h"
+#endif
+
 #if BN_CFG_SPRITE_TILES_LOG_ENABLED
     #include "bn_log.h"
     #include "bn_tile.h"
@@ -33,6 +38,10 @@ namespace
     static_assert(BN_CFG_SPRITE_TILES_MAX_ITEMS > 0 &&
                   BN_CFG_SPRITE_TILES_MAX_ITEMS <= hw::sprite_tiles::tiles_count());
     static_assert(power_of_two(BN_CFG_SPRITE_TILES_MAX_ITEMS));
+    static_assert(BN_CFG_SPRITE_TILES_STAGING_BUFFER_SIZE >= 0 &&
+                  BN_CFG_SPRITE_TILES_STAGING_BUFFER_SIZE <= hw::sprite_tiles::tiles_count() * int(sizeof(tile)));
+    static_assert(BN_CFG_SPRITE_TILES_STAGING_BUFFER_SIZE % int(sizeof(tile)) == 0);
+    static_assert(BN_CFG_SPRITE_TILES_STAGING_MAX_CYCLES > 0);
 
 
     #if BN_CFG_LOG_ENABLED
@@ -44,6 +53,7 @@ namespace
 
     constexpr int max_items = BN_CFG_SPRITE_TILES_MAX_ITEMS;
     constexpr int max_list_items = max_items + 2;
+    constexpr int staging_tiles_count = BN_CFG_SPRITE_TILES_STAGING_BUFFER_SIZE / int(sizeof(tile));
 
 
     enum class status_type
@@ -72,6 +82,11 @@ namespace
         unsigned start_tile: 12 = 0;
         unsigned tiles_count: 12 = 0;
 
+        #if BN_CFG_SPRITE_TILES_STAGING_BUFFER_SIZE
+            const tile* staged_data = nullptr;
+            uint16_t staging_tile = 0;
+        #endif
+
     private:
         uint8_t _status: 2 = uint8_t(status_type::FREE);
         uint8_t _compression: 2 = uint8_t(compression_type::NONE);
@@ -252,6 +267,17 @@ namespace
     };
 
 
+    class streamed_item_type
+    {
+
+    public:
+        const tile* data;
+        uint16_t id;
+        uint16_t start_tile;
+        uint16_t tiles_count;
+    };
+
+
     class static_data
     {
 
@@ -262,6 +288,14 @@ namespace
         vector<uint16_t, max_items> to_remove_items;
         vector<uint16_t, max_items> to_commit_uncompressed_items;
         vector<uint16_t, max_items> to_commit_compressed_items;
+        vector<streamed_item_type, max_items> to_commit_streamed_items;
+
+        #if BN_CFG_SPRITE_TILES_STAGING_BUFFER_SIZE
+            tile staging_tiles[staging_tiles_count];
+            vector<uint16_t, max_items> staged_items;
+            int staging_used_tiles_count = 0;
+        #endif
+
         uint16_t free_tiles_count = 0;
         uint16_t to_remove_tiles_count = 0;
         bool delay_commit = false;
@@ -481,6 +515,19 @@ namespace
         }
     }
 
+    void _erase_to_commit_streamed_items(int id)
+    {
+        vector<streamed_item_type, max_items>& to_commit_items = data.to_commit_streamed_items;
+
+        if(! to_commit_items.empty())
+        {
+            erase_if(to_commit_items, [id](const streamed_item_type& streamed_item)
+            {
+                return streamed_item.id == id;
+            });
+        }
+    }
+
     void _erase_to_commit_item(int id, item_type& item)
     {
         if(item.commit)
@@ -590,6 +637,70 @@ namespace
         }
     }
 
+    #if BN_CFG_SPRITE_TILES_STAGING_BUFFER_SIZE
+        [[nodiscard]] bool _staged(const item_type& item)
+        {
+            return item.staged_data == item.data;
+        }
+
+        void _stage_compressed_items()
+        {
+            constexpr int max_ticks = BN_CFG_SPRITE_TILES_STAGING_MAX_CYCLES / hw::timers::divisor();
+
+            timer staging_timer;
+            bool staged_items = false;
+
+            for(int item_index : data.to_commit_compressed_items)
+            {
+                item_type& item = data.items.item(item_index);
+                int tiles_count = int(item.tiles_count);
+
+                if(_staged(item) || tiles_count > staging_tiles_count)
+                {
+                    continue;
+                }
+
+                if(data.staging_used_tiles_count + tiles_count > staging_tiles_count)
+                {
+                    break;
+                }
+
+                if(staged_items && staging_timer.elapsed_ticks() >= max_ticks)
+                {
+                    break;
+                }
+
+                tile* staging_tiles_ptr = data.staging_tiles + data.staging_used_tiles_count;
+
+                switch(item.compression())
+                {
+
+                case compression_type::LZ77:
+                    hw::decompress::lz77(item.data, staging_tiles_ptr);
+                    break;
+
+                case compression_type::RUN_LENGTH:
+                    hw::decompress::rl_wram(item.data, staging_tiles_ptr);
+                    break;
+
+                case compression_type::HUFFMAN:
+                    hw::decompress::huff(item.data, staging_tiles_ptr);
+                    break;
+
+                default:
+                    BN_ERROR("Invalid compression type: ", int(item.compression()));
+                    break;
+                }
+
+                item.staged_data = item.data;
+                item.staging_tile = uint16_t(data.staging_used_tiles_count);
+                data.staging_used_tiles_count += tiles_count;
+                data.staged_items.push_back(uint16_t(item_index));
+                staged_items = true;
+            }
+        }
+    #endif
+
     [[nodiscard]] int _create_item(
             int id, const tile* tiles_data, compression_type compression, int tiles_count, bool delay_commit)
     {
@@ -977,6 +1088,7 @@ void decrease_usages(int id)
         item.set_status(status_type::TO_REMOVE);
         item.commit_if_recovered = item.commit;
         _erase_to_commit_item(id, item);
+        _erase_to_commit_streamed_items(id);
         _insert_to_remove_item(id);
         data.to_remove_tiles_count += item.tiles_count;
     }
@@ -1077,6 +1189,33 @@ void reload_tiles_ref(int id)
     BN_SPRITE_TILES_LOG_STATUS();
 }
 
+bool ready([[maybe_unused]] int id)
+{
+    #if BN_CFG_SPRITE_TILES_STAGING_BUFFER_SIZE
+        const item_type& item = data.items.item(id);
+
+        if(item.commit && item.compression() != compression_type::NONE)
+        {
+            return _staged(item) || int(item.tiles_count) > staging_tiles_count;
+        }
+    #endif
+
+    return true;
+}
+
+void stream_tiles(int id, const tile* tiles_data)
+{
+    const item_type& item = data.items.item(id);
+
+    BN_SPRITE_TILES_LOG("sprite_tiles_manager - STREAM_TILES: ", item.start_tile, " - ", tiles_data);
+
+    BN_BASIC_ASSERT(! item.data, "Item has data");
+    BN_BASIC_ASSERT(! data.to_commit_streamed_items.full(), "Too many streamed tiles");
+
+    data.to_commit_streamed_items.push_back(
+                streamed_item_type{ tiles_data, uint16_t(id), uint16_t(item.start_tile), uint16_t(item.tiles_count) });
+}
+
 optional<span<tile>> vram(int id)
 {
     const item_type& item = data.items.item(id);
@@ -1157,6 +1296,13 @@ void update()
     }
 
     data.delay_commit = false;
+
+    #if BN_CFG_SPRITE_TILES_STAGING_BUFFER_SIZE
+        if(! data.to_commit_compressed_items.empty())
+        {
+            _stage_compressed_items();
+        }
+    #endif
 }
 
 void commit_uncompressed(bool use_dma)
@@ -1188,25 +1334,99 @@ void commit_uncompressed(bool use_dma)
 
         BN_SPRITE_TILES_LOG_STATUS();
     }
+
+    if(! data.to_commit_streamed_items.empty())
+    {
+        if(use_dma)
+        {
+            for(const streamed_item_type& streamed_item : data.to_commit_streamed_items)
+            {
+                hw::sprite_tiles::commit_with_dma(streamed_item.data, int(streamed_item.start_tile),
+                                                  int(streamed_item.tiles_count));
+            }
+        }
+        else
+        {
+            for(const streamed_item_type& streamed_item : data.to_commit_streamed_items)
+            {
+                hw::sprite_tiles::commit_with_cpu(streamed_item.data, int(streamed_item.start_tile),
+                                                  int(streamed_item.tiles_count));
+            }
+        }
+
+        data.to_commit_streamed_items.clear();
+    }
 }
 
-void commit_compressed()
+void commit_compressed([[maybe_unused]] bool use_dma)
 {
     if(! data.to_commit_compressed_items.empty())
     {
         BN_SPRITE_TILES_LOG("sprite_tiles_manager - COMMIT COMPRESSED");
 
-        for(int item_index : data.to_commit_compressed_items)
-        {
-            item_type& item = data.items.item(item_index);
-            _hw_commit(item.data, item.compression(), int(item.start_tile), int(item.tiles_count));
-            item.commit = false;
-        }
+        #if BN_CFG_SPRITE_TILES_STAGING_BUFFER_SIZE
+            vector<uint16_t, max_items>& to_commit_items = data.to_commit_compressed_items;
+            int pending_items_count = 0;
 
-        data.to_commit_compressed_items.clear();
+            for(int item_index : to_commit_items)
+            {
+                item_type& item = data.items.item(item_index);
+                int tiles_count = int(item.tiles_count);
+
+                if(_staged(item))
+                {
+                    const tile* staged_tiles_ptr = data.staging_tiles + item.staging_tile;
+
+                    if(use_dma)
+                    {
+                        hw::sprite_tiles::commit_with_dma(staged_tiles_ptr, int(item.start_tile), tiles_count);
+                    }
+                    else
+                    {
+                        hw::sprite_tiles::commit_with_cpu(staged_tiles_ptr, int(item.start_tile), tiles_count);
+                    }
+
+                    item.commit = false;
+                }
+                else if(tiles_count > staging_tiles_count)
+                {
+                    _hw_commit(item.data, item.compression(), int(item.start_tile), tiles_count);
+                    item.commit = false;
+                }
+                else
+                {
+                    to_commit_items[pending_items_count] = uint16_t(item_index);
+                    ++pending_items_count;
+                }
+            }
+
+            to_commit_items.shrink(pending_items_count);
+        #else
+            for(int item_index : data.to_commit_compressed_items)
+            {
+                item_type& item = data.items.item(item_index);
+                _hw_commit(item.data, item.compression(), int(item.start_tile), int(item.tiles_count));
+                item.commit = false;
+            }
+
+            data.to_commit_compressed_items.clear();
+        #endif
 
         BN_SPRITE_TILES_LOG_STATUS();
     }
+
+    #if BN_CFG_SPRITE_TILES_STAGING_BUFFER_SIZE
+        if(! data.staged_items.empty())
+        {
+            for(int item_index : data.staged_items)
+            {
+                data.items.item(item_index).staged_data = nullptr;
+            }
+
+            data.staged_items.clear();
+            data.staging_used_tiles_count = 0;
+        }
+    #endif
 }
 
 }
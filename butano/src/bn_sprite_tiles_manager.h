@@ -59,13 +59,17 @@ namespace bn::sprite_tiles_manager
 
     void reload_tiles_ref(int id);
 
+    [[nodiscard]] bool ready(int id);
+
+    void stream_tiles(int id, const tile* tiles_data);
+
     [[nodiscard]] optional<span<tile>> vram(int id);
 
     void update();
 
     void commit_uncompressed(bool use_dma);
 
-    void commit_compressed();
+    void commit_compressed(bool use_dma);
 }
 
 #endif
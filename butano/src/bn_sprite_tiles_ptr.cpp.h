@@ -163,6 +163,11 @@ void sprite_tiles_ptr::reload_tiles_ref()
     sprite_tiles_manager::reload_tiles_ref(_handle);
 }
 
+bool sprite_tiles_ptr::ready() const
+{
+    return sprite_tiles_manager::ready(_handle);
+}
+
 optional<span<tile>> sprite_tiles_ptr::vram()
 {
     return sprite_tiles_manager::vram(_handle);
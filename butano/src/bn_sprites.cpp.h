@@ -41,6 +41,31 @@ void set_blending_bottom_enabled(bool blending_bottom_enabled)
     display_manager::set_blending_bottom_sprites_enabled(blending_bottom_enabled);
 }
 
+int overflow_items_count()
+{
+    return sprites_manager::overflow_items_count();
+}
+
+int scanline_overflow_items_count(int scanline)
+{
+    return sprites_manager::scanline_overflow_items_count(scanline);
+}
+
+int multiplexed_items_count()
+{
+    return sprites_manager::multiplexed_items_count();
+}
+
+int last_commit_bytes()
+{
+    return sprites_manager::last_commit_bytes();
+}
+
+int last_commit_runs()
+{
+    return sprites_manager::last_commit_runs();
+}
+
 int reserved_handles_count()
 {
     return sprites_manager::reserved_handles_count();
@@ -58,7 +58,8 @@ void _check_items_on_screen(intrusive_list<sorted_sprites::layer>& layers)
     }
 }
 
-int _rebuild_handles_impl(int reserved_handles_count, void* hw_handles, intrusive_list<sorted_sprites::layer>& layers)
+int _rebuild_handles_impl(int reserved_handles_count, void* hw_handles, sprites_manager_item** handle_items,
+                          unsigned* dirty_handles, intrusive_list<sorted_sprites::layer>& layers)
 {
     auto handles = reinterpret_cast<hw::sprites::handle_type*>(hw_handles);
     int visible_items_count = reserved_handles_count;
@@ -76,7 +77,12 @@ int _rebuild_handles_impl(int reserved_handles_count, void* hw_handles, intrusiv
                     }
                 #endif
 
-                hw::sprites::copy_handle(item.handle, handles[visible_items_count]);
+                if(hw::sprites::copy_handle_if_changed(item.handle, handles[visible_items_count]))
+                {
+                    _set_dirty_handle(visible_items_count, dirty_handles);
+                }
+
+                handle_items[visible_items_count] = &item;
                 item.handles_index = int8_t(visible_items_count);
                 ++visible_items_count;
             }
@@ -90,24 +96,69 @@ int _rebuild_handles_impl(int reserved_handles_count, void* hw_handles, intrusiv
     return visible_items_count;
 }
 
-bool _update_cameras_impl(intrusive_list<sorted_sprites::layer>& layers)
+int _update_batch_impl(const batch_commit_data& batch_data, int handles_index, void* hw_handles,
+                       unsigned* dirty_handles)
 {
-    bool check_items_on_screen = false;
-
-    for(sorted_sprites::layer& layer : layers)
+    auto handles = reinterpret_cast<hw::sprites::handle_type*>(hw_handles);
+    const int16_t* xs = batch_data.xs;
+    const int16_t* ys = batch_data.ys;
+    const uint8_t* tiles_indexes = batch_data.tiles_indexes;
+    const uint8_t* flags = batch_data.flags;
+    const uint16_t* third_attributes = batch_data.third_attributes;
+    int count = batch_data.count;
+    int first_attributes = batch_data.first_attributes;
+    int second_attributes = batch_data.second_attributes;
+    int x_offset = batch_data.x_offset;
+    int y_offset = batch_data.y_offset;
+    int width = batch_data.width;
+    int height = batch_data.height;
+
+    for(int index = 0; index < count; ++index)
     {
-        for(sprites_manager_item& item : layer.items())
+        int x = xs[index] + x_offset;
+        int y = ys[index] + y_offset;
+
+        if(x < display::width() && x + width > 0 && y < display::height() && y + height > 0)
         {
-            if(item.camera)
+            // Sprites which don't fit in OAM are not shown:
+            if(handles_index == hw::sprites::count()) [[unlikely]]
             {
-                item.update_hw_position();
+                break;
+            }
 
-                if(item.visible)
-                {
-                    item.check_on_screen = true;
-                    check_items_on_screen = true;
-                }
+            hw::sprites::handle_type& handle = handles[handles_index];
+            auto attr0 = uint16_t(first_attributes | (y & 255));
+            auto attr1 = uint16_t(second_attributes | (x & 511) | (flags[index] << 12));
+            uint16_t attr2 = third_attributes[tiles_indexes[index]];
+
+            if(handle.attr0 != attr0 || handle.attr1 != attr1 || handle.attr2 != attr2)
+            {
+                handle.attr0 = attr0;
+                handle.attr1 = attr1;
+                handle.attr2 = attr2;
+                _set_dirty_handle(handles_index, dirty_handles);
             }
+
+            ++handles_index;
+        }
+    }
+
+    return handles_index;
+}
+
+bool _update_camera_impl(intrusive_list<intrusive_list_node_type>& camera_nodes)
+{
+    bool check_items_on_screen = false;
+
+    for(sprite_camera_attach_node_type& camera_node : camera_nodes)
+    {
+        sprites_manager_item& item = sprites_manager_item::camera_attach_node_item(camera_node);
+        item.update_hw_position();
+
+        if(item.visible)
+        {
+            item.check_on_screen = true;
+            check_items_on_screen = true;
         }
     }
 
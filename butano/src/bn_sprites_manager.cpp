@@ -6,14 +6,22 @@
 #include "bn_sprites_manager.h"
 
 #include "bn_vector.h"
+#include "bn_memory.h"
+#include "bn_sprite_batch.h"
+#include "bn_config_cameras.h"
 #include "bn_sprite_first_attributes.h"
 #include "bn_sprite_regular_second_attributes.h"
 #include "bn_sorted_sprites.h"
 #include "../hw/include/bn_hw_sprite_affine_mats_constants.h"
 
+#if BN_CFG_SPRITES_MULTIPLEXING_ENABLED
+    #include "../hw/include/bn_hw_sprites_multiplexer.h"
+#endif
+
 #include "bn_sprites.cpp.h"
 #include "bn_sprite_ptr.cpp.h"
 #include "bn_sprite_item.cpp.h"
+#include "bn_sprite_batch.cpp.h"
 #include "bn_sprite_builder.cpp.h"
 #include "bn_sprite_third_attributes.cpp.h"
 #include "bn_sprite_affine_second_attributes.cpp.h"
@@ -24,6 +32,9 @@ namespace bn::sprites_manager
 namespace
 {
     static_assert(BN_CFG_SPRITES_MAX_ITEMS > 0);
+    static_assert(BN_CFG_SPRITES_MAX_BATCHES >= 0);
+    static_assert(! BN_CFG_SPRITES_MULTIPLEXING_ENABLED || ! BN_CFG_SPRITES_MAX_BATCHES,
+                  "Sprite batches are not supported when sprites multiplexing is enabled");
 
     using item_type = sprites_manager_item;
     using sorted_items_type = vector<item_type*, BN_CFG_SPRITES_MAX_ITEMS>;
@@ -34,35 +45,584 @@ namespace
     public:
         pool<item_type, BN_CFG_SPRITES_MAX_ITEMS> items_pool;
         hw::sprites::handle_type handles[hw::sprites::count()];
+        item_type* handle_items[hw::sprites::count()];
         sorted_sprites::sorter sorter;
+        intrusive_list<sprite_camera_attach_node_type> camera_nodes[BN_CFG_CAMERA_MAX_ITEMS];
+        unsigned dirty_handles[hw::sprites::count() / 32];
         int reserved_handles_count = 0;
-        int first_index_to_commit = 0;
-        int last_index_to_commit = hw::sprites::count() - 1;
         int last_visible_items_count = 0;
+        int last_commit_bytes = 0;
+        int last_commit_runs = 0;
         bool check_items_on_screen = false;
         bool rebuild_handles = false;
         bool reload_all_handles = false;
+
+        #if BN_CFG_SPRITES_MAX_BATCHES
+            vector<isprite_batch*, BN_CFG_SPRITES_MAX_BATCHES> batches;
+            uint16_t batch_third_attributes[256];
+            int last_batches_handles_index = 0;
+        #endif
+
+        #if BN_CFG_SPRITES_MULTIPLEXING_ENABLED
+            item_type* multiplexed_items[BN_CFG_SPRITES_MAX_ITEMS];
+            uint16_t scanline_overflow_items_counts[display::height()];
+            uint16_t multiplexing_band_items_ends[hw::sprites_multiplexer::max_bands()];
+            int8_t multiplexing_table_bands[hw::sprites_multiplexer::max_bands()];
+            bool multiplexing_dirty_bands[hw::sprites_multiplexer::max_bands()];
+            int multiplexing_band_items_counts[hw::sprites_multiplexer::max_bands() + 1];
+            hw::sprites_multiplexer::rewrite multiplexing_restore_rewrites[hw::sprites::count()];
+            uint32_t multiplexing_restored_handles[hw::sprites::count() / 32];
+            int8_t multiplexing_free_handles[hw::sprites::count()];
+            int8_t multiplexing_released_handles_heads[hw::sprites_multiplexer::max_bands()];
+            int8_t multiplexing_released_handles_next[hw::sprites::count()];
+            int overflow_items_count = 0;
+            int multiplexed_items_count = 0;
+            bool multiplexing_table_a_active = false;
+            bool commit_multiplexing_table = false;
+            bool update_multiplexing_bands = false;
+        #endif
     };
 
     BN_DATA_EWRAM_BSS static_data data;
 
-    void _always_update_indexes_to_commit(const item_type& item)
+    constexpr bool incremental_sort = BN_CFG_SPRITES_INCREMENTAL_SORT_ENABLED &&
+            ! BN_CFG_SPRITES_MULTIPLEXING_ENABLED;
+
+    void _attach_camera(item_type& item)
     {
-        int handles_index = item.handles_index;
+        if(const camera_ptr* camera = item.camera.get())
+        {
+            data.camera_nodes[camera->id()].push_back(item.camera_attach_node);
+        }
+    }
 
-        if(handles_index >= 0)
+    void _detach_camera(item_type& item)
+    {
+        if(const camera_ptr* camera = item.camera.get())
+        {
+            data.camera_nodes[camera->id()].erase(item.camera_attach_node);
+        }
+    }
+
+    void _set_all_dirty_handles()
+    {
+        for(unsigned& dirty_handles : data.dirty_handles)
+        {
+            dirty_handles = ~0U;
+        }
+    }
+
+    void _hide_handle(int handle_index)
+    {
+        hw::sprites::handle_type& handle = data.handles[handle_index];
+        uint16_t old_attr0 = handle.attr0;
+        hw::sprites::hide_and_destroy(handle);
+
+        if(handle.attr0 != old_attr0)
+        {
+            _set_dirty_handle(handle_index, data.dirty_handles);
+        }
+    }
+
+    [[nodiscard]] int _find_handle_index(int handle_index, bool dirty)
+    {
+        constexpr int words_count = hw::sprites::count() / 32;
+
+        int word_index = handle_index / 32;
+        unsigned word = data.dirty_handles[word_index];
+
+        if(! dirty)
+        {
+            word = ~word;
+        }
+
+        word &= ~0U << (handle_index % 32);
+
+        while(! word)
+        {
+            ++word_index;
+
+            if(word_index == words_count)
+            {
+                return hw::sprites::count();
+            }
+
+            word = data.dirty_handles[word_index];
+
+            if(! dirty)
+            {
+                word = ~word;
+            }
+        }
+
+        return (word_index * 32) + __builtin_ctz(word);
+    }
+
+    [[nodiscard]] bool _incremental_sort(const item_type& item)
+    {
+        return incremental_sort && ! data.rebuild_handles && item.handles_index >= 0;
+    }
+
+    void _set_handle_item(item_type& item, int handle_index)
+    {
+        data.handle_items[handle_index] = &item;
+        item.handles_index = int8_t(handle_index);
+
+        if(hw::sprites::copy_handle_if_changed(item.handle, data.handles[handle_index]))
+        {
+            _set_dirty_handle(handle_index, data.dirty_handles);
+        }
+    }
+
+    void _sort_handle(item_type& item)
+    {
+        item_type** handle_items = data.handle_items;
+        int old_index = item.handles_index;
+        int new_index;
+
+        if(const item_type* next_item = data.sorter.next_item_with_handle(item))
+        {
+            int next_index = next_item->handles_index;
+            new_index = next_index > old_index ? next_index - 1 : next_index;
+        }
+        else
+        {
+            new_index = data.last_visible_items_count - 1;
+        }
+
+        for(int index = old_index; index < new_index; ++index)
+        {
+            _set_handle_item(*handle_items[index + 1], index);
+        }
+
+        for(int index = old_index; index > new_index; --index)
+        {
+            _set_handle_item(*handle_items[index - 1], index);
+        }
+
+        _set_handle_item(item, new_index);
+    }
+
+    void _remove_handle(item_type& item)
+    {
+        item_type** handle_items = data.handle_items;
+        int last_index = data.last_visible_items_count - 1;
+
+        for(int index = item.handles_index; index < last_index; ++index)
+        {
+            _set_handle_item(*handle_items[index + 1], index);
+        }
+
+        _hide_handle(last_index);
+        item.handles_index = -1;
+        data.last_visible_items_count = last_index;
+    }
+
+    void _update_sort(item_type& item)
+    {
+        if(_incremental_sort(item))
+        {
+            _sort_handle(item);
+        }
+        else
+        {
+            data.rebuild_handles = true;
+        }
+    }
+
+    #if BN_CFG_SPRITES_MULTIPLEXING_ENABLED
+        constexpr int multiplexing_bands = hw::sprites_multiplexer::max_bands();
+
+        static_assert(multiplexing_bands > 1 && multiplexing_bands <= display::height() / 4);
+        static_assert(hw::sprites_multiplexer::max_band_rewrites() > 0);
+        static_assert(hw::sprites_multiplexer::max_band_rewrites() <= hw::sprites_multiplexer::max_irq_rewrites(),
+                      "Too many sprite handles rewrites per band");
+
+        class static_multiplexing_data
+        {
+
+        public:
+            hw::sprites_multiplexer::table table_a;
+            hw::sprites_multiplexer::table table_b;
+        };
+
+        BN_DATA_EWRAM_BSS static_multiplexing_data multiplexing_data;
+
+        [[nodiscard]] constexpr int _multiplexing_band(int scanline)
+        {
+            return scanline * multiplexing_bands / display::height();
+        }
+
+        [[nodiscard]] constexpr int _multiplexing_band_first_scanline(int band)
+        {
+            return ((band * display::height()) + multiplexing_bands - 1) / multiplexing_bands;
+        }
+
+        [[nodiscard]] inline int _multiplexing_first_scanline(const item_type& item)
+        {
+            return max(item.hw_position.y(), 0);
+        }
+
+        [[nodiscard]] inline int _multiplexing_last_scanline(const item_type& item)
+        {
+            return min(item.hw_position.y() + (item.half_height * 2), display::height()) - 1;
+        }
+
+        [[nodiscard]] inline int _multiplexing_release_band(const item_type& item)
+        {
+            // Handles can be reused by the band which V-Count interrupt is triggered after their last scanline:
+            int last_scanline = _multiplexing_last_scanline(item) + hw::sprites_multiplexer::rewrite_scanlines() - 1;
+            return _multiplexing_band(last_scanline) + 1;
+        }
+
+        inline void _set_multiplexing_dirty_band(const item_type& item)
+        {
+            data.multiplexing_dirty_bands[item.multiplexing_first_band] = true;
+            data.update_multiplexing_bands = true;
+        }
+
+        int _rebuild_multiplexed_handles_impl(int reserved_handles_count, hw::sprites::handle_type* handles)
+        {
+            using hw_rewrite = hw::sprites_multiplexer::rewrite;
+
+            // Sort on screen items by their first band, keeping their sort order:
+            int* band_items_counts = data.multiplexing_band_items_counts;
+            memory::clear(multiplexing_bands + 1, band_items_counts[0]);
+            int multiplexed_items_count = 0;
+
+            for(sorted_sprites::layer& layer : data.sorter.layers())
+            {
+                for(item_type& item : layer.items())
+                {
+                    if(item.on_screen)
+                    {
+                        ++band_items_counts[_multiplexing_band(_multiplexing_first_scanline(item)) + 1];
+                        ++multiplexed_items_count;
+                    }
+                    else
+                    {
+                        item.handles_index = -1;
+                    }
+                }
+            }
+
+            for(int band = 1; band < multiplexing_bands; ++band)
+            {
+                band_items_counts[band] += band_items_counts[band - 1];
+            }
+
+            item_type** multiplexed_items = data.multiplexed_items;
+
+            for(sorted_sprites::layer& layer : data.sorter.layers())
+            {
+                for(item_type& item : layer.items())
+                {
+                    if(item.on_screen)
+                    {
+                        int band = _multiplexing_band(_multiplexing_first_scanline(item));
+                        multiplexed_items[band_items_counts[band]] = &item;
+                        ++band_items_counts[band];
+                    }
+                }
+            }
+
+            // Assign hardware handles to items band by band. Unused handles are written directly,
+            // and when there's none left, the ones released by items of upper bands are rewritten:
+            int8_t* free_handles = data.multiplexing_free_handles;
+            int free_handles_count = 0;
+
+            int8_t* released_handles_heads = data.multiplexing_released_handles_heads;
+            int8_t* released_handles_next = data.multiplexing_released_handles_next;
+            uint32_t* restored_handles = data.multiplexing_restored_handles;
+            memory::clear(hw::sprites::count() / 32, restored_handles[0]);
+
+            for(int band = 0; band < multiplexing_bands; ++band)
+            {
+                released_handles_heads[band] = -1;
+            }
+
+            hw::sprites_multiplexer::table& table = data.multiplexing_table_a_active ?
+                        multiplexing_data.table_b : multiplexing_data.table_a;
+            hw_rewrite* restore_rewrites = data.multiplexing_restore_rewrites;
+            int restore_rewrites_count = 0;
+            int rewrites_count = 0;
+            int bands_count = 0;
+            int visible_items_count = reserved_handles_count;
+            int overflow_items_count = 0;
+            int item_index = 0;
+
+            if(data.overflow_items_count)
+            {
+                memory::clear(display::height(), data.scanline_overflow_items_counts[0]);
+            }
+
+            for(int band = 0; band < multiplexing_bands; ++band)
+            {
+                for(int handle_index = released_handles_heads[band]; handle_index >= 0;
+                    handle_index = released_handles_next[handle_index])
+                {
+                    free_handles[free_handles_count] = int8_t(handle_index);
+                    ++free_handles_count;
+                }
+
+                int band_first_rewrite = rewrites_count;
+                int band_last_item_index = band_items_counts[band];
+                data.multiplexing_band_items_ends[band] = uint16_t(band_last_item_index);
+                data.multiplexing_table_bands[band] = -1;
+                data.multiplexing_dirty_bands[band] = false;
+
+                for(; item_index < band_last_item_index; ++item_index)
+                {
+                    item_type& item = *multiplexed_items[item_index];
+                    int release_band = _multiplexing_release_band(item);
+                    int handle_index;
+
+                    if(visible_items_count < hw::sprites::count())
+                    {
+                        handle_index = visible_items_count;
+                        item.multiplexing_rewrite = false;
+                        ++visible_items_count;
+
+                        if(hw::sprites::copy_handle_if_changed(item.handle, handles[handle_index]))
+                        {
+                            _set_dirty_handle(handle_index, data.dirty_handles);
+                        }
+                    }
+                    else if(free_handles_count && rewrites_count - band_first_rewrite <
+                            hw::sprites_multiplexer::max_band_rewrites())
+                    {
+                        --free_handles_count;
+                        handle_index = free_handles[free_handles_count];
+                        item.multiplexing_rewrite = true;
+
+                        unsigned restored_mask = 1U << (handle_index % 32);
+                        uint32_t& restored = restored_handles[handle_index / 32];
+
+                        if(! (restored & restored_mask))
+                        {
+                            const hw::sprites::handle_type& handle = handles[handle_index];
+                            restored |= restored_mask;
+                            restore_rewrites[restore_rewrites_count] = {
+                                handle.attr0, handle.attr1, handle.attr2, uint16_t(handle_index) };
+                            ++restore_rewrites_count;
+                        }
+
+                        const hw::sprites::handle_type& item_handle = item.handle;
+                        table.rewrites[rewrites_count] = {
+                            item_handle.attr0, item_handle.attr1, item_handle.attr2, uint16_t(handle_index) };
+                        ++rewrites_count;
+                    }
+                    else
+                    {
+                        item.handles_index = -1;
+                        ++overflow_items_count;
+
+                        uint16_t* scanline_counts = data.scanline_overflow_items_counts;
+
+                        for(int scanline = _multiplexing_first_scanline(item),
+                            last_scanline = _multiplexing_last_scanline(item); scanline <= last_scanline; ++scanline)
+                        {
+                            ++scanline_counts[scanline];
+                        }
+
+                        continue;
+                    }
+
+                    item.handles_index = int8_t(handle_index);
+                    item.multiplexing_first_band = int8_t(band);
+                    item.multiplexing_release_band = int8_t(release_band);
+
+                    if(release_band < multiplexing_bands)
+                    {
+                        released_handles_next[handle_index] = released_handles_heads[release_band];
+                        released_handles_heads[release_band] = int8_t(handle_index);
+                    }
+                }
+
+                if(int band_rewrites_count = rewrites_count - band_first_rewrite)
+                {
+                    hw::sprites_multiplexer::band& hw_band = table.bands[bands_count];
+                    hw_band.rewrites = table.rewrites + band_first_rewrite;
+                    hw_band.rewrites_count = band_rewrites_count;
+                    hw_band.vcount = hw::sprites_multiplexer::band_vcount(_multiplexing_band_first_scanline(band));
+                    data.multiplexing_table_bands[band] = int8_t(bands_count);
+                    ++bands_count;
+                }
+            }
+
+            if(bands_count)
+            {
+                hw_rewrite* table_restore_rewrites = table.rewrites + rewrites_count;
+                hw::sprites_multiplexer::band& hw_band = table.bands[bands_count];
+                hw_band.rewrites = table_restore_rewrites;
+                hw_band.rewrites_count = restore_rewrites_count;
+                hw_band.vcount = hw::sprites_multiplexer::restore_vcount();
+                ++bands_count;
+
+                for(int index = 0; index < restore_rewrites_count; ++index)
+                {
+                    table_restore_rewrites[index] = restore_rewrites[index];
+                }
+            }
+
+            table.bands_count = bands_count;
+            data.multiplexing_table_a_active = ! data.multiplexing_table_a_active;
+            data.commit_multiplexing_table = true;
+            data.update_multiplexing_bands = false;
+            data.overflow_items_count = overflow_items_count;
+            data.multiplexed_items_count = multiplexed_items_count - overflow_items_count -
+                    (visible_items_count - reserved_handles_count);
+            return visible_items_count;
+        }
+
+        [[nodiscard]] bool _update_multiplexed_item_position(const item_type& item)
+        {
+            // Items which stay on screen in the same bands only need to rewrite their first band:
+            if(data.rebuild_handles || item.handles_index < 0 || item.check_on_screen)
+            {
+                return false;
+            }
+
+            int x = item.hw_position.x();
+
+            if(x >= display::width() || x + (item.half_width * 2) <= 0)
+            {
+                return false;
+            }
+
+            int y = item.hw_position.y();
+
+            if(y >= display::height() || y + (item.half_height * 2) <= 0)
+            {
+                return false;
+            }
+
+            if(_multiplexing_band(_multiplexing_first_scanline(item)) != item.multiplexing_first_band ||
+                    _multiplexing_release_band(item) != item.multiplexing_release_band)
+            {
+                return false;
+            }
+
+            _set_multiplexing_dirty_band(item);
+            return true;
+        }
+
+        void _update_multiplexed_bands()
         {
-            hw::sprites::copy_handle(item.handle, data.handles[handles_index]);
+            if(! data.update_multiplexing_bands)
+            {
+                return;
+            }
+
+            using hw_rewrite = hw::sprites_multiplexer::rewrite;
 
-            if(handles_index < data.first_index_to_commit)
+            // Copy the active table to the inactive one, since only the dirty bands are rewritten:
+            const hw::sprites_multiplexer::table& active_table = data.multiplexing_table_a_active ?
+                        multiplexing_data.table_a : multiplexing_data.table_b;
+            hw::sprites_multiplexer::table& table = data.multiplexing_table_a_active ?
+                        multiplexing_data.table_b : multiplexing_data.table_a;
+            int bands_count = active_table.bands_count;
+
+            if(bands_count)
             {
-                data.first_index_to_commit = handles_index;
+                const hw::sprites_multiplexer::band& restore_band = active_table.bands[bands_count - 1];
+                int rewrites_count = int(restore_band.rewrites - active_table.rewrites) + restore_band.rewrites_count;
+                memory::copy(active_table.rewrites[0], rewrites_count, table.rewrites[0]);
+
+                for(int index = 0; index < bands_count; ++index)
+                {
+                    const hw::sprites_multiplexer::band& active_band = active_table.bands[index];
+                    hw::sprites_multiplexer::band& band = table.bands[index];
+                    band.rewrites = table.rewrites + (active_band.rewrites - active_table.rewrites);
+                    band.rewrites_count = active_band.rewrites_count;
+                    band.vcount = active_band.vcount;
+                }
             }
 
-            if(handles_index > data.last_index_to_commit)
+            table.bands_count = bands_count;
+
+            hw::sprites::handle_type* handles = data.handles;
+            item_type** multiplexed_items = data.multiplexed_items;
+            int item_index = 0;
+            bool restore = false;
+
+            for(int band = 0; band < multiplexing_bands; ++band)
             {
-                data.last_index_to_commit = handles_index;
+                int band_last_item_index = data.multiplexing_band_items_ends[band];
+
+                if(data.multiplexing_dirty_bands[band])
+                {
+                    data.multiplexing_dirty_bands[band] = false;
+
+                    hw_rewrite* rewrites = nullptr;
+
+                    if(int table_band = data.multiplexing_table_bands[band]; table_band >= 0)
+                    {
+                        const hw::sprites_multiplexer::band& hw_band = table.bands[table_band];
+                        rewrites = table.rewrites + (hw_band.rewrites - table.rewrites);
+                    }
+
+                    for(; item_index < band_last_item_index; ++item_index)
+                    {
+                        const item_type& item = *multiplexed_items[item_index];
+
+                        if(int handles_index = item.handles_index; handles_index >= 0)
+                        {
+                            if(item.multiplexing_rewrite)
+                            {
+                                const hw::sprites::handle_type& item_handle = item.handle;
+                                *rewrites = { item_handle.attr0, item_handle.attr1, item_handle.attr2,
+                                              uint16_t(handles_index) };
+                                ++rewrites;
+                            }
+                            else if(hw::sprites::copy_handle_if_changed(item.handle, handles[handles_index]))
+                            {
+                                _set_dirty_handle(handles_index, data.dirty_handles);
+                                restore = true;
+                            }
+                        }
+                    }
+                }
+
+                item_index = band_last_item_index;
+            }
+
+            // Reused handles must be restored with the new state of the items which were written directly:
+            if(restore && bands_count)
+            {
+                const hw::sprites_multiplexer::band& restore_band = table.bands[bands_count - 1];
+                hw_rewrite* restore_rewrites = table.rewrites + (restore_band.rewrites - table.rewrites);
+
+                for(int index = 0, limit = restore_band.rewrites_count; index < limit; ++index)
+                {
+                    hw_rewrite& restore_rewrite = restore_rewrites[index];
+                    const hw::sprites::handle_type& handle = handles[restore_rewrite.handle_index];
+                    restore_rewrite.attr0 = handle.attr0;
+                    restore_rewrite.attr1 = handle.attr1;
+                    restore_rewrite.attr2 = handle.attr2;
+                }
             }
+
+            data.multiplexing_table_a_active = ! data.multiplexing_table_a_active;
+            data.commit_multiplexing_table = true;
+            data.update_multiplexing_bands = false;
+        }
+    #endif
+
+    void _always_update_indexes_to_commit(const item_type& item)
+    {
+        int handles_index = item.handles_index;
+
+        if(handles_index >= 0)
+        {
+            #if BN_CFG_SPRITES_MULTIPLEXING_ENABLED
+                _set_multiplexing_dirty_band(item);
+            #else
+                if(hw::sprites::copy_handle_if_changed(item.handle, data.handles[handles_index]))
+                {
+                    _set_dirty_handle(handles_index, data.dirty_handles);
+                }
+            #endif
         }
     }
 
@@ -74,6 +634,43 @@ namespace
         }
     }
 
+    void _reload_indexes_to_commit(const item_type& item)
+    {
+        int handles_index = item.handles_index;
+
+        if(handles_index >= 0)
+        {
+            // OAM could have been written directly (by H-Blank effects for example),
+            // so handles are committed even if they have not changed:
+            #if BN_CFG_SPRITES_MULTIPLEXING_ENABLED
+                if(! item.multiplexing_rewrite)
+                {
+                    hw::sprites::handle_type& handle = data.handles[handles_index];
+                    handle.attr0 = uint16_t(~item.handle.attr0);
+                }
+
+                _set_multiplexing_dirty_band(item);
+            #else
+                hw::sprites::copy_handle(item.handle, data.handles[handles_index]);
+                _set_dirty_handle(handles_index, data.dirty_handles);
+            #endif
+        }
+    }
+
+    void _update_visible_item_position(item_type& item)
+    {
+        #if BN_CFG_SPRITES_MULTIPLEXING_ENABLED
+            if(_update_multiplexed_item_position(item))
+            {
+                return;
+            }
+        #endif
+
+        item.check_on_screen = true;
+        data.check_items_on_screen = true;
+        data.rebuild_handles = true;
+    }
+
     void _update_item_dimensions(item_type& item)
     {
         item.update_half_dimensions();
@@ -184,9 +781,17 @@ namespace
                 {
                     hw::sprites::hide_and_destroy(handles[index]);
                 }
+
+                _set_all_dirty_handles();
             }
 
-            int visible_items_count = _rebuild_handles_impl(reserved_count, handles, data.sorter.layers());
+            #if BN_CFG_SPRITES_MULTIPLEXING_ENABLED
+                int visible_items_count = _rebuild_multiplexed_handles_impl(reserved_count, handles);
+            #else
+                int visible_items_count = _rebuild_handles_impl(
+                            reserved_count, handles, data.handle_items, data.dirty_handles, data.sorter.layers());
+            #endif
+
             BN_BASIC_ASSERT(visible_items_count >= 0, "Too many on screen sprites");
 
             int last_visible_items_count = data.last_visible_items_count;
@@ -195,40 +800,85 @@ namespace
 
             for(int index = visible_items_count; index < last_visible_items_count; ++index)
             {
-                hw::sprites::hide_and_destroy(handles[index]);
+                _hide_handle(index);
+            }
+        }
+    }
+
+    #if BN_CFG_SPRITES_MAX_BATCHES
+        [[nodiscard]] int _update_batch(const isprite_batch& batch, int handles_index, bool fade_enabled)
+        {
+            const ivector<sprite_tiles_ptr>& tiles_list = batch.tiles_list();
+            const sprite_palette_ptr& palette = batch.palette();
+            const sprite_shape_size& shape_size = batch.shape_size();
+            int tiles_count = tiles_list.size();
+            int palette_id = palette.id();
+            int bg_priority = batch.bg_priority();
+            uint16_t* third_attributes = data.batch_third_attributes;
+
+            for(int index = 0; index < tiles_count; ++index)
+            {
+                int tiles_id = tiles_list[index].id();
+                third_attributes[index] = uint16_t(hw::sprites::third_attributes(tiles_id, palette_id, bg_priority));
             }
 
-            if(reload_all_handles) [[unlikely]]
+            int width = shape_size.width();
+            int height = shape_size.height();
+            int x_offset = (display::width() / 2) - (width / 2);
+            int y_offset = (display::height() / 2) - (height / 2);
+
+            if(const optional<camera_ptr>& camera = batch.camera())
             {
-                data.first_index_to_commit = 0;
-                data.last_index_to_commit = hw::sprites::count() - 1;
+                const fixed_point& camera_position = camera->position();
+                x_offset -= camera_position.x().right_shift_integer();
+                y_offset -= camera_position.y().right_shift_integer();
             }
-            else
+
+            batch_commit_data batch_data;
+            batch_data.xs = batch.xs().data();
+            batch_data.ys = batch.ys().data();
+            batch_data.tiles_indexes = batch.tiles_indexes().data();
+            batch_data.flags = batch.flags().data();
+            batch_data.third_attributes = third_attributes;
+            batch_data.count = batch.size();
+            batch_data.first_attributes = hw::sprites::first_attributes(
+                        0, shape_size.shape(), palette.bpp(), 0, false, batch.blending_enabled(), false,
+                        fade_enabled);
+            batch_data.second_attributes = hw::sprites::second_attributes(0, shape_size.size(), false, false);
+            batch_data.x_offset = x_offset;
+            batch_data.y_offset = y_offset;
+            batch_data.width = width;
+            batch_data.height = height;
+            return _update_batch_impl(batch_data, handles_index, data.handles, data.dirty_handles);
+        }
+
+        void _update_batches()
+        {
+            // Batches are placed after the sprite items handles, so they are drawn below them:
+            int handles_index = data.last_visible_items_count;
+            int last_handles_index = data.last_batches_handles_index;
+
+            if(! data.batches.empty())
             {
-                int to_commit_items_count;
+                bool fade_enabled = display_manager::blending_fade_enabled();
 
-                if(visible_items_count < last_visible_items_count)
+                for(const isprite_batch* batch : data.batches)
                 {
-                    to_commit_items_count = min(last_visible_items_count, hw::sprites::count() - reserved_count);
-                }
-                else
-                {
-                    to_commit_items_count = visible_items_count;
+                    if(batch->visible() && ! batch->empty())
+                    {
+                        handles_index = _update_batch(*batch, handles_index, fade_enabled);
+                    }
                 }
+            }
 
-                if(to_commit_items_count)
-                {
-                    data.first_index_to_commit = reserved_count;
-                    data.last_index_to_commit = reserved_count + to_commit_items_count - 1;
-                }
-                else
-                {
-                    data.first_index_to_commit = hw::sprites::count();
-                    data.last_index_to_commit = 0;
-                }
+            data.last_batches_handles_index = handles_index;
+
+            for(int index = handles_index; index < last_handles_index; ++index)
+            {
+                _hide_handle(index);
             }
         }
-    }
+    #endif
 }
 
 void init()
@@ -240,6 +890,8 @@ void init()
         hw::sprites::hide_and_destroy(handle);
     }
 
+    _set_all_dirty_handles();
+
     sprite_affine_mats_manager::init(data.handles);
 }
 
@@ -286,6 +938,7 @@ id_type create(sprite_builder&& builder)
 
     item_type& new_item = data.items_pool.create(move(builder));
     data.sorter.insert(new_item);
+    _attach_camera(new_item);
 
     if(new_item.visible)
     {
@@ -321,6 +974,7 @@ id_type create_optional(sprite_builder&& builder)
 
     item_type& new_item = data.items_pool.create(move(builder), move(*tiles_ptr), move(*palette_ptr));
     data.sorter.insert(new_item);
+    _attach_camera(new_item);
 
     if(new_item.visible)
     {
@@ -345,6 +999,7 @@ void decrease_usages(id_type id)
     if(! item->usages) [[likely]]
     {
         data.sorter.erase(*item);
+        _detach_camera(*item);
 
         if(const sprite_affine_mat_ptr* item_affine_mat = item->affine_mat.get())
         {
@@ -354,7 +1009,15 @@ void decrease_usages(id_type id)
         if(item->visible)
         {
             hw::sprites::hide_and_destroy(item->handle);
-            data.rebuild_handles = true;
+
+            if(_incremental_sort(*item))
+            {
+                _remove_handle(*item);
+            }
+            else
+            {
+                data.rebuild_handles = true;
+            }
         }
 
         data.items_pool.destroy(*item);
@@ -598,9 +1261,7 @@ void set_x(id_type id, fixed x)
 
         if(item->visible)
         {
-            item->check_on_screen = true;
-            data.check_items_on_screen = true;
-            data.rebuild_handles = true;
+            _update_visible_item_position(*item);
         }
     }
 }
@@ -623,9 +1284,7 @@ void set_y(id_type id, fixed y)
 
         if(item->visible)
         {
-            item->check_on_screen = true;
-            data.check_items_on_screen = true;
-            data.rebuild_handles = true;
+            _update_visible_item_position(*item);
         }
     }
 }
@@ -651,9 +1310,7 @@ void set_position(id_type id, const fixed_point& position)
 
         if(item->visible)
         {
-            item->check_on_screen = true;
-            data.check_items_on_screen = true;
-            data.rebuild_handles = true;
+            _update_visible_item_position(*item);
         }
     }
 }
@@ -677,7 +1334,7 @@ void set_bg_priority(id_type id, int bg_priority)
         data.sorter.erase(*item);
         item->set_bg_priority(bg_priority);
         data.sorter.insert(*item);
-        data.rebuild_handles = true;
+        _update_sort(*item);
     }
 }
 
@@ -699,7 +1356,7 @@ void set_z_order(id_type id, int z_order)
         data.sorter.erase(*item);
         item->set_z_order(z_order);
         data.sorter.insert(*item);
-        data.rebuild_handles = true;
+        _update_sort(*item);
     }
 }
 
@@ -709,7 +1366,7 @@ void put_above(id_type id)
 
     if(data.sorter.put_in_front_of_layer(*item))
     {
-        data.rebuild_handles = true;
+        _update_sort(*item);
     }
 }
 
@@ -719,7 +1376,7 @@ void put_below(id_type id)
 
     if(data.sorter.put_in_back_of_layer(*item))
     {
-        data.rebuild_handles = true;
+        _update_sort(*item);
     }
 }
 
@@ -906,18 +1563,27 @@ void set_visible(id_type id, bool visible)
     if(visible != item->visible)
     {
         item->visible = visible;
-        data.rebuild_handles = true;
 
         if(visible)
         {
             item->check_on_screen = true;
             data.check_items_on_screen = true;
+            data.rebuild_handles = true;
         }
         else
         {
             hw::sprites::hide(item->handle);
             item->on_screen = false;
             item->check_on_screen = false;
+
+            if(_incremental_sort(*item))
+            {
+                _remove_handle(*item);
+            }
+            else
+            {
+                data.rebuild_handles = true;
+            }
         }
     }
 }
@@ -934,7 +1600,9 @@ void set_camera(id_type id, camera_ptr&& camera)
 
     if(camera != item->camera)
     {
+        _detach_camera(*item);
         item->camera = move(camera);
+        _attach_camera(*item);
         item->update_hw_position();
 
         if(item->visible)
@@ -952,6 +1620,7 @@ void remove_camera(id_type id)
 
     if(item->camera)
     {
+        _detach_camera(*item);
         item->camera.reset();
         item->update_hw_position();
 
@@ -1088,6 +1757,45 @@ void set_third_attributes(id_type id, const sprite_third_attributes& third_attri
     set_bg_priority(id, third_attributes.bg_priority());
 }
 
+int overflow_items_count()
+{
+    #if BN_CFG_SPRITES_MULTIPLEXING_ENABLED
+        return data.overflow_items_count;
+    #else
+        return 0;
+    #endif
+}
+
+int scanline_overflow_items_count([[maybe_unused]] int scanline)
+{
+    BN_ASSERT(scanline >= 0 && scanline < display::height(), "Invalid scanline: ", scanline);
+
+    #if BN_CFG_SPRITES_MULTIPLEXING_ENABLED
+        return data.overflow_items_count ? data.scanline_overflow_items_counts[scanline] : 0;
+    #else
+        return 0;
+    #endif
+}
+
+int multiplexed_items_count()
+{
+    #if BN_CFG_SPRITES_MULTIPLEXING_ENABLED
+        return data.multiplexed_items_count;
+    #else
+        return 0;
+    #endif
+}
+
+int last_commit_bytes()
+{
+    return data.last_commit_bytes;
+}
+
+int last_commit_runs()
+{
+    return data.last_commit_runs;
+}
+
 int reserved_handles_count()
 {
     return data.reserved_handles_count;
@@ -1123,7 +1831,16 @@ void set_reserved_handles_count(int reserved_handles_count)
 void reload(id_type id)
 {
     auto item = static_cast<item_type*>(id);
-    _update_indexes_to_commit(*item);
+
+    if(data.rebuild_handles)
+    {
+        // Rebuilt handles are committed only if they have changed:
+        data.reload_all_handles = true;
+    }
+    else
+    {
+        _reload_indexes_to_commit(*item);
+    }
 }
 
 void reload_blending()
@@ -1147,7 +1864,7 @@ void reload_blending()
             for(item_type& item : layer.items())
             {
                 hw::sprites::set_blending_enabled(item.blending_enabled, fade_enabled, item.handle);
-                _always_update_indexes_to_commit(item);
+                _reload_indexes_to_commit(item);
             }
         }
     }
@@ -1322,9 +2039,27 @@ void fill_hblank_effect_third_attributes([[maybe_unused]] sprite_shape_size shap
     }
 }
 
-void update_cameras()
+void attach_batch([[maybe_unused]] isprite_batch& batch)
 {
-    if(_update_cameras_impl(data.sorter.layers()))
+    #if BN_CFG_SPRITES_MAX_BATCHES
+        BN_BASIC_ASSERT(! data.batches.full(), "No more sprite batches available");
+
+        data.batches.push_back(&batch);
+    #else
+        BN_ERROR("Sprite batches are disabled");
+    #endif
+}
+
+void detach_batch([[maybe_unused]] isprite_batch& batch)
+{
+    #if BN_CFG_SPRITES_MAX_BATCHES
+        erase(data.batches, &batch);
+    #endif
+}
+
+void update_camera(int camera_id)
+{
+    if(_update_camera_impl(data.camera_nodes[camera_id]))
     {
         data.check_items_on_screen = true;
         data.rebuild_handles = true;
@@ -1360,31 +2095,98 @@ void update()
     }
 
     _rebuild_handles();
+
+    #if BN_CFG_SPRITES_MULTIPLEXING_ENABLED
+        _update_multiplexed_bands();
+    #elif BN_CFG_SPRITES_MAX_BATCHES
+        _update_batches();
+    #endif
 }
 
 void commit(bool use_dma)
 {
     sprite_affine_mats_manager::commit_data affine_mats_commit_data =
             sprite_affine_mats_manager::retrieve_commit_data();
-    int first_index_to_commit = data.first_index_to_commit;
-    int last_index_to_commit = data.last_index_to_commit;
 
     if(int count = affine_mats_commit_data.count)
     {
         int multiplier = hw::sprites::count() / hw::sprite_affine_mats::count();
         int first_mat_index_to_commit = affine_mats_commit_data.offset * multiplier;
-        int last_mat_index_to_commit = first_mat_index_to_commit + (count * multiplier) - 1;
-        first_index_to_commit = min(first_index_to_commit, first_mat_index_to_commit);
-        last_index_to_commit = max(last_index_to_commit, last_mat_index_to_commit);
+        int last_mat_index_to_commit = first_mat_index_to_commit + (count * multiplier);
+
+        for(int index = first_mat_index_to_commit; index < last_mat_index_to_commit; ++index)
+        {
+            _set_dirty_handle(index, data.dirty_handles);
+        }
+    }
+
+    // Coalesce dirty handles separated by a few clean ones in the same burst,
+    // since copying them is cheaper than starting a new one:
+    constexpr int max_clean_handles_per_run = 4;
+
+    hw::sprites::handle_type& handles = data.handles[0];
+    int committed_handles_count = 0;
+    int runs_count = 0;
+    int first_index = _find_handle_index(0, true);
+
+    while(first_index < hw::sprites::count())
+    {
+        int last_index = _find_handle_index(first_index, false);
+
+        while(last_index < hw::sprites::count())
+        {
+            int next_first_index = _find_handle_index(last_index, true);
+
+            if(next_first_index == hw::sprites::count() ||
+                    next_first_index - last_index > max_clean_handles_per_run)
+            {
+                break;
+            }
+
+            last_index = _find_handle_index(next_first_index, false);
+        }
+
+        int run_handles_count = last_index - first_index;
+        hw::sprites::commit(handles, first_index, run_handles_count, use_dma);
+        committed_handles_count += run_handles_count;
+        ++runs_count;
+
+        if(last_index == hw::sprites::count())
+        {
+            break;
+        }
+
+        first_index = _find_handle_index(last_index, true);
     }
 
-    if(first_index_to_commit < hw::sprites::count())
+    if(runs_count)
     {
-        int commit_items_count = last_index_to_commit - first_index_to_commit + 1;
-        hw::sprites::commit(data.handles[0], first_index_to_commit, commit_items_count, use_dma);
-        data.first_index_to_commit = hw::sprites::count();
-        data.last_index_to_commit = 0;
+        for(unsigned& dirty_handles : data.dirty_handles)
+        {
+            dirty_handles = 0;
+        }
     }
+
+    data.last_commit_bytes = committed_handles_count * int(sizeof(hw::sprites::handle_type));
+    data.last_commit_runs = runs_count;
+
+    #if BN_CFG_SPRITES_MULTIPLEXING_ENABLED
+        if(data.commit_multiplexing_table)
+        {
+            const hw::sprites_multiplexer::table& table = data.multiplexing_table_a_active ?
+                        multiplexing_data.table_a : multiplexing_data.table_b;
+            data.commit_multiplexing_table = false;
+
+            if(table.bands_count)
+            {
+                hw::sprites_multiplexer::commit_table(table);
+            }
+            else
+            {
+                hw::sprites_multiplexer::disable();
+            }
+        }
+    #endif
 }
 
 }
@@ -17,10 +17,12 @@ namespace bn
 class size;
 class point;
 class camera_ptr;
+class isprite_batch;
 class sprite_builder;
 class sprite_tiles_ptr;
 class sprite_shape_size;
 class sprite_palette_ptr;
+class sprites_manager_item;
 class affine_mat_attributes;
 class sprite_affine_mat_ptr;
 class sprite_first_attributes;
@@ -184,6 +186,16 @@ namespace sprites_manager
 
     void set_third_attributes(id_type id, const sprite_third_attributes& third_attributes);
 
+    [[nodiscard]] int overflow_items_count();
+
+    [[nodiscard]] int scanline_overflow_items_count(int scanline);
+
+    [[nodiscard]] int multiplexed_items_count();
+
+    [[nodiscard]] int last_commit_bytes();
+
+    [[nodiscard]] int last_commit_runs();
+
     int reserved_handles_count();
 
     void set_reserved_handles_count(int reserved_handles_count);
@@ -212,7 +224,11 @@ namespace sprites_manager
     void fill_hblank_effect_third_attributes(
             sprite_shape_size shape_size, const sprite_third_attributes* third_attributes_ptr, uint16_t* dest_ptr);
 
-    void update_cameras();
+    void attach_batch(isprite_batch& batch);
+
+    void detach_batch(isprite_batch& batch);
+
+    void update_camera(int camera_id);
 
     void remove_identity_affine_mat_when_not_needed(id_type id);
 
@@ -222,12 +238,39 @@ namespace sprites_manager
 
     void commit(bool use_dma);
 
+    class batch_commit_data
+    {
+
+    public:
+        const int16_t* xs;
+        const int16_t* ys;
+        const uint8_t* tiles_indexes;
+        const uint8_t* flags;
+        const uint16_t* third_attributes;
+        int count;
+        int first_attributes;
+        int second_attributes;
+        int x_offset;
+        int y_offset;
+        int width;
+        int height;
+    };
+
+    inline void _set_dirty_handle(int handle_index, unsigned* dirty_handles)
+    {
+        dirty_handles[handle_index / 32] |= 1U << (handle_index % 32);
+    }
+
     BN_CODE_IWRAM void _check_items_on_screen(intrusive_list<sorted_sprites::layer>& layers);
 
     [[nodiscard]] BN_CODE_IWRAM int _rebuild_handles_impl(
-            int reserved_handles_count, void* hw_handles, intrusive_list<sorted_sprites::layer>& layers);
+            int reserved_handles_count, void* hw_handles, sprites_manager_item** handle_items,
+            unsigned* dirty_handles, intrusive_list<sorted_sprites::layer>& layers);
+
+    [[nodiscard]] BN_CODE_IWRAM int _update_batch_impl(
+            const batch_commit_data& batch_data, int handles_index, void* hw_handles, unsigned* dirty_handles);
 
-    [[nodiscard]] BN_CODE_IWRAM bool _update_cameras_impl(intrusive_list<sorted_sprites::layer>& layers);
+    [[nodiscard]] BN_CODE_IWRAM bool _update_camera_impl(intrusive_list<intrusive_list_node_type>& camera_nodes);
 }
 
 }
@@ -10,6 +10,7 @@
 #include "bn_sort_key.h"
 #include "bn_camera_ptr.h"
 #include "bn_intrusive_list.h"
+#include "bn_config_sprites.h"
 #include "bn_display_manager.h"
 #include "bn_sprites_manager.h"
 #include "bn_sprite_tiles_ptr.h"
@@ -23,6 +24,7 @@ namespace bn
     class sprite_builder;
 
     using sprite_affine_mat_attach_node_type = intrusive_list_node_type;
+    using sprite_camera_attach_node_type = intrusive_list_node_type;
 }
 
 namespace bn::sorted_sprites
@@ -38,6 +40,7 @@ class sprites_manager_item : public intrusive_list_node_type
 
 public:
     sprite_affine_mat_attach_node_type affine_mat_attach_node;
+    sprite_camera_attach_node_type camera_attach_node;
     hw::sprites::handle_type handle;
     fixed_point position;
     point hw_position;
@@ -59,6 +62,12 @@ public:
     bool on_screen: 1;
     bool check_on_screen: 1;
 
+    #if BN_CFG_SPRITES_MULTIPLEXING_ENABLED
+        int8_t multiplexing_first_band = 0;
+        int8_t multiplexing_release_band = 0;
+        bool multiplexing_rewrite = false;
+    #endif
+
     [[nodiscard]] static sprites_manager_item& affine_mat_attach_node_item(
             sprite_affine_mat_attach_node_type& attach_node)
     {
@@ -69,6 +78,15 @@ public:
         return *item;
     }
 
+    [[nodiscard]] static sprites_manager_item& camera_attach_node_item(sprite_camera_attach_node_type& attach_node)
+    {
+        auto item_address = reinterpret_cast<intptr_t>(&attach_node);
+        item_address -= sizeof(intrusive_list_node_type) + sizeof(sprite_affine_mat_attach_node_type);
+
+        auto item = reinterpret_cast<sprites_manager_item*>(item_address);
+        return *item;
+    }
+
     sprites_manager_item(const fixed_point& _position, const sprite_shape_size& shape_size,
                          sprite_tiles_ptr&& _tiles, sprite_palette_ptr&& _palette) :
         position(_position),
@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2020-2025 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_sram_journal.h"
+
+#include "bn_memory.h"
+#include "../hw/include/bn_hw_sram.h"
+
+namespace bn
+{
+
+namespace
+{
+    constexpr unsigned journal_magic = 0x314A4E42; // "BNJ1"
+    constexpr unsigned journal_invalid_magic = 0;
+    constexpr unsigned journal_checksum_basis = 0x811C9DC5;
+    constexpr unsigned journal_checksum_prime = 0x01000193;
+    constexpr int journal_read_chunk_size = 64;
+
+    class journal_header
+    {
+
+    public:
+        unsigned magic;
+        unsigned sequence;
+        unsigned data_size;
+        unsigned checksum;
+    };
+
+    static_assert(int(sizeof(journal_header)) == isram_journal::header_size());
+
+    [[nodiscard]] unsigned _update_journal_checksum(const uint8_t* data, int size, unsigned checksum)
+    {
+        // FNV-1a:
+        for(int index = 0; index < size; ++index)
+        {
+            checksum = (checksum ^ data[index]) * journal_checksum_prime;
+        }
+
+        return checksum;
+    }
+}
+
+isram_journal::isram_journal(uint8_t* snapshot, int data_size, int offset, int max_bytes_per_update) :
+    _snapshot(snapshot),
+    _data_size(data_size),
+    _offset(offset),
+    _max_bytes_per_update(max_bytes_per_update)
+{
+    BN_ASSERT(offset >= 0, "Invalid offset: ", offset);
+    BN_ASSERT(offset + size() <= sram::size(), "Size and offset are too high: ", size(), " - ", offset);
+    BN_ASSERT(max_bytes_per_update > 0, "Invalid max bytes per update: ", max_bytes_per_update);
+}
+
+void isram_journal::set_max_bytes_per_update(int max_bytes_per_update)
+{
+    BN_ASSERT(max_bytes_per_update > 0, "Invalid max bytes per update: ", max_bytes_per_update);
+
+    _max_bytes_per_update = max_bytes_per_update;
+}
+
+fixed isram_journal::progress() const
+{
+    return fixed(_written_bytes) / slot_size();
+}
+
+void isram_journal::update()
+{
+    if(_target_slot >= 0)
+    {
+        _write_bytes(_max_bytes_per_update);
+    }
+}
+
+void isram_journal::flush()
+{
+    if(_target_slot >= 0)
+    {
+        _write_bytes(slot_size());
+    }
+}
+
+void isram_journal::clear()
+{
+    for(int slot = 0; slot < 2; ++slot)
+    {
+        hw::sram::write(&journal_invalid_magic, int(sizeof(journal_invalid_magic)), _slot_offset(slot));
+    }
+
+    _written_bytes = 0;
+    _target_slot = -1;
+    _last_slot = -1;
+    _slots_checked = true;
+}
+
+bool isram_journal::_read(void* destination)
+{
+    _check_slots();
+
+    if(_last_slot < 0)
+    {
+        return false;
+    }
+
+    hw::sram::read(destination, _data_size, _slot_offset(_last_slot) + header_size());
+    return true;
+}
+
+void isram_journal::_write(const void* source)
+{
+    _check_slots();
+    memory::copy(*static_cast<const uint8_t*>(source), _data_size, *_snapshot);
+
+    // The target slot is invalidated before writing any data into it,
+    // so an interrupted write is never read back:
+    int target_slot = _last_slot == 0 ? 1 : 0;
+    hw::sram::write(&journal_invalid_magic, int(sizeof(journal_invalid_magic)), _slot_offset(target_slot));
+
+    _written_bytes = 0;
+    _target_slot = target_slot;
+    _checksum = journal_checksum_basis;
+}
+
+void isram_journal::_write_bytes(int max_bytes)
+{
+    int data_size = _data_size;
+    int written_bytes = _written_bytes;
+    int slot_offset = _slot_offset(_target_slot);
+
+    if(written_bytes < data_size)
+    {
+        int bytes = min(max_bytes, data_size - written_bytes);
+        const uint8_t* source = _snapshot + written_bytes;
+        hw::sram::write(source, bytes, slot_offset + header_size() + written_bytes);
+        _checksum = _update_journal_checksum(source, bytes, _checksum);
+        written_bytes += bytes;
+        _written_bytes = written_bytes;
+
+        if(written_bytes < data_size || max_bytes - bytes < header_size())
+        {
+            return;
+        }
+    }
+
+    // The magic number is written last, so the slot becomes valid only when everything else is in SRAM:
+    unsigned sequence = _last_sequence + 1;
+    journal_header header = { journal_magic, sequence, unsigned(data_size), _checksum };
+    hw::sram::write(&header.sequence, header_size() - int(sizeof(header.magic)),
+                    slot_offset + int(sizeof(header.magic)));
+    hw::sram::write(&header.magic, int(sizeof(header.magic)), slot_offset);
+
+    _written_bytes = slot_size();
+    _last_slot = _target_slot;
+    _target_slot = -1;
+    _last_sequence = sequence;
+}
+
+bool isram_journal::_read_valid_header(int slot, unsigned& sequence) const
+{
+    journal_header header;
+    int slot_offset = _slot_offset(slot);
+    hw::sram::read(&header, header_size(), slot_offset);
+
+    if(header.magic != journal_magic || header.data_size != unsigned(_data_size))
+    {
+        return false;
+    }
+
+    uint8_t chunk[journal_read_chunk_size];
+    unsigned checksum = journal_checksum_basis;
+    int data_offset = slot_offset + header_size();
+
+    for(int index = 0, data_size = _data_size; index < data_size; index += journal_read_chunk_size)
+    {
+        int bytes = min(journal_read_chunk_size, data_size - index);
+        hw::sram::read(chunk, bytes, data_offset + index);
+        checksum = _update_journal_checksum(chunk, bytes, checksum);
+    }
+
+    if(checksum != header.checksum)
+    {
+        return false;
+    }
+
+    sequence = header.sequence;
+    return true;
+}
+
+void isram_journal::_check_slots()
+{
+    if(_slots_checked)
+    {
+        return;
+    }
+
+    unsigned first_sequence = 0;
+    unsigned second_sequence = 0;
+    bool first_valid = _read_valid_header(0, first_sequence);
+    bool second_valid = _read_valid_header(1, second_sequence);
+    _slots_checked = true;
+
+    if(first_valid && second_valid)
+    {
+        // Sequence numbers are compared with wraparound:
+        bool second_newer = int(second_sequence - first_sequence) > 0;
+        _last_slot = second_newer ? 1 : 0;
+        _last_sequence = second_newer ? second_sequence : first_sequence;
+    }
+    else if(first_valid)
+    {
+        _last_slot = 0;
+        _last_sequence = first_sequence;
+    }
+    else if(second_valid)
+    {
+        _last_slot = 1;
+        _last_sequence = second_sequence;
+    }
+}
+
+}
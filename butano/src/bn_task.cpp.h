@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) 2020-2025 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_task.h"
+
+#include "bn_tasks_manager.h"
+
+namespace _bn::tasks
+{
+
+void* alloc(unsigned bytes)
+{
+    return bn::tasks_manager::alloc(bytes);
+}
+
+void free(void* ptr)
+{
+    bn::tasks_manager::free(ptr);
+}
+
+int create(std::coroutine_handle<> handle, const void* promise)
+{
+    return bn::tasks_manager::create(handle, promise);
+}
+
+void wait(int id, ready_type ready, void* ready_data)
+{
+    bn::tasks_manager::wait(id, ready, ready_data);
+}
+
+}
@@ -0,0 +1,23 @@
+/*
+ * Copyright (c) 2020-2025 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_tasks.h"
+
+#include "bn_tasks_manager.h"
+
+namespace bn::tasks
+{
+
+int used_items_count()
+{
+    return tasks_manager::used_items_count();
+}
+
+int available_items_count()
+{
+    return tasks_manager::available_items_count();
+}
+
+}
@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2020-2025 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_tasks_manager.h"
+
+#include <new>
+#include "bn_assert.h"
+#include "bn_limits.h"
+#include "bn_config_tasks.h"
+
+#include "bn_task.cpp.h"
+#include "bn_tasks.cpp.h"
+
+namespace bn::tasks_manager
+{
+
+namespace
+{
+    constexpr int max_items = BN_CFG_TASKS_MAX_ITEMS;
+    constexpr int max_frame_size = BN_CFG_TASKS_MAX_FRAME_SIZE;
+
+    static_assert(max_items >= 0 && max_items <= numeric_limits<uint8_t>::max());
+    static_assert(max_frame_size > 0 && max_frame_size % 8 == 0);
+
+    #if BN_CFG_TASKS_MAX_ITEMS
+        class item_type
+        {
+
+        public:
+            std::coroutine_handle<> handle;
+            _bn::tasks::ready_type ready = nullptr;
+            void* ready_data = nullptr;
+            unsigned stamp = 0;
+            bool waiting = false;
+        };
+
+
+        class static_data
+        {
+
+        public:
+            alignas(8) uint8_t frames[max_items * max_frame_size];
+            item_type items[max_items];
+            alignas(int) uint8_t free_item_indexes_array[max_items];
+            uint16_t free_item_indexes_size = max_items;
+            unsigned stamp = 0;
+        };
+
+        BN_DATA_EWRAM_BSS static_data data;
+
+        [[nodiscard]] int _item_index(const void* ptr)
+        {
+            auto frames = reinterpret_cast<uintptr_t>(data.frames);
+            auto address = reinterpret_cast<uintptr_t>(ptr);
+            BN_BASIC_ASSERT(address >= frames && address < frames + sizeof(data.frames),
+                            "Task frame not allocated in the tasks pool");
+
+            return int(address - frames) / max_frame_size;
+        }
+    #endif
+}
+
+#if BN_CFG_TASKS_MAX_ITEMS
+void init()
+{
+    ::new(static_cast<void*>(&data)) static_data();
+
+    for(int index = 0; index < max_items; ++index)
+    {
+        data.free_item_indexes_array[index] = uint8_t(max_items - index - 1);
+    }
+}
+
+int used_items_count()
+{
+    return max_items - data.free_item_indexes_size;
+}
+
+int available_items_count()
+{
+    return data.free_item_indexes_size;
+}
+
+void* alloc(unsigned bytes)
+{
+    BN_BASIC_ASSERT(int(bytes) <= max_frame_size, "Task frame is too big: ", bytes, " - ", max_frame_size);
+    BN_BASIC_ASSERT(data.free_item_indexes_size, "No more tasks available");
+
+    --data.free_item_indexes_size;
+
+    int item_index = data.free_item_indexes_array[data.free_item_indexes_size];
+    return data.frames + (item_index * max_frame_size);
+}
+
+void free(void* ptr)
+{
+    int item_index = _item_index(ptr);
+    data.items[item_index] = item_type();
+    data.free_item_indexes_array[data.free_item_indexes_size] = uint8_t(item_index);
+    ++data.free_item_indexes_size;
+}
+
+int create(std::coroutine_handle<> handle, const void* promise)
+{
+    int item_index = _item_index(promise);
+    data.items[item_index].handle = handle;
+    return item_index;
+}
+
+void wait(int id, _bn::tasks::ready_type ready, void* ready_data)
+{
+    item_type& item = data.items[id];
+    item.ready = ready;
+    item.ready_data = ready_data;
+    item.stamp = data.stamp;
+    item.waiting = true;
+}
+
+void update()
+{
+    if(data.free_item_indexes_size == max_items)
+    {
+        return;
+    }
+
+    // Tasks suspended in this update (for example, tasks created by another task) are not resumed until the next one:
+    unsigned stamp = data.stamp + 1;
+    data.stamp = stamp;
+
+    for(item_type& item : data.items)
+    {
+        if(item.waiting && item.stamp != stamp)
+        {
+            _bn::tasks::ready_type ready = item.ready;
+
+            if(! ready || ready(item.ready_data))
+            {
+                item.waiting = false;
+                item.handle.resume();
+            }
+        }
+    }
+}
+#else
+void init()
+{
+}
+
+int used_items_count()
+{
+    return 0;
+}
+
+int available_items_count()
+{
+    return 0;
+}
+
+void* alloc(unsigned)
+{
+    BN_ERROR("Tasks are disabled (see BN_CFG_TASKS_MAX_ITEMS)");
+
+    return nullptr;
+}
+
+void free(void*)
+{
+}
+
+int create(std::coroutine_handle<>, const void*)
+{
+    return 0;
+}
+
+void wait(int, _bn::tasks::ready_type, void*)
+{
+}
+
+void update()
+{
+}
+#endif
+
+}
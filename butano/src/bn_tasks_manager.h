@@ -0,0 +1,30 @@
+/*
+ * Copyright (c) 2020-2025 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_TASKS_MANAGER_H
+#define BN_TASKS_MANAGER_H
+
+#include "bn_task.h"
+
+namespace bn::tasks_manager
+{
+    void init();
+
+    [[nodiscard]] int used_items_count();
+
+    [[nodiscard]] int available_items_count();
+
+    [[nodiscard]] void* alloc(unsigned bytes);
+
+    void free(void* ptr);
+
+    [[nodiscard]] int create(std::coroutine_handle<> handle, const void* promise);
+
+    void wait(int id, _bn::tasks::ready_type ready, void* ready_data);
+
+    void update();
+}
+
+#endif
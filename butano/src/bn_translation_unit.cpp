@@ -8,9 +8,14 @@
 #include "bn_timer.cpp.h"
 
 #include "bn_backdrop.cpp.h"
+#include "bn_camera_3d.cpp.h"
 #include "bn_format.cpp.h"
+#include "bn_inplace_function.cpp.h"
 #include "bn_log.cpp.h"
 #include "bn_math.cpp.h"
+#include "bn_model_3d.cpp.h"
 #include "bn_reciprocal_lut.cpp.h"
 #include "bn_sin_lut.cpp.h"
+#include "bn_spatial_grid.cpp.h"
 #include "bn_sram.cpp.h"
+#include "bn_sram_journal.cpp.h"
@@ -0,0 +1,229 @@
+/*
+ * Copyright (c) 2020-2025 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_vblank_monitor.h"
+
+#if BN_CFG_VBLANK_MONITOR_ENABLED
+    #include "bn_deque.h"
+
+    #if BN_CFG_LOG_ENABLED
+        #include "bn_log.h"
+    #endif
+
+    namespace bn::vblank_monitor
+    {
+        namespace
+        {
+            static_assert(BN_CFG_VBLANK_MONITOR_MAX_FRAMES > 0);
+            static_assert(power_of_two(BN_CFG_VBLANK_MONITOR_MAX_FRAMES));
+
+            class static_data
+            {
+
+            public:
+                deque<frame_record, BN_CFG_VBLANK_MONITOR_MAX_FRAMES> frames;
+                optional<frame_record> last_overrun;
+                int frame_index = 0;
+                int overruns_count = 0;
+            };
+
+            BN_DATA_EWRAM_BSS static_data data;
+
+            #if BN_CFG_LOG_ENABLED
+                void _log_frame(const frame_record& frame)
+                {
+                    if(frame.overrun())
+                    {
+                        BN_LOG("    frame ", frame.frame_index(), " - ticks: ", frame.ticks(),
+                               " - overrun at: ", stage_name(frame.overrun_stage()));
+                    }
+                    else
+                    {
+                        BN_LOG("    frame ", frame.frame_index(), " - ticks: ", frame.ticks());
+                    }
+
+                    for(int index = 0; index < stages_count(); ++index)
+                    {
+                        auto commit_stage = stage(index);
+
+                        if(int ticks = frame.stage_ticks(commit_stage))
+                        {
+                            BN_LOG("        ", stage_name(commit_stage), ": ", ticks);
+                        }
+                    }
+                }
+            #endif
+        }
+
+        string_view stage_name(stage commit_stage)
+        {
+            switch(commit_stage)
+            {
+
+            case stage::AUDIO_COMMANDS:
+                return "audio_commands";
+
+            case stage::DISPLAY:
+                return "display";
+
+            case stage::SPRITES:
+                return "sprites";
+
+            case stage::BGS:
+                return "bgs";
+
+            case stage::PALETTES:
+                return "palettes";
+
+            case stage::SPRITE_TILES_UNCOMPRESSED:
+                return "sprite_tiles_uncompressed";
+
+            case stage::HDMA:
+                return "hdma";
+
+            case stage::HBLANK_EFFECTS:
+                return "hblank_effects";
+
+            case stage::BIG_MAPS:
+                return "big_maps";
+
+            case stage::BG_BLOCKS_UNCOMPRESSED:
+                return "bg_blocks_uncompressed";
+
+            case stage::SPRITE_TILES_COMPRESSED:
+                return "sprite_tiles_compressed";
+
+            case stage::BG_BLOCKS_COMPRESSED:
+                return "bg_blocks_compressed";
+
+            case stage::VBLANK_CALLBACK:
+                return "vblank_callback";
+
+            default:
+                BN_ERROR("Invalid stage: ", int(commit_stage));
+                return "";
+            }
+        }
+
+        frame_record::frame_record(int frame_index, const int (&stage_end_ticks)[stages_count()]) :
+            _frame_index(frame_index),
+            _ticks(stage_end_ticks[stages_count() - 1])
+        {
+            int stage_start_ticks = 0;
+
+            for(int index = 0; index < stages_count(); ++index)
+            {
+                int stage_end = stage_end_ticks[index];
+                _stage_ticks[index] = stage_end - stage_start_ticks;
+                stage_start_ticks = stage_end;
+            }
+        }
+
+        stage frame_record::overrun_stage() const
+        {
+            BN_BASIC_ASSERT(overrun(), "V-Blank period was not exceeded");
+
+            int ticks_per_vblank = timers::ticks_per_vblank();
+            int stage_end_ticks = 0;
+
+            for(int index = 0; index < stages_count(); ++index)
+            {
+                stage_end_ticks += _stage_ticks[index];
+
+                if(stage_end_ticks > ticks_per_vblank)
+                {
+                    return stage(index);
+                }
+            }
+
+            return stage::VBLANK_CALLBACK;
+        }
+
+        stage frame_record::max_stage() const
+        {
+            int max_index = 0;
+
+            for(int index = 1; index < stages_count(); ++index)
+            {
+                if(_stage_ticks[index] > _stage_ticks[max_index])
+                {
+                    max_index = index;
+                }
+            }
+
+            return stage(max_index);
+        }
+
+        const ideque<frame_record>& frames()
+        {
+            return data.frames;
+        }
+
+        int overruns_count()
+        {
+            return data.overruns_count;
+        }
+
+        const optional<frame_record>& last_overrun()
+        {
+            return data.last_overrun;
+        }
+
+        void reset()
+        {
+            data.frames.clear();
+            data.last_overrun.reset();
+            data.overruns_count = 0;
+        }
+
+        void log()
+        {
+            #if BN_CFG_LOG_ENABLED
+                BN_LOG("VBLANK MONITOR results (V-Blank budget: ", timers::ticks_per_vblank(), " ticks):");
+                BN_LOG("    overruns: ", data.overruns_count);
+
+                if(const optional<frame_record>& last_overrun = data.last_overrun)
+                {
+                    BN_LOG("VBLANK MONITOR last overrun:");
+                    _log_frame(*last_overrun);
+                }
+
+                BN_LOG("VBLANK MONITOR last frames:");
+
+                for(const frame_record& frame : data.frames)
+                {
+                    _log_frame(frame);
+                }
+            #endif
+        }
+    }
+
+    namespace _bn::vblank_monitor
+    {
+        void add_frame(const int (&stage_end_ticks)[bn::vblank_monitor::stages_count()])
+        {
+            using namespace bn::vblank_monitor;
+
+            if(data.frames.full())
+            {
+                data.frames.pop_front();
+            }
+
+            const frame_record& frame = data.frames.emplace_back(data.frame_index, stage_end_ticks);
+            ++data.frame_index;
+
+            if(frame.overrun())
+            {
+                data.last_overrun = frame;
+                ++data.overruns_count;
+
+                #if BN_CFG_VBLANK_MONITOR_LOG_OVERRUNS && BN_CFG_LOG_ENABLED
+                    BN_LOG("VBLANK MONITOR overrun at frame ", frame.frame_index(), " - ticks: ", frame.ticks(),
+                           " - stage: ", stage_name(frame.overrun_stage()));
+                #endif
+            }
+        }
+    }
+#endif
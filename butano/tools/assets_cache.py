@@ -0,0 +1,181 @@
+"""
+Copyright (c) 2020-2025 Gustavo Valiente gustavo.valiente@protonmail.com
+zlib License, see LICENSE file.
+"""
+
+import hashlib
+import json
+import os
+import shutil
+import tempfile
+
+
+class AssetsCache:
+
+    entry_file_name = '_bn_cache_entry.json'
+
+    @staticmethod
+    def create(cache_folder_path, build_folder_path, tool_paths):
+        tools_key = AssetsCache.__build_tools_key(tool_paths)
+
+        if cache_folder_path is None or len(cache_folder_path) == 0:
+            cache_folder_path = os.environ.get('BN_ASSETS_CACHE', '')
+
+        if len(cache_folder_path) == 0:
+            # The default cache is shared by all projects, so switching branches or projects reuses it:
+            cache_folder_path = os.path.join(os.path.expanduser('~'), '.butano_assets_cache')
+        elif cache_folder_path == 'build':
+            cache_folder_path = os.path.join(build_folder_path, '_bn_assets_cache')
+        elif cache_folder_path == 'none':
+            return AssetsCache(None, tools_key)
+
+        try:
+            os.makedirs(cache_folder_path, exist_ok=True)
+        except OSError:
+            return AssetsCache(None, tools_key)
+
+        return AssetsCache(cache_folder_path, tools_key)
+
+    @staticmethod
+    def read_key(file_info_path):
+        try:
+            with open(file_info_path, 'r') as file_info:
+                return file_info.read()
+        except OSError:
+            return None
+
+    @staticmethod
+    def write_key(file_info_path, key):
+        with open(file_info_path, 'w') as file_info:
+            file_info.write(key)
+
+    def __init__(self, folder_path, tools_key):
+        self.__folder_path = folder_path
+        self.__tools_key = tools_key
+
+    def enabled(self):
+        return self.__folder_path is not None
+
+    def build_key(self, tag, file_paths):
+        sha = hashlib.sha256()
+        sha.update(self.__tools_key.encode())
+        sha.update(tag.encode())
+
+        for file_path in file_paths:
+            sha.update(b'\0')
+
+            if file_path is not None:
+                with open(file_path, 'rb') as file:
+                    file_data = file.read()
+
+                sha.update(str(len(file_data)).encode())
+                sha.update(b'\0')
+                sha.update(file_data)
+
+        return sha.hexdigest()
+
+    def restore(self, key, build_folder_path):
+        if self.__folder_path is None:
+            return None
+
+        entry_folder_path = self.__entry_folder_path(key)
+        entry_file_path = os.path.join(entry_folder_path, AssetsCache.entry_file_name)
+
+        try:
+            with open(entry_file_path, 'r') as entry_file:
+                entry = json.load(entry_file)
+
+            for file_name in entry['files']:
+                shutil.copyfile(os.path.join(entry_folder_path, file_name), os.path.join(build_folder_path, file_name))
+
+            return entry
+        except (OSError, ValueError, KeyError):
+            return None
+
+    def store(self, key, file_paths, entry):
+        if self.__folder_path is None:
+            return
+
+        entry_folder_path = self.__entry_folder_path(key)
+
+        if os.path.isdir(entry_folder_path):
+            return
+
+        temp_folder_path = None
+
+        try:
+            # Entries are written in a temporary folder and renamed when complete,
+            # so concurrent builds never read partial entries:
+            os.makedirs(os.path.dirname(entry_folder_path), exist_ok=True)
+            temp_folder_path = tempfile.mkdtemp(dir=os.path.dirname(entry_folder_path))
+            file_names = []
+
+            for file_path in file_paths:
+                file_name = os.path.basename(file_path)
+                shutil.copyfile(file_path, os.path.join(temp_folder_path, file_name))
+                file_names.append(file_name)
+
+            entry = dict(entry)
+            entry['files'] = file_names
+
+            with open(os.path.join(temp_folder_path, AssetsCache.entry_file_name), 'w') as entry_file:
+                json.dump(entry, entry_file)
+
+            os.rename(temp_folder_path, entry_folder_path)
+            temp_folder_path = None
+        except OSError:
+            pass
+
+        if temp_folder_path is not None:
+            shutil.rmtree(temp_folder_path, ignore_errors=True)
+
+    def __entry_folder_path(self, key):
+        return os.path.join(self.__folder_path, key[:2], key)
+
+    @staticmethod
+    def __build_tools_key(tool_paths):
+        # Converted assets are invalidated when the conversion tools change:
+        sha = hashlib.sha256()
+        tools_folder_path = os.path.dirname(os.path.abspath(__file__))
+
+        for folder_path, folder_names, file_names in os.walk(tools_folder_path):
+            folder_names.sort()
+
+            for file_name in sorted(file_names):
+                if file_name.endswith('.py'):
+                    with open(os.path.join(folder_path, file_name), 'rb') as file:
+                        sha.update(file_name.encode())
+                        sha.update(file.read())
+
+        for tool_path in tool_paths:
+            sha.update(tool_path.encode())
+
+            if os.path.isfile(tool_path):
+                sha.update(str(os.path.getsize(tool_path)).encode())
+
+        return sha.hexdigest()
+
+
+class AssetsCacheStats:
+
+    def __init__(self):
+        self.hits = 0
+        self.misses = 0
+
+    def add(self, cache_hit):
+        if cache_hit:
+            self.hits += 1
+        else:
+            self.misses += 1
+
+    def add_stats(self, other):
+        self.hits += other.hits
+        self.misses += other.misses
+
+    def print_hit_rate(self, assets_cache):
+        total = self.hits + self.misses
+
+        if total > 0 and assets_cache.enabled():
+            hit_rate = (self.hits * 100) / total
+            print('Assets cache: ' + str(self.hits) + ' hits, ' + str(self.misses) + ' misses (' +
+                  '{:.1f}'.format(hit_rate) + '% hit rate)')
@@ -0,0 +1,178 @@
+"""
+Copyright (c) 2020-2025 Gustavo Valiente gustavo.valiente@protonmail.com
+zlib License, see LICENSE file.
+"""
+
+import re
+import struct
+
+chunk_size = 32
+
+
+def lz77_compress(data):
+    # GBA BIOS LZ77 format. Displacements of one byte are avoided, so data can be decompressed with 16bit writes:
+    size = len(data)
+    result = bytearray(struct.pack('<I', 0x10 | (size << 8)))
+    positions = {}
+    index = 0
+
+    while index < size:
+        flags_index = len(result)
+        flags = 0
+        result.append(0)
+
+        for bit in range(8):
+            if index >= size:
+                break
+
+            best_length = 0
+            best_displacement = 0
+            max_length = min(18, size - index)
+
+            if max_length >= 3:
+                for candidate in reversed(positions.get(bytes(data[index:index + 3]), ())):
+                    displacement = index - candidate
+
+                    if displacement > 4096:
+                        break
+
+                    if displacement < 2:
+                        continue
+
+                    length = 3
+
+                    while length < max_length and data[candidate + length] == data[index + length]:
+                        length += 1
+
+                    if length > best_length:
+                        best_length = length
+                        best_displacement = displacement
+
+                        if length == max_length:
+                            break
+
+            if best_length >= 3:
+                flags |= 0x80 >> bit
+                result.append(((best_length - 3) << 4) | ((best_displacement - 1) >> 8))
+                result.append((best_displacement - 1) & 0xFF)
+                step = best_length
+            else:
+                result.append(data[index])
+                step = 1
+
+            for _ in range(step):
+                if index + 3 <= size:
+                    positions.setdefault(bytes(data[index:index + 3]), []).append(index)
+
+                index += 1
+
+        result[flags_index] = flags
+
+    return result
+
+
+def run_length_compress(data):
+    # GBA BIOS run length format:
+    size = len(data)
+    result = bytearray(struct.pack('<I', 0x30 | (size << 8)))
+    literals = bytearray()
+    index = 0
+
+    def flush_literals():
+        if len(literals) > 0:
+            result.append(len(literals) - 1)
+            result.extend(literals)
+            literals.clear()
+
+    while index < size:
+        run = 1
+
+        while index + run < size and run < 130 and data[index + run] == data[index]:
+            run += 1
+
+        if run >= 3:
+            flush_literals()
+            result.append(0x80 | (run - 3))
+            result.append(data[index])
+            index += run
+        else:
+            literals.append(data[index])
+            index += 1
+
+            if len(literals) == 128:
+                flush_literals()
+
+    flush_literals()
+    return result
+
+
+def build_chunked_map(grit_data, map_name, width, height, cell_size, compression):
+    # The uncompressed map array exported by grit is replaced with the byte offset of each chunk of 32x32 cells,
+    # followed by the chunks compressed independently.
+    # Returns the new grit data and the size difference in bytes between the new and the old map arrays:
+    if width % chunk_size != 0 or height % chunk_size != 0:
+        raise ValueError('Compressed big map size is not divisible by chunk size: ' +
+                         str(width) + ' - ' + str(height) + ' - ' + str(chunk_size))
+
+    if compression == 'lz77':
+        compress = lz77_compress
+    elif compression == 'run_length':
+        compress = run_length_compress
+    else:
+        raise ValueError('Compression not supported by big maps: ' + str(compression))
+
+    map_pattern = re.compile(r'(unsigned (char|short|int) ' + map_name + r'\[)([0-9]+)(\][^=;]*=\s*\{)([^}]*)(\})')
+    map_match = map_pattern.search(grit_data)
+
+    if map_match is None:
+        raise ValueError('Map array not found: ' + map_name)
+
+    unit_size = {'char': 1, 'short': 2, 'int': 4}[map_match.group(2)]
+    map_data = bytearray()
+
+    for value in map_match.group(5).split(','):
+        value = value.strip()
+
+        if len(value) > 0:
+            map_data.extend(int(value, 0).to_bytes(unit_size, 'little'))
+
+    row_size = width * cell_size
+    chunk_row_size = chunk_size * cell_size
+
+    if len(map_data) != row_size * height:
+        raise ValueError('Invalid map array size: ' + str(len(map_data)) + ' - ' + str(row_size * height))
+
+    chunks_count = (width // chunk_size) * (height // chunk_size)
+    chunks_data = bytearray()
+    offsets = []
+
+    for chunk_y in range(0, height, chunk_size):
+        for chunk_x in range(0, width, chunk_size):
+            chunk_data = bytearray()
+
+            for y in range(chunk_y, chunk_y + chunk_size):
+                row_start = (y * row_size) + (chunk_x * cell_size)
+                chunk_data.extend(map_data[row_start:row_start + chunk_row_size])
+
+            offsets.append((chunks_count * 4) + len(chunks_data))
+            chunks_data.extend(compress(chunk_data))
+
+            # Keep chunks word aligned:
+            while len(chunks_data) % 4 != 0:
+                chunks_data.append(0)
+
+    blob = bytearray(struct.pack('<' + str(chunks_count) + 'I', *offsets))
+    blob.extend(chunks_data)
+    units = [int.from_bytes(blob[index:index + unit_size], 'little') for index in range(0, len(blob), unit_size)]
+    unit_format = '0x{:0' + str(unit_size * 2) + 'X}'
+    lines = []
+
+    for line_start in range(0, len(units), 8):
+        lines.append('\t' + ','.join(unit_format.format(unit) for unit in units[line_start:line_start + 8]) + ',')
+
+    map_array = map_match.group(1) + map_match.group(3) + map_match.group(4) + '\n' + '\n'.join(lines) + '\n' + \
+        map_match.group(6)
+    grit_data = grit_data[:map_match.start()] + map_array + grit_data[map_match.end():]
+    grit_data = re.sub(map_name + r'\[[0-9]+]', map_name + '[' + str(len(units)) + ']', grit_data)
+    grit_data = re.sub(r'(#define ' + map_name + r'Len )[0-9]+', r'\g<1>' + str(len(blob)), grit_data)
+    return grit_data, len(blob) - len(map_data)
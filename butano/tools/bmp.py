@@ -49,6 +49,8 @@ class BMP:
             if bits_per_pixel != 4 and bits_per_pixel != 8:
                 raise ValueError('Invalid bits per pixel: ' + str(bits_per_pixel))
 
+            self.__bits_per_pixel = bits_per_pixel
+
             compression_method = read_int()
 
             if compression_method != 0:
@@ -92,6 +94,37 @@ class BMP:
 
             self.colors_count = colors_count
 
+    def read_gba_colors_and_pixels(self):
+        # Returns the palette colors in GBA format and the pixel indexes of each row, from top to bottom:
+        with open(self.__file_path, 'rb') as file:
+            file.seek(self.__colors_offset)
+            palette_colors_count = int((self.__pixels_offset - self.__colors_offset) / 4)
+            colors = struct.unpack(str(palette_colors_count) + 'I', file.read(palette_colors_count * 4))
+            gba_colors = [((color >> 19) & 0x1F) | (((color >> 11) & 0x1F) << 5) | (((color >> 3) & 0x1F) << 10)
+                          for color in colors]
+
+            file.seek(self.__pixels_offset)
+            width = self.width
+            row_size = int((width * self.__bits_per_pixel) / 8)  # no padding, width is multiple of 8.
+            pixels = []
+
+            for y in range(self.height):
+                row = file.read(row_size)
+
+                if self.__bits_per_pixel == 4:
+                    row_pixels = []
+
+                    for pixels_byte in row:
+                        row_pixels.append(pixels_byte >> 4)
+                        row_pixels.append(pixels_byte & 0xF)
+                else:
+                    row_pixels = list(row)
+
+                pixels.append(row_pixels)
+
+        pixels.reverse()
+        return gba_colors, pixels
+
     def quantize(self, output_file_path):
         if self.colors_count == 16:
             shutil.copyfile(self.__file_path, output_file_path)
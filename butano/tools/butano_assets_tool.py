@@ -2,9 +2,11 @@ import argparse
 import sys
 import traceback
 
+from assets_cache import AssetsCache, AssetsCacheStats
 from butano_audio_tool import process_audio
 from butano_dmg_audio_tool import process_dmg_audio
 from butano_graphics_tool import process_graphics
+from pool import create_pool
 
 
 if __name__ == "__main__":
@@ -15,12 +17,19 @@ if __name__ == "__main__":
     parser.add_argument('--dmg_audio', required=True, help='dmg audio folder and file paths')
     parser.add_argument('--graphics', required=True, help='graphics folder and file paths')
     parser.add_argument('--build', required=True, help='build folder path')
+    parser.add_argument('--cache', default='', help='assets cache folder path '
+                        '(\'build\' uses the build folder, \'none\' disables it)')
 
     try:
         args = parser.parse_args()
-        process_audio(args.mmutil, args.audio, args.build)
-        process_dmg_audio(args.dmg_audio, args.build)
-        process_graphics(args.grit, args.graphics, args.build)
+        assets_cache = AssetsCache.create(args.cache, args.build, [args.grit, args.mmutil])
+        cache_stats = AssetsCacheStats()
+        pool = create_pool()
+        cache_stats.add_stats(process_audio(args.mmutil, args.audio, args.build, pool, assets_cache))
+        cache_stats.add_stats(process_dmg_audio(args.dmg_audio, args.build, pool, assets_cache))
+        cache_stats.add_stats(process_graphics(args.grit, args.graphics, args.build, pool, assets_cache))
+        pool.close()
+        cache_stats.print_hit_rate(assets_cache)
     except Exception as ex:
         sys.stderr.write('Error: ' + str(ex) + '\n')
         traceback.print_exc()
@@ -8,6 +8,10 @@ import subprocess
 import sys
 
 from file_info import FileInfo
+from assets_cache import AssetsCache, AssetsCacheStats
+
+
+audio_output_file_names = ['bn_music_items.h', 'bn_sound_items.h', 'bn_music_items_info.h', 'bn_sound_items_info.h']
 
 
 def list_audio_files(audio_paths):
@@ -171,14 +175,34 @@ def write_output_files(audio_file_names_no_ext, soundbank_header_path, build_fol
                            'sound_item', build_folder_path + '/bn_sound_items_info.h')
 
 
-def process_audio(mmutil, audio_paths, build_folder_path):
+class AudioFileKeyBuilder:
+
+    def __init__(self, assets_cache):
+        self.__assets_cache = assets_cache
+
+    def __call__(self, audio_file_path):
+        return self.__assets_cache.build_key('audio:' + os.path.basename(audio_file_path), [audio_file_path])
+
+
+def process_audio(mmutil, audio_paths, build_folder_path, pool, assets_cache):
+    cache_stats = AssetsCacheStats()
     audio_file_names, audio_file_names_no_ext, audio_file_paths = list_audio_files(audio_paths)
     file_info_path = build_folder_path + '/_bn_audio_files_info.txt'
     old_file_info = FileInfo.read(file_info_path)
     new_file_info = FileInfo.build_from_files(audio_file_paths)
 
     if old_file_info == new_file_info:
-        return
+        return cache_stats
+
+    # mmutil builds one soundbank from all audio files,
+    # so the soundbank is rebuilt only if the content of any audio file has changed:
+    audio_file_keys = pool.map(AudioFileKeyBuilder(assets_cache), audio_file_paths)
+    key = assets_cache.build_key('audio_soundbank:' + ' '.join(audio_file_keys), [])
+    key_file_path = build_folder_path + '/_bn_audio_files_key.txt'
+
+    if AssetsCache.read_key(key_file_path) == key:
+        new_file_info.write(file_info_path)
+        return cache_stats
 
     for audio_file_name in audio_file_names:
         print(audio_file_name)
@@ -186,10 +210,37 @@ def process_audio(mmutil, audio_paths, build_folder_path):
     sys.stdout.flush()
 
     soundbank_bin_path = build_folder_path + '/_bn_audio_soundbank.bin'
-    soundbank_header_path = build_folder_path + '/_bn_audio_soundbank.h'
-    total_size = process_audio_files(mmutil, audio_file_paths, soundbank_bin_path, soundbank_header_path,
-                                     build_folder_path)
-    write_output_files(audio_file_names_no_ext, soundbank_header_path, build_folder_path)
-    print('    Processed audio size: ' + str(total_size) + ' bytes')
-    os.remove(soundbank_header_path)
+    cache_entry = assets_cache.restore(key, build_folder_path)
+
+    if cache_entry is not None:
+        for audio_output_file_name in audio_output_file_names:
+            if audio_output_file_name not in cache_entry['files']:
+                audio_output_file_path = build_folder_path + '/' + audio_output_file_name
+
+                if os.path.exists(audio_output_file_path):
+                    os.remove(audio_output_file_path)
+
+        print('    Processed audio size: ' + str(cache_entry['size']) + ' bytes (cached)')
+        cache_stats.add(True)
+    else:
+        soundbank_header_path = build_folder_path + '/_bn_audio_soundbank.h'
+        total_size = process_audio_files(mmutil, audio_file_paths, soundbank_bin_path, soundbank_header_path,
+                                         build_folder_path)
+        write_output_files(audio_file_names_no_ext, soundbank_header_path, build_folder_path)
+        print('    Processed audio size: ' + str(total_size) + ' bytes')
+        os.remove(soundbank_header_path)
+
+        output_file_paths = [soundbank_bin_path]
+
+        for audio_output_file_name in audio_output_file_names:
+            audio_output_file_path = build_folder_path + '/' + audio_output_file_name
+
+            if os.path.exists(audio_output_file_path):
+                output_file_paths.append(audio_output_file_path)
+
+        assets_cache.store(key, output_file_paths, {'size': total_size})
+        cache_stats.add(False)
+
+    AssetsCache.write_key(key_file_path, key)
     new_file_info.write(file_info_path)
+    return cache_stats
@@ -8,7 +8,7 @@ import json
 import sys
 
 from file_info import FileInfo
-from pool import create_pool
+from assets_cache import AssetsCache, AssetsCacheStats
 
 
 class DmgAudioFileInfo:
@@ -22,16 +22,35 @@ class DmgAudioFileInfo:
         self.__file_info_path = file_info_path
         self.__import_instruments = False
         self.__mod_speed_conversion = True
+        self.__key = None
 
     def print_file_name(self):
         print(self.__file_name)
 
-    def process(self, build_folder_path):
+    def build_key(self, assets_cache):
+        return assets_cache.build_key('dmg_audio:' + self.__file_name, [self.__file_path, self.__json_file_path])
+
+    def set_key(self, key):
+        self.__key = key
+
+    def up_to_date(self):
+        return AssetsCache.read_key(self.__file_info_path) == self.__key
+
+    def touch_file_info(self):
+        os.utime(self.__file_info_path)
+
+    def process(self, build_folder_path, assets_cache):
         output_tag = self.__file_name_no_ext + '_bn_dmg'
         output_file_name = output_tag + '.c'
         output_file_path = build_folder_path + '/' + output_file_name
 
         try:
+            cache_entry = assets_cache.restore(self.__key, build_folder_path)
+
+            if cache_entry is not None:
+                AssetsCache.write_key(self.__file_info_path, self.__key)
+                return [self.__file_name, build_folder_path + '/' + cache_entry['header'], cache_entry['size'], True]
+
             if self.__json_file_path is not None:
                 try:
                     with open(self.__json_file_path) as json_file:
@@ -62,11 +81,10 @@ class DmgAudioFileInfo:
                 music_type = 'VGM'
 
             header_file_path = self.__write_header(build_folder_path, output_tag, music_type)
-
-            with open(self.__file_info_path, 'w') as file_info:
-                file_info.write('')
-
-            return [self.__file_name, header_file_path, file_size]
+            assets_cache.store(self.__key, [output_file_path, header_file_path],
+                               {'header': os.path.basename(header_file_path), 'size': file_size})
+            AssetsCache.write_key(self.__file_info_path, self.__key)
+            return [self.__file_name, header_file_path, file_size, False]
         except Exception as exc:
             if os.path.exists(output_file_name):
                 os.remove(output_file_name)
@@ -157,13 +175,23 @@ class DmgAudioFileInfo:
         return header_file_path
 
 
+class DmgAudioFileInfoKeyBuilder:
+
+    def __init__(self, assets_cache):
+        self.__assets_cache = assets_cache
+
+    def __call__(self, audio_file_info):
+        return audio_file_info.build_key(self.__assets_cache)
+
+
 class DmgAudioFileInfoProcessor:
 
-    def __init__(self, build_folder_path):
+    def __init__(self, build_folder_path, assets_cache):
         self.__build_folder_path = build_folder_path
+        self.__assets_cache = assets_cache
 
     def __call__(self, audio_file_info):
-        return audio_file_info.process(self.__build_folder_path)
+        return audio_file_info.process(self.__build_folder_path, self.__assets_cache)
 
 
 def list_dmg_audio_file_infos(audio_paths, build_folder_path):
@@ -230,32 +258,52 @@ def list_dmg_audio_file_infos(audio_paths, build_folder_path):
     return audio_file_infos
 
 
-def process_dmg_audio(audio_paths, build_folder_path):
+def process_dmg_audio(audio_paths, build_folder_path, pool, assets_cache):
+    cache_stats = AssetsCacheStats()
+
     if len(audio_paths) == 0:
-        return
+        return cache_stats
 
     audio_file_infos = list_dmg_audio_file_infos(audio_paths, build_folder_path)
 
+    if len(audio_file_infos) > 0:
+        # DMG audio files with a modification time newer than their build info are rebuilt
+        # only if their content has changed:
+        keys = pool.map(DmgAudioFileInfoKeyBuilder(assets_cache), audio_file_infos)
+        outdated_audio_file_infos = []
+
+        for audio_file_info, key in zip(audio_file_infos, keys):
+            audio_file_info.set_key(key)
+
+            if audio_file_info.up_to_date():
+                audio_file_info.touch_file_info()
+            else:
+                outdated_audio_file_infos.append(audio_file_info)
+
+        audio_file_infos = outdated_audio_file_infos
+
     if len(audio_file_infos) > 0:
         for audio_file_info in audio_file_infos:
             audio_file_info.print_file_name()
 
         sys.stdout.flush()
 
-        pool = create_pool()
-        process_results = pool.map(DmgAudioFileInfoProcessor(build_folder_path), audio_file_infos)
-        pool.close()
-
+        process_results = pool.map(DmgAudioFileInfoProcessor(build_folder_path, assets_cache), audio_file_infos)
         process_excs = []
 
         for process_result in process_results:
-            if len(process_result) == 3:
+            if len(process_result) == 4:
                 result = '    ' + str(process_result[0]) + ' item header written in ' + str(process_result[1])
                 file_size = process_result[2]
+                cache_hit = process_result[3]
+                cache_stats.add(cache_hit)
 
                 if file_size >= 0:
                     result += ' (music size: ' + str(file_size) + ' bytes)'
 
+                if cache_hit:
+                    result += ' (cached)'
+
                 print(result)
             else:
                 process_excs.append(process_result)
@@ -267,3 +315,5 @@ def process_dmg_audio(audio_paths, build_folder_path):
                 sys.stderr.write(str(process_exc[0]) + ' error: ' + str(process_exc[1]) + '\n')
 
             exit(-1)
+
+    return cache_stats
@@ -5,14 +5,17 @@ zlib License, see LICENSE file.
 
 import os
 import json
+import math
 import re
 import string
 import subprocess
 import sys
 
 from bmp import BMP
+from bg_map_chunks import build_chunked_map
 from file_info import FileInfo
-from pool import create_pool
+from tiles_banks import TilesBank, TilesBankItem
+from assets_cache import AssetsCache, AssetsCacheStats
 
 
 def parse_colors_count(info, bmp, tag='colors_count'):
@@ -714,6 +717,13 @@ class RegularBgItem:
             except KeyError:
                 self.__map_compression = 'none'
 
+        if self.__big and self.__map_compression != 'none' and not self.__map_compression.startswith('auto'):
+            if self.__map_compression == 'huffman':
+                raise ValueError('Huffman compression not supported by big maps')
+
+            if self.__maps > 1:
+                raise ValueError('Compressed big maps with more than one map not supported: ' + str(self.__maps))
+
     def process(self, grit):
         tiles_compression = self.__tiles_compression
         palette_compression = self.__palette_compression
@@ -743,13 +753,18 @@ class RegularBgItem:
                                                                                  file_size)
 
         if map_compression.startswith('auto'):
-            test_huffman = map_compression == 'auto'
-            map_compression, file_size = self.__test_map_compression(grit, map_compression, 'none', None)
-            map_compression, file_size = self.__test_map_compression(grit, map_compression, 'run_length', file_size)
-            map_compression, file_size = self.__test_map_compression(grit, map_compression, 'lz77', file_size)
+            if self.__big and self.__maps > 1:
+                map_compression = 'none'
+            else:
+                test_huffman = map_compression == 'auto' and not self.__big
+                map_compression, file_size = self.__test_map_compression(grit, map_compression, 'none', None)
+                map_compression, file_size = self.__test_map_compression(grit, map_compression, 'run_length',
+                                                                         file_size)
+                map_compression, file_size = self.__test_map_compression(grit, map_compression, 'lz77', file_size)
 
-            if test_huffman:
-                map_compression, file_size = self.__test_map_compression(grit, map_compression, 'huffman', file_size)
+                if test_huffman:
+                    map_compression, file_size = self.__test_map_compression(grit, map_compression, 'huffman',
+                                                                             file_size)
 
         self.__execute_command(grit, tiles_compression, palette_compression, map_compression)
         return self.__write_header(tiles_compression, palette_compression, map_compression, False)
@@ -788,6 +803,12 @@ class RegularBgItem:
 
         with open(grit_file_path, 'r') as grit_file:
             grit_data = grit_file.read()
+            map_size_delta = 0
+
+            if self.__big and map_compression != 'none':
+                grit_data, map_size_delta = build_chunked_map(grit_data, name + '_bn_gfxMap', self.__width,
+                                                              self.__height, 2, map_compression)
+
             grit_data = grit_data.replace('unsigned int', 'bn::tile', 1)
             grit_data = grit_data.replace('unsigned short', 'bn::regular_bg_map_cell', 1)
 
@@ -807,7 +828,7 @@ class RegularBgItem:
                         raise ValueError('Regular BGs with more than 1024 tiles not supported: ' + str(tiles_count))
 
                 if 'Total size:' in grit_line:
-                    total_size = int(grit_line.split()[-1])
+                    total_size = int(grit_line.split()[-1]) + map_size_delta
 
                     if skip_write:
                         return total_size
@@ -899,7 +920,11 @@ class RegularBgItem:
 
         append_compression_command('g', tiles_compression, command)
         append_compression_command('p', palette_compression, command)
-        append_compression_command('m', map_compression, command)
+
+        # Big maps are split in chunks compressed independently after calling grit:
+        if not self.__big:
+            append_compression_command('m', map_compression, command)
+
         command.append('-o' + self.__build_folder_path + '/' + self.__file_name_no_ext + '_bn_gfx')
         command = ' '.join(command)
 
@@ -1093,6 +1118,222 @@ class RegularBgTilesItem:
             raise ValueError(grit + ' call failed (return code ' + str(e.returncode) + '): ' + str(e.output))
 
 
+class RegularBgStreamedItem:
+
+    def __init__(self, file_path, file_name_no_ext, build_folder_path, info):
+        bmp = BMP(file_path)
+        self.__bmp = bmp
+        self.__file_name_no_ext = file_name_no_ext
+        self.__build_folder_path = build_folder_path
+
+        width = bmp.width
+        height = bmp.height
+
+        if width % 256 != 0:
+            raise ValueError('Regular BGs width must be divisible by 256: ' + str(width))
+
+        if height % 256 != 0:
+            raise ValueError('Regular BGs height must be divisible by 256: ' + str(height))
+
+        if width == 256 and height == 256:
+            raise ValueError('Too small size for a streamed regular BG: ' + str(width) + ' - ' + str(height))
+
+        if width > 16384 or height > 16384:
+            raise ValueError('Too big size for a streamed regular BG: ' + str(width) + ' - ' + str(height))
+
+        if 'height' in info and int(info['height']) != height:
+            raise ValueError('Streamed regular BGs with more than one map not supported')
+
+        if 'big' in info and not bool(info['big']):
+            raise ValueError('Streamed regular BGs must be big')
+
+        if 'palette_item' in info:
+            raise ValueError('External palette items not supported by streamed regular BGs')
+
+        for compression_tag in ['compression', 'tiles_compression', 'palette_compression', 'map_compression']:
+            if compression_tag in info and str(info[compression_tag]) != 'none':
+                raise ValueError('Compression not supported by streamed regular BGs: ' + str(info[compression_tag]))
+
+        self.__width = int(width / 8)
+        self.__height = int(height / 8)
+        self.__colors_count = parse_colors_count(info, bmp)
+
+        try:
+            bpp_mode = str(info['bpp_mode'])
+
+            if bpp_mode == 'bpp_8':
+                self.__bpp_8 = True
+            elif bpp_mode == 'bpp_4' or bpp_mode == 'bpp_4_manual':
+                self.__bpp_8 = False
+            else:
+                raise ValueError('Invalid BPP mode: ' + bpp_mode)
+        except KeyError:
+            self.__bpp_8 = self.__colors_count > 16
+
+        try:
+            self.__repeated_tiles_reduction = bool(info['repeated_tiles_reduction'])
+        except KeyError:
+            self.__repeated_tiles_reduction = True
+
+        try:
+            self.__flipped_tiles_reduction = bool(info['flipped_tiles_reduction'])
+        except KeyError:
+            self.__flipped_tiles_reduction = True
+
+    def process(self, grit):
+        # Tiles are not generated with grit, since map cells can only reference up to 1024 tiles.
+        # Instead, the source tile of each map cell is stored in a separate array of indexes:
+        colors, pixels = self.__bmp.read_gba_colors_and_pixels()
+        colors = list(colors[:self.__colors_count])
+        colors += [0] * (self.__colors_count - len(colors))
+        bpp_8 = self.__bpp_8
+        tiles_words = []
+        tiles = {}
+        tiles_count = 0
+        cells = []
+        tile_indexes = []
+
+        for ty in range(0, self.__height * 8, 8):
+            for tx in range(0, self.__width * 8, 8):
+                rows = [pixels[y][tx:tx + 8] for y in range(ty, ty + 8)]
+
+                if bpp_8:
+                    palette_index = 0
+                else:
+                    palette_indexes = set(pixel >> 4 for row in rows for pixel in row if pixel & 0xF)
+
+                    if len(palette_indexes) > 1:
+                        raise ValueError('There\'s a tile with colors of more than one 4bpp palette: ' +
+                                         str(tx) + ' - ' + str(ty))
+
+                    palette_index = palette_indexes.pop() if palette_indexes else 0
+                    rows = [[pixel & 0xF for pixel in row] for row in rows]
+
+                tile_index = None
+
+                if self.__repeated_tiles_reduction:
+                    for flip_flags, flipped_rows in self.__flipped_tiles(rows):
+                        tile_index = tiles.get(self.__tile_words(flipped_rows, bpp_8))
+
+                        if tile_index is not None:
+                            break
+
+                if tile_index is None:
+                    if tiles_count == 65535:
+                        raise ValueError('Streamed regular BGs with more than 65534 tiles not supported')
+
+                    flip_flags = 0
+                    tile_index = tiles_count
+                    tiles_count += 1
+                    key = self.__tile_words(rows, bpp_8)
+                    tiles[key] = tile_index
+                    tiles_words.extend(key)
+
+                cells.append((tile_index & 0x3FF) | flip_flags | (palette_index << 12))
+                tile_indexes.append(tile_index)
+
+        return self.__write_header(tiles_words, colors, cells, tile_indexes)
+
+    def __flipped_tiles(self, rows):
+        if not self.__flipped_tiles_reduction:
+            return [(0, rows)]
+
+        horizontal_rows = [list(reversed(row)) for row in rows]
+        return [(0, rows), (1 << 10, horizontal_rows), (1 << 11, list(reversed(rows))),
+                ((1 << 10) | (1 << 11), list(reversed(horizontal_rows)))]
+
+    @staticmethod
+    def __tile_words(rows, bpp_8):
+        words = []
+
+        if bpp_8:
+            for row in rows:
+                words.append(row[0] | (row[1] << 8) | (row[2] << 16) | (row[3] << 24))
+                words.append(row[4] | (row[5] << 8) | (row[6] << 16) | (row[7] << 24))
+        else:
+            for row in rows:
+                word = 0
+
+                for x in range(8):
+                    word |= row[x] << (x * 4)
+
+                words.append(word)
+
+        return tuple(words)
+
+    def __write_header(self, tiles_words, colors, cells, tile_indexes):
+        name = self.__file_name_no_ext
+        header_file_path = self.__build_folder_path + '/bn_regular_bg_streamed_items_' + name + '.h'
+        tiles_count = int(len(tiles_words) / 8)
+        bpp_mode_label = 'bpp_mode::BPP_8' if self.__bpp_8 else 'bpp_mode::BPP_4'
+        total_size = (len(tiles_words) * 4) + (len(colors) * 2) + (len(cells) * 2) + (len(tile_indexes) * 2)
+
+        with open(header_file_path, 'w') as header_file:
+            include_guard = 'BN_REGULAR_BG_STREAMED_ITEMS_' + name.upper() + '_H'
+            header_file.write('#ifndef ' + include_guard + '\n')
+            header_file.write('#define ' + include_guard + '\n')
+            header_file.write('\n')
+            header_file.write('#include "bn_regular_bg_streamed_item.h"' + '\n')
+            header_file.write('\n')
+            header_file.write('alignas(4) inline constexpr bn::tile ' + name + '_bn_gfxTiles[' + str(tiles_count) +
+                              '] =' + '\n')
+            header_file.write('{' + '\n')
+
+            for index in range(0, len(tiles_words), 8):
+                header_file.write('    ' + ', '.join('0x{:08X}'.format(word) for word in tiles_words[index:index + 8]) +
+                                  ',' + '\n')
+
+            header_file.write('};' + '\n')
+            header_file.write('\n')
+            header_file.write('alignas(4) inline constexpr bn::color ' + name + '_bn_gfxPal[' + str(len(colors)) +
+                              '] =' + '\n')
+            header_file.write('{' + '\n')
+
+            for index in range(0, len(colors), 4):
+                header_file.write('    ' + ', '.join('bn::color(0x{:04X})'.format(color)
+                                                     for color in colors[index:index + 4]) + ',' + '\n')
+
+            header_file.write('};' + '\n')
+            header_file.write('\n')
+            header_file.write('alignas(4) inline constexpr bn::regular_bg_map_cell ' + name + '_bn_gfxMap[' +
+                              str(len(cells)) + '] =' + '\n')
+            header_file.write('{' + '\n')
+
+            for index in range(0, len(cells), 8):
+                header_file.write('    ' + ', '.join('0x{:04X}'.format(cell) for cell in cells[index:index + 8]) +
+                                  ',' + '\n')
+
+            header_file.write('};' + '\n')
+            header_file.write('\n')
+            header_file.write('alignas(4) inline constexpr uint16_t ' + name + '_bn_gfxTileIndexes[' +
+                              str(len(tile_indexes)) + '] =' + '\n')
+            header_file.write('{' + '\n')
+
+            for index in range(0, len(tile_indexes), 8):
+                header_file.write('    ' + ', '.join(str(tile_index)
+                                                     for tile_index in tile_indexes[index:index + 8]) + ',' + '\n')
+
+            header_file.write('};' + '\n')
+            header_file.write('\n')
+            header_file.write('namespace bn::regular_bg_streamed_items' + '\n')
+            header_file.write('{' + '\n')
+            header_file.write('    constexpr inline regular_bg_streamed_item ' + name + '(' + '\n            ' +
+                              'span<const tile>(' + name + '_bn_gfxTiles, ' + str(tiles_count) + '),' +
+                              '\n            ' +
+                              'bg_palette_item(span<const color>(' + name + '_bn_gfxPal, ' + str(len(colors)) +
+                              '), ' + bpp_mode_label + ', compression_type::NONE),' + '\n            ' +
+                              'regular_bg_map_item(' + name + '_bn_gfxMap[0], ' +
+                              'size(' + str(self.__width) + ', ' + str(self.__height) + '), ' +
+                              'compression_type::NONE, 1, true),' + '\n            ' +
+                              'span<const uint16_t>(' + name + '_bn_gfxTileIndexes));' + '\n')
+            header_file.write('}' + '\n')
+            header_file.write('\n')
+            header_file.write('#endif' + '\n')
+            header_file.write('\n')
+
+        return total_size, header_file_path
+
+
 class AffineBgItem:
 
     def __init__(self, file_path, file_name_no_ext, build_folder_path, info):
@@ -1195,6 +1436,13 @@ class AffineBgItem:
             except KeyError:
                 self.__map_compression = 'none'
 
+        if self.__big and self.__map_compression != 'none' and not self.__map_compression.startswith('auto'):
+            if self.__map_compression == 'huffman':
+                raise ValueError('Huffman compression not supported by big maps')
+
+            if self.__maps > 1:
+                raise ValueError('Compressed big maps with more than one map not supported: ' + str(self.__maps))
+
     def process(self, grit):
         tiles_compression = self.__tiles_compression
         palette_compression = self.__palette_compression
@@ -1224,13 +1472,18 @@ class AffineBgItem:
                                                                                  file_size)
 
         if map_compression.startswith('auto'):
-            test_huffman = map_compression == 'auto'
-            map_compression, file_size = self.__test_map_compression(grit, map_compression, 'none', None)
-            map_compression, file_size = self.__test_map_compression(grit, map_compression, 'run_length', file_size)
-            map_compression, file_size = self.__test_map_compression(grit, map_compression, 'lz77', file_size)
+            if self.__big and self.__maps > 1:
+                map_compression = 'none'
+            else:
+                test_huffman = map_compression == 'auto' and not self.__big
+                map_compression, file_size = self.__test_map_compression(grit, map_compression, 'none', None)
+                map_compression, file_size = self.__test_map_compression(grit, map_compression, 'run_length',
+                                                                         file_size)
+                map_compression, file_size = self.__test_map_compression(grit, map_compression, 'lz77', file_size)
 
-            if test_huffman:
-                map_compression, file_size = self.__test_map_compression(grit, map_compression, 'huffman', file_size)
+                if test_huffman:
+                    map_compression, file_size = self.__test_map_compression(grit, map_compression, 'huffman',
+                                                                             file_size)
 
         self.__execute_command(grit, tiles_compression, palette_compression, map_compression)
         return self.__write_header(tiles_compression, palette_compression, map_compression, False)
@@ -1269,6 +1522,12 @@ class AffineBgItem:
 
         with open(grit_file_path, 'r') as grit_file:
             grit_data = grit_file.read()
+            map_size_delta = 0
+
+            if self.__big and map_compression != 'none':
+                grit_data, map_size_delta = build_chunked_map(grit_data, name + '_bn_gfxMap', self.__width,
+                                                              self.__height, 1, map_compression)
+
             grit_data = grit_data.replace('unsigned int', 'bn::tile', 1)
             grit_data = grit_data.replace('unsigned char', 'bn::affine_bg_map_cell', 1)
 
@@ -1288,7 +1547,7 @@ class AffineBgItem:
                         raise ValueError('Affine BGs with more than 256 tiles not supported: ' + str(tiles_count))
 
                 if 'Total size:' in grit_line:
-                    total_size = int(grit_line.split()[-1])
+                    total_size = int(grit_line.split()[-1]) + map_size_delta
 
                     if skip_write:
                         return total_size
@@ -1354,7 +1613,11 @@ class AffineBgItem:
 
         append_compression_command('g', tiles_compression, command)
         append_compression_command('p', palette_compression, command)
-        append_compression_command('m', map_compression, command)
+
+        # Big maps are split in chunks compressed independently after calling grit:
+        if not self.__big:
+            append_compression_command('m', map_compression, command)
+
         command.append('-o' + self.__build_folder_path + '/' + self.__file_name_no_ext + '_bn_gfx')
         command = ' '.join(command)
 
@@ -1636,6 +1899,267 @@ class BgPaletteItem:
             raise ValueError(grit + ' call failed (return code ' + str(e.returncode) + '): ' + str(e.output))
 
 
+class HbeTablesItem:
+
+    @staticmethod
+    def screen_height():
+        return 160
+
+    def __init__(self, file_name_no_ext, build_folder_path, info):
+        self.__file_name_no_ext = file_name_no_ext
+        self.__build_folder_path = build_folder_path
+
+        try:
+            self.__value_type = str(info['value_type'])
+        except KeyError:
+            self.__value_type = 'fixed'
+
+        if self.__value_type not in ['fixed', 'int', 'int16']:
+            raise ValueError('Invalid value type: ' + self.__value_type)
+
+        try:
+            fractional_bits = int(info['fractional_bits'])
+        except KeyError:
+            fractional_bits = 0
+
+        if fractional_bits < 0 or fractional_bits > 16:
+            raise ValueError('Invalid fractional bits: ' + str(fractional_bits))
+
+        if self.__value_type == 'fixed':
+            if fractional_bits != 0:
+                raise ValueError('Fractional bits field is only valid for int and int16 value types')
+
+            self.__multiplier = 4096
+        else:
+            self.__multiplier = 1 << fractional_bits
+
+        try:
+            effect = str(info['effect'])
+        except KeyError:
+            raise ValueError('effect field not found in graphics json file: ' + file_name_no_ext + '.json')
+
+        if effect == 'values':
+            tables = HbeTablesItem.__parse_values(info)
+        else:
+            try:
+                frames = int(info['frames'])
+            except KeyError:
+                frames = 1
+
+            if frames < 1 or frames > 1024:
+                raise ValueError('Invalid frames: ' + str(frames))
+
+            if effect == 'wave':
+                tables = HbeTablesItem.__generate_wave(info, frames)
+            elif effect == 'parallax':
+                tables = HbeTablesItem.__generate_parallax(info, frames)
+            elif effect == 'perspective':
+                tables = HbeTablesItem.__generate_perspective(info, frames)
+            else:
+                raise ValueError('Unknown effect: ' + effect)
+
+        self.__tables = tables
+
+    def process(self, grit):
+        name = self.__file_name_no_ext
+        header_file_path = self.__build_folder_path + '/bn_hbe_tables_items_' + name + '.h'
+        value_type = self.__value_type
+        multiplier = self.__multiplier
+        raw_values = []
+
+        for table in self.__tables:
+            for value in table:
+                raw_values.append(int(round(value * multiplier)))
+
+        if value_type == 'int16':
+            cpp_type = 'int16_t'
+            value_size = 2
+            min_value = -32768
+            max_value = 32767
+        else:
+            cpp_type = 'int' if value_type == 'int' else 'bn::fixed'
+            value_size = 4
+            min_value = -2147483648
+            max_value = 2147483647
+
+        for raw_value in raw_values:
+            if raw_value < min_value or raw_value > max_value:
+                raise ValueError('Value out of range: ' + str(raw_value / multiplier))
+
+        tables_count = len(self.__tables)
+        values_count = len(raw_values)
+        values_name = name + '_bn_hbe_values'
+
+        with open(header_file_path, 'w') as header_file:
+            include_guard = 'BN_HBE_TABLES_ITEMS_' + name.upper() + '_H'
+            header_file.write('#ifndef ' + include_guard + '\n')
+            header_file.write('#define ' + include_guard + '\n')
+            header_file.write('\n')
+            header_file.write('#include "bn_hbe_tables_item.h"' + '\n')
+
+            if value_type == 'fixed':
+                header_file.write('#include "bn_fixed.h"' + '\n')
+
+            header_file.write('\n')
+            header_file.write('alignas(4) inline constexpr ' + cpp_type + ' ' + values_name + '[' +
+                              str(values_count) + '] =' + '\n')
+            header_file.write('{' + '\n')
+
+            values_per_line = 4 if value_type == 'fixed' else 8
+
+            for index in range(0, values_count, values_per_line):
+                line_values = raw_values[index:index + values_per_line]
+
+                if value_type == 'fixed':
+                    line_values = ['bn::fixed::from_data(' + str(line_value) + ')' for line_value in line_values]
+                else:
+                    line_values = [str(line_value) for line_value in line_values]
+
+                header_file.write('    ' + ', '.join(line_values) + ',' + '\n')
+
+            header_file.write('};' + '\n')
+            header_file.write('\n')
+            header_file.write('namespace bn::hbe_tables_items' + '\n')
+            header_file.write('{' + '\n')
+            header_file.write('    constexpr inline hbe_tables_item<' + cpp_type.replace('bn::', '') + '> ' + name +
+                              '(span<const ' + cpp_type.replace('bn::', '') + '>(' + values_name + '), ' +
+                              str(tables_count) + ');' + '\n')
+            header_file.write('}' + '\n')
+            header_file.write('\n')
+            header_file.write('#endif' + '\n')
+            header_file.write('\n')
+
+        return values_count * value_size, header_file_path
+
+    @staticmethod
+    def __parse_values(info):
+        try:
+            tables = info['values']
+        except KeyError:
+            raise ValueError('values field not found')
+
+        if len(tables) == 0:
+            raise ValueError('Empty values')
+
+        screen_height = HbeTablesItem.screen_height()
+
+        for table in tables:
+            if len(table) != screen_height:
+                raise ValueError('Invalid values count in table: ' + str(len(table)) + ' (' + str(screen_height) +
+                                 ' expected)')
+
+        return [[float(value) for value in table] for table in tables]
+
+    @staticmethod
+    def __generate_wave(info, frames):
+        try:
+            amplitude = float(info['amplitude'])
+        except KeyError:
+            raise ValueError('amplitude field not found')
+
+        try:
+            period = float(info['period'])
+        except KeyError:
+            period = HbeTablesItem.screen_height()
+
+        if period <= 0:
+            raise ValueError('Invalid period: ' + str(period))
+
+        tables = []
+
+        for frame in range(frames):
+            table = []
+
+            for line in range(HbeTablesItem.screen_height()):
+                table.append(amplitude * math.sin(2 * math.pi * ((line / period) + (frame / frames))))
+
+            tables.append(table)
+
+        return tables
+
+    @staticmethod
+    def __generate_parallax(info, frames):
+        try:
+            bands = info['bands']
+        except KeyError:
+            raise ValueError('bands field not found')
+
+        screen_height = HbeTablesItem.screen_height()
+        band_lines = []
+        lines_count = 0
+
+        for band in bands:
+            try:
+                lines = int(band['lines'])
+            except KeyError:
+                raise ValueError('lines field not found in parallax band')
+
+            if lines < 1:
+                raise ValueError('Invalid parallax band lines: ' + str(lines))
+
+            try:
+                value = float(band['value'])
+            except KeyError:
+                value = 0
+
+            try:
+                speed = float(band['speed'])
+            except KeyError:
+                speed = 0
+
+            band_lines.append([lines, value, speed])
+            lines_count += lines
+
+        if lines_count != screen_height:
+            raise ValueError('Invalid parallax bands lines count: ' + str(lines_count) + ' (' + str(screen_height) +
+                             ' expected)')
+
+        tables = []
+
+        for frame in range(frames):
+            table = []
+
+            for lines, value, speed in band_lines:
+                table += [value + (speed * frame)] * lines
+
+            tables.append(table)
+
+        return tables
+
+    @staticmethod
+    def __generate_perspective(info, frames):
+        if frames != 1:
+            raise ValueError('Perspective effect can\'t be animated')
+
+        try:
+            horizon = int(info['horizon'])
+        except KeyError:
+            raise ValueError('horizon field not found')
+
+        if horizon < 0 or horizon >= HbeTablesItem.screen_height():
+            raise ValueError('Invalid horizon: ' + str(horizon))
+
+        try:
+            scale = float(info['scale'])
+        except KeyError:
+            raise ValueError('scale field not found')
+
+        try:
+            sky_value = float(info['sky_value'])
+        except KeyError:
+            sky_value = 0
+
+        table = []
+
+        for line in range(HbeTablesItem.screen_height()):
+            if line > horizon:
+                table.append(scale / (line - horizon))
+            else:
+                table.append(sky_value)
+
+        return [table]
+
+
 class GraphicsFileInfo:
 
     def __init__(self, json_file_path, file_path, file_name, file_name_no_ext, file_info_path):
@@ -1644,61 +2168,206 @@ class GraphicsFileInfo:
         self.__file_name = file_name
         self.__file_name_no_ext = file_name_no_ext
         self.__file_info_path = file_info_path
+        self.__key = None
 
     def print_file_name(self):
         print(self.__file_name)
 
-    def process(self, grit, build_folder_path):
+    def build_key(self, assets_cache):
+        if self.__file_path == self.__json_file_path:
+            file_paths = [self.__json_file_path]
+        else:
+            file_paths = [self.__file_path, self.__json_file_path]
+
+        return assets_cache.build_key('graphics:' + self.__file_name_no_ext, file_paths)
+
+    def set_key(self, key):
+        self.__key = key
+
+    def up_to_date(self):
+        return AssetsCache.read_key(self.__file_info_path) == self.__key
+
+    def touch_file_info(self):
+        os.utime(self.__file_info_path)
+
+    def process(self, grit, build_folder_path, assets_cache):
         try:
-            try:
-                with open(self.__json_file_path) as json_file:
-                    info = json.load(json_file)
-            except Exception as exception:
-                raise ValueError(self.__json_file_path + ' graphics json file parse failed: ' + str(exception))
+            cache_entry = assets_cache.restore(self.__key, build_folder_path)
 
-            try:
-                graphics_type = str(info['type'])
-            except KeyError:
-                raise ValueError('type field not found in graphics json file: ' + self.__json_file_path)
-
-            if graphics_type == 'sprite':
-                item = SpriteItem(self.__file_path, self.__file_name_no_ext, build_folder_path, info)
-            elif graphics_type == 'sprite_tiles':
-                item = SpriteTilesItem(self.__file_path, self.__file_name_no_ext, build_folder_path, info)
-            elif graphics_type == 'sprite_palette':
-                item = SpritePaletteItem(self.__file_path, self.__file_name_no_ext, build_folder_path, info)
-            elif graphics_type == 'regular_bg':
-                item = RegularBgItem(self.__file_path, self.__file_name_no_ext, build_folder_path, info)
-            elif graphics_type == 'regular_bg_tiles':
-                item = RegularBgTilesItem(self.__file_path, self.__file_name_no_ext, build_folder_path, info)
-            elif graphics_type == 'affine_bg':
-                item = AffineBgItem(self.__file_path, self.__file_name_no_ext, build_folder_path, info)
-            elif graphics_type == 'affine_bg_tiles':
-                item = AffineBgTilesItem(self.__file_path, self.__file_name_no_ext, build_folder_path, info)
-            elif graphics_type == 'bg_palette':
-                item = BgPaletteItem(self.__file_path, self.__file_name_no_ext, build_folder_path, info)
+            if cache_entry is not None:
+                header_file_path = build_folder_path + '/' + cache_entry['header']
+                total_size = cache_entry['size']
+                cache_hit = True
             else:
-                raise ValueError('Unknown graphics type "' + graphics_type +
-                                 '" found in graphics json file: ' + self.__json_file_path)
+                total_size, header_file_path = self.__process_item(grit, build_folder_path)
+                output_file_paths = [header_file_path]
+                asm_file_path = build_folder_path + '/' + self.__file_name_no_ext + '_bn_gfx.s'
 
-            total_size, header_file_path = item.process(grit)
+                if os.path.isfile(asm_file_path):
+                    output_file_paths.append(asm_file_path)
 
-            with open(self.__file_info_path, 'w') as file_info:
-                file_info.write('')
+                assets_cache.store(self.__key, output_file_paths,
+                                   {'header': os.path.basename(header_file_path), 'size': total_size})
+                cache_hit = False
 
-            return [self.__file_name, header_file_path, total_size]
+            AssetsCache.write_key(self.__file_info_path, self.__key)
+            return [self.__file_name, header_file_path, total_size, cache_hit]
         except Exception as exc:
             return [self.__file_name, exc]
 
+    def __process_item(self, grit, build_folder_path):
+        try:
+            with open(self.__json_file_path) as json_file:
+                info = json.load(json_file)
+        except Exception as exception:
+            raise ValueError(self.__json_file_path + ' graphics json file parse failed: ' + str(exception))
+
+        try:
+            graphics_type = str(info['type'])
+        except KeyError:
+            raise ValueError('type field not found in graphics json file: ' + self.__json_file_path)
+
+        if self.__file_path == self.__json_file_path:
+            if graphics_type != 'hbe_tables':
+                raise ValueError('Graphics file not found for graphics json file: ' + self.__json_file_path)
+
+            item = HbeTablesItem(self.__file_name_no_ext, build_folder_path, info)
+        elif graphics_type == 'sprite':
+            item = SpriteItem(self.__file_path, self.__file_name_no_ext, build_folder_path, info)
+        elif graphics_type == 'sprite_tiles':
+            item = SpriteTilesItem(self.__file_path, self.__file_name_no_ext, build_folder_path, info)
+        elif graphics_type == 'sprite_palette':
+            item = SpritePaletteItem(self.__file_path, self.__file_name_no_ext, build_folder_path, info)
+        elif graphics_type == 'regular_bg':
+            item = RegularBgItem(self.__file_path, self.__file_name_no_ext, build_folder_path, info)
+        elif graphics_type == 'regular_bg_streamed':
+            item = RegularBgStreamedItem(self.__file_path, self.__file_name_no_ext, build_folder_path, info)
+        elif graphics_type == 'regular_bg_tiles':
+            item = RegularBgTilesItem(self.__file_path, self.__file_name_no_ext, build_folder_path, info)
+        elif graphics_type == 'affine_bg':
+            item = AffineBgItem(self.__file_path, self.__file_name_no_ext, build_folder_path, info)
+        elif graphics_type == 'affine_bg_tiles':
+            item = AffineBgTilesItem(self.__file_path, self.__file_name_no_ext, build_folder_path, info)
+        elif graphics_type == 'bg_palette':
+            item = BgPaletteItem(self.__file_path, self.__file_name_no_ext, build_folder_path, info)
+        elif graphics_type == 'hbe_tables':
+            item = HbeTablesItem(self.__file_name_no_ext, build_folder_path, info)
+        else:
+            raise ValueError('Unknown graphics type "' + graphics_type +
+                             '" found in graphics json file: ' + self.__json_file_path)
+
+        return item.process(grit)
+
+
+class TilesBankInfo:
+
+    def __init__(self, name, build_folder_path):
+        self.__name = name
+        self.__items = []
+        self.__file_info_path = build_folder_path + '/_bn_' + name + '_tiles_bank_file_info.txt'
+        self.__key = None
+
+    def add_item(self, json_file_path, file_path, file_name_no_ext):
+        self.__items.append([json_file_path, file_path, file_name_no_ext])
+
+    def print_file_name(self):
+        print(self.__name + ' (tiles bank)')
+
+    def build_key(self, assets_cache):
+        file_paths = []
+
+        for json_file_path, file_path, file_name_no_ext in sorted(self.__items, key=lambda item: item[2]):
+            file_paths.append(file_path)
+            file_paths.append(json_file_path)
+
+        return assets_cache.build_key('tiles_bank:' + self.__name, file_paths)
+
+    def set_key(self, key):
+        self.__key = key
+
+    def up_to_date(self):
+        return AssetsCache.read_key(self.__file_info_path) == self.__key
+
+    def touch_file_info(self):
+        os.utime(self.__file_info_path)
+
+    def process(self, grit, build_folder_path, assets_cache):
+        try:
+            cache_entry = assets_cache.restore(self.__key, build_folder_path)
+
+            if cache_entry is not None:
+                header_file_paths = [build_folder_path + '/' + header for header in cache_entry['headers']]
+                total_size = cache_entry['size']
+                cache_hit = True
+            else:
+                items = []
+
+                for json_file_path, file_path, file_name_no_ext in self.__items:
+                    try:
+                        with open(json_file_path) as json_file:
+                            info = json.load(json_file)
+                    except Exception as exception:
+                        raise ValueError(json_file_path + ' graphics json file parse failed: ' + str(exception))
+
+                    for compression_tag in ['compression', 'tiles_compression', 'map_compression']:
+                        if compression_tag in info:
+                            validate_compression(info[compression_tag])
+
+                    items.append(TilesBankItem(file_path, file_name_no_ext, info))
+
+                tiles_bank = TilesBank(self.__name, items)
+                bank_header_file_path, item_results, total_size = tiles_bank.process(build_folder_path)
+                header_file_paths = [bank_header_file_path] + [item_result[1] for item_result in item_results]
+                assets_cache.store(self.__key, header_file_paths,
+                                   {'headers': [os.path.basename(path) for path in header_file_paths],
+                                    'size': total_size})
+                cache_hit = False
+
+            AssetsCache.write_key(self.__file_info_path, self.__key)
+            return [self.__name + ' tiles bank', ', '.join(header_file_paths), total_size, cache_hit]
+        except Exception as exc:
+            return [self.__name + ' tiles bank', exc]
+
+
+class GraphicsFileInfoKeyBuilder:
+
+    def __init__(self, assets_cache):
+        self.__assets_cache = assets_cache
+
+    def __call__(self, graphics_file_info):
+        return graphics_file_info.build_key(self.__assets_cache)
+
 
 class GraphicsFileInfoProcessor:
 
-    def __init__(self, grit, build_folder_path):
+    def __init__(self, grit, build_folder_path, assets_cache):
         self.__grit = grit
         self.__build_folder_path = build_folder_path
+        self.__assets_cache = assets_cache
 
     def __call__(self, graphics_file_info):
-        return graphics_file_info.process(self.__grit, self.__build_folder_path)
+        return graphics_file_info.process(self.__grit, self.__build_folder_path, self.__assets_cache)
+
+
+def read_tiles_bank(json_file_path):
+    try:
+        with open(json_file_path) as json_file:
+            info = json.load(json_file)
+    except Exception as exception:
+        raise ValueError(json_file_path + ' graphics json file parse failed: ' + str(exception))
+
+    try:
+        tiles_bank = str(info['tiles_bank'])
+    except KeyError:
+        return None
+
+    if info.get('type') != 'regular_bg':
+        raise ValueError('Tiles banks are only supported by regular BGs: ' + json_file_path)
+
+    if not FileInfo.validate(tiles_bank + '.json'):
+        raise ValueError('Invalid tiles bank name: ' + tiles_bank)
+
+    return tiles_bank
 
 
 def list_graphics_file_infos(graphics_paths, build_folder_path):
@@ -1717,6 +2386,7 @@ def list_graphics_file_infos(graphics_paths, build_folder_path):
             graphics_file_paths.append(graphics_path)
 
     graphics_file_infos = []
+    tiles_bank_infos = {}
     file_names_set = set()
 
     for graphics_file_path in graphics_file_paths:
@@ -1725,10 +2395,9 @@ def list_graphics_file_infos(graphics_paths, build_folder_path):
         if FileInfo.validate(graphics_file_name):
             graphics_file_name_split = os.path.splitext(graphics_file_name)
             graphics_file_name_ext = graphics_file_name_split[1]
+            graphics_file_name_no_ext = graphics_file_name_split[0]
 
             if graphics_file_name_ext == '.bmp':
-                graphics_file_name_no_ext = graphics_file_name_split[0]
-
                 if graphics_file_name_no_ext in file_names_set:
                     raise ValueError('There\'s two or more graphics files with the same name: ' +
                                      graphics_file_name_no_ext)
@@ -1739,6 +2408,19 @@ def list_graphics_file_infos(graphics_paths, build_folder_path):
                 if not os.path.isfile(json_file_path):
                     raise ValueError('Graphics json file not found: ' + json_file_path)
 
+                # Items of the same tiles bank are processed together, so they are not listed here:
+                tiles_bank = read_tiles_bank(json_file_path)
+
+                if tiles_bank is not None:
+                    tiles_bank_info = tiles_bank_infos.get(tiles_bank)
+
+                    if tiles_bank_info is None:
+                        tiles_bank_info = TilesBankInfo(tiles_bank, build_folder_path)
+                        tiles_bank_infos[tiles_bank] = tiles_bank_info
+
+                    tiles_bank_info.add_item(json_file_path, graphics_file_path, graphics_file_name_no_ext)
+                    continue
+
                 file_info_path = build_folder_path + '/_bn_' + graphics_file_name_no_ext + '_graphics_file_info.txt'
 
                 if not os.path.exists(file_info_path):
@@ -1757,12 +2439,58 @@ def list_graphics_file_infos(graphics_paths, build_folder_path):
                     graphics_file_infos.append(GraphicsFileInfo(
                         json_file_path, graphics_file_path, graphics_file_name, graphics_file_name_no_ext,
                         file_info_path))
+            elif graphics_file_name_ext == '.json':
+                bmp_file_path = graphics_file_path[:-len(graphics_file_name_ext)] + '.bmp'
+
+                if not os.path.isfile(bmp_file_path):
+                    # Graphics json files without graphics file (like H-Blank effect tables):
+                    if graphics_file_name_no_ext in file_names_set:
+                        raise ValueError('There\'s two or more graphics files with the same name: ' +
+                                         graphics_file_name_no_ext)
+
+                    file_names_set.add(graphics_file_name_no_ext)
+                    file_info_path = build_folder_path + '/_bn_' + graphics_file_name_no_ext + \
+                        '_graphics_file_info.txt'
+
+                    if not os.path.exists(file_info_path):
+                        build = True
+                    else:
+                        build = os.path.getmtime(file_info_path) < os.path.getmtime(graphics_file_path)
+
+                    if build:
+                        graphics_file_infos.append(GraphicsFileInfo(
+                            graphics_file_path, graphics_file_path, graphics_file_name, graphics_file_name_no_ext,
+                            file_info_path))
+
+    for tiles_bank in tiles_bank_infos:
+        if tiles_bank in file_names_set:
+            raise ValueError('There\'s a graphics file with the same name as a tiles bank: ' + tiles_bank)
 
-    return graphics_file_infos
+    return graphics_file_infos, list(tiles_bank_infos.values())
 
 
-def process_graphics(grit, graphics_paths, build_folder_path):
-    graphics_file_infos = list_graphics_file_infos(graphics_paths, build_folder_path)
+def process_graphics(grit, graphics_paths, build_folder_path, pool, assets_cache):
+    cache_stats = AssetsCacheStats()
+    graphics_file_infos, tiles_bank_infos = list_graphics_file_infos(graphics_paths, build_folder_path)
+
+    # Tiles banks are always checked, since they are rebuilt when any of their items changes:
+    graphics_file_infos += tiles_bank_infos
+
+    if len(graphics_file_infos) > 0:
+        # Graphics files with a modification time newer than their build info are rebuilt
+        # only if their content has changed:
+        keys = pool.map(GraphicsFileInfoKeyBuilder(assets_cache), graphics_file_infos)
+        outdated_graphics_file_infos = []
+
+        for graphics_file_info, key in zip(graphics_file_infos, keys):
+            graphics_file_info.set_key(key)
+
+            if graphics_file_info.up_to_date():
+                graphics_file_info.touch_file_info()
+            else:
+                outdated_graphics_file_infos.append(graphics_file_info)
+
+        graphics_file_infos = outdated_graphics_file_infos
 
     if len(graphics_file_infos) > 0:
         for graphics_file_info in graphics_file_infos:
@@ -1770,19 +2498,24 @@ def process_graphics(grit, graphics_paths, build_folder_path):
 
         sys.stdout.flush()
 
-        pool = create_pool()
-        process_results = pool.map(GraphicsFileInfoProcessor(grit, build_folder_path), graphics_file_infos)
-        pool.close()
-
+        process_results = pool.map(GraphicsFileInfoProcessor(grit, build_folder_path, assets_cache),
+                                   graphics_file_infos)
         total_size = 0
         process_excs = []
 
         for process_result in process_results:
-            if len(process_result) == 3:
+            if len(process_result) == 4:
                 file_size = process_result[2]
+                cache_hit = process_result[3]
                 total_size += file_size
-                print('    ' + str(process_result[0]) + ' item header written in ' + str(process_result[1]) +
-                      ' (graphics size: ' + str(file_size) + ' bytes)')
+                cache_stats.add(cache_hit)
+                result = '    ' + str(process_result[0]) + ' item header written in ' + str(process_result[1]) + \
+                         ' (graphics size: ' + str(file_size) + ' bytes)'
+
+                if cache_hit:
+                    result += ' (cached)'
+
+                print(result)
             else:
                 process_excs.append(process_result)
 
@@ -1795,3 +2528,5 @@ def process_graphics(grit, graphics_paths, build_folder_path):
             exit(-1)
 
         print('    ' + 'Processed graphics size: ' + str(total_size) + ' bytes')
+
+    return cache_stats
@@ -0,0 +1,271 @@
+"""
+Copyright (c) 2020-2025 Gustavo Valiente gustavo.valiente@protonmail.com
+zlib License, see LICENSE file.
+"""
+
+import os
+import sys
+import json
+import math
+import argparse
+import traceback
+
+from file_info import FileInfo
+
+
+max_colors = 10
+shading_levels = 8
+
+
+def format_number(value):
+    result = ('%.4f' % value).rstrip('0').rstrip('.')
+
+    if result == '-0':
+        result = '0'
+
+    return result
+
+
+def format_vertex(vertex):
+    return 'vertex_3d(' + ', '.join(format_number(coordinate) for coordinate in vertex) + ')'
+
+
+class ModelFileInfo:
+
+    def __init__(self, obj_file_path, json_file_path, file_name_no_ext, file_info_path):
+        self.__obj_file_path = obj_file_path
+        self.__json_file_path = json_file_path
+        self.__file_name_no_ext = file_name_no_ext
+        self.__file_info_path = file_info_path
+
+    def print_file_name(self):
+        print(os.path.basename(self.__obj_file_path))
+
+    def process(self, include_folder_path):
+        materials = self.__read_materials()
+        vertices = []
+        faces = []
+        material = None
+        used_materials = []
+
+        with open(self.__obj_file_path) as obj_file:
+            for line_index, line in enumerate(obj_file):
+                tokens = line.split()
+
+                if len(tokens) == 0:
+                    continue
+
+                if tokens[0] == 'v':
+                    vertices.append([round(float(token), 2) for token in tokens[1:4]])
+                elif tokens[0] == 'usemtl':
+                    material = tokens[1] if len(tokens) > 1 else None
+
+                    if material not in used_materials:
+                        used_materials.append(material)
+                elif tokens[0] == 'f':
+                    indexes = []
+
+                    for token in tokens[1:]:
+                        index = int(token.split('/')[0])
+                        indexes.append(index - 1 if index > 0 else len(vertices) + index)
+
+                    if len(indexes) < 3:
+                        raise ValueError('Invalid face at line ' + str(line_index + 1) + ': ' + line.strip())
+
+                    if len(indexes) <= 4:
+                        faces.append([indexes, material])
+                    else:
+                        for fan_index in range(1, len(indexes) - 1):
+                            faces.append([[indexes[0], indexes[fan_index], indexes[fan_index + 1]], material])
+
+        if len(vertices) == 0:
+            raise ValueError('There\'s no vertices')
+
+        if len(faces) == 0:
+            raise ValueError('There\'s no faces')
+
+        name = self.__file_name_no_ext
+        vertices_name = name + '_vertices'
+        faces_lines = []
+
+        for face_indexes, face_material in faces:
+            for face_index in face_indexes:
+                if face_index < 0 or face_index >= len(vertices):
+                    raise ValueError('Invalid vertex index: ' + str(face_index + 1))
+
+            color_index, shading = self.__material_info(materials, used_materials, face_material)
+            normal = self.__normal(vertices, face_indexes)
+            shading_literal = 'face_3d::directional_shading' if shading < 0 else str(shading)
+            faces_lines.append('face_3d(' + vertices_name + ', ' + format_vertex(normal) + ', ' +
+                               ', '.join(str(face_index) for face_index in face_indexes) + ', ' +
+                               str(color_index) + ', ' + shading_literal + ')')
+
+        header_file_path = include_folder_path + '/bn_model_3d_items_' + name + '.h'
+
+        with open(header_file_path, 'w') as header_file:
+            include_guard = 'BN_MODEL_3D_ITEMS_' + name.upper() + '_H'
+            header_file.write('#ifndef ' + include_guard + '\n')
+            header_file.write('#define ' + include_guard + '\n')
+            header_file.write('\n')
+            header_file.write('#include "bn_model_3d_item.h"' + '\n')
+            header_file.write('\n')
+            header_file.write('namespace bn::model_3d_items' + '\n')
+            header_file.write('{' + '\n')
+            header_file.write('    constexpr inline vertex_3d ' + vertices_name + '[] = {' + '\n')
+
+            for vertex in vertices:
+                header_file.write('        ' + format_vertex(vertex) + ',' + '\n')
+
+            header_file.write('    };' + '\n')
+            header_file.write('\n')
+            header_file.write('    constexpr inline face_3d ' + name + '_faces[] = {' + '\n')
+
+            for face_line in faces_lines:
+                header_file.write('        ' + face_line + ',' + '\n')
+
+            header_file.write('    };' + '\n')
+            header_file.write('\n')
+            header_file.write('    constexpr inline model_3d_item ' + name + '(' + vertices_name + ', ' + name +
+                              '_faces);' + '\n')
+            header_file.write('}' + '\n')
+            header_file.write('\n')
+            header_file.write('#endif' + '\n')
+            header_file.write('\n')
+
+        file_paths = [self.__obj_file_path]
+
+        if self.__json_file_path is not None:
+            file_paths.append(self.__json_file_path)
+
+        FileInfo.build_from_files(file_paths).write(self.__file_info_path)
+        return [len(vertices), len(faces)]
+
+    def __read_materials(self):
+        if self.__json_file_path is None:
+            return {}
+
+        try:
+            with open(self.__json_file_path) as json_file:
+                info = json.load(json_file)
+        except Exception as exception:
+            raise ValueError(self.__json_file_path + ' model json file parse failed: ' + str(exception))
+
+        try:
+            return info['materials']
+        except KeyError:
+            return {}
+
+    @staticmethod
+    def __material_info(materials, used_materials, material):
+        color_index = used_materials.index(material) if material in used_materials else 0
+        shading = -1
+
+        if material in materials:
+            material_info = materials[material]
+
+            try:
+                color_index = int(material_info['color'])
+            except KeyError:
+                pass
+
+            try:
+                shading = int(material_info['shading'])
+            except KeyError:
+                pass
+
+        if color_index < 0 or color_index >= max_colors:
+            raise ValueError('Invalid color index: ' + str(color_index) + ' (material: ' + str(material) + ')')
+
+        if shading < -1 or shading >= shading_levels:
+            raise ValueError('Invalid shading: ' + str(shading) + ' (material: ' + str(material) + ')')
+
+        return color_index, shading
+
+    @staticmethod
+    def __normal(vertices, face_indexes):
+        v0 = vertices[face_indexes[0]]
+        v1 = vertices[face_indexes[1]]
+        v2 = vertices[face_indexes[2]]
+        a = [v1[index] - v0[index] for index in range(3)]
+        b = [v2[index] - v0[index] for index in range(3)]
+        normal = [a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0]]
+        length = math.sqrt(sum(coordinate * coordinate for coordinate in normal))
+
+        if length == 0:
+            raise ValueError('Degenerate face: ' + ', '.join(str(face_index + 1) for face_index in face_indexes))
+
+        return [coordinate / length for coordinate in normal]
+
+
+def list_model_file_infos(models_paths, build_folder_path):
+    obj_file_paths = []
+
+    for models_path in models_paths.split(' '):
+        if os.path.isdir(models_path):
+            for models_file_name in sorted(os.listdir(models_path)):
+                obj_file_paths.append(models_path + '/' + models_file_name)
+        elif os.path.isfile(models_path):
+            obj_file_paths.append(models_path)
+
+    model_file_infos = []
+    file_names_set = set()
+
+    for obj_file_path in obj_file_paths:
+        obj_file_name = os.path.basename(obj_file_path)
+
+        if os.path.isfile(obj_file_path) and FileInfo.validate(obj_file_name):
+            obj_file_name_no_ext, obj_file_name_ext = os.path.splitext(obj_file_name)
+
+            if obj_file_name_ext == '.obj':
+                if obj_file_name_no_ext in file_names_set:
+                    raise ValueError('There\'s two or more models with the same name: ' + obj_file_name_no_ext)
+
+                file_names_set.add(obj_file_name_no_ext)
+                json_file_path = obj_file_path[:-len(obj_file_name_ext)] + '.json'
+                file_paths = [obj_file_path]
+
+                if os.path.isfile(json_file_path):
+                    file_paths.append(json_file_path)
+                else:
+                    json_file_path = None
+
+                file_info_path = build_folder_path + '/_bn_' + obj_file_name_no_ext + '_model_3d_file_info.txt'
+                old_file_info = FileInfo.read(file_info_path)
+                new_file_info = FileInfo.build_from_files(file_paths)
+
+                if old_file_info != new_file_info:
+                    model_file_infos.append(ModelFileInfo(obj_file_path, json_file_path, obj_file_name_no_ext,
+                                                          file_info_path))
+
+    return model_file_infos
+
+
+def process_models(models_paths, build_folder_path):
+    include_folder_path = build_folder_path + '/include'
+
+    if not os.path.exists(include_folder_path):
+        os.makedirs(include_folder_path)
+
+    for model_file_info in list_model_file_infos(models_paths, build_folder_path):
+        model_file_info.print_file_name()
+
+        try:
+            vertices_count, faces_count = model_file_info.process(include_folder_path)
+        except Exception as exception:
+            raise ValueError('Model processing failed: ' + str(exception))
+
+        print('    ' + str(vertices_count) + ' vertices, ' + str(faces_count) + ' faces')
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description='Butano 3D models tool.')
+    parser.add_argument('--models', required=True, help='models folder and file paths')
+    parser.add_argument('--build', required=True, help='build folder path')
+
+    try:
+        args = parser.parse_args()
+        process_models(args.models, args.build)
+    except Exception as ex:
+        sys.stderr.write('Error: ' + str(ex) + '\n')
+        traceback.print_exc()
+        exit(-1)
@@ -20,7 +20,7 @@ CPPWARNINGS	:=	-Wuseless-cast -Wnon-virtual-dtor -Woverloaded-virtual
 CXXFLAGS    :=	$(CFLAGS) $(CPPWARNINGS) -std=c++23 -fno-rtti -fno-exceptions -fno-threadsafe-statics \
 				-fuse-cxa-atexit $(USERCXXFLAGS)
 
-ASFLAGS     :=	-gdwarf-4 $(ARCH) $(USERASFLAGS)
+ASFLAGS     :=	-gdwarf-4 $(ARCH) $(filter -D%,$(USERFLAGS)) $(USERASFLAGS)
 
 ifndef DEFAULTLIBS
 	BN_NODEFAULT_LIBS	:=	-nodefaultlibs
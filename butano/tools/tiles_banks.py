@@ -0,0 +1,396 @@
+"""
+Copyright (c) 2020-2025 Gustavo Valiente gustavo.valiente@protonmail.com
+zlib License, see LICENSE file.
+"""
+
+import struct
+
+from bmp import BMP
+from bg_map_chunks import lz77_compress, run_length_compress
+
+max_tiles_count = 1024
+max_palettes_count = 16
+
+
+def compress_data(data, compression):
+    # Returns the compression with the smallest output and its compressed data:
+    if compression == 'none':
+        return compression, data
+
+    if compression == 'lz77':
+        return compression, lz77_compress(data)
+
+    if compression == 'run_length':
+        return compression, run_length_compress(data)
+
+    if compression == 'auto' or compression == 'auto_no_huffman':
+        best_compression, best_data = 'none', data
+
+        for new_compression in ['run_length', 'lz77']:
+            new_compression, new_data = compress_data(data, new_compression)
+
+            if len(new_data) < len(best_data):
+                best_compression, best_data = new_compression, new_data
+
+        return best_compression, best_data
+
+    raise ValueError('Compression not supported by tiles banks: ' + str(compression))
+
+
+def pad_data(data, alignment):
+    data = bytearray(data)
+
+    while len(data) % alignment != 0:
+        data.append(0)
+
+    return data
+
+
+def compression_label(compression):
+    return 'compression_type::' + compression.upper()
+
+
+class TilesBankItem:
+
+    def __init__(self, file_path, file_name_no_ext, info):
+        bmp = BMP(file_path)
+        self.file_name_no_ext = file_name_no_ext
+        self.width = bmp.width
+        self.__bmp = bmp
+
+        if bmp.width % 256 != 0:
+            raise ValueError('Regular BGs width must be divisible by 256: ' + str(bmp.width))
+
+        try:
+            self.height = int(info['height'])
+
+            if bmp.height % self.height:
+                raise ValueError('File height is not divisible by item height: ' +
+                                 str(bmp.height) + ' - ' + str(self.height))
+
+            self.maps = int(bmp.height / self.height)
+        except KeyError:
+            self.height = bmp.height
+            self.maps = 1
+
+        if self.height % 256 != 0:
+            raise ValueError('Regular BGs height must be divisible by 256: ' + str(self.height))
+
+        big_dimensions = self.width > 512 or self.height > 512
+        self.big = bool(info.get('big', big_dimensions))
+
+        if self.big:
+            if self.width == 256 and self.height == 256:
+                raise ValueError('Too small size for a big regular BG: ' + str(self.width) + ' - ' + str(self.height))
+
+            if self.width > 16384 or self.height > 16384:
+                raise ValueError('Too big size for a big regular BG: ' + str(self.width) + ' - ' + str(self.height))
+        elif big_dimensions:
+            raise ValueError('Too big size for a not big regular BG: ' + str(self.width) + ' - ' + str(self.height))
+
+        if 'bpp_mode' in info and str(info['bpp_mode']) != 'bpp_4':
+            raise ValueError('BPP mode not supported by tiles banks: ' + str(info['bpp_mode']))
+
+        if 'palette_item' in info:
+            raise ValueError('External palette items not supported by tiles banks')
+
+        try:
+            self.tiles_compression = info['tiles_compression']
+        except KeyError:
+            self.tiles_compression = info.get('compression', 'none')
+
+        try:
+            self.map_compression = info['map_compression']
+        except KeyError:
+            self.map_compression = info.get('compression', 'none')
+
+        if self.big and self.map_compression != 'none':
+            raise ValueError('Compressed big maps not supported by tiles banks')
+
+    def read_tiles(self):
+        # Returns the colors of each tile, from left to right and from top to bottom.
+        # Pixels with the first color index are transparent (None):
+        colors, pixels = self.__bmp.read_gba_colors_and_pixels()
+        tiles = []
+
+        for ty in range(0, len(pixels), 8):
+            for tx in range(0, self.width, 8):
+                tile = []
+
+                for y in range(ty, ty + 8):
+                    row = pixels[y]
+                    tile.append([colors[pixel] if pixel > 0 else None for pixel in row[tx:tx + 8]])
+
+                tiles.append((tx, ty, tile))
+
+        return colors[0], tiles
+
+
+class TilesBank:
+
+    def __init__(self, name, items):
+        self.name = name
+        self.items = sorted(items, key=lambda item: item.file_name_no_ext)
+        self.__tiles_compression = self.items[0].tiles_compression
+
+        for item in self.items:
+            if item.tiles_compression != self.__tiles_compression:
+                raise ValueError('All items of a tiles bank must have the same tiles compression: ' +
+                                 item.file_name_no_ext + ' - ' + str(item.tiles_compression) + ' - ' +
+                                 str(self.__tiles_compression))
+
+    def process(self, build_folder_path):
+        transparent_color = None
+        items_tiles = []
+
+        for item in self.items:
+            item_transparent_color, item_tiles = item.read_tiles()
+            items_tiles.append(item_tiles)
+
+            if transparent_color is None:
+                transparent_color = item_transparent_color
+
+        palettes = self.__pack_palettes(items_tiles)
+        palettes_data = bytearray()
+
+        for palette in palettes:
+            palette_colors = [transparent_color] + palette
+            palette_colors += [0] * (16 - len(palette_colors))
+            palettes_data.extend(struct.pack('<16H', *palette_colors))
+
+        # Tiles are deduplicated across all items, including flipped ones:
+        tiles_data = bytearray()
+        tile_indexes = {}
+        items_maps_data = []
+
+        for item, item_tiles in zip(self.items, items_tiles):
+            cells = []
+
+            for tx, ty, tile in item_tiles:
+                palette_index = self.__find_palette(palettes, tile)
+                palette = palettes[palette_index]
+                rows = [[palette.index(pixel) + 1 if pixel is not None else 0 for pixel in row] for row in tile]
+                cell = None
+
+                for flip_flags, flipped_rows in TilesBank.__flipped_tiles(rows):
+                    key = tuple(TilesBank.__row_word(row) for row in flipped_rows)
+                    tile_index = tile_indexes.get(key)
+
+                    if tile_index is not None:
+                        cell = tile_index | flip_flags
+                        break
+
+                if cell is None:
+                    tile_index = len(tile_indexes)
+
+                    if tile_index == max_tiles_count:
+                        raise ValueError('Tiles banks with more than ' + str(max_tiles_count) +
+                                         ' tiles not supported: ' + self.name)
+
+                    key = tuple(TilesBank.__row_word(row) for row in rows)
+                    tile_indexes[key] = tile_index
+                    tiles_data.extend(struct.pack('<8I', *key))
+                    cell = tile_index
+
+                cells.append(cell | (palette_index << 12))
+
+            items_maps_data.append(TilesBank.__map_data(item, cells))
+
+        tiles_count = len(tile_indexes)
+        tiles_compression, tiles_data = compress_data(tiles_data, self.__tiles_compression)
+        tiles_data = pad_data(tiles_data, 32)
+        total_size = len(tiles_data) + len(palettes_data)
+        bank_header_file_path = self.__write_bank_header(build_folder_path, tiles_data, tiles_count,
+                                                         tiles_compression, palettes_data)
+        results = []
+
+        for item, map_data in zip(self.items, items_maps_data):
+            map_compression, map_data = compress_data(map_data, item.map_compression)
+            map_data = pad_data(map_data, 4)
+            header_file_path = self.__write_item_header(build_folder_path, item, map_data, map_compression)
+            results.append([item.file_name_no_ext, header_file_path, len(map_data)])
+            total_size += len(map_data)
+
+        return bank_header_file_path, results, total_size
+
+    @staticmethod
+    def __pack_palettes(items_tiles):
+        # Tiles are grouped by their set of colors, and the sets are merged in the smallest number of 15 colors
+        # palettes (plus the transparent one), with the biggest sets placed first:
+        color_sets = set()
+
+        for item_tiles in items_tiles:
+            for tx, ty, tile in item_tiles:
+                color_set = frozenset(pixel for row in tile for pixel in row if pixel is not None)
+
+                if len(color_set) > 15:
+                    raise ValueError('There\'s a tile with more than 15 colors: ' + str(tx) + ' - ' + str(ty) +
+                                     ' - ' + str(len(color_set)))
+
+                color_sets.add(color_set)
+
+        palettes = []
+
+        for color_set in sorted(color_sets, key=lambda colors: (-len(colors), sorted(colors))):
+            best_palette = None
+            best_new_colors = None
+
+            for palette in palettes:
+                new_colors = len(color_set.difference(palette))
+
+                if len(palette) + new_colors <= 15 and (best_new_colors is None or new_colors < best_new_colors):
+                    best_palette = palette
+                    best_new_colors = new_colors
+
+            if best_palette is None:
+                if len(palettes) == max_palettes_count:
+                    raise ValueError('There\'s more than ' + str(max_palettes_count) + ' 4bpp palettes')
+
+                best_palette = []
+                palettes.append(best_palette)
+
+            for color in sorted(color_set):
+                if color not in best_palette:
+                    best_palette.append(color)
+
+        if len(palettes) == 0:
+            palettes.append([])
+
+        return palettes
+
+    @staticmethod
+    def __find_palette(palettes, tile):
+        color_set = set(pixel for row in tile for pixel in row if pixel is not None)
+
+        for palette_index in range(len(palettes)):
+            if color_set.issubset(palettes[palette_index]):
+                return palette_index
+
+        raise ValueError('No valid palette found for tile')
+
+    @staticmethod
+    def __flipped_tiles(rows):
+        horizontal_rows = [list(reversed(row)) for row in rows]
+        return [(0, rows), (1 << 10, horizontal_rows), (1 << 11, list(reversed(rows))),
+                ((1 << 10) | (1 << 11), list(reversed(horizontal_rows)))]
+
+    @staticmethod
+    def __row_word(row):
+        word = 0
+
+        for x in range(8):
+            word |= row[x] << (x * 4)
+
+        return word
+
+    @staticmethod
+    def __map_data(item, cells):
+        # Maps with a width or a height of 512 pixels are stored in 32x32 cells blocks (one per screenblock):
+        columns = int(item.width / 8)
+        rows = int(item.height / 8)
+        sbb = not item.big and (columns == 64 or rows == 64)
+        map_cells = []
+
+        for map_index in range(item.maps):
+            map_first_cell = map_index * columns * rows
+
+            if sbb:
+                for block_y in range(0, rows, 32):
+                    for block_x in range(0, columns, 32):
+                        for y in range(block_y, block_y + 32):
+                            row_first_cell = map_first_cell + (y * columns)
+                            map_cells.extend(cells[row_first_cell + block_x:row_first_cell + block_x + 32])
+            else:
+                map_cells.extend(cells[map_first_cell:map_first_cell + (columns * rows)])
+
+        return bytearray(struct.pack('<' + str(len(map_cells)) + 'H', *map_cells))
+
+    def __write_bank_header(self, build_folder_path, tiles_data, tiles_count, tiles_compression, palettes_data):
+        name = self.name
+        header_file_path = build_folder_path + '/bn_regular_bg_tiles_items_' + name + '.h'
+        tiles_words = struct.unpack('<' + str(int(len(tiles_data) / 4)) + 'I', tiles_data)
+        colors = struct.unpack('<' + str(int(len(palettes_data) / 2)) + 'H', palettes_data)
+
+        with open(header_file_path, 'w') as header_file:
+            include_guard = 'BN_REGULAR_BG_TILES_ITEMS_' + name.upper() + '_H'
+            header_file.write('#ifndef ' + include_guard + '\n')
+            header_file.write('#define ' + include_guard + '\n')
+            header_file.write('\n')
+            header_file.write('#include "bn_regular_bg_tiles_item.h"' + '\n')
+            header_file.write('#include "bn_bg_palette_item.h"' + '\n')
+            header_file.write('\n')
+            header_file.write('alignas(4) inline constexpr bn::tile ' + name + '_bn_gfxTiles[' +
+                              str(int(len(tiles_words) / 8)) + '] =' + '\n')
+            header_file.write('{' + '\n')
+
+            for index in range(0, len(tiles_words), 8):
+                header_file.write('    ' + ', '.join('0x{:08X}'.format(word) for word in tiles_words[index:index + 8]) +
+                                  ',' + '\n')
+
+            header_file.write('};' + '\n')
+            header_file.write('\n')
+            header_file.write('alignas(4) inline constexpr bn::color ' + name + '_bn_gfxPal[' + str(len(colors)) +
+                              '] =' + '\n')
+            header_file.write('{' + '\n')
+
+            for index in range(0, len(colors), 4):
+                header_file.write('    ' + ', '.join('bn::color(0x{:04X})'.format(color)
+                                                     for color in colors[index:index + 4]) + ',' + '\n')
+
+            header_file.write('};' + '\n')
+            header_file.write('\n')
+            header_file.write('namespace bn::regular_bg_tiles_items' + '\n')
+            header_file.write('{' + '\n')
+            header_file.write('    constexpr inline regular_bg_tiles_item ' + name + '(' + '\n            ' +
+                              'span<const tile>(' + name + '_bn_gfxTiles, ' + str(tiles_count) + '), ' +
+                              'bpp_mode::BPP_4, ' + compression_label(tiles_compression) + ');' + '\n')
+            header_file.write('\n')
+            header_file.write('    constexpr inline bg_palette_item ' + name + '_palette(' +
+                              'span<const color>(' + name + '_bn_gfxPal, ' + str(len(colors)) + '), ' +
+                              '\n            ' + 'bpp_mode::BPP_4, compression_type::NONE);' + '\n')
+            header_file.write('}' + '\n')
+            header_file.write('\n')
+            header_file.write('#endif' + '\n')
+            header_file.write('\n')
+
+        return header_file_path
+
+    def __write_item_header(self, build_folder_path, item, map_data, map_compression):
+        name = item.file_name_no_ext
+        bank_name = self.name
+        header_file_path = build_folder_path + '/bn_regular_bg_items_' + name + '.h'
+        map_cells = struct.unpack('<' + str(int(len(map_data) / 2)) + 'H', map_data)
+
+        with open(header_file_path, 'w') as header_file:
+            include_guard = 'BN_REGULAR_BG_ITEMS_' + name.upper() + '_H'
+            header_file.write('#ifndef ' + include_guard + '\n')
+            header_file.write('#define ' + include_guard + '\n')
+            header_file.write('\n')
+            header_file.write('#include "bn_regular_bg_item.h"' + '\n')
+            header_file.write('#include "bn_regular_bg_tiles_items_' + bank_name + '.h"' + '\n')
+            header_file.write('\n')
+            header_file.write('alignas(4) inline constexpr bn::regular_bg_map_cell ' + name + '_bn_gfxMap[' +
+                              str(len(map_cells)) + '] =' + '\n')
+            header_file.write('{' + '\n')
+
+            for index in range(0, len(map_cells), 8):
+                header_file.write('    ' + ', '.join('0x{:04X}'.format(cell) for cell in map_cells[index:index + 8]) +
+                                  ',' + '\n')
+
+            header_file.write('};' + '\n')
+            header_file.write('\n')
+            header_file.write('namespace bn::regular_bg_items' + '\n')
+            header_file.write('{' + '\n')
+            header_file.write('    constexpr inline regular_bg_item ' + name + '(' + '\n            ' +
+                              'bn::regular_bg_tiles_items::' + bank_name + ',' + '\n            ' +
+                              'bn::regular_bg_tiles_items::' + bank_name + '_palette,' + '\n            ' +
+                              'regular_bg_map_item(' + name + '_bn_gfxMap[0], ' +
+                              'size(' + str(int(item.width / 8)) + ', ' + str(int(item.height / 8)) + '), ' +
+                              compression_label(map_compression) + ', ' + str(item.maps) + ', ' +
+                              str(item.big).lower() + '));' + '\n')
+            header_file.write('}' + '\n')
+            header_file.write('\n')
+            header_file.write('#endif' + '\n')
+            header_file.write('\n')
+
+        return header_file_path
@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2020-2025 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_core.h"
+
+#include "bn_log.h"
+#include "bn_keypad.h"
+#include "bn_string.h"
+#include "bn_models_3d.h"
+#include "bn_camera_3d.h"
+#include "bn_unique_ptr.h"
+#include "bn_sprite_text.h"
+#include "bn_bg_palettes.h"
+#include "bn_sprite_text_generator.h"
+
+#include "bn_model_3d_items_cube.h"
+#include "bn_model_3d_items_ground.h"
+#include "bn_model_3d_items_pyramid.h"
+
+#include "common_info.h"
+#include "common_variable_8x8_sprite_font.h"
+
+namespace
+{
+    constexpr bn::string_view info_text_lines[] = {
+        "PAD: move camera",
+        "L/R: rotate camera",
+        "A/B: change camera height",
+        "",
+        "Vertices, faces, scanline sprites",
+        "and discarded scanline sprites",
+        "per frame are shown below",
+    };
+
+    constexpr bn::color colors[] = {
+        bn::color(6, 12, 6),
+        bn::color(10, 18, 8),
+        bn::color(30, 8, 6),
+        bn::color(30, 24, 4),
+    };
+
+    constexpr int models_columns = 5;
+    constexpr int models_rows = 3;
+    constexpr int models_separation = 48;
+    constexpr int max_dynamic_models = models_columns * models_rows;
+
+    using models_type = bn::models_3d<max_dynamic_models, 256, 192>;
+
+    void _update_camera(bn::camera_3d& camera)
+    {
+        bn::point_3d position = camera.position();
+        bn::fixed phi = camera.phi();
+
+        if(bn::keypad::left_held())
+        {
+            position -= camera.u();
+        }
+        else if(bn::keypad::right_held())
+        {
+            position += camera.u();
+        }
+
+        if(bn::keypad::up_held())
+        {
+            position -= camera.v();
+        }
+        else if(bn::keypad::down_held())
+        {
+            position += camera.v();
+        }
+
+        if(bn::keypad::a_held())
+        {
+            position.set_y(bn::max(position.y() - 2, bn::fixed(64)));
+        }
+        else if(bn::keypad::b_held())
+        {
+            position.set_y(bn::min(position.y() + 2, bn::fixed(512)));
+        }
+
+        if(bn::keypad::l_held())
+        {
+            phi -= 1;
+
+            if(phi < 0)
+            {
+                phi += 360;
+            }
+        }
+        else if(bn::keypad::r_held())
+        {
+            phi += 1;
+
+            if(phi >= 360)
+            {
+                phi -= 360;
+            }
+        }
+
+        camera.set_position(position);
+        camera.set_phi(phi);
+    }
+}
+
+int main()
+{
+    bn::core::init();
+    bn::bg_palettes::set_transparent_color(bn::color(2, 2, 6));
+
+    bn::sprite_text_generator text_generator(common::variable_8x8_sprite_font);
+    common::info info("3D models", info_text_lines, text_generator);
+
+    bn::unique_ptr<models_type> models(new models_type());
+    models->set_colors(colors);
+
+    const bn::model_3d_item* static_model_items[] = {
+        &bn::model_3d_items::ground
+    };
+
+    models->set_static_model_items(static_model_items);
+
+    bn::vector<bn::model_3d*, max_dynamic_models> dynamic_models;
+
+    for(int row = 0; row < models_rows; ++row)
+    {
+        for(int column = 0; column < models_columns; ++column)
+        {
+            const bn::model_3d_item& model_item = (row + column) % 2 ?
+                        bn::model_3d_items::pyramid : bn::model_3d_items::cube;
+            bn::model_3d& model = models->create_dynamic_model(model_item);
+            model.set_position(bn::point_3d((column - (models_columns / 2)) * models_separation, 0,
+                                            (row - (models_rows / 2)) * models_separation));
+            dynamic_models.push_back(&model);
+        }
+    }
+
+    text_generator.set_left_alignment();
+
+    bn::camera_3d camera;
+    bn::sprite_text<8> stats_text(text_generator, -120 + 8, 80 - 16, "");
+    bn::fixed angle;
+    int frames_counter = 0;
+
+    while(true)
+    {
+        _update_camera(camera);
+
+        angle += 1;
+
+        if(angle >= 360)
+        {
+            angle -= 360;
+        }
+
+        for(int index = 0, limit = dynamic_models.size(); index < limit; ++index)
+        {
+            bn::fixed model_angle = angle + (index * 24);
+
+            if(model_angle >= 360)
+            {
+                model_angle -= 360;
+            }
+
+            dynamic_models[index]->set_rotation(model_angle, angle, 360 - model_angle);
+        }
+
+        models->update(camera);
+
+        bn::string<48> text;
+        bn::ostringstream text_stream(text);
+        text_stream.append("V: ");
+        text_stream.append(models->last_vertices_count());
+        text_stream.append(" F: ");
+        text_stream.append(models->last_faces_count());
+        text_stream.append(" S: ");
+        text_stream.append(models->last_hlines_count());
+        text_stream.append(" D: ");
+        text_stream.append(models->last_discarded_hlines_count());
+        stats_text.set_text(text);
+
+        ++frames_counter;
+
+        if(frames_counter == 60)
+        {
+            frames_counter = 0;
+            BN_LOG(text);
+        }
+
+        info.update();
+        bn::core::update();
+    }
+}
@@ -8,13 +8,13 @@
 
 #include "bn_sprite_palette_actions.h"
 
+#include "fr_point_3d.h"
 #include "fr_sprite_3d_item.h"
 
 namespace fr
 {
 
 class stage;
-class point_3d;
 class sprite_3d;
 class models_3d;
 class camera_3d;
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2020-2025 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BIG_MAP_CHUNKS_TESTS_H
+#define BIG_MAP_CHUNKS_TESTS_H
+
+#include "bn_core.h"
+#include "bn_regular_bg_ptr.h"
+#include "bn_regular_bg_map_ptr.h"
+#include "bn_regular_bg_tiles_ptr.h"
+#include "bn_config_bg_blocks.h"
+#include "bn_regular_bg_items_chunked_bg.h"
+#include "bn_regular_bg_items_staging_bg.h"
+#include "bn_regular_bg_items_chunked_bg_none.h"
+#include "bn_display.h"
+#include "bn_optional.h"
+#include "../../butano/hw/include/bn_hw_tonc.h"
+#include "tests.h"
+
+#if ! BN_CFG_BG_BLOCKS_MAX_MAP_CHUNKS || ! BN_CFG_BG_BLOCKS_STAGING_BUFFER_SIZE
+    static_assert(false, "Enable big map chunks and staging buffers in the Makefile to run big map chunks tests");
+#endif
+
+class big_map_chunks_tests : public tests
+{
+
+public:
+    big_map_chunks_tests() :
+        tests("big_map_chunks")
+    {
+        _scroll_test();
+        _staging_test();
+    }
+
+private:
+    static void _scroll_test()
+    {
+        const bn::regular_bg_map_item& map_item = bn::regular_bg_items::chunked_bg.map_item();
+        const bn::regular_bg_map_item& expected_map_item = bn::regular_bg_items::chunked_bg_none.map_item();
+        BN_ASSERT(map_item.compression() != bn::compression_type::NONE);
+        BN_ASSERT(expected_map_item.compression() == bn::compression_type::NONE);
+        BN_ASSERT(map_item.dimensions() == expected_map_item.dimensions());
+
+        // The map must have more than one chunk per row:
+        BN_ASSERT(map_item.dimensions().width() > 32);
+
+        bn::regular_bg_ptr bg = bn::regular_bg_items::chunked_bg.create_bg(0, 0);
+        bn::core::update();
+        _check(bg);
+
+        // Exposed columns cross the chunk boundary and the map wrap:
+        for(int index = 0; index < map_item.dimensions().width(); ++index)
+        {
+            bg.set_x(bg.x() - 8);
+            bn::core::update();
+            _check(bg);
+        }
+
+        for(int index = 0; index < map_item.dimensions().width(); ++index)
+        {
+            bg.set_position(bg.x() + 8, bg.y() + 8);
+            bn::core::update();
+            _check(bg);
+        }
+
+        // Jumps commit the whole map:
+        bg.set_x(bg.x() - 200);
+        bn::core::update();
+        _check(bg);
+    }
+
+    static void _staging_test()
+    {
+        // Map chunks and staged items are decompressed before V-Blank in the same frame:
+        bn::regular_bg_tiles_ptr staged_tiles = bn::regular_bg_items::staging_bg.tiles_item().create_tiles();
+        BN_ASSERT(! staged_tiles.ready());
+
+        bn::regular_bg_ptr bg = bn::regular_bg_items::chunked_bg.create_bg(-100, 0);
+        bn::core::update();
+        BN_ASSERT(staged_tiles.ready());
+        BN_ASSERT(bg.map().ready());
+        _check(bg);
+
+        bg.set_x(bg.x() - 64);
+        bn::core::update();
+        _check(bg);
+    }
+
+    static void _check(const bn::regular_bg_ptr& bg)
+    {
+        const bn::regular_bg_map_item& expected_map_item = bn::regular_bg_items::chunked_bg_none.map_item();
+        const bn::regular_bg_map_cell* expected_cells_ptr = expected_map_item.cells_ptr();
+        int map_width = expected_map_item.dimensions().width();
+        int map_height = expected_map_item.dimensions().height();
+
+        // The hardware map shows the 32x32 cells area starting at the top-left corner of the screen:
+        int first_x = (-bg.x().right_shift_integer() - (bn::display::width() / 2) + (map_width * 4)) >> 3;
+        int first_y = (-bg.y().right_shift_integer() - (bn::display::height() / 2) + (map_height * 4)) >> 3;
+        const SCREENBLOCK& vram_cells = se_mem[_hw_map_sbb()];
+        bn::optional<uint16_t> offset;
+
+        for(int y = first_y; y < first_y + 32; ++y)
+        {
+            int map_y = ((y % map_height) + map_height) % map_height;
+
+            for(int x = first_x; x < first_x + 32; ++x)
+            {
+                int map_x = ((x % map_width) + map_width) % map_width;
+                uint16_t vram_cell = vram_cells[((map_y & 31) * 32) + (map_x & 31)];
+                uint16_t expected_cell = expected_cells_ptr[(map_y * map_width) + map_x];
+
+                // Tiles and palette offsets are added to all cells:
+                if(! offset)
+                {
+                    offset = uint16_t(vram_cell - expected_cell);
+                }
+
+                BN_ASSERT(vram_cell == uint16_t(expected_cell + *offset), "Invalid VRAM cell: ", map_x, " - ", map_y);
+            }
+        }
+    }
+
+    [[nodiscard]] static int _hw_map_sbb()
+    {
+        int result = -1;
+
+        // Only one BG must be shown:
+        for(int hw_id = 0; hw_id < 4; ++hw_id)
+        {
+            if(REG_DISPCNT & (DCNT_BG0 << hw_id))
+            {
+                BN_ASSERT(result == -1, "More than one BG is shown");
+
+                result = (REG_BGCNT[hw_id] & BG_SBB_MASK) >> BG_SBB_SHIFT;
+            }
+        }
+
+        BN_ASSERT(result >= 0, "No BG is shown");
+
+        return result;
+    }
+};
+
+#endif
@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2020-2025 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef HBE_TABLES_TESTS_H
+#define HBE_TABLES_TESTS_H
+
+#include "bn_array.h"
+#include "bn_hbe_tables_animate_actions.h"
+#include "tests.h"
+
+#include "bn_hbe_tables_items_parallax_tables.h"
+
+struct hbe_tables_tests_deltas_hbe
+{
+    bn::span<const bn::fixed> deltas_ref;
+
+    void set_deltas_ref(const bn::span<const bn::fixed>& _deltas_ref)
+    {
+        deltas_ref = _deltas_ref;
+    }
+};
+
+struct hbe_tables_tests_values_hbe
+{
+    bn::span<const int> values_ref;
+
+    void set_values_ref(const bn::span<const int>& _values_ref)
+    {
+        values_ref = _values_ref;
+    }
+};
+
+class hbe_tables_tests : public tests
+{
+
+public:
+    hbe_tables_tests() :
+        tests("hbe_tables")
+    {
+        _item_test();
+        _forever_action_test();
+        _once_action_test();
+        _values_action_test();
+    }
+
+private:
+    using deltas_action = bn::hbe_deltas_tables_animate_action<hbe_tables_tests_deltas_hbe>;
+    using values_action = bn::hbe_values_tables_animate_action<hbe_tables_tests_values_hbe, int>;
+
+    static void _item_test()
+    {
+        // parallax_tables.json: 64 lines starting at 0 with 0.5 speed and 96 lines starting at 8 with 2 speed:
+        const bn::hbe_tables_item<bn::fixed>& item = bn::hbe_tables_items::parallax_tables;
+        BN_ASSERT(item.tables_count() == 3);
+        BN_ASSERT(item.values_ref().size() == 3 * bn::display::height());
+
+        for(int table_index = 0; table_index < 3; ++table_index)
+        {
+            bn::span<const bn::fixed> table = item.table(table_index);
+            BN_ASSERT(table.size() == bn::display::height());
+            BN_ASSERT(table.data() == item.values_ref().data() + (table_index * bn::display::height()));
+            BN_ASSERT(table[0] == bn::fixed(0.5) * table_index, table_index, " - ", table[0]);
+            BN_ASSERT(table[63] == bn::fixed(0.5) * table_index, table_index, " - ", table[63]);
+            BN_ASSERT(table[64] == 8 + (2 * table_index), table_index, " - ", table[64]);
+            BN_ASSERT(table[159] == 8 + (2 * table_index), table_index, " - ", table[159]);
+        }
+    }
+
+    static void _forever_action_test()
+    {
+        const bn::hbe_tables_item<bn::fixed>& item = bn::hbe_tables_items::parallax_tables;
+        deltas_action action = deltas_action::forever(hbe_tables_tests_deltas_hbe(), 1, item);
+        BN_ASSERT(action.update_forever());
+        BN_ASSERT(action.current_index() == 0);
+
+        for(int loop = 0; loop < 2; ++loop)
+        {
+            for(int table_index = 0; table_index < 3; ++table_index)
+            {
+                action.update();
+                BN_ASSERT(action.hbe().deltas_ref.data() == item.table(table_index).data(), loop, " - ", table_index);
+                BN_ASSERT(action.next_change_updates() == 1);
+
+                // The referenced table must not change until wait updates are done:
+                action.update();
+                BN_ASSERT(action.hbe().deltas_ref.data() == item.table(table_index).data(), loop, " - ", table_index);
+                BN_ASSERT(action.next_change_updates() == 0);
+                BN_ASSERT(! action.done());
+            }
+
+            BN_ASSERT(action.current_index() == 0);
+        }
+    }
+
+    static void _once_action_test()
+    {
+        const bn::hbe_tables_item<bn::fixed>& item = bn::hbe_tables_items::parallax_tables;
+        deltas_action action = deltas_action::once(hbe_tables_tests_deltas_hbe(), 0, item);
+        BN_ASSERT(! action.update_forever());
+
+        for(int table_index = 0; table_index < 3; ++table_index)
+        {
+            BN_ASSERT(! action.done());
+            action.update();
+            BN_ASSERT(action.hbe().deltas_ref.data() == item.table(table_index).data(), table_index);
+        }
+
+        BN_ASSERT(action.done());
+
+        action.reset();
+        BN_ASSERT(! action.done());
+        BN_ASSERT(action.current_index() == 0);
+    }
+
+    static void _values_action_test()
+    {
+        static bn::array<int, 2 * bn::display::height()> values;
+
+        for(int index = 0, limit = values.size(); index < limit; ++index)
+        {
+            values[index] = index;
+        }
+
+        bn::hbe_tables_item<int> item(values, 2);
+        values_action action = values_action::once(hbe_tables_tests_values_hbe(), 0, item);
+        action.update();
+        BN_ASSERT(action.hbe().values_ref.data() == values.data());
+        BN_ASSERT(action.hbe().values_ref.size() == bn::display::height());
+
+        action.update();
+        BN_ASSERT(action.hbe().values_ref.data() == values.data() + bn::display::height());
+        BN_ASSERT(action.hbe().values_ref[0] == bn::display::height());
+        BN_ASSERT(action.done());
+    }
+};
+
+#endif
@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2020-2025 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef INPLACE_FUNCTION_TESTS_H
+#define INPLACE_FUNCTION_TESTS_H
+
+#include "bn_function_ref.h"
+#include "bn_inplace_function.h"
+#include "tests.h"
+
+struct inplace_function_tests_counter
+{
+    int* copies;
+    int* destructions;
+    int value;
+
+    inplace_function_tests_counter(int* _copies, int* _destructions, int _value) :
+        copies(_copies),
+        destructions(_destructions),
+        value(_value)
+    {
+    }
+
+    inplace_function_tests_counter(const inplace_function_tests_counter& other) :
+        copies(other.copies),
+        destructions(other.destructions),
+        value(other.value)
+    {
+        ++*copies;
+    }
+
+    ~inplace_function_tests_counter()
+    {
+        ++*destructions;
+    }
+
+    int operator()(int increment) const
+    {
+        return value + increment;
+    }
+};
+
+class inplace_function_tests : public tests
+{
+
+public:
+    inplace_function_tests() :
+        tests("inplace_function")
+    {
+        _empty_test();
+        _copy_test();
+        _move_test();
+        _capacity_test();
+        _function_ref_test();
+    }
+
+private:
+    static int _add_one(int value)
+    {
+        return value + 1;
+    }
+
+    static void _empty_test()
+    {
+        // Calling an empty function stops the execution, so emptiness must be tracked:
+        bn::inplace_function<int(int)> empty_function;
+        BN_ASSERT(! empty_function);
+        BN_ASSERT(empty_function == nullptr);
+
+        bn::inplace_function<int(int)> null_function(nullptr);
+        BN_ASSERT(! null_function);
+
+        int(*null_function_ptr)(int) = nullptr;
+        bn::inplace_function<int(int)> null_ptr_function(null_function_ptr);
+        BN_ASSERT(! null_ptr_function);
+
+        bn::inplace_function<int(int)> function(_add_one);
+        BN_ASSERT(function);
+        BN_ASSERT(function(1) == 2);
+
+        function.reset();
+        BN_ASSERT(! function);
+
+        function = &_add_one;
+        BN_ASSERT(function(2) == 3);
+
+        function = nullptr;
+        BN_ASSERT(! function);
+    }
+
+    static void _copy_test()
+    {
+        int copies = 0;
+        int destructions = 0;
+
+        {
+            bn::inplace_function<int(int), sizeof(inplace_function_tests_counter)> function(
+                    inplace_function_tests_counter(&copies, &destructions, 10));
+            BN_ASSERT(function(1) == 11);
+
+            // Targets which aren't trivially copyable are copied with their copy constructor:
+            int copies_before = copies;
+            auto function_copy = function;
+            BN_ASSERT(copies == copies_before + 1, copies);
+            BN_ASSERT(function(2) == 12);
+            BN_ASSERT(function_copy(3) == 13);
+
+            int destructions_before = destructions;
+            function_copy = function;
+            BN_ASSERT(destructions == destructions_before + 1, destructions);
+            BN_ASSERT(function_copy(4) == 14);
+
+            // Trivially copyable targets are copied too:
+            int value = 5;
+            bn::inplace_function<int(int)> lambda_function = [value](int increment) { return value + increment; };
+            bn::inplace_function<int(int)> lambda_function_copy = lambda_function;
+            BN_ASSERT(lambda_function(1) == 6);
+            BN_ASSERT(lambda_function_copy(2) == 7);
+        }
+
+        BN_ASSERT(copies + 1 == destructions, copies, " - ", destructions);
+    }
+
+    static void _move_test()
+    {
+        int copies = 0;
+        int destructions = 0;
+
+        {
+            bn::inplace_function<int(int), sizeof(inplace_function_tests_counter)> function(
+                    inplace_function_tests_counter(&copies, &destructions, 20));
+
+            // Moved from functions become empty:
+            auto moved_function = bn::move(function);
+            BN_ASSERT(! function);
+            BN_ASSERT(moved_function(1) == 21);
+
+            function = bn::move(moved_function);
+            BN_ASSERT(! moved_function);
+            BN_ASSERT(function(2) == 22);
+
+            bn::inplace_function<int(int), sizeof(inplace_function_tests_counter)> other_function(
+                    inplace_function_tests_counter(&copies, &destructions, 30));
+            function.swap(other_function);
+            BN_ASSERT(function(3) == 33);
+            BN_ASSERT(other_function(4) == 24);
+        }
+
+        BN_ASSERT(copies + 2 == destructions, copies, " - ", destructions);
+    }
+
+    static void _capacity_test()
+    {
+        using function_type = bn::inplace_function<int(), int(sizeof(int) * 4)>;
+        static_assert(sizeof(function_type) == (sizeof(int) * 4) + (sizeof(void*) * 2));
+
+        // A lambda as big as the storage fits:
+        int a = 1;
+        int b = 2;
+        int c = 3;
+        int d = 4;
+        function_type function = [a, b, c, d]() { return a + b + c + d; };
+        BN_ASSERT(function() == 10);
+    }
+
+    static void _function_ref_test()
+    {
+        bn::function_ref<int(int)> free_function_ref(_add_one);
+        BN_ASSERT(free_function_ref(1) == 2);
+
+        int value = 10;
+        auto lambda = [&value](int increment) { value += increment; return value; };
+        bn::function_ref<int(int)> lambda_ref(lambda);
+        BN_ASSERT(lambda_ref(1) == 11);
+
+        // The referenced lambda isn't copied:
+        BN_ASSERT(lambda_ref(2) == 13);
+        BN_ASSERT(value == 13);
+
+        bn::inplace_function<int(int)> function = lambda;
+        bn::function_ref<int(int)> function_ref(function);
+        BN_ASSERT(function_ref(3) == 16);
+    }
+};
+
+#endif
@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2020-2025 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef LINK_ROLLBACK_TESTS_H
+#define LINK_ROLLBACK_TESTS_H
+
+#include "bn_array.h"
+#include "bn_deque.h"
+#include "bn_memory.h"
+#include "bn_link_rollback_session.h"
+#include "tests.h"
+
+class link_rollback_tests : public tests
+{
+
+public:
+    link_rollback_tests() :
+        tests("link_rollback")
+    {
+        _test(2, 0, 1, 0);
+        _test(1, 0, 3, 5);
+        _test(2, 6, 1, 0);
+        _test(1, 6, 3, 0);
+        _test(2, 6, 2, 7);
+    }
+
+private:
+    static constexpr int _frames_count = 128;
+
+    class test_simulation
+    {
+
+    public:
+        bn::array<unsigned, _frames_count> checksums = {};
+
+        void save(int slot)
+        {
+            _saved_frames[slot] = _frame;
+            _saved_checksums[slot] = _checksum;
+        }
+
+        void restore(int slot)
+        {
+            _frame = _saved_frames[slot];
+            _checksum = _saved_checksums[slot];
+        }
+
+        void simulate(unsigned first_player_keys, unsigned second_player_keys)
+        {
+            _checksum = _next_checksum(_checksum, first_player_keys, second_player_keys);
+
+            if(_frame < _frames_count)
+            {
+                checksums[_frame] = _checksum;
+            }
+
+            ++_frame;
+        }
+
+    private:
+        int _frame = 0;
+        unsigned _checksum = 0;
+        int _saved_frames[bn::link_rollback_session::max_max_rollback_frames()] = {};
+        unsigned _saved_checksums[bn::link_rollback_session::max_max_rollback_frames()] = {};
+    };
+
+    class word_type
+    {
+
+    public:
+        int delivery_update;
+        int data;
+    };
+
+    [[nodiscard]] static unsigned _next_checksum(unsigned checksum, unsigned first_player_keys,
+                                                 unsigned second_player_keys)
+    {
+        return (checksum * 31) + (first_player_keys << 10) + second_player_keys;
+    }
+
+    [[nodiscard]] static unsigned _keys(int player_id, int frame, int input_delay)
+    {
+        // Keys change every few frames, so some predictions are wrong:
+        if(frame < input_delay)
+        {
+            return 0;
+        }
+
+        return unsigned(((frame / 5) + player_id) * (player_id + 3)) & 0x3FF;
+    }
+
+    static void _update(int player_id, int update, int input_delay, int latency, int drop_one_in,
+                        int& sent_words_count, bn::link_rollback_session& session, test_simulation& simulation,
+                        bn::ideque<word_type>& received_words, bn::ideque<word_type>& sent_words)
+    {
+        while(! received_words.empty() && received_words.front().delivery_update <= update)
+        {
+            session.push_received_word(received_words.front().data);
+            received_words.pop_front();
+        }
+
+        session.update(player_id, _keys(player_id, session.frame() + input_delay, input_delay), simulation);
+
+        while(bn::optional<int> word = session.pop_sent_word())
+        {
+            ++sent_words_count;
+
+            if(! drop_one_in || sent_words_count % drop_one_in)
+            {
+                sent_words.push_back(word_type{ update + latency, *word });
+            }
+        }
+    }
+
+    static void _test(int input_delay, int max_rollback_frames, int latency, int drop_one_in)
+    {
+        struct test_data
+        {
+            bn::link_rollback_session first_session;
+            bn::link_rollback_session second_session;
+            test_simulation first_simulation;
+            test_simulation second_simulation;
+            bn::deque<word_type, 64> first_to_second_words;
+            bn::deque<word_type, 64> second_to_first_words;
+
+            test_data(int input_delay, int max_rollback_frames) :
+                first_session(input_delay, max_rollback_frames),
+                second_session(input_delay, max_rollback_frames)
+            {
+            }
+        };
+
+        bn::unique_ptr<test_data> data = bn::make_unique<test_data>(input_delay, max_rollback_frames);
+        bn::link_rollback_session& first_session = data->first_session;
+        bn::link_rollback_session& second_session = data->second_session;
+        int sent_words_count = 0;
+
+        for(int update = 0; update < 2000; ++update)
+        {
+            _update(0, update, input_delay, latency, drop_one_in, sent_words_count, first_session,
+                    data->first_simulation, data->second_to_first_words, data->first_to_second_words);
+            _update(1, update, input_delay, latency, drop_one_in, sent_words_count, second_session,
+                    data->second_simulation, data->first_to_second_words, data->second_to_first_words);
+
+            if(first_session.frame() > _frames_count && second_session.frame() > _frames_count &&
+                    first_session.confirmed_frame() >= _frames_count &&
+                    second_session.confirmed_frame() >= _frames_count)
+            {
+                break;
+            }
+        }
+
+        BN_ASSERT(first_session.confirmed_frame() >= _frames_count, first_session.confirmed_frame());
+        BN_ASSERT(second_session.confirmed_frame() >= _frames_count, second_session.confirmed_frame());
+
+        // Once keys are confirmed, both players must have simulated the same frames with the same keys:
+        unsigned checksum = 0;
+
+        for(int frame = 0; frame < _frames_count; ++frame)
+        {
+            checksum = _next_checksum(checksum, _keys(0, frame, input_delay), _keys(1, frame, input_delay));
+            BN_ASSERT(data->first_simulation.checksums[frame] == checksum, "Invalid first checksum: ", frame);
+            BN_ASSERT(data->second_simulation.checksums[frame] == checksum, "Invalid second checksum: ", frame);
+        }
+
+        BN_ASSERT(first_session.peak_rollback_frames() <= max_rollback_frames, first_session.peak_rollback_frames());
+        BN_ASSERT(second_session.peak_rollback_frames() <= max_rollback_frames,
+                  second_session.peak_rollback_frames());
+
+        if(max_rollback_frames)
+        {
+            // Keys arrive later than their frames are simulated, so wrong predictions must be rolled back:
+            if(latency > input_delay)
+            {
+                BN_ASSERT(first_session.rollbacks_count() || second_session.rollbacks_count());
+            }
+        }
+        else
+        {
+            BN_ASSERT(! first_session.rollbacks_count(), first_session.rollbacks_count());
+            BN_ASSERT(! second_session.rollbacks_count(), second_session.rollbacks_count());
+
+            // In lockstep, frames wait for the keys of the other player:
+            if(latency > input_delay)
+            {
+                BN_ASSERT(first_session.stalled_updates() || second_session.stalled_updates());
+            }
+        }
+    }
+};
+
+#endif
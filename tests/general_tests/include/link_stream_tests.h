@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2020-2025 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef LINK_STREAM_TESTS_H
+#define LINK_STREAM_TESTS_H
+
+#include "bn_array.h"
+#include "bn_memory.h"
+#include "bn_seed_random.h"
+#include "bn_link_stream.h"
+#include "bn_link_stream_loopback.h"
+#include "tests.h"
+
+class link_stream_tests : public tests
+{
+
+public:
+    link_stream_tests() :
+        tests("link_stream")
+    {
+        _test(0, 0, 1);
+        _test(256, 512, 3);
+    }
+
+private:
+    static constexpr int _size = 1024;
+
+    static void _test(int drop_one_in, int corrupt_one_in, int latency)
+    {
+        struct test_data
+        {
+            bn::link_stream<256> first_stream;
+            bn::link_stream<256> second_stream;
+            bn::array<uint8_t, _size> first_sent;
+            bn::array<uint8_t, _size> second_sent;
+            bn::array<uint8_t, _size> first_received;
+            bn::array<uint8_t, _size> second_received;
+        };
+
+        bn::unique_ptr<test_data> data = bn::make_unique<test_data>();
+
+        // Random bytes are used to test words which must be escaped:
+        bn::seed_random random;
+
+        for(int index = 0; index < _size; ++index)
+        {
+            data->first_sent[index] = uint8_t(random.get_int(256));
+            data->second_sent[index] = uint8_t(random.get_int(256));
+        }
+
+        bn::link_stream_loopback loopback(data->first_stream, data->second_stream);
+        loopback.set_latency(latency);
+        loopback.set_drop_one_in(drop_one_in);
+        loopback.set_corrupt_one_in(corrupt_one_in);
+
+        int first_written = 0;
+        int second_written = 0;
+        int first_read = 0;
+        int second_read = 0;
+
+        for(int update = 0; update < 10000; ++update)
+        {
+            first_written += data->first_stream.write(
+                        bn::span<const uint8_t>(data->first_sent.data() + first_written, _size - first_written));
+            second_written += data->second_stream.write(
+                        bn::span<const uint8_t>(data->second_sent.data() + second_written, _size - second_written));
+
+            loopback.update();
+
+            bn::span<uint8_t> first_destination(data->second_received.data() + first_read, _size - first_read);
+            first_read += data->second_stream.read(first_destination);
+
+            bn::span<uint8_t> second_destination(data->first_received.data() + second_read, _size - second_read);
+            second_read += data->first_stream.read(second_destination);
+
+            if(first_read == _size && second_read == _size && data->first_stream.flushed() &&
+                    data->second_stream.flushed())
+            {
+                break;
+            }
+        }
+
+        BN_ASSERT(first_read == _size, "Invalid first read: ", first_read);
+        BN_ASSERT(second_read == _size, "Invalid second read: ", second_read);
+        BN_ASSERT(data->first_stream.flushed());
+        BN_ASSERT(data->second_stream.flushed());
+        BN_ASSERT(data->first_sent == data->second_received);
+        BN_ASSERT(data->second_sent == data->first_received);
+
+        if(drop_one_in || corrupt_one_in)
+        {
+            BN_ASSERT(loopback.dropped_words() || loopback.corrupted_words());
+            BN_ASSERT(data->first_stream.retransmitted_packets() || data->second_stream.retransmitted_packets());
+        }
+        else
+        {
+            BN_ASSERT(! data->first_stream.retransmitted_packets());
+            BN_ASSERT(! data->second_stream.retransmitted_packets());
+            BN_ASSERT(! data->first_stream.discarded_packets());
+            BN_ASSERT(! data->second_stream.discarded_packets());
+        }
+    }
+};
+
+#endif
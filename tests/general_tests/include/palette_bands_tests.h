@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2020-2025 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef PALETTE_BANDS_TESTS_H
+#define PALETTE_BANDS_TESTS_H
+
+#include "bn_core.h"
+#include "bn_hdma.h"
+#include "bn_array.h"
+#include "bn_unique_ptr.h"
+#include "bn_palette_bands.h"
+#include "bn_bg_palette_item.h"
+#include "../../butano/hw/include/bn_hw_tonc.h"
+#include "../../butano/hw/include/bn_hw_palettes.h"
+#include "tests.h"
+
+class palette_bands_tests : public tests
+{
+
+public:
+    palette_bands_tests() :
+        tests("palette_bands")
+    {
+        _hblank_colors_test();
+        _bands_test();
+        _start_test();
+        _scanlines_test();
+    }
+
+private:
+    static constexpr int _colors_count = 16;
+
+    using colors_type = bn::array<bn::color, _colors_count>;
+    using bands_type = bn::palette_bands<4, _colors_count>;
+
+    [[nodiscard]] static colors_type _colors(int seed)
+    {
+        colors_type result;
+
+        for(int index = 0; index < _colors_count; ++index)
+        {
+            result[index] = bn::color((index + seed) % 32, (index * 2) % 32, seed % 32);
+        }
+
+        return result;
+    }
+
+    [[nodiscard]] static bn::bg_palette_ptr _palette()
+    {
+        static const colors_type colors = _colors(0);
+        return bn::bg_palette_ptr::create_new(bn::bg_palette_item(colors, bn::bpp_mode::BPP_4));
+    }
+
+    static void _hblank_colors_test()
+    {
+        bn::unique_ptr<bands_type> bands_ptr(new bands_type(_palette()));
+        bands_type& bands = *bands_ptr;
+        colors_type first_colors = _colors(0);
+        BN_ASSERT(bands.empty());
+        BN_ASSERT(bands.colors_count() == _colors_count);
+
+        bands.push_band(0, first_colors);
+        BN_ASSERT(bands.hblank_colors() == 0);
+
+        // Bands with the same colors don't copy anything:
+        bands.push_band(40, first_colors);
+        BN_ASSERT(bands.hblank_colors() == 0);
+
+        // Only the range of colors which change between consecutive bands is copied:
+        colors_type third_colors = first_colors;
+        third_colors[2] = bn::color(31, 31, 31);
+        third_colors[4] = bn::color(31, 0, 31);
+        bands.push_band(80, third_colors);
+        BN_ASSERT(bands.hblank_colors() == 3, bands.hblank_colors());
+
+        colors_type fourth_colors = third_colors;
+        fourth_colors[9] = bn::color(0, 31, 0);
+        bands.push_band(120, fourth_colors);
+        BN_ASSERT(bands.full());
+        BN_ASSERT(bands.hblank_colors() == 8, bands.hblank_colors());
+        BN_ASSERT(bands.fits_hblank());
+
+        // The last band is compared with the first one too:
+        bands.clear();
+        bands.push_band(0, first_colors);
+        fourth_colors = first_colors;
+        fourth_colors[14] = bn::color(0, 0, 31);
+        bands.push_band(100, fourth_colors);
+        BN_ASSERT(bands.hblank_colors() == 1, bands.hblank_colors());
+    }
+
+    static void _bands_test()
+    {
+        bn::unique_ptr<bands_type> bands_ptr(new bands_type(_palette()));
+        bands_type& bands = *bands_ptr;
+
+        for(int band_index = 0; band_index < bands.max_bands_count(); ++band_index)
+        {
+            colors_type colors = _colors(band_index);
+            bands.push_band(band_index * 32, colors);
+        }
+
+        BN_ASSERT(bands.bands_count() == bands.max_bands_count());
+
+        for(int band_index = 0; band_index < bands.bands_count(); ++band_index)
+        {
+            colors_type expected_colors = _colors(band_index);
+            bn::span<const bn::color> colors = bands.band_colors(band_index);
+            BN_ASSERT(bands.band_first_scanline(band_index) == band_index * 32);
+            BN_ASSERT(colors.size() == _colors_count);
+
+            for(int index = 0; index < _colors_count; ++index)
+            {
+                BN_ASSERT(colors[index] == expected_colors[index], "Invalid color: ", band_index, " - ", index);
+            }
+        }
+    }
+
+    static void _start_test()
+    {
+        bn::unique_ptr<bands_type> bands_ptr(new bands_type(_palette()));
+        bands_type& bands = *bands_ptr;
+        bands.push_band(0, _colors(0));
+        bands.push_band(80, _colors(1));
+
+        bands.start();
+        BN_ASSERT(bands.running());
+        BN_ASSERT(bn::hdma::running());
+        BN_ASSERT(! bn::hdma::high_priority_running());
+
+        bands.high_priority_start();
+        BN_ASSERT(bands.running());
+        BN_ASSERT(! bn::hdma::running());
+        BN_ASSERT(bn::hdma::high_priority_running());
+
+        bands.stop();
+        BN_ASSERT(! bands.running());
+        BN_ASSERT(! bn::hdma::high_priority_running());
+
+        // HDMA is stopped when the bands are destroyed:
+        bands.start();
+        bands_ptr.reset();
+        BN_ASSERT(! bn::hdma::running());
+        bn::core::update();
+    }
+
+    static void _scanlines_test()
+    {
+        bn::bg_palette_ptr palette = _palette();
+        bn::unique_ptr<bands_type> bands_ptr(new bands_type(palette));
+        bands_type& bands = *bands_ptr;
+        bands.push_band(0, _colors(3));
+        bands.push_band(50, _colors(7));
+        bands.push_band(100, _colors(11));
+        bands.start();
+        bn::core::update();
+
+        // Scanlines next to band changes are skipped, so the test doesn't depend on the H-Blank timing:
+        _check_scanline(palette, 20, _colors(3));
+        _check_scanline(palette, 70, _colors(7));
+        _check_scanline(palette, 130, _colors(11));
+
+        bands_ptr.reset();
+        bn::core::update();
+    }
+
+    static void _check_scanline(const bn::bg_palette_ptr& palette, int scanline, const colors_type& expected_colors)
+    {
+        const uint16_t* colors_ptr = bn::hw::palettes::bg_color_register(
+                    palette.id() * bn::hw::palettes::colors_per_palette());
+
+        while(REG_VCOUNT != scanline)
+        {
+        }
+
+        colors_type colors;
+
+        for(int index = 0; index < _colors_count; ++index)
+        {
+            colors[index] = bn::color(int(colors_ptr[index]));
+        }
+
+        // Color 0 isn't checked since it can be the backdrop color:
+        for(int index = 1; index < _colors_count; ++index)
+        {
+            BN_ASSERT(colors[index] == expected_colors[index], "Invalid color: ", scanline, " - ", index);
+        }
+    }
+};
+
+#endif
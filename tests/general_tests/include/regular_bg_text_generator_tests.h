@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2020-2025 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef REGULAR_BG_TEXT_GENERATOR_TESTS_H
+#define REGULAR_BG_TEXT_GENERATOR_TESTS_H
+
+#include "bn_core.h"
+#include "bn_regular_bg_ptr.h"
+#include "bn_regular_bg_tiles_ptr.h"
+#include "bn_regular_bg_map_cell_info.h"
+#include "bn_regular_bg_text_generator.h"
+#include "common_fixed_8x8_sprite_font.h"
+#include "common_variable_8x8_sprite_font.h"
+#include "tests.h"
+
+class regular_bg_text_generator_tests : public tests
+{
+
+public:
+    regular_bg_text_generator_tests() :
+        tests("regular_bg_text_generator")
+    {
+        _fixed_test();
+        _overwrite_test();
+        _variable_test();
+        _max_tiles_test();
+    }
+
+private:
+    using generator_type = bn::regular_bg_text_generator<64>;
+
+    static void _fixed_test()
+    {
+        generator_type generator(common::fixed_8x8_sprite_font);
+        BN_ASSERT(generator.used_tiles_count() == 1);
+        BN_ASSERT(generator.available_tiles_count() == generator.max_tiles_count() - 1);
+
+        int character_width = 8 + common::fixed_8x8_sprite_font.space_between_characters();
+        BN_ASSERT(generator.width("ABBA") == character_width * 4);
+
+        // Repeated characters share their tiles and spaces use the blank tile:
+        generator.generate(0, 0, "A A");
+        BN_ASSERT(generator.used_tiles_count() == 2, generator.used_tiles_count());
+        BN_ASSERT(_tile_index(generator, 0, 0) == _tile_index(generator, 2, 0));
+        BN_ASSERT(_tile_index(generator, 1, 0) == 0);
+        _check_character(generator, 0, 0, 'A');
+
+        generator.generate(0, 8, "BA");
+        BN_ASSERT(generator.used_tiles_count() == 3, generator.used_tiles_count());
+        BN_ASSERT(_tile_index(generator, 1, 1) == _tile_index(generator, 0, 0));
+        _check_character(generator, 0, 1, 'B');
+
+        // Aligned texts are drawn in the same cells:
+        generator.set_right_alignment();
+        generator.generate(generator.width("BA"), 16, "BA");
+        BN_ASSERT(_tile_index(generator, 0, 2) == _tile_index(generator, 0, 1));
+        BN_ASSERT(_tile_index(generator, 1, 2) == _tile_index(generator, 1, 1));
+        BN_ASSERT(generator.used_tiles_count() == 3, generator.used_tiles_count());
+
+        // Tiles are kept while there's a cell which references them:
+        generator.clear_cells(0, 0, 3, 1);
+        BN_ASSERT(generator.used_tiles_count() == 3, generator.used_tiles_count());
+        BN_ASSERT(_tile_index(generator, 0, 0) == 0);
+
+        generator.clear();
+        BN_ASSERT(generator.used_tiles_count() == 1, generator.used_tiles_count());
+
+        for(int y = 0; y < 32; ++y)
+        {
+            for(int x = 0; x < 32; ++x)
+            {
+                BN_ASSERT(_tile_index(generator, x, y) == 0, "Invalid tile index: ", x, " - ", y);
+            }
+        }
+
+        // The generated map can be shown with a regular BG:
+        bn::regular_bg_ptr bg = bn::regular_bg_ptr::create(generator.map());
+        generator.generate(0, 0, "ABBA");
+        bn::core::update();
+        _check_character(generator, 2, 0, 'B');
+    }
+
+    static void _overwrite_test()
+    {
+        generator_type generator(common::fixed_8x8_sprite_font);
+        generator.generate(0, 0, "AB");
+        BN_ASSERT(generator.used_tiles_count() == 3, generator.used_tiles_count());
+
+        // Cells covered by new text are overwritten, releasing the tiles not referenced anymore:
+        generator.generate(0, 0, "CB");
+        BN_ASSERT(generator.used_tiles_count() == 3, generator.used_tiles_count());
+        _check_character(generator, 0, 0, 'C');
+        _check_character(generator, 1, 0, 'B');
+
+        generator.generate(0, 0, "CC");
+        BN_ASSERT(generator.used_tiles_count() == 2, generator.used_tiles_count());
+    }
+
+    static void _variable_test()
+    {
+        generator_type generator(common::variable_8x8_sprite_font);
+        const char* text = "Hello, world!";
+        int text_width = generator.width(text);
+        BN_ASSERT(text_width > 0 && text_width < bn::string_view(text).size() * 8, text_width);
+
+        // Consecutive characters share cells:
+        generator.generate(3, 0, text);
+        int columns = ((3 + text_width - 1) / 8) + 1;
+        int used_tiles_count = generator.used_tiles_count();
+        BN_ASSERT(used_tiles_count > 1 && used_tiles_count <= columns + 1, used_tiles_count, " - ", columns);
+        BN_ASSERT(_tile_index(generator, columns, 0) == 0);
+
+        // The same text with the same offset in another row reuses all tiles:
+        generator.generate(3, 16, text);
+        BN_ASSERT(generator.used_tiles_count() == used_tiles_count, generator.used_tiles_count());
+
+        for(int x = 0; x < columns; ++x)
+        {
+            BN_ASSERT(_tile_index(generator, x, 2) == _tile_index(generator, x, 0), "Invalid tile index: ", x);
+        }
+
+        // With another offset, tiles are different:
+        generator.generate(4, 24, text);
+        BN_ASSERT(generator.used_tiles_count() > used_tiles_count, generator.used_tiles_count());
+
+        generator.clear();
+        BN_ASSERT(generator.used_tiles_count() == 1, generator.used_tiles_count());
+    }
+
+    static void _max_tiles_test()
+    {
+        bn::regular_bg_text_generator<4> generator(common::fixed_8x8_sprite_font);
+        generator.generate(0, 0, "ABC");
+        BN_ASSERT(generator.available_tiles_count() == 0, generator.available_tiles_count());
+
+        // Texts with the same tiles can still be drawn when there's no more tiles available:
+        generator.generate(0, 8, "CBA");
+        generator.generate(0, 16, "A B C");
+        BN_ASSERT(generator.available_tiles_count() == 0, generator.available_tiles_count());
+
+        generator.clear_cells(0, 0, 32, 2);
+        BN_ASSERT(generator.available_tiles_count() == 0, generator.available_tiles_count());
+
+        generator.clear_cells(0, 2, 32, 1);
+        BN_ASSERT(generator.available_tiles_count() == 3, generator.available_tiles_count());
+    }
+
+    [[nodiscard]] static int _tile_index(const bn::iregular_bg_text_generator& generator, int x, int y)
+    {
+        bn::regular_bg_map_ptr map = generator.map();
+        bn::regular_bg_map_cell cell = map.vram()->data()[(y * 32) + x];
+        return bn::regular_bg_map_cell_info(cell).tile_index() - map.tiles_offset();
+    }
+
+    static void _check_character(const bn::iregular_bg_text_generator& generator, int x, int y, char character)
+    {
+        const bn::sprite_tiles_item& font_tiles_item = generator.font().item().tiles_item();
+        const bn::tile& expected_tile = font_tiles_item.graphics_tiles_ref(character - '!')[0];
+        bn::regular_bg_tiles_ptr tiles = generator.map().tiles();
+        const bn::tile& vram_tile = tiles.vram()->data()[_tile_index(generator, x, y)];
+
+        for(int row = 0; row < 8; ++row)
+        {
+            BN_ASSERT(vram_tile.data[row] == expected_tile.data[row], "Invalid tile: ", x, " - ", y, " - ", row);
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2020-2025 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef REGULAR_BG_TILES_CACHE_TESTS_H
+#define REGULAR_BG_TILES_CACHE_TESTS_H
+
+#include "bn_core.h"
+#include "bn_unique_ptr.h"
+#include "bn_regular_bg_ptr.h"
+#include "bn_regular_bg_map_ptr.h"
+#include "bn_regular_bg_tiles_ptr.h"
+#include "bn_regular_bg_tiles_cache.h"
+#include "bn_regular_bg_streamed_items_streamed_bg.h"
+#include "../../butano/hw/include/bn_hw_tonc.h"
+#include "tests.h"
+
+class regular_bg_tiles_cache_tests : public tests
+{
+
+public:
+    regular_bg_tiles_cache_tests() :
+        tests("regular_bg_tiles_cache")
+    {
+        _streamed_item_test();
+    }
+
+private:
+    static constexpr const bn::regular_bg_streamed_item& _item = bn::regular_bg_streamed_items::streamed_bg;
+    static constexpr int _source_tiles_count = _item.tiles_ref().size();
+
+    // Map cells can't reference all these tiles:
+    static_assert(_source_tiles_count > 1024);
+
+    using tiles_cache_type = bn::regular_bg_tiles_cache<1024, _source_tiles_count>;
+
+    static void _streamed_item_test()
+    {
+        bn::unique_ptr<tiles_cache_type> tiles_cache_ptr(new tiles_cache_type());
+        tiles_cache_type& tiles_cache = *tiles_cache_ptr;
+        BN_ASSERT(tiles_cache.max_source_tiles_count() == _source_tiles_count);
+
+        {
+            bn::regular_bg_ptr bg = _item.create_bg(0, 0, tiles_cache);
+            bn::core::update();
+            _check();
+
+            // Exposed columns and rows replace tiles which are no longer referenced:
+            for(int index = 0; index < 8; ++index)
+            {
+                bg.set_position(bg.x() - 8, bg.y() - 8);
+                bn::core::update();
+                _check();
+            }
+
+            BN_ASSERT(tiles_cache.referenced_tiles_count() == 1024, tiles_cache.referenced_tiles_count());
+            BN_ASSERT(tiles_cache.loaded_tiles_count() == 1024, tiles_cache.loaded_tiles_count());
+        }
+
+        BN_ASSERT(! tiles_cache.used());
+    }
+
+    static void _check()
+    {
+        unsigned hw_cnt = _hw_bg_cnt();
+        const SCREENBLOCK& vram_cells = se_mem[(hw_cnt & BG_SBB_MASK) >> BG_SBB_SHIFT];
+        const bn::tile* vram_tiles_ptr = reinterpret_cast<const bn::tile*>(
+                    tile_mem[(hw_cnt & BG_CBB_MASK) >> BG_CBB_SHIFT]);
+        const bn::regular_bg_map_cell* source_cells_ptr = _item.map_item().cells_ptr();
+        const uint16_t* source_tile_indexes_ptr = _item.tile_indexes_ref().data();
+        const bn::tile* source_tiles_ptr = _item.tiles_ref().data();
+        int map_width = _item.map_item().dimensions().width();
+
+        for(int y = 0; y < 32; ++y)
+        {
+            for(int x = 0; x < 32; ++x)
+            {
+                unsigned vram_cell = vram_cells[(y * 32) + x];
+                const bn::tile& vram_tile = vram_tiles_ptr[vram_cell & 0x3FF];
+                bool found = false;
+
+                // Each VRAM cell shows one of the map cells with the same position modulo 32:
+                for(int map_x = x; map_x < map_width && ! found; map_x += 32)
+                {
+                    int source_cell_index = (y * map_width) + map_x;
+                    unsigned source_cell = source_cells_ptr[source_cell_index];
+
+                    if((vram_cell & 0xC00) == (source_cell & 0xC00))
+                    {
+                        const bn::tile& source_tile = source_tiles_ptr[source_tile_indexes_ptr[source_cell_index]];
+                        found = true;
+
+                        for(int row = 0; row < 8; ++row)
+                        {
+                            found &= vram_tile.data[row] == source_tile.data[row];
+                        }
+                    }
+                }
+
+                BN_ASSERT(found, "Invalid VRAM cell: ", x, " - ", y);
+            }
+        }
+    }
+
+    [[nodiscard]] static unsigned _hw_bg_cnt()
+    {
+        int result = -1;
+
+        // Only one BG must be shown:
+        for(int hw_id = 0; hw_id < 4; ++hw_id)
+        {
+            if(REG_DISPCNT & (DCNT_BG0 << hw_id))
+            {
+                BN_ASSERT(result == -1, "More than one BG is shown");
+
+                result = REG_BGCNT[hw_id];
+            }
+        }
+
+        BN_ASSERT(result >= 0, "No BG is shown");
+
+        return unsigned(result);
+    }
+};
+
+#endif
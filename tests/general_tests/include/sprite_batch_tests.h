@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2020-2025 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef SPRITE_BATCH_TESTS_H
+#define SPRITE_BATCH_TESTS_H
+
+#include "bn_core.h"
+#include "bn_display.h"
+#include "bn_sprite_ptr.h"
+#include "bn_sprite_batch.h"
+#include "bn_sprite_items_streamed_sprite.h"
+#include "../../butano/hw/include/bn_hw_tonc.h"
+#include "tests.h"
+
+class sprite_batch_tests : public tests
+{
+
+public:
+    sprite_batch_tests() :
+        tests("sprite_batch")
+    {
+        _push_back_erase_test();
+        _full_test();
+        _oam_test();
+        _sprite_items_order_test();
+    }
+
+private:
+    using batch_type = bn::sprite_batch<8, 4>;
+
+    static void _push_back_erase_test()
+    {
+        batch_type batch(bn::sprite_items::streamed_sprite);
+        BN_ASSERT(batch.empty());
+        BN_ASSERT(batch.tiles_list().size() == 4);
+
+        batch.push_back(0, 0, 0);
+        batch.push_back(10, 1, 1);
+        batch.push_back(20, 2, 2);
+        batch.push_back(30, 3, 3);
+        batch.set_horizontal_flip(3, true);
+        BN_ASSERT(batch.size() == 4);
+
+        for(int index = 0; index < 4; ++index)
+        {
+            BN_ASSERT(batch.position(index) == bn::point(index * 10, index));
+            BN_ASSERT(batch.tiles_index(index) == index);
+        }
+
+        // The erased sprite is replaced with the last one:
+        batch.erase(1);
+        BN_ASSERT(batch.size() == 3);
+        BN_ASSERT(batch.position(0) == bn::point(0, 0));
+        BN_ASSERT(batch.position(1) == bn::point(30, 3));
+        BN_ASSERT(batch.tiles_index(1) == 3);
+        BN_ASSERT(batch.horizontal_flip(1));
+        BN_ASSERT(batch.position(2) == bn::point(20, 2));
+        BN_ASSERT(batch.tiles_index(2) == 2);
+        BN_ASSERT(! batch.horizontal_flip(2));
+
+        // Erasing the last sprite keeps the other ones:
+        batch.erase(2);
+        BN_ASSERT(batch.size() == 2);
+        BN_ASSERT(batch.position(1) == bn::point(30, 3));
+
+        batch.pop_back();
+        BN_ASSERT(batch.size() == 1);
+        BN_ASSERT(batch.position(0) == bn::point(0, 0));
+
+        batch.clear();
+        BN_ASSERT(batch.empty());
+    }
+
+    static void _full_test()
+    {
+        // Pushing a sprite into a full batch stops the execution, so the batch must report it:
+        bn::sprite_batch<2, 4> batch(bn::sprite_items::streamed_sprite);
+        BN_ASSERT(batch.max_size() == 2);
+
+        batch.push_back(0, 0);
+        BN_ASSERT(! batch.full());
+
+        batch.push_back(0, 0);
+        BN_ASSERT(batch.full());
+
+        batch.erase(0);
+        BN_ASSERT(! batch.full());
+    }
+
+    static void _oam_test()
+    {
+        batch_type batch(bn::sprite_items::streamed_sprite);
+        batch.push_back(-40, -20, 0);
+        batch.push_back(-20, 10, 1);
+        batch.push_back(0, 30, 2);
+        batch.push_back(20, -30, 3);
+        batch.set_vertical_flip(2, true);
+
+        // Sprites outside the screen don't take OAM entries:
+        batch.push_back(bn::display::width(), 0, 0);
+
+        bn::core::update();
+        _check(batch, 0, 4);
+        BN_ASSERT(_hidden(4));
+
+        batch.erase(0);
+        batch.set_position(1, 50, -50);
+        bn::core::update();
+        _check(batch, 0, 3);
+        BN_ASSERT(_hidden(3));
+
+        batch.set_visible(false);
+        bn::core::update();
+        BN_ASSERT(_hidden(0));
+    }
+
+    static void _sprite_items_order_test()
+    {
+        bn::sprite_ptr sprite = bn::sprite_items::streamed_sprite.create_sprite(0, 0);
+        batch_type batch(bn::sprite_items::streamed_sprite);
+        batch.push_back(0, 0, 1);
+        batch.push_back(16, 0, 2);
+
+        // Batches are drawn below sprite items, so they are placed after them in OAM:
+        bn::core::update();
+        BN_ASSERT(! _hidden(0));
+        _check(batch, 1, 2);
+        BN_ASSERT(_hidden(3));
+    }
+
+    static void _check(const bn::isprite_batch& batch, int first_handle, int visible_sprites)
+    {
+        const bn::sprite_shape_size& shape_size = batch.shape_size();
+        int width = shape_size.width();
+        int height = shape_size.height();
+        const bn::sprite_tiles_item& tiles_item = bn::sprite_items::streamed_sprite.tiles_item();
+        auto vram_tiles_ptr = reinterpret_cast<const bn::tile*>(tile_mem[4]);
+        int handle_index = first_handle;
+
+        for(int index = 0, limit = batch.size(); index < limit; ++index)
+        {
+            int x = batch.x(index) + (bn::display::width() / 2) - (width / 2);
+            int y = batch.y(index) + (bn::display::height() / 2) - (height / 2);
+
+            if(x < bn::display::width() && x + width > 0 && y < bn::display::height() && y + height > 0)
+            {
+                const OBJ_ATTR& handle = oam_mem[handle_index];
+                BN_ASSERT(! _hidden(handle_index), "Hidden sprite: ", index);
+                BN_ASSERT((handle.attr0 & ATTR0_Y_MASK) == (y & ATTR0_Y_MASK), "Invalid y: ", index);
+                BN_ASSERT((handle.attr1 & ATTR1_X_MASK) == (x & ATTR1_X_MASK), "Invalid x: ", index);
+                BN_ASSERT(bool(handle.attr1 & ATTR1_HFLIP) == batch.horizontal_flip(index),
+                          "Invalid horizontal flip: ", index);
+                BN_ASSERT(bool(handle.attr1 & ATTR1_VFLIP) == batch.vertical_flip(index),
+                          "Invalid vertical flip: ", index);
+
+                int start_tile = (handle.attr2 & ATTR2_ID_MASK) >> ATTR2_ID_SHIFT;
+                bn::span<const bn::tile> expected_tiles = tiles_item.graphics_tiles_ref(batch.tiles_index(index));
+
+                for(int tile_index = 0, tiles_limit = expected_tiles.size(); tile_index < tiles_limit; ++tile_index)
+                {
+                    const bn::tile& expected_tile = expected_tiles[tile_index];
+                    const bn::tile& vram_tile = vram_tiles_ptr[start_tile + tile_index];
+
+                    for(int row = 0; row < 8; ++row)
+                    {
+                        BN_ASSERT(vram_tile.data[row] == expected_tile.data[row],
+                                  "Invalid tile: ", index, " - ", tile_index, " - ", row);
+                    }
+                }
+
+                ++handle_index;
+            }
+        }
+
+        BN_ASSERT(handle_index - first_handle == visible_sprites, handle_index - first_handle, " - ", visible_sprites);
+    }
+
+    [[nodiscard]] static bool _hidden(int handle_index)
+    {
+        return (oam_mem[handle_index].attr0 & ATTR0_MODE_MASK) == ATTR0_HIDE;
+    }
+};
+
+#endif
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2020-2025 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef SPRITE_HBE_CLEANUP_TESTS_H
+#define SPRITE_HBE_CLEANUP_TESTS_H
+
+#include "bn_core.h"
+#include "bn_array.h"
+#include "bn_display.h"
+#include "bn_sprite_ptr.h"
+#include "bn_sprite_first_attributes.h"
+#include "bn_sprite_regular_second_attributes.h"
+#include "bn_sprite_first_attributes_hbe_ptr.h"
+#include "bn_sprite_regular_second_attributes_hbe_ptr.h"
+#include "bn_sprite_items_streamed_sprite.h"
+#include "../../butano/hw/include/bn_hw_tonc.h"
+#include "tests.h"
+
+class sprite_hbe_cleanup_tests : public tests
+{
+
+public:
+    sprite_hbe_cleanup_tests() :
+        tests("sprite_hbe_cleanup")
+    {
+        _first_attributes_test();
+        _second_attributes_test();
+    }
+
+private:
+    using oam_type = bn::array<uint16_t, 128 * 3>;
+
+    [[nodiscard]] static oam_type _oam()
+    {
+        oam_type result;
+
+        for(int index = 0; index < 128; ++index)
+        {
+            const OBJ_ATTR& handle = oam_mem[index];
+            result[index * 3] = handle.attr0;
+            result[(index * 3) + 1] = handle.attr1;
+            result[(index * 3) + 2] = handle.attr2;
+        }
+
+        return result;
+    }
+
+    static void _first_attributes_test()
+    {
+        bn::sprite_ptr sprite = bn::sprite_items::streamed_sprite.create_sprite(0, 0);
+        bn::core::update();
+
+        oam_type expected_oam = _oam();
+
+        bn::sprite_first_attributes hbe_attributes = sprite.first_attributes();
+        hbe_attributes.set_mosaic_enabled(true);
+        hbe_attributes.set_y(-16);
+
+        bn::array<bn::sprite_first_attributes, bn::display::height()> attributes;
+        attributes.fill(hbe_attributes);
+
+        {
+            bn::sprite_first_attributes_hbe_ptr hbe = bn::sprite_first_attributes_hbe_ptr::create(sprite, attributes);
+            bn::core::update();
+            bn::core::update();
+            BN_ASSERT(_oam() != expected_oam);
+        }
+
+        // The H-Blank effect writes OAM directly, so removing it must commit the sprite attributes again:
+        bn::core::update();
+        bn::core::update();
+        BN_ASSERT(_oam() == expected_oam);
+    }
+
+    static void _second_attributes_test()
+    {
+        bn::sprite_ptr sprite = bn::sprite_items::streamed_sprite.create_sprite(0, 0);
+        bn::core::update();
+
+        oam_type expected_oam = _oam();
+
+        bn::sprite_regular_second_attributes hbe_attributes = sprite.regular_second_attributes();
+        hbe_attributes.set_x(32);
+        hbe_attributes.set_horizontal_flip(true);
+
+        bn::array<bn::sprite_regular_second_attributes, bn::display::height()> attributes;
+        attributes.fill(hbe_attributes);
+
+        {
+            bn::sprite_regular_second_attributes_hbe_ptr hbe =
+                    bn::sprite_regular_second_attributes_hbe_ptr::create(sprite, attributes);
+            bn::core::update();
+            bn::core::update();
+            BN_ASSERT(_oam() != expected_oam);
+        }
+
+        bn::core::update();
+        bn::core::update();
+        BN_ASSERT(_oam() == expected_oam);
+    }
+};
+
+#endif
@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2020-2025 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef SPRITE_STREAMED_ANIMATE_ACTION_TESTS_H
+#define SPRITE_STREAMED_ANIMATE_ACTION_TESTS_H
+
+#include "bn_core.h"
+#include "bn_optional.h"
+#include "bn_sprite_ptr.h"
+#include "bn_sprite_tiles_ptr.h"
+#include "bn_sprite_animate_actions.h"
+#include "bn_sprite_items_streamed_sprite.h"
+#include "tests.h"
+
+class sprite_streamed_animate_action_tests : public tests
+{
+
+public:
+    sprite_streamed_animate_action_tests() :
+        tests("sprite_streamed_animate_action")
+    {
+        _forever_test();
+        _once_test();
+        _wait_updates_test();
+        _same_frame_test();
+        _destroy_test();
+    }
+
+private:
+    static void _forever_test()
+    {
+        const bn::sprite_item& item = bn::sprite_items::streamed_sprite;
+        const bn::sprite_tiles_item& tiles_item = item.tiles_item();
+        BN_ASSERT(tiles_item.compression() == bn::compression_type::NONE);
+        BN_ASSERT(tiles_item.graphics_count() == 4);
+
+        bn::sprite_ptr sprite = item.create_sprite(0, 0);
+        auto action = bn::create_sprite_streamed_animate_action_forever(sprite, 0, tiles_item, 1, 2, 3, 0);
+        BN_ASSERT(action.front_tiles() != action.back_tiles());
+
+        int graphics_indexes[] = { 1, 2, 3, 0, 1, 2 };
+
+        for(int graphics_index : graphics_indexes)
+        {
+            // The back slot is shown and becomes the front slot:
+            bn::sprite_tiles_ptr back_tiles = action.back_tiles();
+            action.update();
+            BN_ASSERT(! action.done());
+            BN_ASSERT(action.front_tiles() == back_tiles);
+            BN_ASSERT(action.sprite().tiles() == back_tiles);
+
+            bn::core::update();
+            _check(back_tiles, tiles_item, graphics_index);
+        }
+    }
+
+    static void _once_test()
+    {
+        const bn::sprite_tiles_item& tiles_item = bn::sprite_items::streamed_sprite.tiles_item();
+        bn::sprite_ptr sprite = bn::sprite_items::streamed_sprite.create_sprite(0, 0);
+
+        // Repeated tile sets are not copied again:
+        auto action = bn::create_sprite_streamed_animate_action_once(bn::move(sprite), 0, tiles_item, 3, 3, 1);
+        action.update();
+        bn::sprite_tiles_ptr first_tiles = action.front_tiles();
+        bn::core::update();
+        _check(first_tiles, tiles_item, 3);
+
+        action.update();
+        BN_ASSERT(action.front_tiles() == first_tiles);
+        BN_ASSERT(! action.done());
+        bn::core::update();
+        _check(first_tiles, tiles_item, 3);
+
+        action.update();
+        BN_ASSERT(action.front_tiles() != first_tiles);
+        BN_ASSERT(action.done());
+        bn::core::update();
+        _check(action.front_tiles(), tiles_item, 1);
+
+        action.reset();
+        BN_ASSERT(! action.done());
+        BN_ASSERT(action.current_graphics_index() == 3);
+    }
+
+    static void _wait_updates_test()
+    {
+        const bn::sprite_tiles_item& tiles_item = bn::sprite_items::streamed_sprite.tiles_item();
+        bn::sprite_ptr sprite = bn::sprite_items::streamed_sprite.create_sprite(0, 0);
+        auto action = bn::create_sprite_streamed_animate_action_forever(sprite, 2, tiles_item, 1, 2);
+        action.update();
+        BN_ASSERT(action.current_graphics_index() == 2);
+        BN_ASSERT(action.next_change_updates() == 2);
+
+        // Tile sets are changed once every wait_updates + 1 updates:
+        bn::sprite_tiles_ptr front_tiles = action.front_tiles();
+        action.update();
+        action.update();
+        BN_ASSERT(action.front_tiles() == front_tiles);
+        BN_ASSERT(action.next_change_updates() == 0);
+
+        action.update();
+        BN_ASSERT(action.front_tiles() != front_tiles);
+        bn::core::update();
+        _check(action.front_tiles(), tiles_item, 2);
+    }
+
+    static void _same_frame_test()
+    {
+        const bn::sprite_tiles_item& tiles_item = bn::sprite_items::streamed_sprite.tiles_item();
+        bn::sprite_ptr sprite = bn::sprite_items::streamed_sprite.create_sprite(0, 0);
+        auto action = bn::create_sprite_streamed_animate_action_forever(sprite, 0, tiles_item, 1, 2, 3);
+
+        // All queued copies are done in the next V-Blank:
+        action.update();
+        action.update();
+        action.update();
+        bn::core::update();
+        _check(action.front_tiles(), tiles_item, 3);
+        _check(action.back_tiles(), tiles_item, 2);
+    }
+
+    static void _destroy_test()
+    {
+        const bn::sprite_tiles_item& tiles_item = bn::sprite_items::streamed_sprite.tiles_item();
+        bn::sprite_ptr sprite = bn::sprite_items::streamed_sprite.create_sprite(0, 0);
+
+        {
+            auto action = bn::create_sprite_streamed_animate_action_forever(sprite, 0, tiles_item, 1, 2);
+            action.update();
+            action.update();
+        }
+
+        // Queued copies of destroyed tiles are discarded, the shown ones are kept by the sprite:
+        bn::core::update();
+        _check(sprite.tiles(), tiles_item, 2);
+    }
+
+    static void _check(bn::sprite_tiles_ptr tiles, const bn::sprite_tiles_item& tiles_item, int graphics_index)
+    {
+        // Streamed tiles are allocated, so they can be read from VRAM:
+        bn::optional<bn::span<bn::tile>> vram_tiles = tiles.vram();
+        BN_ASSERT(vram_tiles.has_value());
+
+        bn::span<const bn::tile> expected_tiles = tiles_item.graphics_tiles_ref(graphics_index);
+        BN_ASSERT(vram_tiles->size() == expected_tiles.size());
+
+        for(int tile_index = 0, limit = expected_tiles.size(); tile_index < limit; ++tile_index)
+        {
+            const bn::tile& expected_tile = expected_tiles[tile_index];
+            const bn::tile& vram_tile = (*vram_tiles)[tile_index];
+
+            for(int row = 0; row < 8; ++row)
+            {
+                BN_ASSERT(vram_tile.data[row] == expected_tile.data[row],
+                          "Invalid tile: ", graphics_index, " - ", tile_index, " - ", row);
+            }
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2020-2025 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef SPRITE_TEXT_TESTS_H
+#define SPRITE_TEXT_TESTS_H
+
+#include "bn_core.h"
+#include "bn_size.h"
+#include "bn_vector.h"
+#include "bn_optional.h"
+#include "bn_sprite_text.h"
+#include "bn_sprite_tiles_ptr.h"
+#include "common_fixed_8x16_sprite_font.h"
+#include "common_variable_8x8_sprite_font.h"
+#include "tests.h"
+
+class sprite_text_tests : public tests
+{
+
+public:
+    sprite_text_tests() :
+        tests("sprite_text")
+    {
+        _set_text_test(common::variable_8x8_sprite_font);
+        _set_text_test(common::fixed_8x16_sprite_font);
+        _set_alignment_test();
+    }
+
+private:
+    static constexpr int _max_sprites = 8;
+    static constexpr int _canvas_width = _max_sprites * 32;
+
+    using sprites_type = bn::vector<bn::sprite_ptr, _max_sprites>;
+
+    static void _set_text_test(const bn::sprite_font& font)
+    {
+        bn::sprite_text_generator::alignment_type alignments[] = {
+            bn::sprite_text_generator::alignment_type::LEFT,
+            bn::sprite_text_generator::alignment_type::CENTER,
+            bn::sprite_text_generator::alignment_type::RIGHT
+        };
+
+        for(bn::sprite_text_generator::alignment_type alignment : alignments)
+        {
+            bn::sprite_text_generator generator(font);
+            generator.set_alignment(alignment);
+
+            int x = 0;
+
+            if(alignment == bn::sprite_text_generator::alignment_type::LEFT)
+            {
+                x = -_canvas_width / 2;
+            }
+            else if(alignment == bn::sprite_text_generator::alignment_type::RIGHT)
+            {
+                x = _canvas_width / 2;
+            }
+
+            bn::sprite_text<_max_sprites> text(generator, x, 0, "SCORE: 100000");
+            _check(text, "SCORE: 100000");
+
+            // Changed digits:
+            text.set_text("SCORE: 100001");
+            _check(text, "SCORE: 100001");
+
+            text.set_text("SCORE: 100999");
+            _check(text, "SCORE: 100999");
+
+            // Wider text with more sprites:
+            int sprites_count = text.sprites().size();
+            text.set_text("SCORE: 100999 - HIGH: 999999");
+            _check(text, "SCORE: 100999 - HIGH: 999999");
+            BN_ASSERT(text.sprites().size() > sprites_count, text.sprites().size(), " - ", sprites_count);
+
+            // Narrower text with less sprites:
+            sprites_count = text.sprites().size();
+            text.set_text("LIVES: 3");
+            _check(text, "LIVES: 3");
+            BN_ASSERT(text.sprites().size() < sprites_count, text.sprites().size(), " - ", sprites_count);
+
+            // Different characters with the same width:
+            text.set_text("LIVES: 2");
+            _check(text, "LIVES: 2");
+
+            text.set_text("");
+            _check(text, "");
+            BN_ASSERT(text.sprites().empty());
+
+            text.set_text("GAME OVER");
+            _check(text, "GAME OVER");
+        }
+    }
+
+    static void _set_alignment_test()
+    {
+        bn::sprite_text_generator generator(common::variable_8x8_sprite_font);
+        bn::sprite_text<_max_sprites> text(generator, 0, 0, "PAUSE 123");
+        _check(text, "PAUSE 123");
+
+        text.set_alignment(bn::sprite_text_generator::alignment_type::CENTER);
+        _check(text, "PAUSE 123");
+
+        text.set_alignment(bn::sprite_text_generator::alignment_type::RIGHT);
+        text.set_text("PAUSE 1");
+        _check(text, "PAUSE 1");
+    }
+
+    static void _check(const bn::isprite_text& text, const bn::string_view& text_string)
+    {
+        // Sprites are placed in a different way, so the pixels drawn by both of them are compared:
+        sprites_type generated_sprites;
+        text.generator().generate(text.position(), text_string, generated_sprites);
+        BN_ASSERT(text.width() == text.generator().width(text_string), text.width(), " - ", text_string);
+
+        int height = text.generator().font().item().shape_size().height();
+        int first_x = text.position().x().right_shift_integer();
+
+        if(text.alignment() == bn::sprite_text_generator::alignment_type::CENTER)
+        {
+            first_x -= _canvas_width / 2;
+        }
+        else if(text.alignment() == bn::sprite_text_generator::alignment_type::RIGHT)
+        {
+            first_x -= _canvas_width;
+        }
+
+        for(int y = -height / 2; y < height / 2; ++y)
+        {
+            for(int x = first_x, last_x = first_x + _canvas_width; x < last_x; ++x)
+            {
+                int pixel = _pixel(text.sprites(), x, y);
+                int generated_pixel = _pixel(generated_sprites, x, y);
+                BN_ASSERT(pixel == generated_pixel, "Invalid pixel: ", text_string, " - ", x, " - ", y);
+            }
+        }
+    }
+
+    [[nodiscard]] static int _pixel(const bn::ivector<bn::sprite_ptr>& sprites, int x, int y)
+    {
+        for(const bn::sprite_ptr& sprite : sprites)
+        {
+            bn::size dimensions = sprite.dimensions();
+            int sprite_x = x - sprite.x().right_shift_integer() + (dimensions.width() / 2);
+            int sprite_y = y - sprite.y().right_shift_integer() + (dimensions.height() / 2);
+
+            if(sprite_x >= 0 && sprite_x < dimensions.width() && sprite_y >= 0 && sprite_y < dimensions.height())
+            {
+                bn::sprite_tiles_ptr tiles = sprite.tiles();
+                bn::optional<bn::span<bn::tile>> vram_tiles = tiles.vram();
+                BN_ASSERT(vram_tiles.has_value());
+
+                int tile_index = ((sprite_y / 8) * (dimensions.width() / 8)) + (sprite_x / 8);
+                const bn::tile& tile = (*vram_tiles)[tile_index];
+                return int(tile.data[sprite_y % 8] >> ((sprite_x % 8) * 4)) & 0xF;
+            }
+        }
+
+        return 0;
+    }
+};
+
+#endif
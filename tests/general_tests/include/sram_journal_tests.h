@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2020-2025 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef SRAM_JOURNAL_TESTS_H
+#define SRAM_JOURNAL_TESTS_H
+
+#include "bn_sram.h"
+#include "bn_array.h"
+#include "bn_sram_journal.h"
+#include "tests.h"
+
+class sram_journal_tests : public tests
+{
+
+public:
+    sram_journal_tests() :
+        tests("sram_journal")
+    {
+        _round_trip_test();
+        _abandoned_write_test();
+        _corrupted_slot_test();
+        _progress_test();
+    }
+
+private:
+    struct test_data
+    {
+        bn::array<int, 16> values;
+    };
+
+    using journal_type = bn::sram_journal<test_data>;
+
+    // Journal slots are placed at the end of SRAM, so they don't overlap SRAM tests data:
+    static constexpr int _offset = bn::sram::size() - ((bn::isram_journal::header_size() + 64) * 2);
+
+    static_assert(sizeof(test_data) == 64);
+
+    [[nodiscard]] static test_data _data(int seed)
+    {
+        test_data result;
+
+        for(int index = 0, limit = result.values.size(); index < limit; ++index)
+        {
+            result.values[index] = (seed * 1000) + index;
+        }
+
+        return result;
+    }
+
+    static void _round_trip_test()
+    {
+        journal_type journal(_offset);
+        journal.clear();
+
+        test_data loaded;
+        BN_ASSERT(! journal.read(loaded));
+
+        test_data expected = _data(1);
+        journal.write(expected);
+        journal.flush();
+        BN_ASSERT(! journal.writing());
+        BN_ASSERT(journal.completed());
+
+        // A new journal must read the data from SRAM, not from the snapshot of the previous one:
+        journal_type other_journal(_offset);
+        BN_ASSERT(other_journal.read(loaded));
+        BN_ASSERT(loaded.values == expected.values);
+    }
+
+    static void _abandoned_write_test()
+    {
+        test_data first = _data(2);
+        test_data second = _data(3);
+
+        {
+            journal_type journal(_offset, 8);
+            journal.clear();
+            journal.write(first);
+            journal.flush();
+
+            // The second write is abandoned halfway, like when the console is turned off:
+            journal.write(second);
+            journal.update();
+            journal.update();
+            BN_ASSERT(journal.writing());
+        }
+
+        journal_type journal(_offset);
+        test_data loaded;
+        BN_ASSERT(journal.read(loaded));
+        BN_ASSERT(loaded.values == first.values);
+
+        // The abandoned slot is written again by the next write:
+        journal.write(second);
+        journal.flush();
+
+        journal_type other_journal(_offset);
+        BN_ASSERT(other_journal.read(loaded));
+        BN_ASSERT(loaded.values == second.values);
+    }
+
+    static void _corrupted_slot_test()
+    {
+        test_data first = _data(4);
+        test_data second = _data(5);
+
+        journal_type journal(_offset);
+        journal.clear();
+        journal.write(first);
+        journal.flush();
+        journal.write(second);
+        journal.flush();
+
+        // Both slots are valid, so the first write is in the first slot and the second write in the second one:
+        int corrupted_offset = _offset + journal.slot_size() + bn::isram_journal::header_size();
+        int corrupted_value = second.values[0] + 1;
+        bn::sram::write_offset(corrupted_value, corrupted_offset);
+
+        journal_type other_journal(_offset);
+        test_data loaded;
+        BN_ASSERT(other_journal.read(loaded));
+        BN_ASSERT(loaded.values == first.values);
+    }
+
+    static void _progress_test()
+    {
+        constexpr int max_bytes_per_update = 16;
+
+        journal_type journal(_offset, max_bytes_per_update);
+        journal.clear();
+        BN_ASSERT(! journal.writing());
+        BN_ASSERT(! journal.completed());
+
+        journal.write(_data(6));
+        BN_ASSERT(journal.writing());
+        BN_ASSERT(journal.written_bytes() == 0);
+        BN_ASSERT(journal.progress() == 0);
+
+        int updates = 0;
+        int last_written_bytes = 0;
+
+        while(journal.writing())
+        {
+            journal.update();
+            ++updates;
+
+            int written_bytes = journal.written_bytes();
+            BN_ASSERT(written_bytes > last_written_bytes);
+            BN_ASSERT(written_bytes - last_written_bytes <= max_bytes_per_update);
+            BN_ASSERT(journal.progress() > 0 && journal.progress() <= 1);
+            last_written_bytes = written_bytes;
+        }
+
+        // Data is written a few bytes per update, and the header is written in a separate update at the end:
+        BN_ASSERT(updates == (int(sizeof(test_data)) / max_bytes_per_update) + 1, updates);
+        BN_ASSERT(journal.completed());
+        BN_ASSERT(journal.written_bytes() == journal.total_bytes());
+        BN_ASSERT(journal.progress() == 1);
+
+        journal.clear();
+    }
+};
+
+#endif
@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2020-2025 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef STAGING_TESTS_H
+#define STAGING_TESTS_H
+
+#include "bn_core.h"
+#include "bn_optional.h"
+#include "bn_sprite_tiles_ptr.h"
+#include "bn_regular_bg_ptr.h"
+#include "bn_regular_bg_map_ptr.h"
+#include "bn_regular_bg_tiles_ptr.h"
+#include "bn_config_bg_blocks.h"
+#include "bn_config_sprite_tiles.h"
+#include "bn_sprite_items_staging_sprite.h"
+#include "bn_regular_bg_items_chunked_bg.h"
+#include "bn_regular_bg_items_staging_bg.h"
+#include "tests.h"
+
+#if ! BN_CFG_SPRITE_TILES_STAGING_BUFFER_SIZE || ! BN_CFG_BG_BLOCKS_STAGING_BUFFER_SIZE
+    static_assert(false, "Enable staging buffers in the Makefile to run staging tests");
+#endif
+
+#if ! BN_CFG_BG_BLOCKS_MAX_MAP_CHUNKS
+    static_assert(false, "Enable big map chunks in the Makefile to run staging tests");
+#endif
+
+class staging_tests : public tests
+{
+
+public:
+    staging_tests() :
+        tests("staging")
+    {
+        _sprite_tiles_test();
+        _regular_bg_tiles_test();
+        _compressed_big_map_test();
+    }
+
+private:
+    static void _sprite_tiles_test()
+    {
+        const bn::sprite_tiles_item& tiles_item = bn::sprite_items::staging_sprite.tiles_item();
+        BN_ASSERT(tiles_item.compression() != bn::compression_type::NONE);
+
+        {
+            bn::sprite_tiles_ptr tiles = tiles_item.create_tiles();
+
+            // Compressed tiles which fit in the staging buffer are not ready until the next update:
+            BN_ASSERT(! tiles.ready());
+            BN_ASSERT(! tiles.vram());
+
+            // Tiles being staged can be found and shared:
+            bn::optional<bn::sprite_tiles_ptr> found_tiles = bn::sprite_tiles_ptr::find(tiles_item);
+            BN_ASSERT(found_tiles && found_tiles->id() == tiles.id());
+            BN_ASSERT(! found_tiles->ready());
+
+            bn::sprite_tiles_ptr shared_tiles = bn::sprite_tiles_ptr::create(tiles_item);
+            BN_ASSERT(shared_tiles.id() == tiles.id());
+
+            bn::core::update();
+            BN_ASSERT(tiles.ready());
+            BN_ASSERT(found_tiles->ready());
+        }
+
+        bn::core::update();
+        BN_ASSERT(! bn::sprite_tiles_ptr::find(tiles_item));
+
+        // Tiles destroyed before being staged don't block the staging buffer:
+        {
+            bn::sprite_tiles_ptr discarded_tiles = tiles_item.create_tiles();
+            BN_ASSERT(! discarded_tiles.ready());
+        }
+
+        bn::core::update();
+
+        bn::sprite_tiles_ptr tiles = tiles_item.create_tiles();
+        BN_ASSERT(! tiles.ready());
+        bn::core::update();
+        BN_ASSERT(tiles.ready());
+    }
+
+    static void _regular_bg_tiles_test()
+    {
+        const bn::regular_bg_tiles_item& tiles_item = bn::regular_bg_items::staging_bg.tiles_item();
+        BN_ASSERT(tiles_item.compression() != bn::compression_type::NONE);
+
+        bn::regular_bg_tiles_ptr tiles = tiles_item.create_tiles();
+        BN_ASSERT(! tiles.ready());
+        BN_ASSERT(! tiles.vram());
+
+        bn::optional<bn::regular_bg_tiles_ptr> found_tiles = bn::regular_bg_tiles_ptr::find(tiles_item);
+        BN_ASSERT(found_tiles && found_tiles->id() == tiles.id());
+
+        bn::core::update();
+        BN_ASSERT(tiles.ready());
+        BN_ASSERT(found_tiles->ready());
+
+        // Staged BGs are shown with the staged tiles:
+        bn::regular_bg_ptr bg = bn::regular_bg_items::staging_bg.create_bg(0, 0);
+        BN_ASSERT(bg.tiles().id() == tiles.id());
+        bn::core::update();
+        BN_ASSERT(bg.map().ready());
+    }
+
+    static void _compressed_big_map_test()
+    {
+        const bn::regular_bg_map_item& map_item = bn::regular_bg_items::chunked_bg.map_item();
+        const bn::size& dimensions = map_item.dimensions();
+        BN_ASSERT(map_item.compression() != bn::compression_type::NONE);
+        BN_ASSERT(dimensions.width() * dimensions.height() * 2 <= BN_CFG_BG_BLOCKS_STAGING_BUFFER_SIZE);
+
+        bn::regular_bg_ptr bg = bn::regular_bg_items::chunked_bg.create_bg(0, 0);
+        bn::regular_bg_map_ptr map = bg.map();
+        BN_ASSERT(map.big());
+        BN_ASSERT(! map.vram());
+
+        // Big maps are committed from bgs_manager, so they must not wait for the staging buffer:
+        BN_ASSERT(map.ready());
+        bn::core::update();
+        BN_ASSERT(map.ready());
+
+        bn::optional<bn::regular_bg_map_ptr> found_map = bn::regular_bg_map_ptr::find(bn::regular_bg_items::chunked_bg);
+        BN_ASSERT(found_map && found_map->id() == map.id());
+        BN_ASSERT(found_map->ready());
+    }
+};
+
+#endif
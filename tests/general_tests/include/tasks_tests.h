@@ -0,0 +1,255 @@
+/*
+ * Copyright (c) 2020-2025 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef TASKS_TESTS_H
+#define TASKS_TESTS_H
+
+#include "bn_core.h"
+#include "bn_array.h"
+#include "bn_tasks.h"
+#include "bn_vector.h"
+#include "bn_config_tasks.h"
+#include "tests.h"
+
+static_assert(BN_CFG_TASKS_MAX_ITEMS >= 4, "Tasks are disabled (see BN_CFG_TASKS_MAX_ITEMS)");
+
+struct tasks_tests_destroy_counter
+{
+    int* destructions;
+
+    ~tasks_tests_destroy_counter()
+    {
+        ++*destructions;
+    }
+};
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wswitch-default"
+
+class tasks_tests : public tests
+{
+
+public:
+    tasks_tests() :
+        tests("tasks")
+    {
+        _next_frame_test();
+        _wait_frames_test();
+        _wait_until_test();
+        _wait_done_test();
+        _destroy_test();
+        _frame_size_test();
+        _max_items_test();
+    }
+
+private:
+    static bn::task _next_frame_task(int& counter)
+    {
+        while(true)
+        {
+            ++counter;
+            co_await bn::tasks::next_frame();
+        }
+    }
+
+    static bn::task _wait_frames_task(int frames, int& resumes)
+    {
+        co_await bn::tasks::wait_frames(frames);
+        ++resumes;
+    }
+
+    static bn::task _wait_until_task(const bool& ready, int& resumes)
+    {
+        co_await bn::tasks::wait_until([&ready]() { return ready; });
+        ++resumes;
+    }
+
+    static bn::task _wait_done_task(const bn::task& other_task, int& resumes)
+    {
+        co_await bn::tasks::wait_done(other_task);
+        ++resumes;
+    }
+
+    static bn::task _destroy_task(int& destructions, int& resumes)
+    {
+        tasks_tests_destroy_counter counter{ &destructions };
+        co_await bn::tasks::wait_frames(10);
+        ++resumes;
+    }
+
+    static bn::task _frame_size_task(int& result)
+    {
+        // Local variables which live across suspension points are stored in the task frame:
+        bn::array<uint8_t, BN_CFG_TASKS_MAX_FRAME_SIZE / 2> values;
+
+        for(int index = 0, limit = values.size(); index < limit; ++index)
+        {
+            values[index] = uint8_t(index);
+        }
+
+        co_await bn::tasks::next_frame();
+
+        result = 0;
+
+        for(int index = 0, limit = values.size(); index < limit; ++index)
+        {
+            result += values[index] == uint8_t(index);
+        }
+    }
+
+    static void _next_frame_test()
+    {
+        int counter = 0;
+        int used_items_count = bn::tasks::used_items_count();
+
+        {
+            // Tasks run until their first suspension point when they are created:
+            bn::task task = _next_frame_task(counter);
+            BN_ASSERT(counter == 1);
+            BN_ASSERT(! task.done());
+            BN_ASSERT(bn::tasks::used_items_count() == used_items_count + 1);
+
+            bn::core::update();
+            BN_ASSERT(counter == 2);
+
+            bn::core::update();
+            BN_ASSERT(counter == 3);
+        }
+
+        BN_ASSERT(bn::tasks::used_items_count() == used_items_count);
+
+        bn::core::update();
+        BN_ASSERT(counter == 3);
+    }
+
+    static void _wait_frames_test()
+    {
+        int resumes = 0;
+        bn::task task = _wait_frames_task(3, resumes);
+        BN_ASSERT(! task.done());
+
+        bn::core::update();
+        bn::core::update();
+        BN_ASSERT(resumes == 0);
+        BN_ASSERT(! task.done());
+
+        bn::core::update();
+        BN_ASSERT(resumes == 1);
+        BN_ASSERT(task.done());
+
+        // Tasks are not suspended when there's nothing to wait:
+        bn::task no_wait_task = _wait_frames_task(0, resumes);
+        BN_ASSERT(resumes == 2);
+        BN_ASSERT(no_wait_task.done());
+    }
+
+    static void _wait_until_test()
+    {
+        bool ready = false;
+        int resumes = 0;
+        bn::task task = _wait_until_task(ready, resumes);
+
+        bn::core::update();
+        bn::core::update();
+        BN_ASSERT(resumes == 0);
+
+        ready = true;
+        bn::core::update();
+        BN_ASSERT(resumes == 1);
+        BN_ASSERT(task.done());
+
+        bn::task ready_task = _wait_until_task(ready, resumes);
+        BN_ASSERT(resumes == 2);
+        BN_ASSERT(ready_task.done());
+    }
+
+    static void _wait_done_test()
+    {
+        int wait_frames_resumes = 0;
+        int wait_done_resumes = 0;
+        bn::task wait_frames_task = _wait_frames_task(2, wait_frames_resumes);
+        bn::task wait_done_task = _wait_done_task(wait_frames_task, wait_done_resumes);
+
+        bn::core::update();
+        BN_ASSERT(wait_frames_resumes == 0);
+        BN_ASSERT(wait_done_resumes == 0);
+
+        bn::core::update();
+        BN_ASSERT(wait_frames_resumes == 1);
+        BN_ASSERT(wait_frames_task.done());
+
+        // Depending on the order of the tasks in the pool, the waiting task is resumed in the same update
+        // or in the next one:
+        bn::core::update();
+        BN_ASSERT(wait_done_resumes == 1);
+        BN_ASSERT(wait_done_task.done());
+    }
+
+    static void _destroy_test()
+    {
+        int destructions = 0;
+        int resumes = 0;
+        int used_items_count = bn::tasks::used_items_count();
+
+        {
+            bn::task task = _destroy_task(destructions, resumes);
+            bn::core::update();
+            BN_ASSERT(destructions == 0);
+        }
+
+        // Destroying a waiting task destroys its local variables and releases its frame:
+        BN_ASSERT(destructions == 1);
+        BN_ASSERT(bn::tasks::used_items_count() == used_items_count);
+
+        for(int index = 0; index < 12; ++index)
+        {
+            bn::core::update();
+        }
+
+        BN_ASSERT(resumes == 0);
+        BN_ASSERT(destructions == 1);
+    }
+
+    static void _frame_size_test()
+    {
+        // Tasks with frames bigger than BN_CFG_TASKS_MAX_FRAME_SIZE stop the execution,
+        // so a frame which fits must keep its contents across frames:
+        int result = -1;
+        bn::task task = _frame_size_task(result);
+        BN_ASSERT(result == -1);
+
+        bn::core::update();
+        BN_ASSERT(result == BN_CFG_TASKS_MAX_FRAME_SIZE / 2, result);
+        BN_ASSERT(task.done());
+    }
+
+    static void _max_items_test()
+    {
+        // Creating a task when the pool is full stops the execution, so the pool must report it:
+        int counter = 0;
+        int available_items_count = bn::tasks::available_items_count();
+        BN_ASSERT(available_items_count + bn::tasks::used_items_count() == BN_CFG_TASKS_MAX_ITEMS);
+
+        {
+            bn::vector<bn::task, BN_CFG_TASKS_MAX_ITEMS> tasks;
+
+            for(int index = 0; index < available_items_count; ++index)
+            {
+                tasks.push_back(_next_frame_task(counter));
+            }
+
+            BN_ASSERT(bn::tasks::available_items_count() == 0);
+
+            bn::core::update();
+            BN_ASSERT(counter == available_items_count * 2);
+        }
+
+        BN_ASSERT(bn::tasks::available_items_count() == available_items_count);
+    }
+};
+
+#pragma GCC diagnostic pop
+
+#endif
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2020-2025 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef TILES_BANKS_TESTS_H
+#define TILES_BANKS_TESTS_H
+
+#include "bn_core.h"
+#include "bn_regular_bg_ptr.h"
+#include "bn_bg_palette_ptr.h"
+#include "bn_regular_bg_map_ptr.h"
+#include "bn_regular_bg_tiles_ptr.h"
+#include "bn_regular_bg_map_cell_info.h"
+#include "bn_regular_bg_items_tiles_bank_a.h"
+#include "bn_regular_bg_items_tiles_bank_b.h"
+#include "bn_regular_bg_items_tiles_bank_a_ref.h"
+#include "bn_regular_bg_items_tiles_bank_b_ref.h"
+#include "tests.h"
+
+class tiles_banks_tests : public tests
+{
+
+public:
+    tiles_banks_tests() :
+        tests("tiles_banks")
+    {
+        _items_test();
+        _pixels_test(bn::regular_bg_items::tiles_bank_a, bn::regular_bg_items::tiles_bank_a_ref);
+        _pixels_test(bn::regular_bg_items::tiles_bank_b, bn::regular_bg_items::tiles_bank_b_ref);
+        _vram_test();
+    }
+
+private:
+    static void _items_test()
+    {
+        const bn::regular_bg_item& a_item = bn::regular_bg_items::tiles_bank_a;
+        const bn::regular_bg_item& b_item = bn::regular_bg_items::tiles_bank_b;
+        BN_ASSERT(a_item.tiles_item() == bn::regular_bg_tiles_items::tiles_bank_test);
+        BN_ASSERT(b_item.tiles_item() == bn::regular_bg_tiles_items::tiles_bank_test);
+        BN_ASSERT(a_item.palette_item() == bn::regular_bg_tiles_items::tiles_bank_test_palette);
+        BN_ASSERT(b_item.palette_item() == bn::regular_bg_tiles_items::tiles_bank_test_palette);
+
+        // Tiles shared by both backgrounds are stored only once:
+        int tiles_count = bn::regular_bg_tiles_items::tiles_bank_test.tiles_ref().size();
+        int a_tiles_count = bn::regular_bg_items::tiles_bank_a_ref.tiles_item().tiles_ref().size();
+        int b_tiles_count = bn::regular_bg_items::tiles_bank_b_ref.tiles_item().tiles_ref().size();
+        BN_ASSERT(tiles_count < a_tiles_count + b_tiles_count, tiles_count, " - ", a_tiles_count + b_tiles_count);
+
+        // Both backgrounds don't fit in one palette:
+        BN_ASSERT(bn::regular_bg_tiles_items::tiles_bank_test_palette.colors_ref().size() == 32);
+    }
+
+    static void _pixels_test(const bn::regular_bg_item& item, const bn::regular_bg_item& ref_item)
+    {
+        // Pixels must have the same colors as the ones of the background converted without a tiles bank:
+        const bn::regular_bg_map_item& map_item = item.map_item();
+        const bn::regular_bg_map_item& ref_map_item = ref_item.map_item();
+        const bn::regular_bg_map_cell* cells_ptr = map_item.cells_ptr();
+        const bn::regular_bg_map_cell* ref_cells_ptr = ref_map_item.cells_ptr();
+        int columns = map_item.dimensions().width();
+        int rows = map_item.dimensions().height();
+        BN_ASSERT(map_item.dimensions() == ref_map_item.dimensions());
+
+        for(int y = 0; y < rows * 8; ++y)
+        {
+            for(int x = 0; x < columns * 8; ++x)
+            {
+                int cell_index = ((y / 8) * columns) + (x / 8);
+                bn::optional<bn::color> color = _pixel_color(item, cells_ptr[cell_index], x, y);
+                bn::optional<bn::color> ref_color = _pixel_color(ref_item, ref_cells_ptr[cell_index], x, y);
+                BN_ASSERT(color == ref_color, "Invalid pixel: ", x, " - ", y);
+            }
+        }
+    }
+
+    static void _vram_test()
+    {
+        // Backgrounds of the same tiles bank share tiles and colors in VRAM too:
+        bn::regular_bg_ptr a_bg = bn::regular_bg_items::tiles_bank_a.create_bg(0, 0);
+        bn::regular_bg_ptr b_bg = bn::regular_bg_items::tiles_bank_b.create_bg(0, 0);
+        BN_ASSERT(a_bg.tiles() == b_bg.tiles());
+        BN_ASSERT(a_bg.palette() == b_bg.palette());
+        BN_ASSERT(a_bg.map() != b_bg.map());
+        bn::core::update();
+    }
+
+    [[nodiscard]] static bn::optional<bn::color> _pixel_color(
+            const bn::regular_bg_item& item, bn::regular_bg_map_cell cell, int x, int y)
+    {
+        bn::regular_bg_map_cell_info cell_info(cell);
+        int tile_x = x % 8;
+        int tile_y = y % 8;
+
+        if(cell_info.horizontal_flip())
+        {
+            tile_x = 7 - tile_x;
+        }
+
+        if(cell_info.vertical_flip())
+        {
+            tile_y = 7 - tile_y;
+        }
+
+        const bn::tile& tile = item.tiles_item().tiles_ref()[cell_info.tile_index()];
+        int color_index = int((tile.data[tile_y] >> (tile_x * 4)) & 0xF);
+        bn::optional<bn::color> result;
+
+        // The first color of each palette is transparent:
+        if(color_index)
+        {
+            result = item.palette_item().colors_ref()[(cell_info.palette_id() * 16) + color_index];
+        }
+
+        return result;
+    }
+};
+
+#endif
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2020-2025 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef VBLANK_CALLBACK_TESTS_H
+#define VBLANK_CALLBACK_TESTS_H
+
+#include "bn_core.h"
+#include "tests.h"
+
+class vblank_callback_tests : public tests
+{
+
+public:
+    vblank_callback_tests() :
+        tests("vblank_callback")
+    {
+        _call_test();
+        _replace_from_callback_test();
+    }
+
+private:
+    static void _call_test()
+    {
+        int calls = 0;
+        bn::core::set_vblank_callback([&calls]() { ++calls; });
+        BN_ASSERT(bn::core::vblank_callback());
+
+        bn::core::update();
+        bn::core::update();
+        BN_ASSERT(calls == 2, calls);
+
+        bn::core::set_vblank_callback(bn::vblank_callback_type());
+        bn::core::update();
+        BN_ASSERT(calls == 2, calls);
+    }
+
+    static void _replace_from_callback_test()
+    {
+        int first_calls = 0;
+        int second_calls = 0;
+        int* first_calls_ptr = &first_calls;
+        int* second_calls_ptr = &second_calls;
+
+        // The captures of the running callback must stay valid after it is replaced:
+        bn::core::set_vblank_callback([first_calls_ptr, second_calls_ptr]()
+        {
+            bn::core::set_vblank_callback([second_calls_ptr]() { ++*second_calls_ptr; });
+            ++*first_calls_ptr;
+        });
+
+        bn::core::update();
+        BN_ASSERT(first_calls == 1, first_calls);
+        BN_ASSERT(second_calls == 0, second_calls);
+
+        bn::core::update();
+        BN_ASSERT(first_calls == 1, first_calls);
+        BN_ASSERT(second_calls == 1, second_calls);
+
+        bn::core::set_vblank_callback(bn::vblank_callback_type());
+    }
+};
+
+#endif
@@ -19,9 +19,26 @@
 #include "random_tests.h"
 #include "optional_tests.h"
 #include "any_tests.h"
+#include "inplace_function_tests.h"
 #include "format_tests.h"
 #include "memory_tests.h"
 #include "sram_tests.h"
+#include "sram_journal_tests.h"
+#include "hbe_tables_tests.h"
+#include "link_stream_tests.h"
+#include "link_rollback_tests.h"
+#include "staging_tests.h"
+#include "big_map_chunks_tests.h"
+#include "regular_bg_tiles_cache_tests.h"
+#include "sprite_streamed_animate_action_tests.h"
+#include "sprite_hbe_cleanup_tests.h"
+#include "sprite_batch_tests.h"
+#include "tasks_tests.h"
+#include "sprite_text_tests.h"
+#include "vblank_callback_tests.h"
+#include "palette_bands_tests.h"
+#include "tiles_banks_tests.h"
+#include "regular_bg_text_generator_tests.h"
 
 #if ! BN_CFG_ASSERT_ENABLED
     static_assert(false, "Enable asserts in bn_config_assert.h to run tests");
@@ -47,7 +64,24 @@ int main()
     random_tests();
     optional_tests();
     any_tests();
+    inplace_function_tests();
     format_tests();
+    link_stream_tests();
+    link_rollback_tests();
+    staging_tests();
+    big_map_chunks_tests();
+    regular_bg_tiles_cache_tests();
+    sprite_streamed_animate_action_tests();
+    sprite_hbe_cleanup_tests();
+    sprite_batch_tests();
+    tasks_tests();
+    sprite_text_tests();
+    vblank_callback_tests();
+    palette_bands_tests();
+    tiles_banks_tests();
+    regular_bg_text_generator_tests();
+    sram_journal_tests();
+    hbe_tables_tests();
     memory_tests memory_tests(used_stack_iwram);
     sram_tests sram_tests;
 
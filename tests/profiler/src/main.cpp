@@ -4,21 +4,41 @@
  */
 
 #include <coroutine>
+#include "bn_log.h"
 #include "bn_core.h"
+#include "bn_timer.h"
+#include "bn_timers.h"
 #include "bn_limits.h"
 #include "bn_random.h"
+#include "bn_tasks.h"
+#include "bn_vector.h"
+#include "bn_string.h"
+#include "bn_camera_ptr.h"
 #include "bn_profiler.h"
+#include "bn_models_3d.h"
+#include "bn_camera_3d.h"
+#include "bn_sprite_ptr.h"
+#include "bn_sprite_text.h"
+#include "bn_sprite_batch.h"
+#include "bn_config_tasks.h"
+#include "bn_config_sprites.h"
 #include "bn_unique_ptr.h"
 #include "bn_seed_random.h"
+#include "bn_spatial_grid.h"
 #include "bn_best_fit_allocator.h"
 
 #include "../../butano/hw/include/bn_hw_dma.h"
 #include "../../butano/hw/include/bn_hw_memory.h"
+#include "../../butano/hw/include/bn_hw_bg_blocks.h"
 #include "../../butano/hw/include/bn_hw_decompress.h"
 
+#include "bn_model_3d_items_cube.h"
 #include "bn_regular_bg_items_butano_huge_rl.h"
 #include "bn_regular_bg_items_butano_huge_huff.h"
 #include "bn_regular_bg_items_butano_huge_lz77.h"
+#include "bn_sprite_items_common_variable_8x8_font.h"
+
+#include "common_variable_8x8_sprite_font.h"
 
 namespace
 {
@@ -27,6 +47,14 @@ constexpr int its_sqrt = 100;
 constexpr int its = its_sqrt * its_sqrt;
 constexpr bool check_bios = true;
 
+// bn::core::update waits for the next V-Blank, so the CPU ticks of each frame are accumulated too
+// to exclude the wait:
+[[nodiscard]] int core_update_cpu_ticks()
+{
+    bn::core::update();
+    return bn::core::last_cpu_ticks();
+}
+
 void div_test(int& integer)
 {
     constexpr int dividend = bn::numeric_limits<int>::max() / 2;
@@ -180,6 +208,29 @@ void atan2_test(int& integer)
     BN_PROFILER_STOP();
 }
 
+void nested_test(int& integer)
+{
+    BN_PROFILER_SCOPE("nested_outer");
+
+    bn::random random;
+
+    for(int i = 0; i < its; ++i)
+    {
+        integer += random.get();
+    }
+
+    {
+        BN_PROFILER_SCOPE("nested_inner");
+
+        bn::seed_random seed_random;
+
+        for(int i = 0; i < its; ++i)
+        {
+            integer += seed_random.get();
+        }
+    }
+}
+
 template<class allocator>
 class std_coroutine_task
 {
@@ -452,6 +503,543 @@ void coroutine_test(int& integer)
     integer += agbabi_iwram_result;
 }
 
+constexpr int tasks_count = BN_CFG_TASKS_MAX_ITEMS;
+constexpr int tasks_frames = 64;
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wswitch-default"
+
+bn::task tasks_test_impl(bn::random& random, int& integer)
+{
+    while(true)
+    {
+        co_await bn::tasks::next_frame();
+        integer += int(random.get());
+    }
+}
+
+#pragma GCC diagnostic pop
+
+void tasks_test(int& integer)
+{
+    int disabled_cpu_ticks = 0;
+    BN_PROFILER_START("tasks_disabled");
+
+    int disabled_result = 0;
+
+    {
+        bn::random random;
+
+        for(int frame = 0; frame < tasks_frames; ++frame)
+        {
+            for(int index = 0; index < tasks_count; ++index)
+            {
+                disabled_result += int(random.get());
+            }
+
+            disabled_cpu_ticks += core_update_cpu_ticks();
+        }
+    }
+
+    BN_PROFILER_STOP();
+
+    int tasks_cpu_ticks = 0;
+    BN_PROFILER_START("tasks_next_frame");
+
+    int tasks_result = 0;
+
+    {
+        bn::random random;
+        bn::vector<bn::task, tasks_count> tasks;
+
+        for(int index = 0; index < tasks_count; ++index)
+        {
+            tasks.push_back(tasks_test_impl(random, tasks_result));
+        }
+
+        for(int frame = 0; frame < tasks_frames; ++frame)
+        {
+            tasks_cpu_ticks += core_update_cpu_ticks();
+        }
+    }
+
+    BN_PROFILER_STOP();
+
+    BN_ASSERT(disabled_result == tasks_result, "Invalid tasks result");
+
+    // Tasks are resumed at the end of bn::core::update, so each frame reports the tasks resumed in the previous one.
+    // Scheduling overhead per task includes the tasks pool iteration, the resume and the suspension:
+    int overhead_clocks = (tasks_cpu_ticks - disabled_cpu_ticks) * bn::timers::cpu_clocks_per_tick();
+    int clocks_per_task = overhead_clocks / (tasks_count * tasks_frames);
+    BN_LOG("tasks - scheduling CPU clocks per task and frame: ", clocks_per_task);
+
+    integer += tasks_result;
+}
+
+constexpr int allocator_buffer_bytes = 32 * 1024;
+constexpr int allocator_max_ptrs = 256;
+
+int allocator_largest_block(bn::best_fit_allocator& allocator)
+{
+    int min_bytes = 0;
+    int max_bytes = allocator.available_bytes();
+
+    while(min_bytes < max_bytes)
+    {
+        int bytes = (min_bytes + max_bytes + 1) / 2;
+
+        if(void* ptr = allocator.alloc(bytes))
+        {
+            allocator.free(ptr);
+            min_bytes = bytes;
+        }
+        else
+        {
+            max_bytes = bytes - 1;
+        }
+    }
+
+    return min_bytes;
+}
+
+void allocator_test(int& integer)
+{
+    constexpr const char* ids[] = { "allocator_best_fit", "allocator_segregated_fit" };
+
+    bn::unique_ptr<bn::array<uint8_t, allocator_buffer_bytes>> buffer_ptr(
+                new bn::array<uint8_t, allocator_buffer_bytes>());
+
+    for(int mode = 0; mode < 2; ++mode)
+    {
+        const char* id = ids[mode];
+        bool segregated_fit = mode == 1;
+        bn::best_fit_allocator allocator(buffer_ptr->data(), allocator_buffer_bytes, segregated_fit);
+        bn::array<void*, allocator_max_ptrs> ptrs = {};
+        bn::random random;
+        int failed_allocs = 0;
+
+        BN_PROFILER_START(id);
+
+        for(int index = 0; index < its; ++index)
+        {
+            void*& ptr = ptrs[random.get_int(allocator_max_ptrs)];
+
+            if(ptr)
+            {
+                allocator.free(ptr);
+                ptr = nullptr;
+            }
+            else
+            {
+                int bytes = (random.get_int() & 7) ? 4 + random.get_int(60) : 64 + random.get_int(960);
+                ptr = allocator.alloc(bytes);
+
+                if(! ptr)
+                {
+                    ++failed_allocs;
+                }
+            }
+        }
+
+        BN_PROFILER_STOP();
+
+        int largest_block = allocator_largest_block(allocator);
+        BN_LOG(id, " - failed allocs: ", failed_allocs, " - available bytes: ", allocator.available_bytes(),
+               " - largest block: ", largest_block);
+
+        for(void* ptr : ptrs)
+        {
+            if(ptr)
+            {
+                allocator.free(ptr);
+            }
+        }
+
+        integer += failed_allocs + largest_block;
+    }
+}
+
+constexpr int sprites_sort_count = 64;
+constexpr int sprites_sort_changes_per_frame = 8;
+constexpr int sprites_sort_frames = 100;
+
+void sprites_sort_test()
+{
+    // Build the profiler with BN_CFG_SPRITES_INCREMENTAL_SORT_ENABLED set to true and to false
+    // to compare both sort paths:
+    #if BN_CFG_SPRITES_INCREMENTAL_SORT_ENABLED
+        constexpr const char* id = "sprites_sort_incremental";
+    #else
+        constexpr const char* id = "sprites_sort_rebuild";
+    #endif
+
+    bn::vector<bn::sprite_ptr, sprites_sort_count> sprites;
+    bn::random random;
+
+    for(int index = 0; index < sprites_sort_count; ++index)
+    {
+        int x = ((index % 16) * 14) - 104;
+        int y = ((index / 16) * 24) - 40;
+        sprites.push_back(bn::sprite_items::common_variable_8x8_font.create_sprite(x, y));
+    }
+
+    bn::core::update();
+
+    int cpu_ticks = 0;
+    BN_PROFILER_START(id);
+
+    for(int frame = 0; frame < sprites_sort_frames; ++frame)
+    {
+        for(int change = 0; change < sprites_sort_changes_per_frame; ++change)
+        {
+            bn::sprite_ptr& sprite = sprites[random.get_int(sprites_sort_count)];
+            sprite.set_z_order(random.get_int(8));
+        }
+
+        cpu_ticks += core_update_cpu_ticks();
+    }
+
+    BN_PROFILER_STOP();
+
+    BN_LOG(id, " - CPU ticks per frame: ", cpu_ticks / sprites_sort_frames);
+
+    sprites.clear();
+    bn::core::update();
+}
+
+constexpr int cameras_world_sprites_count = 112;
+constexpr int cameras_hud_sprites_count = 8;
+constexpr int cameras_frames = 100;
+
+void cameras_test_impl(bool move_hud, const char* id)
+{
+    bn::camera_ptr world_camera = bn::camera_ptr::create(0, 0);
+    bn::camera_ptr hud_camera = bn::camera_ptr::create(0, 0);
+    bn::vector<bn::sprite_ptr, cameras_world_sprites_count + cameras_hud_sprites_count> sprites;
+
+    for(int index = 0; index < cameras_world_sprites_count + cameras_hud_sprites_count; ++index)
+    {
+        int x = ((index % 16) * 14) - 104;
+        int y = ((index / 16) * 18) - 64;
+        bn::sprite_ptr sprite = bn::sprite_items::common_variable_8x8_font.create_sprite(x, y);
+        sprite.set_camera(index < cameras_world_sprites_count ? world_camera : hud_camera);
+        sprites.push_back(bn::move(sprite));
+    }
+
+    bn::core::update();
+
+    bn::camera_ptr& moved_camera = move_hud ? hud_camera : world_camera;
+    int cpu_ticks = 0;
+    BN_PROFILER_START(id);
+
+    // A one pixel shake of one camera only updates the sprites attached to it:
+    for(int frame = 0; frame < cameras_frames; ++frame)
+    {
+        moved_camera.set_x(frame % 2);
+        cpu_ticks += core_update_cpu_ticks();
+    }
+
+    BN_PROFILER_STOP();
+
+    BN_LOG(id, " - CPU ticks per frame: ", cpu_ticks / cameras_frames);
+
+    bn::core::update();
+}
+
+void cameras_test()
+{
+    cameras_test_impl(true, "cameras_hud_move");
+    cameras_test_impl(false, "cameras_world_move");
+}
+
+constexpr int sprite_batch_sprites_count = 96;
+constexpr int sprite_batch_frames = 100;
+
+[[nodiscard]] bn::point sprite_batch_position(int index, int frame)
+{
+    int x = ((index % 16) * 14) - 104 + (frame % 8);
+    int y = ((index / 16) * 24) - 64 + (frame % 4);
+    return bn::point(x, y);
+}
+
+void sprite_batch_sprites_test()
+{
+    bn::vector<bn::sprite_ptr, sprite_batch_sprites_count> sprites;
+
+    for(int index = 0; index < sprite_batch_sprites_count; ++index)
+    {
+        sprites.push_back(bn::sprite_items::common_variable_8x8_font.create_sprite(sprite_batch_position(index, 0)));
+    }
+
+    bn::core::update();
+
+    int cpu_ticks = 0;
+    BN_PROFILER_START("sprite_batch_sprite_ptrs");
+
+    // Every sprite is moved every frame:
+    for(int frame = 0; frame < sprite_batch_frames; ++frame)
+    {
+        for(int index = 0; index < sprite_batch_sprites_count; ++index)
+        {
+            sprites[index].set_position(sprite_batch_position(index, frame));
+        }
+
+        cpu_ticks += core_update_cpu_ticks();
+    }
+
+    BN_PROFILER_STOP();
+
+    BN_LOG("sprite_batch_sprite_ptrs - CPU ticks per frame: ", cpu_ticks / sprite_batch_frames);
+
+    sprites.clear();
+    bn::core::update();
+}
+
+void sprite_batch_batch_test()
+{
+    const bn::sprite_item& item = bn::sprite_items::common_variable_8x8_font;
+    bn::sprite_tiles_ptr tiles = item.tiles_item().create_tiles();
+    bn::unique_ptr<bn::sprite_batch<sprite_batch_sprites_count>> batch_ptr(
+                new bn::sprite_batch<sprite_batch_sprites_count>(
+                    item.shape_size(), bn::span<const bn::sprite_tiles_ptr>(&tiles, 1),
+                    item.palette_item().create_palette()));
+    bn::sprite_batch<sprite_batch_sprites_count>& batch = *batch_ptr;
+
+    for(int index = 0; index < sprite_batch_sprites_count; ++index)
+    {
+        batch.push_back(sprite_batch_position(index, 0));
+    }
+
+    bn::core::update();
+
+    int cpu_ticks = 0;
+    BN_PROFILER_START("sprite_batch_batch");
+
+    for(int frame = 0; frame < sprite_batch_frames; ++frame)
+    {
+        bn::span<int16_t> xs = batch.xs();
+        bn::span<int16_t> ys = batch.ys();
+
+        for(int index = 0; index < sprite_batch_sprites_count; ++index)
+        {
+            bn::point position = sprite_batch_position(index, frame);
+            xs[index] = int16_t(position.x());
+            ys[index] = int16_t(position.y());
+        }
+
+        cpu_ticks += core_update_cpu_ticks();
+    }
+
+    BN_PROFILER_STOP();
+
+    BN_LOG("sprite_batch_batch - CPU ticks per frame: ", cpu_ticks / sprite_batch_frames);
+
+    batch_ptr.reset();
+    bn::core::update();
+}
+
+void sprite_batch_test()
+{
+    sprite_batch_sprites_test();
+    sprite_batch_batch_test();
+}
+
+constexpr int sprite_text_frames = 64;
+
+void sprite_text_test()
+{
+    bn::sprite_text_generator text_generator(common::variable_8x8_sprite_font);
+    bn::string<16> text;
+
+    {
+        bn::vector<bn::sprite_ptr, 4> text_sprites;
+        BN_PROFILER_START("sprite_text_generate");
+
+        // A HUD score which changes every frame, regenerated from scratch:
+        for(int frame = 0; frame < sprite_text_frames; ++frame)
+        {
+            text = "SCORE: ";
+            text += bn::to_string<8>(100000 + frame);
+            text_sprites.clear();
+            text_generator.generate(0, 0, text, text_sprites);
+        }
+
+        BN_PROFILER_STOP();
+    }
+
+    bn::core::update();
+
+    {
+        bn::sprite_text<4> sprite_text(text_generator, 0, 0, "SCORE: 100000");
+        int redrawn_tiles_count = 0;
+        BN_PROFILER_START("sprite_text_set_text");
+
+        // The same score, redrawing only the tiles of the changed digits:
+        for(int frame = 0; frame < sprite_text_frames; ++frame)
+        {
+            text = "SCORE: ";
+            text += bn::to_string<8>(100000 + frame);
+            sprite_text.set_text(text);
+            redrawn_tiles_count += sprite_text.last_redrawn_tiles_count();
+        }
+
+        BN_PROFILER_STOP();
+
+        BN_LOG("sprite_text_set_text - redrawn tiles per frame: ", redrawn_tiles_count / sprite_text_frames);
+    }
+
+    bn::core::update();
+}
+
+constexpr int models_3d_columns = 5;
+constexpr int models_3d_rows = 3;
+constexpr int models_3d_count = models_3d_columns * models_3d_rows;
+constexpr int models_3d_frames = 32;
+
+void models_3d_test()
+{
+    using models_type = bn::models_3d<models_3d_count, 128, 96>;
+
+    constexpr bn::color colors[] = {
+        bn::color(6, 12, 6),
+        bn::color(10, 18, 8),
+        bn::color(30, 8, 6),
+    };
+
+    bn::unique_ptr<models_type> models(new models_type());
+    models->set_colors(colors);
+
+    bn::vector<bn::model_3d*, models_3d_count> dynamic_models;
+
+    for(int row = 0; row < models_3d_rows; ++row)
+    {
+        for(int column = 0; column < models_3d_columns; ++column)
+        {
+            bn::model_3d& model = models->create_dynamic_model(bn::model_3d_items::cube);
+            model.set_position(bn::point_3d((column - (models_3d_columns / 2)) * 48, 0,
+                                            (row - (models_3d_rows / 2)) * 48));
+            dynamic_models.push_back(&model);
+        }
+    }
+
+    bn::camera_3d camera;
+    int hlines_count = 0;
+    BN_PROFILER_START("models_3d_update");
+
+    // Every model is rotated every frame:
+    for(int frame = 0; frame < models_3d_frames; ++frame)
+    {
+        for(int index = 0; index < models_3d_count; ++index)
+        {
+            int angle = ((frame * 4) + (index * 24)) % 360;
+            dynamic_models[index]->set_rotation(angle, frame, 360 - angle);
+        }
+
+        models->update(camera);
+        hlines_count += models->last_hlines_count();
+    }
+
+    BN_PROFILER_STOP();
+
+    BN_LOG("models_3d_update - scanline sprites per frame: ", hlines_count / models_3d_frames);
+
+    models.reset();
+    bn::core::update();
+}
+
+constexpr int spatial_grid_frames = 4;
+constexpr int spatial_grid_cell_size = 16;
+constexpr int spatial_grid_cells = 16;
+
+template<int Size>
+void spatial_grid_test_impl(const char* id, int& integer)
+{
+    using grid_type = bn::spatial_grid<Size, spatial_grid_cells, spatial_grid_cells>;
+
+    bn::unique_ptr<grid_type> grid_ptr(new grid_type(bn::fixed_point(), spatial_grid_cell_size));
+    bn::unique_ptr<bn::array<bn::top_left_fixed_rect, Size>> rects_ptr(new bn::array<bn::top_left_fixed_rect, Size>());
+    grid_type& grid = *grid_ptr;
+    bn::array<bn::top_left_fixed_rect, Size>& rects = *rects_ptr;
+    bn::vector<uint16_t, Size> indexes;
+    bn::random random;
+    int max_position = spatial_grid_cell_size * spatial_grid_cells;
+
+    for(bn::top_left_fixed_rect& rect : rects)
+    {
+        rect = bn::top_left_fixed_rect(random.get_int(max_position), random.get_int(max_position),
+                                       4 + random.get_int(12), 4 + random.get_int(12));
+        grid.insert(rect);
+    }
+
+    bn::timer timer;
+    BN_PROFILER_START(id);
+
+    // Each frame all rectangles are moved and then tested against the other ones:
+    for(int frame = 0; frame < spatial_grid_frames; ++frame)
+    {
+        for(int index = 0; index < Size; ++index)
+        {
+            bn::top_left_fixed_rect& rect = rects[index];
+            rect.set_x(bn::clamp(rect.x() + random.get_int(-2, 3), bn::fixed(0), bn::fixed(max_position)));
+            rect.set_y(bn::clamp(rect.y() + random.get_int(-2, 3), bn::fixed(0), bn::fixed(max_position)));
+            grid.set_rect(index, rect);
+        }
+
+        for(const bn::top_left_fixed_rect& rect : rects)
+        {
+            indexes.clear();
+            grid.query(rect, indexes);
+            integer += indexes.size();
+        }
+    }
+
+    BN_PROFILER_STOP();
+
+    int queries_per_frame = (Size * spatial_grid_frames * bn::timers::ticks_per_frame()) / timer.elapsed_ticks();
+    BN_LOG(id, " - queries per frame: ", queries_per_frame);
+}
+
+template<int Size>
+void spatial_grid_linear_test_impl(const char* id, int& integer)
+{
+    bn::unique_ptr<bn::array<bn::top_left_fixed_rect, Size>> rects_ptr(new bn::array<bn::top_left_fixed_rect, Size>());
+    bn::array<bn::top_left_fixed_rect, Size>& rects = *rects_ptr;
+    bn::random random;
+    int max_position = spatial_grid_cell_size * spatial_grid_cells;
+
+    for(bn::top_left_fixed_rect& rect : rects)
+    {
+        rect = bn::top_left_fixed_rect(random.get_int(max_position), random.get_int(max_position),
+                                       4 + random.get_int(12), 4 + random.get_int(12));
+    }
+
+    bn::timer timer;
+    BN_PROFILER_START(id);
+
+    for(int frame = 0; frame < spatial_grid_frames; ++frame)
+    {
+        for(const bn::top_left_fixed_rect& rect : rects)
+        {
+            for(const bn::top_left_fixed_rect& other_rect : rects)
+            {
+                integer += rect.intersects(other_rect);
+            }
+        }
+    }
+
+    BN_PROFILER_STOP();
+
+    int queries_per_frame = (Size * spatial_grid_frames * bn::timers::ticks_per_frame()) / timer.elapsed_ticks();
+    BN_LOG(id, " - queries per frame: ", queries_per_frame);
+}
+
+void spatial_grid_test(int& integer)
+{
+    spatial_grid_linear_test_impl<256>("spatial_grid_linear_256", integer);
+    spatial_grid_test_impl<256>("spatial_grid_256", integer);
+    spatial_grid_test_impl<512>("spatial_grid_512", integer);
+    spatial_grid_test_impl<1024>("spatial_grid_1024", integer);
+}
 
 constexpr int copy_words = bn::regular_bg_items::butano_huge_huff.tiles_item().tiles_ref().size_bytes() / 4;
 constexpr int copy_words_data[copy_words] = {};
@@ -567,6 +1155,42 @@ void huff_decomp_test()
     }
 }
 
+void staging_test()
+{
+    const bn::tile* tiles = bn::regular_bg_items::butano_huge_lz77.tiles_item().tiles_ref().data();
+    bn::unique_ptr<bn::array<uint8_t, 64 * 1024>> buffer_ptr(new bn::array<uint8_t, 64 * 1024>());
+    uint8_t* buffer = buffer_ptr->data();
+    uint16_t* vram = bn::hw::bg_blocks::vram(0);
+    int words = int(*reinterpret_cast<const unsigned*>(tiles) >> 8) / 4;
+
+    // Without a staging buffer, compressed tiles are decompressed in V-Blank:
+    BN_PROFILER_START("staging_vblank_before");
+
+    bn::hw::decompress::lz77(tiles, vram);
+
+    BN_PROFILER_STOP();
+
+    // With a staging buffer, they are decompressed before V-Blank and only copied in V-Blank:
+    BN_PROFILER_START("staging_update_after");
+
+    bn::hw::decompress::lz77(tiles, buffer);
+
+    BN_PROFILER_STOP();
+
+    const uint16_t* staged_data = reinterpret_cast<const uint16_t*>(buffer);
+
+    for(int index = 0; index < words * 2; ++index)
+    {
+        BN_ASSERT(vram[index] == staged_data[index], "Invalid staged data: ", index);
+    }
+
+    BN_PROFILER_START("staging_vblank_after");
+
+    bn::hw::dma::copy_words(buffer, words, vram);
+
+    BN_PROFILER_STOP();
+}
+
 }
 
 int main()
@@ -579,14 +1203,25 @@ int main()
     random_test(integer);
     lut_sin_test(integer);
     atan2_test(integer);
+    nested_test(integer);
     coroutine_test(integer);
+    tasks_test(integer);
+    allocator_test(integer);
+    sprites_sort_test();
+    cameras_test();
+    sprite_batch_test();
+    sprite_text_test();
+    models_3d_test();
+    spatial_grid_test(integer);
     copy_words_test();
     rl_decomp_test();
     lz77_decomp_test();
     huff_decomp_test();
+    staging_test();
 
     if(integer)
     {
+        bn::profiler::log();
         bn::profiler::show();
     }
     else
@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2020-2025 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_log.h"
+#include "bn_core.h"
+#include "bn_colors.h"
+#include "bn_vector.h"
+#include "bn_sprites.h"
+#include "bn_sprite_ptr.h"
+#include "bn_bg_palettes.h"
+
+#include "bn_sprite_items_common_variable_8x8_font.h"
+
+#if ! BN_CFG_ASSERT_ENABLED
+    static_assert(false, "Enable asserts in bn_config_assert.h to run tests");
+#endif
+
+#if ! BN_CFG_SPRITES_MULTIPLEXING_ENABLED
+    static_assert(false, "Enable sprites multiplexing in the Makefile to run tests");
+#endif
+
+namespace
+{
+    constexpr int upper_columns = 16;
+    constexpr int upper_rows = 8;
+    constexpr int lower_columns = 8;
+    constexpr int lower_rows = 6;
+    constexpr int rows_height = 10;
+    constexpr int lower_first_y = 90;
+
+    using sprites_vector = bn::vector<bn::sprite_ptr, 192>;
+
+    void add_sprite(int x, int y, sprites_vector& sprites)
+    {
+        bn::sprite_ptr sprite = bn::sprite_items::common_variable_8x8_font.create_sprite(0, 0, sprites.size() % 64);
+        sprite.set_top_left_position(x, y);
+        sprites.push_back(bn::move(sprite));
+    }
+
+    void multiplexed_sprites_test(sprites_vector& sprites)
+    {
+        // Upper rows use all hardware sprite handles, so lower rows must reuse them:
+        for(int row = 0; row < upper_rows; ++row)
+        {
+            for(int column = 0; column < upper_columns; ++column)
+            {
+                add_sprite(column * 15, row * rows_height, sprites);
+            }
+        }
+
+        for(int row = 0; row < lower_rows; ++row)
+        {
+            for(int column = 0; column < lower_columns; ++column)
+            {
+                add_sprite(column * 30, lower_first_y + (row * rows_height), sprites);
+            }
+        }
+
+        bn::core::update();
+        BN_ASSERT(bn::sprites::overflow_items_count() == 0, bn::sprites::overflow_items_count());
+        BN_ASSERT(bn::sprites::multiplexed_items_count() == lower_columns * lower_rows,
+                  bn::sprites::multiplexed_items_count());
+
+        // Moving multiplexed sprites inside their bands must keep them displayed:
+        for(int index = upper_columns * upper_rows; index < sprites.size(); ++index)
+        {
+            bn::sprite_ptr& sprite = sprites[index];
+            sprite.set_x(sprite.x() + 1);
+        }
+
+        bn::core::update();
+        BN_ASSERT(bn::sprites::overflow_items_count() == 0, bn::sprites::overflow_items_count());
+        BN_ASSERT(bn::sprites::multiplexed_items_count() == lower_columns * lower_rows,
+                  bn::sprites::multiplexed_items_count());
+    }
+
+    void band_boundary_sprites_test(sprites_vector& sprites)
+    {
+        // With 16 bands, each band is 10 scanlines high and upper rows release their handles for band 8 onwards.
+        // Rows start at the first scanline of a band or cross the boundary between two bands:
+        constexpr int boundary_columns = 8;
+        constexpr int boundary_rows_y[] = { 80, 99, 120, 149 };
+        constexpr int boundary_moves = 10;
+
+        while(sprites.size() > upper_columns * upper_rows)
+        {
+            sprites.pop_back();
+        }
+
+        for(int row_y : boundary_rows_y)
+        {
+            for(int column = 0; column < boundary_columns; ++column)
+            {
+                add_sprite(column * 30, row_y, sprites);
+            }
+        }
+
+        // Moving rows across band boundaries must keep them displayed:
+        for(int move = 0; move < boundary_moves; ++move)
+        {
+            bn::core::update();
+            BN_ASSERT(bn::sprites::overflow_items_count() == 0, bn::sprites::overflow_items_count(), " - ", move);
+            BN_ASSERT(bn::sprites::multiplexed_items_count() == boundary_columns * 4,
+                      bn::sprites::multiplexed_items_count(), " - ", move);
+
+            for(int row_y : boundary_rows_y)
+            {
+                BN_ASSERT(bn::sprites::scanline_overflow_items_count(row_y + move) == 0,
+                          bn::sprites::scanline_overflow_items_count(row_y + move), " - ", row_y, " - ", move);
+            }
+
+            for(int index = upper_columns * upper_rows; index < sprites.size(); ++index)
+            {
+                bn::sprite_ptr& sprite = sprites[index];
+                sprite.set_y(sprite.y() + 1);
+            }
+        }
+
+        while(sprites.size() > upper_columns * upper_rows)
+        {
+            sprites.pop_back();
+        }
+    }
+
+    void overflow_sprites_test(sprites_vector& sprites)
+    {
+        // The last band can't rewrite more hardware sprite handles than the maximum allowed per band:
+        constexpr int extra_sprites = 4;
+        constexpr int overflow_y = lower_first_y + ((lower_rows - 1) * rows_height);
+
+        for(int index = 0; index < extra_sprites; ++index)
+        {
+            add_sprite(15 + (index * 30), overflow_y, sprites);
+        }
+
+        bn::core::update();
+        BN_ASSERT(bn::sprites::overflow_items_count() == extra_sprites, bn::sprites::overflow_items_count());
+        BN_ASSERT(bn::sprites::scanline_overflow_items_count(overflow_y) == extra_sprites,
+                  bn::sprites::scanline_overflow_items_count(overflow_y));
+
+        for(int index = 0; index < extra_sprites; ++index)
+        {
+            sprites.pop_back();
+        }
+
+        bn::core::update();
+        BN_ASSERT(bn::sprites::overflow_items_count() == 0, bn::sprites::overflow_items_count());
+    }
+}
+
+int main()
+{
+    bn::core::init();
+
+    sprites_vector sprites;
+    multiplexed_sprites_test(sprites);
+    overflow_sprites_test(sprites);
+    band_boundary_sprites_test(sprites);
+
+    BN_LOG("Sprites multiplexing tests passed");
+    bn::bg_palettes::set_transparent_color(bn::colors::green);
+
+    while(true)
+    {
+        bn::core::update();
+    }
+}